@@ -0,0 +1,5 @@
+SOURCES = avx512bw.cpp
+CONFIG -= qt dylib release debug_and_release
+CONFIG += debug console
+isEmpty(QMAKE_CFLAGS_AVX512BW):error("This compiler does not support AVX-512 BW")
+else:QMAKE_CXXFLAGS += $$QMAKE_CFLAGS_AVX512BW
@@ -12,6 +12,7 @@ load(qt_module)
 PRECOMPILED_HEADER = ../corelib/global/qt_pch.h
 
 SOURCES += \
+        qtconcurrentalgorithms.cpp \
         qtconcurrentfilter.cpp \
         qtconcurrentmap.cpp \
         qtconcurrentrun.cpp \
@@ -20,6 +21,7 @@ SOURCES += \
 
 HEADERS += \
         qtconcurrent_global.h \
+        qtconcurrentalgorithms.h \
         qtconcurrentcompilertest.h \
         qtconcurrentexception.h \
         qtconcurrentfilter.h \
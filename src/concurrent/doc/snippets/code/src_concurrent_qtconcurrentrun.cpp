@@ -103,3 +103,23 @@ void someFunction(int arg1, double arg2);
 QFuture<void> future = QtConcurrent::run(std::bind(someFunction, 1, 2.0));
 ...
 //! [6]
+
+//! [7]
+QFuture<void> future = QtConcurrent::run(&pool, 10, urgentFunction);
+//! [7]
+
+//! [8]
+void processFiles(const QStringList &files)
+{
+    QtConcurrent::CancellationToken token = QtConcurrent::CancellationToken::current();
+    foreach (const QString &file, files) {
+        if (token.isCanceled())
+            return;
+        processFile(file);
+    }
+}
+
+QFuture<void> future = QtConcurrent::run(processFiles, files);
+...
+future.cancel();
+//! [8]
@@ -0,0 +1,142 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+/*!
+  \fn void QtConcurrent::blockingFor(int begin, int end, Function function)
+  \since 5.6
+
+  Calls \a function once for each index from \a begin up to, but not
+  including, \a end. No container is created for the indexes; the range is
+  split into blocks that are processed by the threads of the global
+  QThreadPool.
+
+  \note This function will block until all indexes have been processed.
+
+  \sa blockingMap(), blockingTransformReduce()
+*/
+
+/*!
+  \fn T QtConcurrent::blockingTransformReduce(int begin, int end, MapFunction mapFunction, ReduceFunction reduceFunction, QtConcurrent::ReduceOptions reduceOptions)
+  \since 5.6
+
+  Calls \a mapFunction once for each index from \a begin up to, but not
+  including, \a end. The return value of each \a mapFunction is passed to
+  \a reduceFunction, as with blockingMappedReduced(). Pass
+  QtConcurrent::ParallelReduce in \a reduceOptions to reduce in all threads
+  at once.
+
+  \note This function will block until all indexes have been processed.
+
+  \sa blockingMappedReduced(), blockingFor()
+*/
+
+/*!
+  \fn void QtConcurrent::blockingSort(RandomAccessIterator begin, RandomAccessIterator end, LessThan lessThan)
+  \since 5.6
+
+  Sorts the items from \a begin to \a end using \a lessThan to compare them.
+  Parts of the range are sorted in parallel and then merged pairwise. Like
+  std::sort(), the sort is not stable. Small ranges are sorted in the
+  calling thread.
+
+  \note This function will block until the range is sorted.
+*/
+
+/*!
+  \fn void QtConcurrent::blockingSort(RandomAccessIterator begin, RandomAccessIterator end)
+  \since 5.6
+  \overload
+
+  Sorts the items from \a begin to \a end using \c{operator<()}.
+*/
+
+/*!
+  \fn void QtConcurrent::blockingSort(Sequence &sequence, LessThan lessThan)
+  \since 5.6
+  \overload
+
+  Sorts \a sequence using \a lessThan to compare the items.
+*/
+
+/*!
+  \fn void QtConcurrent::blockingSort(Sequence &sequence)
+  \since 5.6
+  \overload
+
+  Sorts \a sequence using \c{operator<()}.
+*/
+
+/*!
+  \fn void QtConcurrent::blockingInclusiveScan(RandomAccessIterator begin, RandomAccessIterator end, BinaryFunction function)
+  \since 5.6
+
+  Replaces every item from \a begin to \a end with the result of combining
+  it and all the items before it using \a function, like
+  std::partial_sum(). \a function must be associative and is called from
+  several threads at the same time.
+
+  \note This function will block until the range is scanned.
+
+  \sa blockingExclusiveScan()
+*/
+
+/*!
+  \fn void QtConcurrent::blockingInclusiveScan(Sequence &sequence, BinaryFunction function)
+  \since 5.6
+  \overload
+
+  Scans \a sequence in place using \a function.
+*/
+
+/*!
+  \fn void QtConcurrent::blockingExclusiveScan(RandomAccessIterator begin, RandomAccessIterator end, const T &initialValue, BinaryFunction function)
+  \since 5.6
+
+  Replaces every item from \a begin to \a end with the result of combining
+  \a initialValue and all the items before it using \a function. The first
+  item becomes \a initialValue. \a function must be associative and is
+  called from several threads at the same time.
+
+  \note This function will block until the range is scanned.
+
+  \sa blockingInclusiveScan()
+*/
+
+/*!
+  \fn void QtConcurrent::blockingExclusiveScan(Sequence &sequence, const T &initialValue, BinaryFunction function)
+  \since 5.6
+  \overload
+
+  Scans \a sequence in place, starting with \a initialValue, using \a function.
+*/
@@ -0,0 +1,389 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QTCONCURRENT_ALGORITHMS_H
+#define QTCONCURRENT_ALGORITHMS_H
+
+#include <QtConcurrent/qtconcurrent_global.h>
+
+#ifndef QT_NO_CONCURRENT
+
+#include <QtConcurrent/qtconcurrentmap.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qvector.h>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <numeric>
+
+QT_BEGIN_NAMESPACE
+
+
+#ifdef Q_QDOC
+
+namespace QtConcurrent {
+
+    void blockingFor(int begin, int end, Function function);
+
+    template <typename T>
+    T blockingTransformReduce(int begin,
+                              int end,
+                              MapFunction function,
+                              ReduceFunction function,
+                              QtConcurrent::ReduceOptions options = UnorderedReduce | SequentialReduce);
+
+    void blockingSort(Sequence &sequence);
+    void blockingSort(Sequence &sequence, LessThan lessThan);
+    void blockingSort(RandomAccessIterator begin, RandomAccessIterator end);
+    void blockingSort(RandomAccessIterator begin, RandomAccessIterator end, LessThan lessThan);
+
+    void blockingInclusiveScan(Sequence &sequence, BinaryFunction function);
+    void blockingInclusiveScan(RandomAccessIterator begin, RandomAccessIterator end, BinaryFunction function);
+    void blockingExclusiveScan(Sequence &sequence, const T &initialValue, BinaryFunction function);
+    void blockingExclusiveScan(RandomAccessIterator begin, RandomAccessIterator end, const T &initialValue, BinaryFunction function);
+
+} // namespace QtConcurrent
+
+#else
+
+namespace QtConcurrent {
+
+// A random access iterator over a range of integers, which lets the
+// iterate kernels run over an index range without a container.
+class IndexIterator
+{
+public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef int value_type;
+    typedef int difference_type;
+    typedef const int *pointer;
+    typedef int reference;
+
+    inline IndexIterator() : i(0) { }
+    inline explicit IndexIterator(int index) : i(index) { }
+
+    inline int operator*() const { return i; }
+    inline int operator[](int j) const { return i + j; }
+
+    inline IndexIterator &operator++() { ++i; return *this; }
+    inline IndexIterator operator++(int) { IndexIterator r = *this; ++i; return r; }
+    inline IndexIterator &operator--() { --i; return *this; }
+    inline IndexIterator operator--(int) { IndexIterator r = *this; --i; return r; }
+    inline IndexIterator &operator+=(int j) { i += j; return *this; }
+    inline IndexIterator &operator-=(int j) { i -= j; return *this; }
+    inline IndexIterator operator+(int j) const { return IndexIterator(i + j); }
+    inline IndexIterator operator-(int j) const { return IndexIterator(i - j); }
+    inline int operator-(IndexIterator other) const { return i - other.i; }
+
+    inline bool operator==(IndexIterator other) const { return i == other.i; }
+    inline bool operator!=(IndexIterator other) const { return i != other.i; }
+    inline bool operator<(IndexIterator other) const { return i < other.i; }
+    inline bool operator<=(IndexIterator other) const { return i <= other.i; }
+    inline bool operator>(IndexIterator other) const { return i > other.i; }
+    inline bool operator>=(IndexIterator other) const { return i >= other.i; }
+
+private:
+    int i;
+};
+
+/*
+    The sort and scan algorithms split their range into chunks of at least
+    MinimumChunkSize items, at most ChunksPerThread per pool thread, and
+    process the chunks with blockingFor().
+*/
+enum {
+    MinimumChunkSize = 2048,
+    ChunksPerThread = 4
+};
+
+inline int chunkCount(qint64 size)
+{
+    const qint64 maxChunks = qint64(QThreadPool::globalInstance()->maxThreadCount()) * ChunksPerThread;
+    return int(qBound(qint64(1), size / MinimumChunkSize, qMax(qint64(1), maxChunks)));
+}
+
+// start of the chunk at index in a range of size items split into count chunks
+inline qint64 chunkBegin(qint64 size, int count, int index)
+{
+    return size * index / count;
+}
+
+template <typename RandomAccessIterator, typename LessThan>
+struct SortChunk
+{
+    RandomAccessIterator begin;
+    qint64 size;
+    int count;
+    LessThan lessThan;
+
+    void operator()(int chunk)
+    {
+        std::sort(begin + chunkBegin(size, count, chunk),
+                  begin + chunkBegin(size, count, chunk + 1),
+                  lessThan);
+    }
+};
+
+template <typename RandomAccessIterator, typename LessThan>
+struct MergeChunks
+{
+    RandomAccessIterator begin;
+    qint64 size;
+    int count;
+    int width;  // number of sorted chunks in each half
+    LessThan lessThan;
+
+    void operator()(int pair)
+    {
+        const int first = pair * 2 * width;
+        const int middle = qMin(first + width, count);
+        const int last = qMin(first + 2 * width, count);
+        std::inplace_merge(begin + chunkBegin(size, count, first),
+                           begin + chunkBegin(size, count, middle),
+                           begin + chunkBegin(size, count, last),
+                           lessThan);
+    }
+};
+
+template <typename RandomAccessIterator, typename BinaryFunctor>
+struct ScanChunk
+{
+    RandomAccessIterator begin;
+    qint64 size;
+    int count;
+    BinaryFunctor function;
+
+    void operator()(int chunk)
+    {
+        RandomAccessIterator first = begin + chunkBegin(size, count, chunk);
+        RandomAccessIterator last = begin + chunkBegin(size, count, chunk + 1);
+        std::partial_sum(first, last, first, function);
+    }
+};
+
+// combines every item of a chunk with the total of the chunks before it
+template <typename RandomAccessIterator, typename BinaryFunctor, typename T>
+struct AddChunkOffset
+{
+    RandomAccessIterator begin;
+    qint64 size;
+    int count;
+    BinaryFunctor function;
+    const T *offsets;
+
+    void operator()(int chunk)
+    {
+        RandomAccessIterator first = begin + chunkBegin(size, count, chunk);
+        RandomAccessIterator last = begin + chunkBegin(size, count, chunk + 1);
+        const T &offset = offsets[chunk];
+        for (RandomAccessIterator it = first; it != last; ++it)
+            *it = function(offset, *it);
+    }
+};
+
+// turns an inclusively scanned chunk into the exclusive scan, moving each
+// item one place up
+template <typename RandomAccessIterator, typename BinaryFunctor, typename T>
+struct ShiftChunk
+{
+    RandomAccessIterator begin;
+    qint64 size;
+    int count;
+    BinaryFunctor function;
+    const T *offsets;
+
+    void operator()(int chunk)
+    {
+        RandomAccessIterator first = begin + chunkBegin(size, count, chunk);
+        RandomAccessIterator last = begin + chunkBegin(size, count, chunk + 1);
+        const T &offset = offsets[chunk];
+        for (RandomAccessIterator it = last - 1; it != first; --it)
+            *it = function(offset, *(it - 1));
+        *first = offset;
+    }
+};
+
+// blockingFor() on index ranges
+template <typename Functor>
+void blockingFor(int begin, int end, Functor function)
+{
+    if (begin >= end)
+        return;
+    startMap(IndexIterator(begin), IndexIterator(end), QtPrivate::createFunctionWrapper(function))
+        .startBlocking();
+}
+
+// blockingTransformReduce() on index ranges
+template <typename ResultType, typename MapFunctor, typename ReduceFunctor>
+ResultType blockingTransformReduce(int begin,
+                                   int end,
+                                   MapFunctor map,
+                                   ReduceFunctor reduce,
+                                   ReduceOptions options = ReduceOptions(UnorderedReduce | SequentialReduce))
+{
+    return blockingMappedReduced<ResultType>(IndexIterator(begin), IndexIterator(qMax(begin, end)),
+                                             map, reduce, options);
+}
+
+template <typename MapFunctor, typename ReduceFunctor>
+typename QtPrivate::ReduceResultType<ReduceFunctor>::ResultType
+blockingTransformReduce(int begin,
+                        int end,
+                        MapFunctor map,
+                        ReduceFunctor reduce,
+                        ReduceOptions options = ReduceOptions(UnorderedReduce | SequentialReduce))
+{
+    return blockingMappedReduced(IndexIterator(begin), IndexIterator(qMax(begin, end)),
+                                 map, reduce, options);
+}
+
+// blockingSort() sorts the chunks in parallel, then merges them pairwise
+// in rounds. Like std::sort(), it is not stable.
+template <typename RandomAccessIterator, typename LessThan>
+void blockingSort(RandomAccessIterator begin, RandomAccessIterator end, LessThan lessThan)
+{
+    const qint64 size = end - begin;
+    const int count = chunkCount(size);
+    if (count == 1) {
+        std::sort(begin, end, lessThan);
+        return;
+    }
+
+    SortChunk<RandomAccessIterator, LessThan> sortChunk = { begin, size, count, lessThan };
+    blockingFor(0, count, sortChunk);
+
+    for (int width = 1; width < count; width *= 2) {
+        MergeChunks<RandomAccessIterator, LessThan> mergeChunks = { begin, size, count, width, lessThan };
+        blockingFor(0, (count + 2 * width - 1) / (2 * width), mergeChunks);
+    }
+}
+
+template <typename RandomAccessIterator>
+void blockingSort(RandomAccessIterator begin, RandomAccessIterator end)
+{
+    blockingSort(begin, end, std::less<typename std::iterator_traits<RandomAccessIterator>::value_type>());
+}
+
+template <typename Sequence, typename LessThan>
+void blockingSort(Sequence &sequence, LessThan lessThan)
+{
+    blockingSort(sequence.begin(), sequence.end(), lessThan);
+}
+
+template <typename Sequence>
+void blockingSort(Sequence &sequence)
+{
+    blockingSort(sequence.begin(), sequence.end());
+}
+
+// blockingInclusiveScan() scans the chunks in parallel, combines the chunk
+// totals sequentially and then adds them to the chunks in parallel.
+template <typename RandomAccessIterator, typename BinaryFunctor>
+void blockingInclusiveScan(RandomAccessIterator begin, RandomAccessIterator end, BinaryFunctor function)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type T;
+
+    const qint64 size = end - begin;
+    const int count = chunkCount(size);
+    if (count == 1) {
+        std::partial_sum(begin, end, begin, function);
+        return;
+    }
+
+    ScanChunk<RandomAccessIterator, BinaryFunctor> scanChunk = { begin, size, count, function };
+    blockingFor(0, count, scanChunk);
+
+    // offsets[i] is the total of the chunks before chunk i; chunk 0 has none
+    QVector<T> offsets(count);
+    offsets[1] = *(begin + (chunkBegin(size, count, 1) - 1));
+    for (int i = 2; i < count; ++i)
+        offsets[i] = function(offsets.at(i - 1), *(begin + (chunkBegin(size, count, i) - 1)));
+
+    AddChunkOffset<RandomAccessIterator, BinaryFunctor, T> addOffset = { begin, size, count, function, offsets.constData() };
+    blockingFor(1, count, addOffset);
+}
+
+template <typename Sequence, typename BinaryFunctor>
+void blockingInclusiveScan(Sequence &sequence, BinaryFunctor function)
+{
+    blockingInclusiveScan(sequence.begin(), sequence.end(), function);
+}
+
+// blockingExclusiveScan() works like blockingInclusiveScan(), but shifts
+// every chunk by one item while it adds the offsets.
+template <typename RandomAccessIterator, typename T, typename BinaryFunctor>
+void blockingExclusiveScan(RandomAccessIterator begin, RandomAccessIterator end, const T &initialValue, BinaryFunctor function)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type ValueType;
+
+    const qint64 size = end - begin;
+    if (size == 0)
+        return;
+    const int count = chunkCount(size);
+
+    ScanChunk<RandomAccessIterator, BinaryFunctor> scanChunk = { begin, size, count, function };
+    if (count == 1)
+        scanChunk(0);
+    else
+        blockingFor(0, count, scanChunk);
+
+    // offsets[i] combines the initial value with the chunks before chunk i
+    QVector<ValueType> offsets(count);
+    offsets[0] = initialValue;
+    for (int i = 1; i < count; ++i)
+        offsets[i] = function(offsets.at(i - 1), *(begin + (chunkBegin(size, count, i) - 1)));
+
+    ShiftChunk<RandomAccessIterator, BinaryFunctor, ValueType> shiftChunk = { begin, size, count, function, offsets.constData() };
+    if (count == 1)
+        shiftChunk(0);
+    else
+        blockingFor(0, count, shiftChunk);
+}
+
+template <typename Sequence, typename T, typename BinaryFunctor>
+void blockingExclusiveScan(Sequence &sequence, const T &initialValue, BinaryFunctor function)
+{
+    blockingExclusiveScan(sequence.begin(), sequence.end(), initialValue, function);
+}
+
+} // namespace QtConcurrent
+
+#endif // Q_QDOC
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_CONCURRENT
+
+#endif
@@ -55,8 +55,15 @@
     \value OrderedReduce Reduction is done in the order of the
     original sequence.
     \value SequentialReduce Reduction is done sequentially: only one
-    thread will enter the reduce function at a time. (Parallel reduction
-    might be supported in a future version of Qt Concurrent.)
+    thread will enter the reduce function at a time.
+    \value ParallelReduce Each thread reduces its own results into a
+    separate, default-constructed partial result, and the partial results
+    are passed to the reduce function at the end. The reduce function is
+    called from several threads at the same time and must be associative
+    and commutative. This option is only available when the reduce function
+    takes the result type as its intermediate type (for example when
+    summing numbers); otherwise UnorderedReduce | SequentialReduce is used.
+    This value was introduced in Qt 5.6.
 */
 
 /*!
@@ -81,19 +81,54 @@ public:
 enum ReduceOption {
     UnorderedReduce = 0x1,
     OrderedReduce = 0x2,
-    SequentialReduce = 0x4
-    // ParallelReduce = 0x8
+    SequentialReduce = 0x4,
+    ParallelReduce = 0x8
 };
 Q_DECLARE_FLAGS(ReduceOptions, ReduceOption)
 Q_DECLARE_OPERATORS_FOR_FLAGS(ReduceOptions)
 
 #ifndef Q_QDOC
 
-// supports both ordered and out-of-order reduction
+// A partial result of ParallelReduce, owned by the thread that reduces into it.
+template <typename ReduceResultType>
+struct PartialReduceResult
+{
+    PartialReduceResult *next;
+    Qt::HANDLE threadId;
+    ReduceResultType result;
+};
+
+// ParallelReduce combines the partial results with the reduce functor,
+// which is only possible when the intermediate type is the result type.
+template <typename ReduceResultType, typename T>
+struct PartialReduceMerger
+{
+    enum { CanMerge = false };
+
+    template <typename ReduceFunctor>
+    static void merge(ReduceFunctor &, ReduceResultType &, const ReduceResultType &)
+    { }
+};
+
+template <typename T>
+struct PartialReduceMerger<T, T>
+{
+    enum { CanMerge = true };
+
+    template <typename ReduceFunctor>
+    static void merge(ReduceFunctor &reduce, T &r, const T &partial)
+    {
+        reduce(r, partial);
+    }
+};
+
+// supports ordered, out-of-order and parallel reduction
 template <typename ReduceFunctor, typename ReduceResultType, typename T>
 class ReduceKernel
 {
     typedef QMap<int, IntermediateResults<T> > ResultsMap;
+    typedef PartialReduceResult<ReduceResultType> PartialResult;
+    typedef PartialReduceMerger<ReduceResultType, T> Merger;
 
     const ReduceOptions reduceOptions;
 
@@ -101,6 +136,38 @@ class ReduceKernel
     int progress, resultsMapSize, threadCount;
     ResultsMap resultsMap;
 
+    // one partial result per thread taking part in a ParallelReduce
+    QAtomicPointer<PartialResult> partialResults;
+
+    static ReduceOptions adjustedOptions(ReduceOptions options)
+    {
+        if (!(options & ParallelReduce))
+            return options;
+        if (!Merger::CanMerge)
+            return UnorderedReduce | SequentialReduce;
+        return ParallelReduce;
+    }
+
+    // returns the calling thread's partial result, creating it on first use
+    ReduceResultType &partialResult()
+    {
+        const Qt::HANDLE self = QThread::currentThreadId();
+        PartialResult *head = partialResults.loadAcquire();
+        for (PartialResult *p = head; p; p = p->next) {
+            if (p->threadId == self)
+                return p->result;
+        }
+
+        // only this thread adds its own entry, so it cannot have appeared meanwhile
+        PartialResult *p = new PartialResult;
+        p->threadId = self;
+        p->result = ReduceResultType();
+        do {
+            p->next = head;
+        } while (!partialResults.testAndSetOrdered(head, p, head));
+        return p->result;
+    }
+
     bool canReduce(int begin) const
     {
         return (((reduceOptions & UnorderedReduce)
@@ -131,14 +198,31 @@ class ReduceKernel
 
 public:
     ReduceKernel(ReduceOptions _reduceOptions)
-        : reduceOptions(_reduceOptions), progress(0), resultsMapSize(0),
-          threadCount(QThreadPool::globalInstance()->maxThreadCount())
+        : reduceOptions(adjustedOptions(_reduceOptions)), progress(0), resultsMapSize(0),
+          threadCount(QThreadPool::globalInstance()->maxThreadCount()),
+          partialResults(0)
     { }
 
+    ~ReduceKernel()
+    {
+        PartialResult *p = partialResults.loadAcquire();
+        while (p) {
+            PartialResult *next = p->next;
+            delete p;
+            p = next;
+        }
+    }
+
     void runReduce(ReduceFunctor &reduce,
                    ReduceResultType &r,
                    const IntermediateResults<T> &result)
     {
+        if (reduceOptions & ParallelReduce) {
+            // no lock, each thread reduces into its own partial result
+            reduceResult(reduce, partialResult(), result);
+            return;
+        }
+
         QMutexLocker locker(&mutex);
         if (!canReduce(result.begin)) {
             ++resultsMapSize;
@@ -198,6 +282,10 @@ public:
     void finish(ReduceFunctor &reduce, ReduceResultType &r)
     {
         reduceResults(reduce, r, resultsMap);
+
+        // all threads are done, merge their partial results
+        for (PartialResult *p = partialResults.loadAcquire(); p; p = p->next)
+            Merger::merge(reduce, r, p->result);
     }
 
     inline bool shouldThrottle()
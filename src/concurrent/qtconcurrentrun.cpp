@@ -122,6 +122,23 @@
     Calling a bound function is done like this:
 
     \snippet code/src_concurrent_qtconcurrentrun.cpp 6
+
+    \section2 Running a Function with a Priority
+
+    When passing a QThreadPool, a priority can be given as well. It is
+    forwarded to QThreadPool::start(), so functions with a higher priority
+    are run first when the pool is busy:
+
+    \snippet code/src_concurrent_qtconcurrentrun.cpp 7
+
+    \section2 Canceling a Running Function
+
+    Calling QFuture::cancel() on the future returned by QtConcurrent::run()
+    prevents the function from running if it has not started yet. A function
+    that is already running can check for cancellation itself with a
+    QtConcurrent::CancellationToken:
+
+    \snippet code/src_concurrent_qtconcurrentrun.cpp 8
 */
 
 /*!
@@ -140,9 +157,9 @@
     values can be accessed via the QFuture::result() function.
 
     Note that the QFuture returned by QtConcurrent::run() does not support
-    canceling, pausing, or progress reporting. The QFuture returned can only
-    be used to query for the running/finished status and the return value of
-    the function.
+    pausing or progress reporting. Canceling it only has an effect if the
+    function has not started yet, or if the function checks its
+    CancellationToken.
 
     \sa {Concurrent Run}
 */
@@ -159,9 +176,117 @@
     values can be accessed via the QFuture::result() function.
 
     Note that the QFuture returned by QtConcurrent::run() does not support
-    canceling, pausing, or progress reporting. The QFuture returned can only
-    be used to query for the running/finished status and the return value of
-    the function.
+    pausing or progress reporting. Canceling it only has an effect if the
+    function has not started yet, or if the function checks its
+    CancellationToken.
+
+    \sa {Concurrent Run}
+*/
+
+/*!
+    \since 5.6
+    \fn QFuture<T> QtConcurrent::run(QThreadPool *pool, int priority, Function function, ...);
+
+    Runs \a function in a separate thread taken from the QThreadPool \a pool.
+    The \a priority is passed to QThreadPool::start(), and decides the order
+    in which functions waiting for a thread in \a pool are run.
+
+    This overload only accepts function pointers and function objects, and
+    is only available if the compiler supports \c decltype and trailing
+    return types. Function objects that declare a \c result_type typedef,
+    such as \c std::function, are not accepted; wrap them in a lambda
+    instead.
 
     \sa {Concurrent Run}
 */
+
+/*!
+    \class QtConcurrent::CancellationToken
+    \inmodule QtConcurrent
+    \since 5.6
+
+    \brief The CancellationToken class lets a function started with
+    QtConcurrent::run() find out whether its future was canceled.
+
+    Calling QFuture::cancel() does not interrupt a function that is already
+    running. A long running function can instead fetch the token of its
+    task with current(), and stop early once isCanceled() returns \c true.
+    Tokens can be copied and passed on to the code doing the actual work.
+
+    \snippet code/src_concurrent_qtconcurrentrun.cpp 8
+
+    \sa QFuture::cancel()
+*/
+
+#include "qtconcurrentrunbase.h"
+
+#ifndef QT_NO_CONCURRENT
+
+#include <QtCore/qthreadstorage.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace QtConcurrent {
+
+namespace {
+struct CurrentTask
+{
+    CurrentTask() : task(0) { }
+    QFutureInterfaceBase *task;
+};
+}
+
+Q_GLOBAL_STATIC(QThreadStorage<CurrentTask>, currentTask)
+
+/*!
+    Constructs a token that is never canceled.
+*/
+CancellationToken::CancellationToken()
+{
+}
+
+/*!
+    \internal
+*/
+CancellationToken::CancellationToken(const QFutureInterfaceBase &future)
+    : future(future)
+{
+}
+
+/*!
+    Returns \c true if the future of the task this token belongs to has been
+    canceled; otherwise returns \c false.
+*/
+bool CancellationToken::isCanceled() const
+{
+    return future.isCanceled();
+}
+
+/*!
+    Returns the token of the function that QtConcurrent::run() is running in
+    the calling thread. If the calling thread is not running such a
+    function, the returned token is never canceled.
+*/
+CancellationToken CancellationToken::current()
+{
+    QFutureInterfaceBase *task = currentTask()->localData().task;
+    return task ? CancellationToken(*task) : CancellationToken();
+}
+
+CurrentTaskScope::CurrentTaskScope(QFutureInterfaceBase *task)
+{
+    CurrentTask &current = currentTask()->localData();
+    previous = current.task;
+    current.task = task;
+}
+
+CurrentTaskScope::~CurrentTaskScope()
+{
+    currentTask()->localData().task = previous;
+}
+
+} // namespace QtConcurrent
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_CONCURRENT
@@ -45,10 +45,42 @@
 QT_BEGIN_NAMESPACE
 
 
+namespace QtConcurrent {
+
+class Q_CONCURRENT_EXPORT CancellationToken
+{
+public:
+    CancellationToken();
+
+    bool isCanceled() const;
+
+    static CancellationToken current();
+
+private:
+    explicit CancellationToken(const QFutureInterfaceBase &future);
+
+    QFutureInterfaceBase future;
+};
+
+} // namespace QtConcurrent
+
 #ifndef Q_QDOC
 
 namespace QtConcurrent {
 
+// Makes the task being run by the current thread available to
+// CancellationToken::current().
+class Q_CONCURRENT_EXPORT CurrentTaskScope
+{
+public:
+    explicit CurrentTaskScope(QFutureInterfaceBase *task);
+    ~CurrentTaskScope();
+
+private:
+    Q_DISABLE_COPY(CurrentTaskScope)
+    QFutureInterfaceBase *previous;
+};
+
 template <typename T>
 struct SelectSpecialization
 {
@@ -72,30 +104,23 @@ public:
         return start(QThreadPool::globalInstance());
     }
 
-    QFuture<T> start(QThreadPool *pool)
+    QFuture<T> start(QThreadPool *pool, int priority = 0)
     {
         this->setThreadPool(pool);
         this->setRunnable(this);
         this->reportStarted();
         QFuture<T> theFuture = this->future();
-        pool->start(this, /*m_priority*/ 0);
+        pool->start(this, priority);
         return theFuture;
     }
 
     void run() {}
     virtual void runFunctor() = 0;
-};
 
-template <typename T>
-class RunFunctionTask : public RunFunctionTaskBase<T>
-{
-public:
-    void run()
+protected:
+    void runFunctorInScope()
     {
-        if (this->isCanceled()) {
-            this->reportFinished();
-            return;
-        }
+        CurrentTaskScope scope(this);
 #ifndef QT_NO_EXCEPTIONS
         try {
 #endif
@@ -107,6 +132,20 @@ public:
             QFutureInterface<T>::reportException(QUnhandledException());
         }
 #endif
+    }
+};
+
+template <typename T>
+class RunFunctionTask : public RunFunctionTaskBase<T>
+{
+public:
+    void run()
+    {
+        if (this->isCanceled()) {
+            this->reportFinished();
+            return;
+        }
+        this->runFunctorInScope();
 
         this->reportResult(result);
         this->reportFinished();
@@ -124,17 +163,7 @@ public:
             this->reportFinished();
             return;
         }
-#ifndef QT_NO_EXCEPTIONS
-        try {
-#endif
-            this->runFunctor();
-#ifndef QT_NO_EXCEPTIONS
-        } catch (QException &e) {
-            QFutureInterface<void>::reportException(e);
-        } catch (...) {
-            QFutureInterface<void>::reportException(QUnhandledException());
-        }
-#endif
+        this->runFunctorInScope();
         this->reportFinished();
     }
 };
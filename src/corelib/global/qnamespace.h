@@ -1240,6 +1240,7 @@ public:
         DirectConnection,
         QueuedConnection,
         BlockingQueuedConnection,
+        BatchedConnection,
         UniqueConnection =  0x80
     };
 
@@ -39,7 +39,9 @@
 #include "qfile.h"
 #include "qstringlist.h"
 #include "qdir.h"
+#include "qstringrope.h"
 #include "private/qbytearray_p.h"
+#include "private/qutfcodec_p.h"
 
 #include <algorithm>
 
@@ -1380,6 +1382,61 @@ qint64 QIODevice::write(const char *data)
     \sa read(), writeData()
 */
 
+/*!
+    \since 5.6
+    \overload
+
+    Writes the text of \a rope to the device, encoded as UTF-8. Returns the
+    number of bytes that were actually written, or -1 if an error occurred.
+
+    The chunks of the rope are encoded and written one after the other,
+    so the text is never flattened into a single string.
+
+    \sa QStringRope::toUtf8()
+*/
+qint64 QIODevice::write(const QStringRope &rope)
+{
+    // the chunks are encoded into a buffer of this size, which is written
+    // out once there is little room left
+    const int bufferSize = 64 * 1024;
+    const int minimumRoom = 64;
+
+    QByteArray buffer(bufferSize, Qt::Uninitialized);
+    char *const begin = buffer.data();
+    char *const end = begin + bufferSize;
+    char *out = begin;
+    QTextCodec::ConverterState state;
+    qint64 written = 0;
+    for (int i = 0; i < rope.chunkCount(); ++i) {
+        const QStringRef chunk = rope.chunk(i);
+        const QChar *uc = chunk.unicode();
+        int len = chunk.size();
+        while (len > 0) {
+            // leave room for three bytes per character, plus one
+            const int n = qMin(len, int(end - out - 1) / 3);
+            out = QUtf8::convertFromUnicode(out, uc, n, &state);
+            uc += n;
+            len -= n;
+            if (end - out < minimumRoom) {
+                const qint64 result = write(begin, out - begin);
+                if (result != out - begin)
+                    return result < 0 && !written ? result : written + qMax(result, qint64(0));
+                written += result;
+                out = begin;
+            }
+        }
+    }
+    if (state.remainingChars)
+        *out++ = '?';   // like QString::toUtf8()
+    if (out != begin) {
+        const qint64 result = write(begin, out - begin);
+        if (result < 0 && !written)
+            return result;
+        written += qMax(result, qint64(0));
+    }
+    return written;
+}
+
 /*!
     Puts the character \a c back into the device, and decrements the
     current position unless the position is 0. This function is
@@ -52,6 +52,7 @@ QT_BEGIN_NAMESPACE
 
 class QByteArray;
 class QIODevicePrivate;
+class QStringRope;
 
 class Q_CORE_EXPORT QIODevice
 #ifndef QT_NO_QOBJECT
@@ -115,6 +116,7 @@ public:
     qint64 write(const char *data);
     inline qint64 write(const QByteArray &data)
     { return write(data.constData(), data.size()); }
+    qint64 write(const QStringRope &rope);
 
     qint64 peek(char *data, qint64 maxlen);
     QByteArray peek(qint64 maxlen);
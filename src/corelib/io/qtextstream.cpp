@@ -222,6 +222,7 @@ static const int QTEXTSTREAM_BUFFERSIZE = 16384;
 #include "qbuffer.h"
 #include "qfile.h"
 #include "qnumeric.h"
+#include "qstringrope.h"
 #ifndef Q_OS_WINCE
 #include <locale.h>
 #endif
@@ -2514,6 +2515,31 @@ QTextStream &QTextStream::operator<<(QLatin1String string)
     return *this;
 }
 
+/*!
+    \since 5.6
+    \overload
+
+    Writes the text of \a rope to the stream, and returns a reference to
+    the QTextStream. Unless the text needs padding to the field width, the
+    chunks of the rope are written one after the other, without flattening
+    them into a single string first.
+*/
+QTextStream &QTextStream::operator<<(const QStringRope &rope)
+{
+    Q_D(QTextStream);
+    CHECK_VALID_STREAM(*this);
+    if (d->params.fieldWidth > rope.size()) {
+        d->putString(rope.toString());
+        return *this;
+    }
+    const int chunkCount = rope.chunkCount();
+    for (int i = 0; i < chunkCount; ++i) {
+        const QStringRef chunk = rope.chunk(i);
+        d->write(chunk.unicode(), chunk.size());
+    }
+    return *this;
+}
+
 /*!
     \overload
 
@@ -51,6 +51,7 @@ QT_BEGIN_NAMESPACE
 
 class QTextCodec;
 class QTextDecoder;
+class QStringRope;
 
 class QTextStreamPrivate;
 class Q_CORE_EXPORT QTextStream                                // text stream class
@@ -179,6 +180,7 @@ public:
     QTextStream &operator<<(double f);
     QTextStream &operator<<(const QString &s);
     QTextStream &operator<<(QLatin1String s);
+    QTextStream &operator<<(const QStringRope &s);
     QTextStream &operator<<(const QByteArray &array);
     QTextStream &operator<<(const char *c);
     QTextStream &operator<<(const void *ptr);
@@ -39,6 +39,7 @@
 #include "qjsonparser_p.h"
 #include "qjson_p.h"
 #include "private/qutfcodec_p.h"
+#include "private/qsimd_p.h"
 
 //#define PARSER_DEBUG
 #ifdef PARSER_DEBUG
@@ -191,6 +192,9 @@ QString QJsonParseError::errorString() const
 
 using namespace QJsonPrivate;
 
+// defined in qstring.cpp
+void qt_from_latin1(ushort *dst, const char *str, size_t size);
+
 Parser::Parser(const char *json, int length)
     : head(json), json(json), data(0), dataLength(0), current(0), nestingLevel(0), lastError(QJsonParseError::NoError)
 {
@@ -250,18 +254,134 @@ void Parser::eatBOM()
         json += 3;
 }
 
+static inline bool isWhitespace(char c)
+{
+    return c == Space || c == Tab || c == LineFeed || c == Return;
+}
+
+// characters that can be copied from a string to the binary format as they
+// are: ASCII that is neither a quote, a backslash nor a control character
+static inline bool isPlainChar(char c)
+{
+    return uchar(c) >= Space && uchar(c) < 0x80 && c != Quote && c != '\\';
+}
+
+/*
+    The scanners below look at 16 bytes at a time with SSE2, or 32 with AVX2
+    if the processor has it, and stop at the first byte that does not
+    belong to the run. The input that is left over at the end is scanned
+    one byte at a time.
+*/
+#if defined(__SSE2__)
+static inline uint whitespaceMask(__m128i chunk)
+{
+    const __m128i space = _mm_cmpeq_epi8(chunk, _mm_set1_epi8(Space));
+    const __m128i tab = _mm_cmpeq_epi8(chunk, _mm_set1_epi8(Tab));
+    const __m128i lineFeed = _mm_cmpeq_epi8(chunk, _mm_set1_epi8(LineFeed));
+    const __m128i carriageReturn = _mm_cmpeq_epi8(chunk, _mm_set1_epi8(Return));
+    return _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(space, tab), _mm_or_si128(lineFeed, carriageReturn)));
+}
+
+static inline uint nonPlainMask(__m128i chunk)
+{
+    const __m128i quote = _mm_cmpeq_epi8(chunk, _mm_set1_epi8(Quote));
+    const __m128i backslash = _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\\'));
+    // signed comparison: finds control characters and non-ASCII bytes alike
+    const __m128i control = _mm_cmplt_epi8(chunk, _mm_set1_epi8(Space));
+    return _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(quote, backslash), control));
+}
+#endif
+
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+QT_FUNCTION_TARGET(AVX2)
+static const char *skipWhitespace_avx2(const char *json, const char *end)
+{
+    const __m256i space = _mm256_set1_epi8(Space);
+    const __m256i tab = _mm256_set1_epi8(Tab);
+    const __m256i lineFeed = _mm256_set1_epi8(LineFeed);
+    const __m256i carriageReturn = _mm256_set1_epi8(Return);
+    for ( ; end - json >= 32; json += 32) {
+        const __m256i chunk = _mm256_loadu_si256((const __m256i *)json);
+        const __m256i match = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, space),
+                                                              _mm256_cmpeq_epi8(chunk, tab)),
+                                              _mm256_or_si256(_mm256_cmpeq_epi8(chunk, lineFeed),
+                                                              _mm256_cmpeq_epi8(chunk, carriageReturn)));
+        const uint mask = ~uint(_mm256_movemask_epi8(match));
+        if (mask)
+            return json + _bit_scan_forward(mask);
+    }
+    return json;
+}
+
+QT_FUNCTION_TARGET(AVX2)
+static const char *scanPlainChars_avx2(const char *json, const char *end)
+{
+    const __m256i quote = _mm256_set1_epi8(Quote);
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i space = _mm256_set1_epi8(Space);
+    for ( ; end - json >= 32; json += 32) {
+        const __m256i chunk = _mm256_loadu_si256((const __m256i *)json);
+        // signed comparison: finds control characters and non-ASCII bytes alike
+        const __m256i match = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote),
+                                                              _mm256_cmpeq_epi8(chunk, backslash)),
+                                              _mm256_cmpgt_epi8(space, chunk));
+        const uint mask = uint(_mm256_movemask_epi8(match));
+        if (mask)
+            return json + _bit_scan_forward(mask);
+    }
+    return json;
+}
+#endif
+
+// returns the first character at or after json that is not whitespace
+static inline const char *skipWhitespace(const char *json, const char *end)
+{
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (end - json >= 32 && qCpuHasFeature(AVX2))
+        json = skipWhitespace_avx2(json, end);
+#endif
+#if defined(__SSE2__)
+    for ( ; end - json >= 16; json += 16) {
+        const uint mask = ~whitespaceMask(_mm_loadu_si128((const __m128i *)json)) & 0xffff;
+        if (mask)
+            return json + _bit_scan_forward(mask);
+    }
+#endif
+    while (json < end && isWhitespace(*json))
+        ++json;
+    return json;
+}
+
+// returns the first character at or after json that is not a plain character
+static inline const char *scanPlainChars(const char *json, const char *end)
+{
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (end - json >= 32 && qCpuHasFeature(AVX2))
+        json = scanPlainChars_avx2(json, end);
+#endif
+#if defined(__SSE2__)
+    for ( ; end - json >= 16; json += 16) {
+        const uint mask = nonPlainMask(_mm_loadu_si128((const __m128i *)json));
+        if (mask)
+            return json + _bit_scan_forward(mask);
+    }
+#endif
+    while (json < end && isPlainChar(*json))
+        ++json;
+    return json;
+}
+
 bool Parser::eatSpace()
 {
-    while (json < end) {
-        if (*json > Space)
-            break;
-        if (*json != Space &&
-            *json != Tab &&
-            *json != LineFeed &&
-            *json != Return)
-            break;
+    // most tokens are followed by at most one whitespace character, don't
+    // start scanning blocks for those
+    if (json < end && !isWhitespace(*json))
+        return true;
+    if (json + 1 < end && !isWhitespace(json[1])) {
         ++json;
+        return true;
     }
+    json = skipWhitespace(json, end);
     return (json < end);
 }
 
@@ -851,7 +971,20 @@ bool Parser::parseString(bool *latin1)
 
     int stringPos = reserveSpace(2);
     BEGIN << "parse string stringPos=" << stringPos << json;
+    // stop copying plain characters at the length limit checked below
+    const char *latin1End = end - start > 0x7fff ? start + 0x7fff : end;
     while (json < end) {
+        // copy characters that need no decoding in one go
+        const char *plainEnd = scanPlainChars(json, latin1End);
+        if (plainEnd != json) {
+            const int length = plainEnd - json;
+            int pos = reserveSpace(length);
+            memcpy(data + pos, json, length);
+            json = plainEnd;
+            if (json >= end)
+                break;
+        }
+
         uint ch = 0;
         if (*json == '"')
             break;
@@ -900,6 +1033,21 @@ bool Parser::parseString(bool *latin1)
     current = outStart + sizeof(int);
 
     while (json < end) {
+        const char *plainEnd = scanPlainChars(json, end);
+        if (plainEnd != json) {
+            const int length = plainEnd - json;
+            int pos = reserveSpace(2 * length);
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+            qt_from_latin1(reinterpret_cast<ushort *>(data + pos), json, length);
+#else
+            for (int i = 0; i < length; ++i)
+                *(QJsonPrivate::qle_ushort *)(data + pos + 2 * i) = (ushort)json[i];
+#endif
+            json = plainEnd;
+            if (json >= end)
+                break;
+        }
+
         uint ch = 0;
         if (*json == '"')
             break;
@@ -35,6 +35,7 @@
 #include "qjsonwriter_p.h"
 #include "qjson_p.h"
 #include "private/qutfcodec_p.h"
+#include <qlocale.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -122,8 +123,8 @@ static void valueToJson(const QJsonPrivate::Base *b, const QJsonPrivate::Value &
         break;
     case QJsonValue::Double: {
         const double d = v.toDouble(b);
-        if (qIsFinite(d)) // +2 to format to ensure the expected precision
-            json += QByteArray::number(d, 'g', std::numeric_limits<double>::digits10 + 2); // ::digits10 is 15
+        if (qIsFinite(d))
+            json += QByteArray::number(d, 'g', QLocale::FloatingPointShortest);
         else
             json += "null"; // +INF || -INF || NaN (see RFC4627#section2.4)
         break;
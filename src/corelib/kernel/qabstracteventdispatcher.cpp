@@ -48,7 +48,9 @@ struct QtTimerIdFreeListConstants : public QFreeListDefaultConstants
     enum
     {
         InitialNextValue = 1,
-        BlockCount = 6
+        BlockCount = 6,
+        // threads that start and kill many timers mostly reuse their own ids
+        MagazineSize = 16
     };
 
     static const int Sizes[BlockCount];
@@ -73,6 +73,9 @@
 #    if !defined(QT_NO_GLIB)
 #      include "qeventdispatcher_glib_p.h"
 #    endif
+#    if !defined(QT_NO_EPOLL)
+#      include "qeventdispatcher_epoll_p.h"
+#    endif
 #    include "qeventdispatcher_unix_p.h"
 #  endif
 #endif
@@ -306,7 +309,11 @@ bool QCoreApplicationPrivate::is_app_closing = false;
 Q_CORE_EXPORT uint qGlobalPostedEventsCount()
 {
     QThreadData *currentThreadData = QThreadData::current();
-    return currentThreadData->postEventList.size() - currentThreadData->postEventList.startOffset;
+    const uint count = currentThreadData->postEventList.size() - currentThreadData->postEventList.startOffset;
+    // events posted from other threads may not have been moved into the list yet
+    if (!count && currentThreadData->postEventList.incoming.load())
+        return 1;
+    return count;
 }
 
 QAbstractEventDispatcher *QCoreApplicationPrivate::eventDispatcher = 0;
@@ -510,10 +517,20 @@ void QCoreApplicationPrivate::createEventDispatcher()
 #  if defined(Q_OS_BLACKBERRY)
     eventDispatcher = new QEventDispatcherBlackberry(q);
 #  else
+#  if !defined(QT_NO_EPOLL)
+    if (QEventDispatcherEpoll::isRequested())
+        eventDispatcher = new QEventDispatcherEpoll(q);
+    else
+#  endif
 #  if !defined(QT_NO_GLIB)
     if (qEnvironmentVariableIsEmpty("QT_NO_GLIB") && QEventDispatcherGlib::versionSupported())
         eventDispatcher = new QEventDispatcherGlib(q);
     else
+#  endif
+#  if !defined(QT_NO_EPOLL)
+    if (QEventDispatcherEpoll::isPreferred())
+        eventDispatcher = new QEventDispatcherEpoll(q);
+    else
 #  endif
         eventDispatcher = new QEventDispatcherUNIX(q);
 #  endif
@@ -1341,6 +1358,31 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
         return;
     }
 
+    // queued calls of the default priority are never compressed, so they
+    // don't need to look at the list and can skip the mutex
+    if (priority == Qt::NormalEventPriority && event->type() == QEvent::MetaCall) {
+        QPostEventNode *node = new QPostEventNode;
+        node->receiver = receiver;
+        node->event = event;
+
+        // QObject::moveToThread() waits for the posters it may have missed
+        data->postEventList.incomingPosters.ref();
+        if (data == *pdata) {
+            event->posted = true;
+            data->postEventList.pushIncoming(node);
+            data->postEventList.incomingPosters.deref();
+
+            QAbstractEventDispatcher* dispatcher = data->eventDispatcher.loadAcquire();
+            if (dispatcher)
+                dispatcher->wakeUp();
+            return;
+        }
+
+        // the object is moving to another thread, follow it the slow way
+        data->postEventList.incomingPosters.deref();
+        delete node;
+    }
+
     // lock the post event mutex
     data->postEventList.mutex.lock();
 
@@ -1360,6 +1402,9 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
 
     QMutexUnlocker locker(&data->postEventList.mutex);
 
+    // keep the order with the events posted without the mutex
+    data->postEventList.addIncomingEvents();
+
     // if this is one of the compressible events, do compression
     if (receiver->d_func()->postedEvents
         && self && self->compressEvent(event, receiver, &data->postEventList)) {
@@ -1467,6 +1512,7 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
     ++data->postEventList.recursion;
 
     QMutexLocker locker(&data->postEventList.mutex);
+    data->postEventList.addIncomingEvents();
 
     // by default, we assume that the event dispatcher can go to sleep after
     // processing all events. if any new events are posted while we send
@@ -1623,6 +1669,7 @@ void QCoreApplication::removePostedEvents(QObject *receiver, int eventType)
 {
     QThreadData *data = receiver ? receiver->d_func()->threadData : QThreadData::current();
     QMutexLocker locker(&data->postEventList.mutex);
+    data->postEventList.addIncomingEvents();
 
     // the QObject destructor calls this function directly.  this can
     // happen while the event loop is in the middle of posting events,
@@ -1688,6 +1735,7 @@ void QCoreApplicationPrivate::removePostedEvent(QEvent * event)
     QThreadData *data = QThreadData::current();
 
     QMutexLocker locker(&data->postEventList.mutex);
+    data->postEventList.addIncomingEvents();
 
     if (data->postEventList.size() == 0) {
 #if defined(QT_DEBUG)
@@ -0,0 +1,646 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qplatformdefs.h"
+
+#include "qcoreapplication.h"
+#include "qelapsedtimer.h"
+#include "qsocketnotifier.h"
+#include "qthread.h"
+
+#include "qeventdispatcher_epoll_p.h"
+#include <private/qthread_p.h>
+#include <private/qcoreapplication_p.h>
+#include <private/qcore_unix_p.h>
+
+#include <errno.h>
+#include <poll.h>
+#include <stdio.h>
+#include <sys/resource.h>
+#include <sys/select.h>
+#include <sys/timerfd.h>
+
+#ifndef QT_NO_EVENTFD
+#  include <sys/eventfd.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+enum {
+    // initial and maximum number of events fetched by one epoll_wait() call
+    InitialEventCount = 64,
+    MaximumEventCount = 4096
+};
+
+static const quint32 epollEventForType[] = { EPOLLIN, EPOLLOUT, EPOLLPRI };
+
+static int timespecToMsecs(const timespec &ts)
+{
+    // round up, so that we never wake up before the timer is due and spin
+    qint64 msecs = qint64(ts.tv_sec) * 1000 + (ts.tv_nsec + 999999) / 1000000;
+    return int(qMin(msecs, qint64(INT_MAX)));
+}
+
+QEventDispatcherEpollPrivate::QEventDispatcherEpollPrivate()
+    : epollFd(-1),
+      edgeTriggered(!qEnvironmentVariableIsEmpty("QT_EPOLL_EDGE_TRIGGERED")),
+      timerFd(-1),
+      unpolledCount(0),
+      events(InitialEventCount)
+{
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd == -1) {
+        perror("QEventDispatcherEpollPrivate(): Unable to create epoll instance");
+        qFatal("QEventDispatcherEpollPrivate(): Can not continue without an epoll instance");
+    }
+
+#ifndef QT_NO_EVENTFD
+    thread_pipe[0] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (thread_pipe[0] != -1)
+        thread_pipe[1] = -1;
+    else // fall through the next "if"
+#endif
+    if (qt_safe_pipe(thread_pipe, O_NONBLOCK) == -1) {
+        perror("QEventDispatcherEpollPrivate(): Unable to create thread pipe");
+        qFatal("QEventDispatcherEpollPrivate(): Can not continue without a thread pipe");
+    }
+
+    // the wake up descriptor is always level-triggered
+    epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.fd = thread_pipe[0];
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, thread_pipe[0], &ev) == -1) {
+        perror("QEventDispatcherEpollPrivate(): Unable to watch thread pipe");
+        qFatal("QEventDispatcherEpollPrivate(): Can not continue without a thread pipe");
+    }
+
+    // timer deadlines are absolute times of the monotonic clock, which is
+    // what timerfd can wait for
+    timerDeadline.tv_sec = timerDeadline.tv_nsec = 0;
+    if (QElapsedTimer::isMonotonic())
+        timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timerFd != -1) {
+        ev.data.fd = timerFd;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, timerFd, &ev) == -1) {
+            close(timerFd);
+            timerFd = -1;
+        }
+    }
+}
+
+QEventDispatcherEpollPrivate::~QEventDispatcherEpollPrivate()
+{
+    close(epollFd);
+    if (timerFd != -1)
+        close(timerFd);
+    close(thread_pipe[0]);
+    if (thread_pipe[1] != -1)
+        close(thread_pipe[1]);
+}
+
+int QEventDispatcherEpollPrivate::doPoll(QEventLoop::ProcessEventsFlags flags, timespec *timeout)
+{
+    // the timeout is relative to the time timerWait() was called at
+    const timespec deadline = timeout ? timerList.currentTime + *timeout : timespec();
+
+    // needed by the timer code
+    timerList.updateCurrentTime();
+
+    int msecs = timeout ? timespecToMsecs(*timeout) : -1;
+
+    // Events for excluded socket notifiers must stay queued in the kernel,
+    // so only the wake up descriptor is watched in that case.
+    if (flags & QEventLoop::ExcludeSocketNotifiers)
+        return waitForThreadWakeUp(msecs);
+
+    if (timerFd != -1) {
+        // let the kernel wake us up when the next timer is due; the timerfd
+        // is only reprogrammed if that time changes
+        if (msecs > 0) {
+            if (setTimerDeadline(deadline))
+                msecs = -1;
+        } else if (!timeout) {
+            setTimerDeadline(timespec());
+        }
+    }
+
+    // epoll cannot watch regular files; select() always reports them as
+    // ready, so we do the same without blocking
+    if (unpolledCount > 0)
+        msecs = 0;
+
+    int nsel;
+    EINTR_LOOP(nsel, epoll_wait(epollFd, events.data(), events.size(), msecs));
+    if (nsel == -1) {
+        // EBADF/EINVAL... shouldn't happen, so let's complain to stderr
+        // and hope someone sends us a bug report
+        perror("epoll_wait");
+        nsel = 0;
+    }
+
+    int nevents = 0;
+    for (int i = 0; i < nsel; ++i) {
+        const epoll_event &ev = events.at(i);
+        const int fd = ev.data.fd;
+        if (fd == thread_pipe[0]) {
+            nevents += processThreadWakeUp();
+            continue;
+        }
+        if (fd == timerFd) {
+            // the timers themselves are activated by our caller
+            quint64 expirations;
+            qt_safe_read(timerFd, &expirations, sizeof(expirations));
+            timerDeadline.tv_sec = timerDeadline.tv_nsec = 0;
+            continue;
+        }
+
+        QHash<int, QEpollSocketNotifierSet>::iterator it = socketNotifiers.find(fd);
+        if (it == socketNotifiers.end())
+            continue;
+
+        QEpollSocketNotifierSet &set = *it;
+        // like select(), report errors and hang ups as readable and writable
+        const quint32 errorEvents = ev.events & (EPOLLERR | EPOLLHUP);
+        if (((ev.events & EPOLLIN) || errorEvents) && set.notifiers[QSocketNotifier::Read])
+            setSocketNotifierPending(fd, set, QSocketNotifier::Read);
+        if (((ev.events & EPOLLOUT) || errorEvents) && set.notifiers[QSocketNotifier::Write])
+            setSocketNotifierPending(fd, set, QSocketNotifier::Write);
+        if (set.notifiers[QSocketNotifier::Exception]) {
+            // errors and hang ups are always reported by epoll; if nobody
+            // else is listening, hand them to the exception notifier instead
+            // of spinning on them
+            if ((ev.events & EPOLLPRI)
+                || (errorEvents && !set.notifiers[QSocketNotifier::Read]
+                    && !set.notifiers[QSocketNotifier::Write]))
+                setSocketNotifierPending(fd, set, QSocketNotifier::Exception);
+        }
+    }
+
+    if (unpolledCount > 0) {
+        QHash<int, QEpollSocketNotifierSet>::iterator it = socketNotifiers.begin();
+        for ( ; it != socketNotifiers.end(); ++it) {
+            if (it->polled)
+                continue;
+            for (int type = 0; type < 3; ++type) {
+                if (it->notifiers[type])
+                    setSocketNotifierPending(it.key(), *it, type);
+            }
+        }
+    }
+
+    // more descriptors may be ready than we could fetch; they will be
+    // returned by the next call, but allow for more of them at once
+    if (nsel == events.size() && events.size() < MaximumEventCount)
+        events.resize(events.size() * 2);
+
+    return nevents + activateSocketNotifiers();
+}
+
+int QEventDispatcherEpollPrivate::waitForThreadWakeUp(int timeout)
+{
+    pollfd pfd;
+    pfd.fd = thread_pipe[0];
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+
+    int nsel;
+    EINTR_LOOP(nsel, ::poll(&pfd, 1, timeout));
+    if (nsel > 0 && (pfd.revents & POLLIN))
+        return processThreadWakeUp();
+    return 0;
+}
+
+bool QEventDispatcherEpollPrivate::setTimerDeadline(const timespec &deadline)
+{
+    if (deadline == timerDeadline)
+        return true;
+
+    // a zero deadline disarms the timer
+    itimerspec spec;
+    spec.it_interval.tv_sec = spec.it_interval.tv_nsec = 0;
+    spec.it_value = deadline;
+    if (timerfd_settime(timerFd, TFD_TIMER_ABSTIME, &spec, 0) == -1) {
+        perror("QEventDispatcherEpollPrivate: Unable to set timer deadline");
+        return false;
+    }
+    timerDeadline = deadline;
+    return true;
+}
+
+int QEventDispatcherEpollPrivate::processThreadWakeUp()
+{
+    // some other thread woke us up... consume the data on the thread pipe so that
+    // epoll doesn't immediately return next time
+#ifndef QT_NO_EVENTFD
+    if (thread_pipe[1] == -1) {
+        // eventfd
+        eventfd_t value;
+        eventfd_read(thread_pipe[0], &value);
+    } else
+#endif
+    {
+        char c[16];
+        while (::read(thread_pipe[0], c, sizeof(c)) > 0) {
+        }
+    }
+
+    if (!wakeUps.testAndSetRelease(1, 0)) {
+        // hopefully, this is dead code
+        qWarning("QEventDispatcherEpoll: internal error, wakeUps.testAndSetRelease(1, 0) failed!");
+    }
+    return 1;
+}
+
+bool QEventDispatcherEpollPrivate::updateSocketNotifierSet(int fd, QEpollSocketNotifierSet &set)
+{
+    quint32 wanted = 0;
+    for (int type = 0; type < 3; ++type) {
+        if (set.notifiers[type])
+            wanted |= epollEventForType[type];
+    }
+    if (wanted && edgeTriggered)
+        wanted |= EPOLLET;
+
+    if (!set.polled)
+        return true;
+    // in edge-triggered mode, re-arming the descriptor reports it again if
+    // it is still ready, so enabling a notifier does not lose that state
+    if (wanted == set.registeredEvents && (!wanted || !edgeTriggered))
+        return true;
+
+    epoll_event ev;
+    ev.events = wanted;
+    ev.data.fd = fd;
+
+    int ret;
+    if (!wanted) {
+        ret = epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, &ev);
+    } else if (!set.registeredEvents) {
+        ret = epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev);
+        if (ret == -1 && errno == EEXIST)
+            ret = epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &ev);
+    } else {
+        ret = epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &ev);
+        // the descriptor was closed and reused behind our back
+        if (ret == -1 && errno == ENOENT)
+            ret = epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev);
+    }
+
+    if (ret == -1) {
+        set.registeredEvents = 0;
+        if (errno == EPERM) {
+            // the descriptor does not support polling (e.g. a regular file)
+            set.polled = false;
+            ++unpolledCount;
+            return true;
+        }
+        // a closed descriptor is silently dropped by the kernel
+        return !wanted;
+    }
+    set.registeredEvents = wanted;
+    return true;
+}
+
+void QEventDispatcherEpollPrivate::setSocketNotifierPending(int fd, QEpollSocketNotifierSet &set,
+                                                            int type)
+{
+    const uint bit = 1u << type;
+    if (set.pending & bit)
+        return;
+    set.pending |= bit;
+    // epoll already rotates the ready list between calls, so a plain queue
+    // is fair even when some peers saturate the IO
+    pendingNotifiers.append(qMakePair(fd, type));
+}
+
+int QEventDispatcherEpollPrivate::activateSocketNotifiers()
+{
+    if (pendingNotifiers.isEmpty())
+        return 0;
+
+    // the list is consumed from the front, so that recursive event loops
+    // entered from a notifier continue with the remaining entries
+    int n_act = 0;
+    QEvent event(QEvent::SockAct);
+    while (!pendingNotifiers.isEmpty()) {
+        const QPair<int, int> entry = pendingNotifiers.takeFirst();
+        QHash<int, QEpollSocketNotifierSet>::iterator it = socketNotifiers.find(entry.first);
+        if (it == socketNotifiers.end())
+            continue;
+        const uint bit = 1u << entry.second;
+        if (!(it->pending & bit))
+            continue;
+        it->pending &= ~bit;
+        QCoreApplication::sendEvent(it->notifiers[entry.second], &event);
+        ++n_act;
+    }
+    return n_act;
+}
+
+QEventDispatcherEpoll::QEventDispatcherEpoll(QObject *parent)
+    : QAbstractEventDispatcher(*new QEventDispatcherEpollPrivate, parent)
+{ }
+
+QEventDispatcherEpoll::QEventDispatcherEpoll(QEventDispatcherEpollPrivate &dd, QObject *parent)
+    : QAbstractEventDispatcher(dd, parent)
+{ }
+
+QEventDispatcherEpoll::~QEventDispatcherEpoll()
+{
+}
+
+/*!
+    \internal
+
+    Returns \c true if the epoll dispatcher was explicitly asked for by
+    setting the \c QT_USE_EPOLL environment variable. It then takes
+    precedence over the Glib event dispatcher.
+*/
+bool QEventDispatcherEpoll::isRequested()
+{
+    return !qEnvironmentVariableIsEmpty("QT_USE_EPOLL")
+            && qEnvironmentVariableIsEmpty("QT_NO_EPOLL");
+}
+
+/*!
+    \internal
+
+    Returns \c true if the epoll dispatcher should be used instead of the
+    select() based QEventDispatcherUNIX. This is the case if it was
+    requested, or if the process may open more file descriptors than
+    select() can handle. Setting \c QT_NO_EPOLL disables it.
+*/
+bool QEventDispatcherEpoll::isPreferred()
+{
+    if (!qEnvironmentVariableIsEmpty("QT_NO_EPOLL"))
+        return false;
+    if (isRequested())
+        return true;
+
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == -1)
+        return false;
+    return limit.rlim_cur == RLIM_INFINITY || limit.rlim_cur > FD_SETSIZE;
+}
+
+/*!
+    \internal
+*/
+void QEventDispatcherEpoll::registerTimer(int timerId, int interval, Qt::TimerType timerType, QObject *obj)
+{
+#ifndef QT_NO_DEBUG
+    if (timerId < 1 || interval < 0 || !obj) {
+        qWarning("QEventDispatcherEpoll::registerTimer: invalid arguments");
+        return;
+    } else if (obj->thread() != thread() || thread() != QThread::currentThread()) {
+        qWarning("QEventDispatcherEpoll::registerTimer: timers cannot be started from another thread");
+        return;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    d->timerList.registerTimer(timerId, interval, timerType, obj);
+}
+
+/*!
+    \internal
+*/
+bool QEventDispatcherEpoll::unregisterTimer(int timerId)
+{
+#ifndef QT_NO_DEBUG
+    if (timerId < 1) {
+        qWarning("QEventDispatcherEpoll::unregisterTimer: invalid argument");
+        return false;
+    } else if (thread() != QThread::currentThread()) {
+        qWarning("QEventDispatcherEpoll::unregisterTimer: timers cannot be stopped from another thread");
+        return false;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    return d->timerList.unregisterTimer(timerId);
+}
+
+/*!
+    \internal
+*/
+bool QEventDispatcherEpoll::unregisterTimers(QObject *object)
+{
+#ifndef QT_NO_DEBUG
+    if (!object) {
+        qWarning("QEventDispatcherEpoll::unregisterTimers: invalid argument");
+        return false;
+    } else if (object->thread() != thread() || thread() != QThread::currentThread()) {
+        qWarning("QEventDispatcherEpoll::unregisterTimers: timers cannot be stopped from another thread");
+        return false;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    return d->timerList.unregisterTimers(object);
+}
+
+QList<QEventDispatcherEpoll::TimerInfo>
+QEventDispatcherEpoll::registeredTimers(QObject *object) const
+{
+    if (!object) {
+        qWarning("QEventDispatcherEpoll:registeredTimers: invalid argument");
+        return QList<TimerInfo>();
+    }
+
+    Q_D(const QEventDispatcherEpoll);
+    return d->timerList.registeredTimers(object);
+}
+
+int QEventDispatcherEpoll::remainingTime(int timerId)
+{
+#ifndef QT_NO_DEBUG
+    if (timerId < 1) {
+        qWarning("QEventDispatcherEpoll::remainingTime: invalid argument");
+        return -1;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    return d->timerList.timerRemainingTime(timerId);
+}
+
+void QEventDispatcherEpoll::registerSocketNotifier(QSocketNotifier *notifier)
+{
+    Q_ASSERT(notifier);
+    int sockfd = notifier->socket();
+    int type = notifier->type();
+#ifndef QT_NO_DEBUG
+    if (sockfd < 0) {
+        qWarning("QSocketNotifier: Internal error");
+        return;
+    } else if (notifier->thread() != thread()
+               || thread() != QThread::currentThread()) {
+        qWarning("QSocketNotifier: socket notifiers cannot be enabled from another thread");
+        return;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    QEpollSocketNotifierSet &set = d->socketNotifiers[sockfd];
+    if (set.notifiers[type] && set.notifiers[type] != notifier) {
+        static const char *t[] = { "Read", "Write", "Exception" };
+        qWarning("QSocketNotifier: Multiple socket notifiers for "
+                 "same socket %d and type %s", sockfd, t[type]);
+    }
+    set.notifiers[type] = notifier;
+    set.pending &= ~(1u << type);
+    if (!d->updateSocketNotifierSet(sockfd, set)) {
+        // disable the invalid socket notifier
+        static const char *t[] = { "Read", "Write", "Exception" };
+        qWarning("QSocketNotifier: Invalid socket %d and type '%s', disabling...",
+                 sockfd, t[type]);
+        notifier->setEnabled(false);
+    }
+}
+
+void QEventDispatcherEpoll::unregisterSocketNotifier(QSocketNotifier *notifier)
+{
+    Q_ASSERT(notifier);
+    int sockfd = notifier->socket();
+    int type = notifier->type();
+#ifndef QT_NO_DEBUG
+    if (sockfd < 0) {
+        qWarning("QSocketNotifier: Internal error");
+        return;
+    } else if (notifier->thread() != thread()
+               || thread() != QThread::currentThread()) {
+        qWarning("QSocketNotifier: socket notifiers cannot be disabled from another thread");
+        return;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    QHash<int, QEpollSocketNotifierSet>::iterator it = d->socketNotifiers.find(sockfd);
+    if (it == d->socketNotifiers.end() || it->notifiers[type] != notifier) // not found
+        return;
+
+    QEpollSocketNotifierSet &set = *it;
+    set.notifiers[type] = 0;
+    set.pending &= ~(1u << type);                // remove from activation list
+    d->updateSocketNotifierSet(sockfd, set);
+
+    if (!set.notifiers[0] && !set.notifiers[1] && !set.notifiers[2]) {
+        if (!set.polled)
+            --d->unpolledCount;
+        d->socketNotifiers.erase(it);
+    }
+}
+
+bool QEventDispatcherEpoll::processEvents(QEventLoop::ProcessEventsFlags flags)
+{
+    Q_D(QEventDispatcherEpoll);
+    d->interrupt.store(0);
+
+    // we are awake, broadcast it
+    emit awake();
+    QCoreApplicationPrivate::sendPostedEvents(0, 0, d->threadData);
+
+    int nevents = 0;
+    const bool canWait = (d->threadData->canWaitLocked()
+                          && !d->interrupt.load()
+                          && (flags & QEventLoop::WaitForMoreEvents));
+
+    if (canWait)
+        emit aboutToBlock();
+
+    if (!d->interrupt.load()) {
+        // return the maximum time we can wait for an event.
+        timespec *tm = 0;
+        timespec wait_tm = { 0l, 0l };
+        if (!(flags & QEventLoop::X11ExcludeTimers)) {
+            if (d->timerList.timerWait(wait_tm))
+                tm = &wait_tm;
+        }
+
+        if (!canWait) {
+            if (!tm)
+                tm = &wait_tm;
+
+            // no time to wait
+            tm->tv_sec  = 0l;
+            tm->tv_nsec = 0l;
+        }
+
+        nevents = d->doPoll(flags, tm);
+
+        // activate timers
+        if (! (flags & QEventLoop::X11ExcludeTimers)) {
+            Q_ASSERT(thread() == QThread::currentThread());
+            nevents += d->timerList.activateTimers();
+        }
+    }
+    // return true if we handled events, false otherwise
+    return (nevents > 0);
+}
+
+bool QEventDispatcherEpoll::hasPendingEvents()
+{
+    extern uint qGlobalPostedEventsCount(); // from qapplication.cpp
+    return qGlobalPostedEventsCount();
+}
+
+void QEventDispatcherEpoll::wakeUp()
+{
+    Q_D(QEventDispatcherEpoll);
+    if (d->wakeUps.testAndSetAcquire(0, 1)) {
+#ifndef QT_NO_EVENTFD
+        if (d->thread_pipe[1] == -1) {
+            // eventfd
+            eventfd_t value = 1;
+            int ret;
+            EINTR_LOOP(ret, eventfd_write(d->thread_pipe[0], value));
+            return;
+        }
+#endif
+        char c = 0;
+        qt_safe_write(d->thread_pipe[1], &c, 1);
+    }
+}
+
+void QEventDispatcherEpoll::interrupt()
+{
+    Q_D(QEventDispatcherEpoll);
+    d->interrupt.store(1);
+    wakeUp();
+}
+
+void QEventDispatcherEpoll::flush()
+{ }
+
+QT_END_NAMESPACE
@@ -0,0 +1,156 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QEVENTDISPATCHER_EPOLL_P_H
+#define QEVENTDISPATCHER_EPOLL_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "QtCore/qabstracteventdispatcher.h"
+#include "QtCore/qhash.h"
+#include "QtCore/qlist.h"
+#include "QtCore/qpair.h"
+#include "QtCore/qvector.h"
+#include "private/qabstracteventdispatcher_p.h"
+#include "private/qtimerinfo_unix_p.h"
+
+#ifndef QT_NO_EPOLL
+
+#include <sys/epoll.h>
+
+QT_BEGIN_NAMESPACE
+
+// all notifiers registered for one file descriptor, indexed by QSocketNotifier::Type
+struct QEpollSocketNotifierSet
+{
+    inline QEpollSocketNotifierSet()
+        : registeredEvents(0), pending(0), polled(true)
+    { notifiers[0] = notifiers[1] = notifiers[2] = 0; }
+
+    QSocketNotifier *notifiers[3];
+    quint32 registeredEvents; // - the epoll event mask currently in the kernel
+    uint pending;             // - bit mask of types queued for activation
+    bool polled;              // - false if epoll refused the fd (e.g. a regular file)
+};
+
+class QEventDispatcherEpollPrivate;
+
+class Q_CORE_EXPORT QEventDispatcherEpoll : public QAbstractEventDispatcher
+{
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(QEventDispatcherEpoll)
+
+public:
+    explicit QEventDispatcherEpoll(QObject *parent = 0);
+    ~QEventDispatcherEpoll();
+
+    bool processEvents(QEventLoop::ProcessEventsFlags flags) Q_DECL_OVERRIDE;
+    bool hasPendingEvents() Q_DECL_OVERRIDE;
+
+    void registerSocketNotifier(QSocketNotifier *notifier) Q_DECL_FINAL;
+    void unregisterSocketNotifier(QSocketNotifier *notifier) Q_DECL_FINAL;
+
+    void registerTimer(int timerId, int interval, Qt::TimerType timerType, QObject *object) Q_DECL_FINAL;
+    bool unregisterTimer(int timerId) Q_DECL_FINAL;
+    bool unregisterTimers(QObject *object) Q_DECL_FINAL;
+    QList<TimerInfo> registeredTimers(QObject *object) const Q_DECL_FINAL;
+
+    int remainingTime(int timerId) Q_DECL_FINAL;
+
+    void wakeUp() Q_DECL_FINAL;
+    void interrupt() Q_DECL_FINAL;
+    void flush() Q_DECL_FINAL;
+
+    static bool isRequested();
+    static bool isPreferred();
+
+protected:
+    QEventDispatcherEpoll(QEventDispatcherEpollPrivate &dd, QObject *parent = 0);
+};
+
+class Q_CORE_EXPORT QEventDispatcherEpollPrivate : public QAbstractEventDispatcherPrivate
+{
+    Q_DECLARE_PUBLIC(QEventDispatcherEpoll)
+
+public:
+    QEventDispatcherEpollPrivate();
+    ~QEventDispatcherEpollPrivate();
+
+    int doPoll(QEventLoop::ProcessEventsFlags flags, timespec *timeout);
+    int waitForThreadWakeUp(int timeout);
+    bool setTimerDeadline(const timespec &deadline);
+    int processThreadWakeUp();
+    bool updateSocketNotifierSet(int fd, QEpollSocketNotifierSet &set);
+    void setSocketNotifierPending(int fd, QEpollSocketNotifierSet &set, int type);
+    int activateSocketNotifiers();
+
+    int epollFd;
+    bool edgeTriggered;
+
+    // timerfd(2) expiring when the next timer is due, or -1 if the
+    // epoll_wait() timeout is used instead
+    int timerFd;
+    timespec timerDeadline; // - zero if timerFd is disarmed
+
+    // note for eventfd(7) support:
+    // if thread_pipe[1] is -1, then eventfd(7) is in use and is stored in thread_pipe[0]
+    int thread_pipe[2];
+
+    QHash<int, QEpollSocketNotifierSet> socketNotifiers;
+    // number of entries in socketNotifiers that epoll could not watch
+    int unpolledCount;
+
+    // pending socket notifiers, as (fd, type) pairs in activation order
+    QList<QPair<int, int> > pendingNotifiers;
+    QVector<epoll_event> events;
+
+    QTimerInfoList timerList;
+
+    QAtomicInt wakeUps;
+    QAtomicInt interrupt; // bool
+};
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_EPOLL
+
+#endif // QEVENTDISPATCHER_EPOLL_P_H
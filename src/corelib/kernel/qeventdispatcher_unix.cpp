@@ -158,9 +158,6 @@ QEventDispatcherUNIXPrivate::~QEventDispatcherUNIXPrivate()
     if (thread_pipe[1] != -1)
         close(thread_pipe[1]);
 #endif
-
-    // cleanup timers
-    qDeleteAll(timerList);
 }
 
 int QEventDispatcherUNIXPrivate::doSelect(QEventLoop::ProcessEventsFlags flags, timespec *timeout)
@@ -2151,6 +2151,9 @@ bool QMetaMethod::invoke(QObject *object,
         connectionType = currentThread == objectThread
                          ? Qt::DirectConnection
                          : Qt::QueuedConnection;
+    } else if (connectionType == Qt::BatchedConnection) {
+        // there is no connection to collect the calls on
+        connectionType = Qt::QueuedConnection;
     }
 
 #ifdef QT_NO_THREAD
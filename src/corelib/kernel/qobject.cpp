@@ -48,6 +48,7 @@
 #include <private/qthread_p.h>
 #include <qdebug.h>
 #include <qpair.h>
+#include <qpointer.h>
 #include <qvarlengtharray.h>
 #include <qset.h>
 #include <qsemaphore.h>
@@ -140,6 +141,18 @@ static inline QMutex *signalSlotLock(const QObject *o)
         uint(quintptr(o)) % sizeof(_q_ObjectMutexPool)/sizeof(QBasicMutex)]);
 }
 
+static QBasicMutex _q_BatchMutexPool[31];
+
+/**
+ * \internal
+ * mutex to be locked when accessing the pending batch of a receiver
+ */
+static inline QMutex *batchLock(const QObject *o)
+{
+    return static_cast<QMutex *>(&_q_BatchMutexPool[
+        uint(quintptr(o)) % sizeof(_q_BatchMutexPool)/sizeof(QBasicMutex)]);
+}
+
 // ### Qt >= 5.6, remove qt_add/removeObject
 extern "C" Q_CORE_EXPORT void qt_addObject(QObject *)
 {}
@@ -196,7 +209,8 @@ QMetaObject *QObjectData::dynamicMetaObject() const
 }
 
 QObjectPrivate::QObjectPrivate(int version)
-    : threadData(0), connectionLists(0), senders(0), currentSender(0), currentChildBeingDeleted(0)
+    : threadData(0), connectionLists(0), senders(0), currentSender(0), currentChildBeingDeleted(0),
+      pendingBatch(0)
 {
 #ifdef QT_BUILD_INTERNAL
     // Don't check the version parameter in internal builds.
@@ -240,7 +254,8 @@ QObjectPrivate::~QObjectPrivate()
         }
     }
 
-    if (postedEvents)
+    // events posted through the lock-free queue are not counted yet
+    if (postedEvents || threadData->postEventList.incoming.load())
         QCoreApplication::removePostedEvents(q_ptr, 0);
 
     threadData->deref();
@@ -290,12 +305,13 @@ class QObjectConnectionListVector : public QVector<QObjectPrivate::ConnectionLis
 {
 public:
     bool orphaned; //the QObject owner of this vector has been destroyed while the vector was inUse
-    bool dirty; //some Connection have been disconnected (their receiver is 0) but not removed from the list yet
     int inUse; //number of functions that are currently accessing this object or its connections
     QObjectPrivate::ConnectionList allsignals;
+    //Connections disconnected (their receiver is 0) while inUse, not removed from their list yet
+    QVector<QObjectPrivate::Connection *> disconnected;
 
     QObjectConnectionListVector()
-        : QVector<QObjectPrivate::ConnectionList>(), orphaned(false), dirty(false), inUse(0)
+        : QVector<QObjectPrivate::ConnectionList>(), orphaned(false), inUse(0)
     { }
 
     QObjectPrivate::ConnectionList &operator[](int at)
@@ -304,6 +320,45 @@ public:
             return allsignals;
         return QVector<QObjectPrivate::ConnectionList>::operator[](at);
     }
+
+    // Removes the disconnected connection \a c from its list, or remembers it
+    // for removeDisconnected() if someone may be walking the lists.
+    void removeConnection(QObjectPrivate::Connection *c)
+    {
+        Q_ASSERT(!c->receiver);
+        if (inUse) {
+            disconnected.append(c);
+            return;
+        }
+        unlink(c);
+    }
+
+    void removeDisconnected()
+    {
+        Q_ASSERT(!inUse);
+        for (int i = 0; i < disconnected.size(); ++i)
+            unlink(disconnected.at(i));
+        disconnected.clear();
+    }
+
+private:
+    void unlink(QObjectPrivate::Connection *c)
+    {
+        // connections to all signals have an index out of range
+        const int signal = c->signal_index;
+        QObjectPrivate::ConnectionList &connectionList =
+            signal < count() ? (*this)[signal] : allsignals;
+
+        if (c->prevConnectionList)
+            c->prevConnectionList->nextConnectionList = c->nextConnectionList;
+        else
+            connectionList.first = c->nextConnectionList;
+        if (c->nextConnectionList)
+            c->nextConnectionList->prevConnectionList = c->prevConnectionList;
+        else
+            connectionList.last = c->prevConnectionList;
+        c->deref();
+    }
 };
 
 // Used by QAccessibleWidget
@@ -381,6 +436,7 @@ void QObjectPrivate::addConnection(int signal, Connection *c)
         connectionLists->resize(signal + 1);
 
     ConnectionList &connectionList = (*connectionLists)[signal];
+    c->prevConnectionList = connectionList.last;
     if (connectionList.last) {
         connectionList.last->nextConnectionList = c;
     } else {
@@ -405,38 +461,8 @@ void QObjectPrivate::addConnection(int signal, Connection *c)
 
 void QObjectPrivate::cleanConnectionLists()
 {
-    if (connectionLists->dirty && !connectionLists->inUse) {
-        // remove broken connections
-        for (int signal = -1; signal < connectionLists->count(); ++signal) {
-            QObjectPrivate::ConnectionList &connectionList =
-                (*connectionLists)[signal];
-
-            // Set to the last entry in the connection list that was *not*
-            // deleted.  This is needed to update the list's last pointer
-            // at the end of the cleanup.
-            QObjectPrivate::Connection *last = 0;
-
-            QObjectPrivate::Connection **prev = &connectionList.first;
-            QObjectPrivate::Connection *c = *prev;
-            while (c) {
-                if (c->receiver) {
-                    last = c;
-                    prev = &c->nextConnectionList;
-                    c = *prev;
-                } else {
-                    QObjectPrivate::Connection *next = c->nextConnectionList;
-                    *prev = next;
-                    c->deref();
-                    c = next;
-                }
-            }
-
-            // Correct the connection list's last pointer.
-            // As conectionList.last could equal last, this could be a noop
-            connectionList.last = last;
-        }
-        connectionLists->dirty = false;
-    }
+    if (!connectionLists->inUse)
+        connectionLists->removeDisconnected();
 }
 
 /*!
@@ -445,7 +471,7 @@ void QObjectPrivate::cleanConnectionLists()
 QMetaCallEvent::QMetaCallEvent(ushort method_offset, ushort method_relative, QObjectPrivate::StaticMetaCallFunction callFunction,
                                const QObject *sender, int signalId,
                                int nargs, int *types, void **args, QSemaphore *semaphore)
-    : QEvent(MetaCall), slotObj_(0), sender_(sender), signalId_(signalId),
+    : QEvent(MetaCall), inlineDataUsed_(0), slotObj_(0), sender_(sender), signalId_(signalId),
       nargs_(nargs), types_(types), args_(args), semaphore_(semaphore),
       callFunction_(callFunction), method_offset_(method_offset), method_relative_(method_relative)
 { }
@@ -455,7 +481,7 @@ QMetaCallEvent::QMetaCallEvent(ushort method_offset, ushort method_relative, QOb
  */
 QMetaCallEvent::QMetaCallEvent(QtPrivate::QSlotObjectBase *slotO, const QObject *sender, int signalId,
                                int nargs, int *types, void **args, QSemaphore *semaphore)
-    : QEvent(MetaCall), slotObj_(slotO), sender_(sender), signalId_(signalId),
+    : QEvent(MetaCall), inlineDataUsed_(0), slotObj_(slotO), sender_(sender), signalId_(signalId),
       nargs_(nargs), types_(types), args_(args), semaphore_(semaphore),
       callFunction_(0), method_offset_(0), method_relative_(ushort(-1))
 {
@@ -470,11 +496,17 @@ QMetaCallEvent::~QMetaCallEvent()
 {
     if (types_) {
         for (int i = 0; i < nargs_; ++i) {
-            if (types_[i] && args_[i])
+            if (!types_[i] || !args_[i])
+                continue;
+            if (isInlineArgument(args_[i]))
+                QMetaType::destruct(types_[i], args_[i]);
+            else
                 QMetaType::destroy(types_[i], args_[i]);
         }
-        free(types_);
-        free(args_);
+        if (types_ != inlineTypes_) {
+            free(types_);
+            free(args_);
+        }
     }
 #ifndef QT_NO_THREAD
     if (semaphore_)
@@ -484,6 +516,64 @@ QMetaCallEvent::~QMetaCallEvent()
         slotObj_->destroyIfLastRef();
 }
 
+/*!
+    \internal
+
+    Makes the event own \a nargs arguments, including the return value, all
+    of them empty. \a argumentTypes holds the types of all but the return
+    value. Events created without arguments only.
+ */
+void QMetaCallEvent::allocateArguments(int nargs, const int *argumentTypes)
+{
+    Q_ASSERT(!types_ && !args_);
+    nargs_ = nargs;
+    if (nargs <= InlineArgumentCount) {
+        types_ = inlineTypes_;
+        args_ = inlineArgs_;
+    } else {
+        types_ = (int *) malloc(nargs * sizeof(int));
+        Q_CHECK_PTR(types_);
+        args_ = (void **) malloc(nargs * sizeof(void *));
+        Q_CHECK_PTR(args_);
+    }
+    types_[0] = 0; // return type
+    args_[0] = 0; // return value
+    for (int i = 1; i < nargs; ++i) {
+        types_[i] = argumentTypes[i - 1];
+        args_[i] = 0;
+    }
+}
+
+/*!
+    \internal
+
+    Stores a copy of \a copy as argument \a index. Small values are copied
+    into the event itself instead of the heap.
+ */
+void QMetaCallEvent::setArgument(int index, const void *copy)
+{
+    Q_ASSERT(index > 0 && index < nargs_ && !args_[index]);
+    const int type = types_[index];
+
+    const int size = QMetaType::sizeOf(type);
+    if (size > 0) {
+        // a type's alignment divides its size; beyond 16 bytes we do not
+        // rely on the buffer lining up
+        const int alignment = size & -size;
+        if (alignment <= 16) {
+            const quintptr start = quintptr(inlineData_.bytes) + inlineDataUsed_;
+            const quintptr where = (start + alignment - 1) & ~quintptr(alignment - 1);
+            const quintptr end = quintptr(inlineData_.bytes) + sizeof(inlineData_.bytes);
+            if (where + size <= end) {
+                args_[index] = QMetaType::construct(type, reinterpret_cast<void *>(where), copy);
+                inlineDataUsed_ = int(where + size - quintptr(inlineData_.bytes));
+                return;
+            }
+        }
+    }
+    args_[index] = QMetaType::create(type, copy);
+}
+
 /*!
     \internal
  */
@@ -498,6 +588,63 @@ void QMetaCallEvent::placeMetaCall(QObject *object)
     }
 }
 
+/*
+    A QMetaCallEvent carrying the calls made through Qt::BatchedConnection
+    connections to one receiver. Until its delivery starts it is the
+    receiver's pendingBatch, and further calls are appended to it instead of
+    being posted on their own.
+*/
+class QMetaCallBatchEvent : public QMetaCallEvent
+{
+public:
+    explicit QMetaCallBatchEvent(QObject *receiver)
+        : QMetaCallEvent(0, 0, 0, 0, -1), receiver(receiver), detached(false)
+    { }
+    ~QMetaCallBatchEvent();
+
+    void placeMetaCall(QObject *object) Q_DECL_OVERRIDE;
+
+    QObject *receiver;
+    bool detached;
+    QVector<QMetaCallEvent *> calls;
+};
+
+QMetaCallBatchEvent::~QMetaCallBatchEvent()
+{
+    if (!detached) {
+        QMutexLocker locker(batchLock(receiver));
+        QObjectPrivate *d = QObjectPrivate::get(receiver);
+        if (d->pendingBatch == this)
+            d->pendingBatch = 0;
+    }
+    qDeleteAll(calls);
+}
+
+void QMetaCallBatchEvent::placeMetaCall(QObject *object)
+{
+    {
+        // from now on nothing is appended, so the calls can be used unlocked
+        QMutexLocker locker(batchLock(receiver));
+        QObjectPrivate *d = QObjectPrivate::get(receiver);
+        if (d->pendingBatch == this)
+            d->pendingBatch = 0;
+        detached = true;
+    }
+
+    // a slot may delete the receiver; the calls after that are dropped
+    QPointer<QObject> guard(object);
+    for (int i = 0; i < calls.size(); ++i) {
+        QScopedPointer<QMetaCallEvent> call(calls.at(i));
+        calls[i] = 0;
+        if (!guard)
+            continue;
+
+        QConnectionSenderSwitcher sw(object, const_cast<QObject *>(call->sender()), call->signalId());
+        call->placeMetaCall(object);
+    }
+    calls.clear();
+}
+
 /*!
     \class QSignalBlocker
     \brief Exception-safe wrapper around QObject::blockSignals()
@@ -1012,9 +1159,7 @@ QObject::~QObject()
                 continue;
             }
             node->receiver = 0;
-            QObjectConnectionListVector *senderLists = sender->d_func()->connectionLists;
-            if (senderLists)
-                senderLists->dirty = true;
+            QObjectPrivate::Connection *disconnected = node;
 
             QtPrivate::QSlotObjectBase *slotObj = Q_NULLPTR;
             if (node->isSlotObject) {
@@ -1023,6 +1168,9 @@ QObject::~QObject()
             }
 
             node = node->next;
+            QObjectConnectionListVector *senderLists = sender->d_func()->connectionLists;
+            if (senderLists)
+                senderLists->removeConnection(disconnected);
             if (needToUnlock)
                 m->unlock();
 
@@ -1505,9 +1653,32 @@ void QObject::moveToThread(QThread *targetThread)
     // keep currentData alive (since we've got it locked)
     currentData->ref();
 
-    // move the object
+    // move the object, along with the events posted to it without the mutex
+    currentData->postEventList.addIncomingEvents();
     d_func()->setThreadData_helper(currentData, targetData);
 
+    // a postEvent() that started before the move may still be pushing onto
+    // the old thread's queue; wait for it, and move what it posted as well
+    QPostEventList &currentList = currentData->postEventList;
+    while (currentList.incomingPosters.fetchAndAddOrdered(0) != 0)
+        QThread::yieldCurrentThread();
+    if (currentList.incoming.load()) {
+        currentList.addIncomingEvents();
+        int eventsMoved = 0;
+        for (int i = 0; i < currentList.size(); ++i) {
+            const QPostEvent &pe = currentList.at(i);
+            if (pe.event && pe.receiver->d_func()->threadData == targetData) {
+                targetData->postEventList.addEvent(pe);
+                const_cast<QPostEvent &>(pe).event = 0;
+                ++eventsMoved;
+            }
+        }
+        if (eventsMoved > 0 && targetData->eventDispatcher.load()) {
+            targetData->canWait = false;
+            targetData->eventDispatcher.load()->wakeUp();
+        }
+    }
+
     locker.unlock();
 
     // now currentData can commit suicide if it wants to
@@ -2723,7 +2894,7 @@ QMetaObject::Connection QObject::connect(const QObject *sender, const char *sign
     }
 
     int *types = 0;
-    if ((type == Qt::QueuedConnection)
+    if ((type == Qt::QueuedConnection || type == Qt::BatchedConnection)
             && !(types = queuedConnectionTypes(signalTypes.constData(), signalTypes.size()))) {
         return QMetaObject::Connection(0);
     }
@@ -2804,7 +2975,7 @@ QMetaObject::Connection QObject::connect(const QObject *sender, const QMetaMetho
     }
 
     int *types = 0;
-    if ((type == Qt::QueuedConnection)
+    if ((type == Qt::QueuedConnection || type == Qt::BatchedConnection)
             && !(types = queuedConnectionTypes(signal.parameterTypes())))
         return QMetaObject::Connection(0);
 
@@ -3345,6 +3516,8 @@ bool QMetaObjectPrivate::disconnectHelper(QObjectPrivate::Connection *c,
                 receiverMutex->unlock();
 
             c->receiver = 0;
+            // the lists are in use by our caller, so this does not unlink c yet
+            QObjectPrivate::get(c->sender)->connectionLists->removeConnection(c);
 
             if (c->isSlotObject) {
                 c->isSlotObject = false;
@@ -3393,24 +3566,24 @@ bool QMetaObjectPrivate::disconnect(const QObject *sender,
         for (int sig_index = -1; sig_index < connectionLists->count(); ++sig_index) {
             QObjectPrivate::Connection *c =
                 (*connectionLists)[sig_index].first;
-            if (disconnectHelper(c, receiver, method_index, slot, senderMutex, disconnectType)) {
+            if (disconnectHelper(c, receiver, method_index, slot, senderMutex, disconnectType))
                 success = true;
-                connectionLists->dirty = true;
-            }
         }
     } else if (signal_index < connectionLists->count()) {
         QObjectPrivate::Connection *c =
             (*connectionLists)[signal_index].first;
-        if (disconnectHelper(c, receiver, method_index, slot, senderMutex, disconnectType)) {
+        if (disconnectHelper(c, receiver, method_index, slot, senderMutex, disconnectType))
             success = true;
-            connectionLists->dirty = true;
-        }
     }
 
     --connectionLists->inUse;
     Q_ASSERT(connectionLists->inUse >= 0);
-    if (connectionLists->orphaned && !connectionLists->inUse)
-        delete connectionLists;
+    if (connectionLists->orphaned) {
+        if (!connectionLists->inUse)
+            delete connectionLists;
+    } else if (!connectionLists->inUse) {
+        connectionLists->removeDisconnected();
+    }
 
     locker.unlock();
     if (success) {
@@ -3549,37 +3722,44 @@ static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connect
     int nargs = 1; // include return type
     while (argumentTypes[nargs-1])
         ++nargs;
-    int *types = (int *) malloc(nargs*sizeof(int));
-    Q_CHECK_PTR(types);
-    void **args = (void **) malloc(nargs*sizeof(void *));
-    Q_CHECK_PTR(args);
-    types[0] = 0; // return type
-    args[0] = 0; // return value
 
-    if (nargs > 1) {
-        for (int n = 1; n < nargs; ++n)
-            types[n] = argumentTypes[n-1];
+    QMetaCallEvent *ev = c->isSlotObject ?
+        new QMetaCallEvent(c->slotObj, sender, signal) :
+        new QMetaCallEvent(c->method_offset, c->method_relative, c->callFunction, sender, signal);
+    ev->allocateArguments(nargs, argumentTypes);
 
+    if (nargs > 1) {
         locker.unlock();
         for (int n = 1; n < nargs; ++n)
-            args[n] = QMetaType::create(types[n], argv[n]);
+            ev->setArgument(n, argv[n]);
         locker.relock();
 
         if (!c->receiver) {
             locker.unlock();
             // we have been disconnected while the mutex was unlocked
-            for (int n = 1; n < nargs; ++n)
-                QMetaType::destroy(types[n], args[n]);
-            free(types);
-            free(args);
+            delete ev;
             locker.relock();
             return;
         }
     }
 
-    QMetaCallEvent *ev = c->isSlotObject ?
-        new QMetaCallEvent(c->slotObj, sender, signal, nargs, types, args) :
-        new QMetaCallEvent(c->method_offset, c->method_relative, c->callFunction, sender, signal, nargs, types, args);
+    if (c->connectionType == Qt::BatchedConnection) {
+        QObject *receiver = c->receiver;
+        QMutexLocker batchLocker(batchLock(receiver));
+        QObjectPrivate *d = QObjectPrivate::get(receiver);
+        if (d->pendingBatch) {
+            d->pendingBatch->calls.append(ev);
+            return;
+        }
+        QMetaCallBatchEvent *batch = new QMetaCallBatchEvent(receiver);
+        batch->calls.append(ev);
+        d->pendingBatch = batch;
+        batchLocker.unlock();
+        // the receiver cannot go away while the sender's mutex is locked
+        QCoreApplication::postEvent(receiver, batch);
+        return;
+    }
+
     QCoreApplication::postEvent(c->receiver, ev);
 }
 
@@ -3639,6 +3819,8 @@ void QMetaObject::activate(QObject *sender, int signalOffset, int local_signal_i
             if (connectionLists->orphaned) {
                 if (!connectionLists->inUse)
                     delete connectionLists;
+            } else if (!connectionLists->inUse && !connectionLists->disconnected.isEmpty()) {
+                connectionLists->removeDisconnected();
             }
         }
 
@@ -3675,7 +3857,8 @@ void QMetaObject::activate(QObject *sender, int signalOffset, int local_signal_i
             // determine if this connection should be sent immediately or
             // put into the event queue
             if ((c->connectionType == Qt::AutoConnection && !receiverInSameThread)
-                || (c->connectionType == Qt::QueuedConnection)) {
+                || (c->connectionType == Qt::QueuedConnection)
+                || (c->connectionType == Qt::BatchedConnection)) {
                 queued_activate(sender, signal_index, c, argv ? argv : empty_argv, locker);
                 continue;
 #ifndef QT_NO_THREAD
@@ -4743,12 +4926,14 @@ bool QObject::disconnect(const QMetaObject::Connection &connection)
 
         QObjectConnectionListVector *connectionLists = QObjectPrivate::get(c->sender)->connectionLists;
         Q_ASSERT(connectionLists);
-        connectionLists->dirty = true;
 
         *c->prev = c->next;
         if (c->next)
             c->next->prev = c->prev;
         c->receiver = 0;
+
+        // the handle still holds a reference, so c stays valid below
+        connectionLists->removeConnection(c);
     }
 
     // destroy the QSlotObject, if possible
@@ -229,7 +229,8 @@ public:
                           "Return type of the slot is not compatible with the return type of the signal.");
 
         const int *types = Q_NULLPTR;
-        if (type == Qt::QueuedConnection || type == Qt::BlockingQueuedConnection)
+        if (type == Qt::QueuedConnection || type == Qt::BlockingQueuedConnection
+                || type == Qt::BatchedConnection)
             types = QtPrivate::ConnectionTypes<typename SignalType::Arguments>::types();
 
         return connectImpl(sender, reinterpret_cast<void **>(&signal),
@@ -269,7 +270,8 @@ public:
                           "Return type of the slot is not compatible with the return type of the signal.");
 
         const int *types = Q_NULLPTR;
-        if (type == Qt::QueuedConnection || type == Qt::BlockingQueuedConnection)
+        if (type == Qt::QueuedConnection || type == Qt::BlockingQueuedConnection
+                || type == Qt::BatchedConnection)
             types = QtPrivate::ConnectionTypes<typename SignalType::Arguments>::types();
 
         return connectImpl(sender, reinterpret_cast<void **>(&signal), context, Q_NULLPTR,
@@ -339,7 +341,8 @@ public:
                           "No Q_OBJECT in the class with the signal");
 
         const int *types = Q_NULLPTR;
-        if (type == Qt::QueuedConnection || type == Qt::BlockingQueuedConnection)
+        if (type == Qt::QueuedConnection || type == Qt::BlockingQueuedConnection
+                || type == Qt::BatchedConnection)
             types = QtPrivate::ConnectionTypes<typename SignalType::Arguments>::types();
 
         return connectImpl(sender, reinterpret_cast<void **>(&signal), context, Q_NULLPTR,
@@ -60,6 +60,7 @@ QT_BEGIN_NAMESPACE
 class QVariant;
 class QThreadData;
 class QObjectConnectionListVector;
+class QMetaCallBatchEvent;
 namespace QtSharedPointer { struct ExternalRefCountData; }
 
 /* for Qt Test */
@@ -125,8 +126,9 @@ public:
             StaticMetaCallFunction callFunction;
             QtPrivate::QSlotObjectBase *slotObj;
         };
-        // The next pointer for the singly-linked ConnectionList
+        // The next and previous pointers for the doubly-linked ConnectionList
         Connection *nextConnectionList;
+        Connection *prevConnectionList;
         //senders linked list
         Connection *next;
         Connection **prev;
@@ -135,10 +137,10 @@ public:
         ushort method_offset;
         ushort method_relative;
         uint signal_index : 27; // In signal range (see QObjectPrivate::signalIndex())
-        ushort connectionType : 3; // 0 == auto, 1 == direct, 2 == queued, 4 == blocking
+        ushort connectionType : 3; // 0 == auto, 1 == direct, 2 == queued, 3 == blocking, 4 == batched
         ushort isSlotObject : 1;
         ushort ownArgumentTypes : 1;
-        Connection() : nextConnectionList(0), ref_(2), ownArgumentTypes(true) {
+        Connection() : nextConnectionList(0), prevConnectionList(0), ref_(2), ownArgumentTypes(true) {
             //ref_ is 2 for the use in the internal lists, and for the use in QMetaObject::Connection
         }
         ~Connection();
@@ -151,7 +153,7 @@ public:
             }
         }
     };
-    // ConnectionList is a singly-linked list
+    // ConnectionList is a doubly-linked list
     struct ConnectionList {
         ConnectionList() : first(0), last(0) {}
         Connection *first;
@@ -233,6 +235,9 @@ public:
     // these objects are all used to indicate that a QObject was deleted
     // plus QPointer, which keeps a separate list
     QAtomicPointer<QtSharedPointer::ExternalRefCountData> sharedRefcount;
+
+    // batched queued calls posted to this object but not being delivered yet
+    QMetaCallBatchEvent *pendingBatch;
 };
 
 
@@ -375,9 +380,27 @@ public:
     inline int signalId() const { return signalId_; }
     inline void **args() const { return args_; }
 
+    void allocateArguments(int nargs, const int *argumentTypes);
+    void setArgument(int index, const void *copy);
+
     virtual void placeMetaCall(QObject *object);
 
 private:
+    bool isInlineArgument(const void *arg) const
+    { return arg >= inlineData_.bytes && arg < inlineData_.bytes + sizeof(inlineData_.bytes); }
+
+    // storage for the arguments of most queued calls, so they need no allocations
+    enum { InlineArgumentCount = 5 };
+    int inlineTypes_[InlineArgumentCount];
+    void *inlineArgs_[InlineArgumentCount];
+    union {
+        char bytes[64];
+        qint64 alignment1;
+        double alignment2;
+        void *alignment3;
+    } inlineData_;
+    int inlineDataUsed_;
+
     QtPrivate::QSlotObjectBase *slotObj_;
     const QObject *sender_;
     int signalId_;
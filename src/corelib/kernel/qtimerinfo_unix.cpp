@@ -46,10 +46,17 @@
 
 #include <sys/times.h>
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 Q_CORE_EXPORT bool qt_disable_lowpriority_timers=false;
 
+static inline qint64 timespecToMsecs(const timespec &ts)
+{
+    return qint64(ts.tv_sec) * 1000 + ts.tv_nsec / (1000 * 1000);
+}
+
 /*
  * Internal functions for manipulating timer data structures.  The
  * timerBitVec array is used for keeping track of timer identifiers.
@@ -77,6 +84,15 @@ QTimerInfoList::QTimerInfoList()
 #endif
 
     firstTimerInfo = 0;
+
+    memset(wheel, 0, sizeof(wheel));
+    memset(wheelOccupied, 0, sizeof(wheelOccupied));
+    wheelTime = timespecToMsecs(updateCurrentTime());
+}
+
+QTimerInfoList::~QTimerInfoList()
+{
+    qDeleteAll(timersById);
 }
 
 timespec QTimerInfoList::updateCurrentTime()
@@ -143,10 +159,17 @@ bool QTimerInfoList::timeChanged(timespec *delta)
 */
 void QTimerInfoList::timerRepair(const timespec &diff)
 {
-    // repair all timers
-    for (int i = 0; i < size(); ++i) {
-        QTimerInfo *t = at(i);
+    // repair all timers; their position on the wheel depends on the
+    // timeout, so the wheel is rebuilt from scratch
+    pendingTimers.clear();
+    memset(wheel, 0, sizeof(wheel));
+    memset(wheelOccupied, 0, sizeof(wheelOccupied));
+    wheelTime = timespecToMsecs(currentTime);
+
+    for (QHash<int, QTimerInfo *>::const_iterator it = timersById.constBegin(); it != timersById.constEnd(); ++it) {
+        QTimerInfo *t = it.value();
         t->timeout = t->timeout + diff;
+        timerInsert(t);
     }
 }
 
@@ -167,18 +190,195 @@ void QTimerInfoList::repairTimersIfNeeded()
 
 #endif
 
+static inline bool timerInfoTimeoutLessThan(const QTimerInfo *t1, const QTimerInfo *t2)
+{
+    return t1->timeout < t2->timeout;
+}
+
 /*
-  insert timer info into list
+  insert timer info into the pending list or onto the wheel
 */
 void QTimerInfoList::timerInsert(QTimerInfo *ti)
 {
-    int index = size();
-    while (index--) {
-        const QTimerInfo * const t = at(index);
-        if (!(ti->timeout < t->timeout))
-            break;
+    if (wheelInsert(ti))
+        return;
+
+    // most timers are due after all the others, so check the end first
+    if (pendingTimers.isEmpty() || !(ti->timeout < pendingTimers.last()->timeout)) {
+        pendingTimers.append(ti);
+        return;
+    }
+    // keep timers with equal timeouts in insertion order
+    QList<QTimerInfo *>::const_iterator it = std::upper_bound(pendingTimers.constBegin(), pendingTimers.constEnd(),
+                                                              ti, timerInfoTimeoutLessThan);
+    pendingTimers.insert(int(it - pendingTimers.constBegin()), ti);
+}
+
+/*
+  Puts the timer into its slot on the wheel. Returns \c false if the timer
+  is due within the current wheel window and belongs on the pending list
+  instead, which is left to the caller.
+*/
+bool QTimerInfoList::wheelInsert(QTimerInfo *ti)
+{
+    const qint64 expires = timespecToMsecs(ti->timeout);
+    const quint64 distance = quint64(expires ^ wheelTime);
+
+    if (expires <= wheelTime || distance < WheelSlots) {
+        ti->slot = -1;
+        ti->next = 0;
+        ti->prev = 0;
+        return false;
+    }
+
+    // the level is given by the highest bit in which the timeout differs
+    // from the wheel time; timers too far away for the wheel go to the
+    // top level and are cascaded again once the wheel has wrapped around
+    const int highestBit = 63 - int(qCountLeadingZeroBits(distance));
+    const int level = qMin<int>(highestBit / WheelLevelBits - 1, WheelLevels - 1);
+    const int index = int(expires >> (WheelLevelBits * (level + 1))) & (WheelSlots - 1);
+
+    ti->slot = level * WheelSlots + index;
+    ti->next = wheel[ti->slot];
+    if (ti->next)
+        ti->next->prev = &ti->next;
+    ti->prev = &wheel[ti->slot];
+    wheel[ti->slot] = ti;
+    wheelOccupied[level] |= Q_UINT64_C(1) << index;
+    return true;
+}
+
+/*
+  remove timer info from the pending list or from the wheel
+*/
+void QTimerInfoList::timerRemove(QTimerInfo *t)
+{
+    if (t->slot < 0) {
+        const int i = timerIndex(t);
+        Q_ASSERT(i != -1);
+        pendingTimers.removeAt(i);
+        return;
+    }
+
+    *t->prev = t->next;
+    if (t->next)
+        t->next->prev = t->prev;
+    if (!wheel[t->slot])
+        wheelOccupied[t->slot / WheelSlots] &= ~(Q_UINT64_C(1) << (t->slot % WheelSlots));
+}
+
+/*
+  Returns the position of \a t in the pending list, using the fact that the
+  list is sorted by timeout, or -1 if it is not in the list.
+*/
+int QTimerInfoList::timerIndex(const QTimerInfo *t) const
+{
+    QList<QTimerInfo *>::const_iterator it = std::lower_bound(pendingTimers.constBegin(), pendingTimers.constEnd(),
+                                                              t, timerInfoTimeoutLessThan);
+    for ( ; it != pendingTimers.constEnd() && !(t->timeout < (*it)->timeout); ++it) {
+        if (*it == t)
+            return int(it - pendingTimers.constBegin());
     }
-    insert(index+1, ti);
+    return -1;
+}
+
+/*
+  Deletes the timer \a t, which must have been removed already.
+*/
+void QTimerInfoList::deleteTimer(QTimerInfo *t)
+{
+    if (t == firstTimerInfo)
+        firstTimerInfo = 0;
+    if (t->activateRef)
+        *(t->activateRef) = 0;
+    delete t;
+}
+
+/*
+  Moves the wheel forward to the current time, cascading the timers of all
+  slots that have been passed down to the lower levels or to the pending list.
+  Must call updateCurrentTime() first!
+*/
+void QTimerInfoList::advanceWheel()
+{
+    const qint64 now = timespecToMsecs(currentTime);
+    if (now <= wheelTime)
+        return;
+
+    QTimerInfo *cascade = 0;
+    for (int level = 0; level < WheelLevels; ++level) {
+        const int shift = WheelLevelBits * (level + 1);
+        const qint64 from = wheelTime >> shift;
+        const qint64 to = now >> shift;
+        if (from == to)
+            break; // the higher levels haven't moved either
+
+        // all slots of this level were passed if the level above moved too
+        quint64 passed = ~Q_UINT64_C(0);
+        if ((from >> WheelLevelBits) == (to >> WheelLevelBits)) {
+            const int first = int(from & (WheelSlots - 1)) + 1;
+            const int last = int(to & (WheelSlots - 1));
+            passed = (~Q_UINT64_C(0) << first) & (~Q_UINT64_C(0) >> (WheelSlots - 1 - last));
+        }
+
+        quint64 occupied = wheelOccupied[level] & passed;
+        wheelOccupied[level] &= ~passed;
+        while (occupied) {
+            QTimerInfo **head = &wheel[level * WheelSlots + qCountTrailingZeroBits(occupied)];
+            occupied &= occupied - 1;
+            for (QTimerInfo *t = *head; t; ) {
+                QTimerInfo *next = t->next;
+                t->next = cascade;
+                cascade = t;
+                t = next;
+            }
+            *head = 0;
+        }
+    }
+
+    wheelTime = now;
+
+    // a whole slot can become due at once, so sort the pending list once
+    // instead of inserting the timers one by one
+    bool needsSort = false;
+    while (cascade) {
+        QTimerInfo *t = cascade;
+        cascade = t->next;
+        if (!wheelInsert(t)) {
+            if (!pendingTimers.isEmpty() && t->timeout < pendingTimers.last()->timeout)
+                needsSort = true;
+            pendingTimers.append(t);
+        }
+    }
+    if (needsSort)
+        std::stable_sort(pendingTimers.begin(), pendingTimers.end(), timerInfoTimeoutLessThan);
+}
+
+/*
+  Returns the timer on the wheel that is due first, or 0 if the wheel is empty.
+*/
+const QTimerInfo *QTimerInfoList::firstWheelTimer() const
+{
+    // every timer on a level is due after all timers on the levels below it
+    for (int level = 0; level < WheelLevels; ++level) {
+        quint64 occupied = wheelOccupied[level];
+        if (!occupied)
+            continue;
+
+        // slots behind the wheel position only exist on the top level,
+        // for timers that are due after the wheel has wrapped around
+        const int position = int(wheelTime >> (WheelLevelBits * (level + 1))) & (WheelSlots - 1);
+        if (const quint64 ahead = occupied & (~Q_UINT64_C(0) << position))
+            occupied = ahead;
+
+        const QTimerInfo *first = wheel[level * WheelSlots + qCountTrailingZeroBits(occupied)];
+        for (const QTimerInfo *t = first->next; t; t = t->next) {
+            if (t->timeout < first->timeout)
+                first = t;
+        }
+        return first;
+    }
+    return 0;
 }
 
 inline timespec &operator+=(timespec &t1, int ms)
@@ -380,16 +580,21 @@ bool QTimerInfoList::timerWait(timespec &tm)
 {
     timespec currentTime = updateCurrentTime();
     repairTimersIfNeeded();
+    advanceWheel();
 
     // Find first waiting timer not already active
-    QTimerInfo *t = 0;
-    for (QTimerInfoList::const_iterator it = constBegin(); it != constEnd(); ++it) {
+    const QTimerInfo *t = 0;
+    for (QList<QTimerInfo *>::const_iterator it = pendingTimers.constBegin(); it != pendingTimers.constEnd(); ++it) {
         if (!(*it)->activateRef) {
             t = *it;
             break;
         }
     }
 
+    // everything on the wheel is due after the pending timers
+    if (!t)
+        t = firstWheelTimer();
+
     if (!t)
       return false;
 
@@ -416,16 +621,13 @@ int QTimerInfoList::timerRemainingTime(int timerId)
     repairTimersIfNeeded();
     timespec tm = {0, 0};
 
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->id == timerId) {
-            if (currentTime < t->timeout) {
-                // time to wait
-                tm = roundToMillisecond(t->timeout - currentTime);
-                return tm.tv_sec*1000 + tm.tv_nsec/1000/1000;
-            } else {
-                return 0;
-            }
+    if (const QTimerInfo *t = timersById.value(timerId)) {
+        if (currentTime < t->timeout) {
+            // time to wait
+            tm = roundToMillisecond(t->timeout - currentTime);
+            return tm.tv_sec*1000 + tm.tv_nsec/1000/1000;
+        } else {
+            return 0;
         }
     }
 
@@ -488,6 +690,7 @@ void QTimerInfoList::registerTimer(int timerId, int interval, Qt::TimerType time
     }
 
     timerInsert(t);
+    timersById.insert(timerId, t);
 
 #ifdef QTIMERINFO_DEBUG
     t->expected = expected;
@@ -501,40 +704,29 @@ void QTimerInfoList::registerTimer(int timerId, int interval, Qt::TimerType time
 
 bool QTimerInfoList::unregisterTimer(int timerId)
 {
-    // set timer inactive
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->id == timerId) {
-            // found it
-            removeAt(i);
-            if (t == firstTimerInfo)
-                firstTimerInfo = 0;
-            if (t->activateRef)
-                *(t->activateRef) = 0;
-            delete t;
-            return true;
-        }
-    }
-    // id not found
-    return false;
+    QTimerInfo *t = timersById.take(timerId);
+    if (!t)
+        return false; // id not found
+
+    timerRemove(t);
+    deleteTimer(t);
+    return true;
 }
 
 bool QTimerInfoList::unregisterTimers(QObject *object)
 {
     if (isEmpty())
         return false;
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
+    QHash<int, QTimerInfo *>::iterator it = timersById.begin();
+    while (it != timersById.end()) {
+        QTimerInfo *t = it.value();
         if (t->obj == object) {
             // object found
-            removeAt(i);
-            if (t == firstTimerInfo)
-                firstTimerInfo = 0;
-            if (t->activateRef)
-                *(t->activateRef) = 0;
-            delete t;
-            // move back one so that we don't skip the new current item
-            --i;
+            it = timersById.erase(it);
+            timerRemove(t);
+            deleteTimer(t);
+        } else {
+            ++it;
         }
     }
     return true;
@@ -543,8 +735,8 @@ bool QTimerInfoList::unregisterTimers(QObject *object)
 QList<QAbstractEventDispatcher::TimerInfo> QTimerInfoList::registeredTimers(QObject *object) const
 {
     QList<QAbstractEventDispatcher::TimerInfo> list;
-    for (int i = 0; i < count(); ++i) {
-        const QTimerInfo * const t = at(i);
+    for (QHash<int, QTimerInfo *>::const_iterator it = timersById.constBegin(); it != timersById.constEnd(); ++it) {
+        const QTimerInfo * const t = it.value();
         if (t->obj == object) {
             list << QAbstractEventDispatcher::TimerInfo(t->id,
                                                         (t->timerType == Qt::VeryCoarseTimer
@@ -570,10 +762,10 @@ int QTimerInfoList::activateTimers()
     timespec currentTime = updateCurrentTime();
     // qDebug() << "Thread" << QThread::currentThreadId() << "woken up at" << currentTime;
     repairTimersIfNeeded();
-
+    advanceWheel();
 
     // Find out how many timer have expired
-    for (QTimerInfoList::const_iterator it = constBegin(); it != constEnd(); ++it) {
+    for (QList<QTimerInfo *>::const_iterator it = pendingTimers.constBegin(); it != pendingTimers.constEnd(); ++it) {
         if (currentTime < (*it)->timeout)
             break;
         maxCount++;
@@ -581,10 +773,10 @@ int QTimerInfoList::activateTimers()
 
     //fire the timers.
     while (maxCount--) {
-        if (isEmpty())
+        if (pendingTimers.isEmpty())
             break;
 
-        QTimerInfo *currentTimerInfo = first();
+        QTimerInfo *currentTimerInfo = pendingTimers.first();
         if (currentTime < currentTimerInfo->timeout)
             break; // no timer has expired
 
@@ -599,7 +791,7 @@ int QTimerInfoList::activateTimers()
         }
 
         // remove from list
-        removeFirst();
+        pendingTimers.removeFirst();
 
 #ifdef QTIMERINFO_DEBUG
         float diff;
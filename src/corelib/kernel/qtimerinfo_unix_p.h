@@ -48,6 +48,7 @@
 // #define QTIMERINFO_DEBUG
 
 #include "qabstracteventdispatcher.h"
+#include "qhash.h"
 
 #include <sys/time.h> // struct timeval
 
@@ -61,6 +62,9 @@ struct QTimerInfo {
     timespec timeout;  // - when to actually fire
     QObject *obj;     // - object to receive event
     QTimerInfo **activateRef; // - ref from activateTimers
+    QTimerInfo *next;  // - next timer in the same wheel slot
+    QTimerInfo **prev; // - link pointing to this timer in its wheel slot
+    int slot;          // - wheel slot, or -1 if on the list of pending timers
 
 #ifdef QTIMERINFO_DEBUG
     timeval expected; // when timer is expected to fire
@@ -69,7 +73,7 @@ struct QTimerInfo {
 #endif
 };
 
-class Q_CORE_EXPORT QTimerInfoList : public QList<QTimerInfo*>
+class Q_CORE_EXPORT QTimerInfoList
 {
 #if ((_POSIX_MONOTONIC_CLOCK-0 <= 0) && !defined(Q_OS_MAC)) || defined(QT_BOOTSTRAPPED)
     timespec previousTime;
@@ -84,8 +88,43 @@ class Q_CORE_EXPORT QTimerInfoList : public QList<QTimerInfo*>
     // state variables used by activateTimers()
     QTimerInfo *firstTimerInfo;
 
+    // all registered timers, for constant time lookups by id
+    QHash<int, QTimerInfo *> timersById;
+
+    // Timers are kept in a hierarchical timing wheel: a timer due in the
+    // same 64 ms window as wheelTime is kept in the sorted pending list,
+    // later timers are hashed into one of the wheel slots by the position
+    // of the highest bit in which their timeout differs from wheelTime.
+    // Each level is 64 times coarser than the one below, and the slots of
+    // a level are cascaded down as wheelTime passes them, so registering
+    // and unregistering a timer is a constant time operation however many
+    // timers exist.
+    enum {
+        WheelLevelBits = 6,
+        WheelSlots = 1 << WheelLevelBits,
+        WheelLevels = 5
+    };
+
+    QList<QTimerInfo *> pendingTimers;
+    QTimerInfo *wheel[WheelLevels * WheelSlots];
+    quint64 wheelOccupied[WheelLevels];
+    qint64 wheelTime;
+
+    int timerIndex(const QTimerInfo *t) const;
+    bool wheelInsert(QTimerInfo *t);
+    void timerRemove(QTimerInfo *t);
+    void deleteTimer(QTimerInfo *t);
+    void advanceWheel();
+    const QTimerInfo *firstWheelTimer() const;
+
+    Q_DISABLE_COPY(QTimerInfoList)
+
 public:
     QTimerInfoList();
+    ~QTimerInfoList();
+
+    bool isEmpty() const { return timersById.isEmpty(); }
+    int size() const { return timersById.size(); }
 
     timespec currentTime;
     timespec updateCurrentTime();
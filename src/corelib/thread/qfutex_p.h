@@ -0,0 +1,112 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Copyright (C) 2012 Intel Corporation
+** Copyright (C) 2012 Olivier Goffart <ogoffart@woboq.com>
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QFUTEX_P_H
+#define QFUTEX_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of qmutex_linux.cpp and qreadwritelock.cpp.  This header file may
+// change from version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qglobal.h>
+#include <QtCore/qatomic.h>
+#include "qmutex_p.h"
+
+#ifdef QT_LINUX_FUTEX
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <errno.h>
+#include <asm/unistd.h>
+#include <time.h>
+#include <limits.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace QtLinuxFutex {
+
+// returns FUTEX_PRIVATE_FLAG if the kernel supports it, 0 otherwise;
+// implemented in qmutex_linux.cpp
+int futexFlags() Q_DECL_NOTHROW;
+
+inline int _q_futex(volatile int *addr, int op, int val, const struct timespec *timeout) Q_DECL_NOTHROW
+{
+    int *addr2 = 0;
+    int val2 = 0;
+
+    // we use __NR_futex because some libcs (like Android's bionic) don't
+    // provide SYS_futex etc.
+    return syscall(__NR_futex, addr, op | futexFlags(), val, timeout, addr2, val2);
+}
+
+inline volatile int *addr(QBasicAtomicInt *ptr) Q_DECL_NOTHROW
+{
+    return reinterpret_cast<volatile int *>(ptr);
+}
+
+// Sleeps while *futex == expectedValue. Returns false only if the timeout
+// expired; spurious wake-ups and value changes return true.
+inline bool futexWait(QBasicAtomicInt &futex, int expectedValue,
+                      const struct timespec *timeout = 0) Q_DECL_NOTHROW
+{
+    int r = _q_futex(addr(&futex), FUTEX_WAIT, expectedValue, timeout);
+    return r == 0 || errno != ETIMEDOUT;
+}
+
+inline void futexWakeOne(QBasicAtomicInt &futex) Q_DECL_NOTHROW
+{
+    _q_futex(addr(&futex), FUTEX_WAKE, 1, 0);
+}
+
+inline void futexWakeAll(QBasicAtomicInt &futex) Q_DECL_NOTHROW
+{
+    _q_futex(addr(&futex), FUTEX_WAKE, INT_MAX, 0);
+}
+
+} // namespace QtLinuxFutex
+
+QT_END_NAMESPACE
+
+#endif // QT_LINUX_FUTEX
+
+#endif // QFUTEX_P_H
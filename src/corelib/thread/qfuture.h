@@ -40,6 +40,7 @@
 
 #include <QtCore/qfutureinterface.h>
 #include <QtCore/qstring.h>
+#include <QtCore/qthreadpool.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -49,6 +50,18 @@ class QFutureWatcher;
 template <>
 class QFutureWatcher<void>;
 
+namespace QtPrivate {
+
+struct Continuations;
+template <typename T, typename Function, typename ResultType>
+class ContinuationTask;
+#ifndef QT_NO_EXCEPTIONS
+template <typename T, typename Function>
+class FailureHandlerTask;
+#endif
+
+} // namespace QtPrivate
+
 template <typename T>
 class QFuture
 {
@@ -143,6 +156,39 @@ public:
     const_iterator end() const { return const_iterator(this, -1); }
     const_iterator constEnd() const { return const_iterator(this, -1); }
 
+#if defined(Q_COMPILER_DECLTYPE) && defined(Q_COMPILER_AUTO_FUNCTION)
+    template <typename Function>
+    auto then(Function function) -> QFuture<decltype(function(QFuture<T>()))>
+    { return then(QThreadPool::globalInstance(), function); }
+
+    template <typename Function>
+    auto then(QThreadPool *pool, Function function) -> QFuture<decltype(function(QFuture<T>()))>
+    {
+        typedef decltype(function(QFuture<T>())) ResultType;
+        QtPrivate::ContinuationTask<T, Function, ResultType> *task =
+            new QtPrivate::ContinuationTask<T, Function, ResultType>(function);
+        QFuture<ResultType> future = task->future();
+        d.addContinuation(task, pool);
+        return future;
+    }
+#endif
+
+#ifndef QT_NO_EXCEPTIONS
+    template <typename Function>
+    QFuture<T> onFailed(Function function)
+    { return onFailed(QThreadPool::globalInstance(), function); }
+
+    template <typename Function>
+    QFuture<T> onFailed(QThreadPool *pool, Function function)
+    {
+        QtPrivate::FailureHandlerTask<T, Function> *task =
+            new QtPrivate::FailureHandlerTask<T, Function>(function);
+        QFuture<T> future = task->future();
+        d.addContinuation(task, pool);
+        return future;
+    }
+#endif
+
 private:
     friend class QFutureWatcher<T>;
 
@@ -233,8 +279,42 @@ public:
     QString progressText() const { return d.progressText(); }
     void waitForFinished() { d.waitForFinished(); }
 
+#if defined(Q_COMPILER_DECLTYPE) && defined(Q_COMPILER_AUTO_FUNCTION)
+    template <typename Function>
+    auto then(Function function) -> QFuture<decltype(function(QFuture<void>()))>
+    { return then(QThreadPool::globalInstance(), function); }
+
+    template <typename Function>
+    auto then(QThreadPool *pool, Function function) -> QFuture<decltype(function(QFuture<void>()))>
+    {
+        typedef decltype(function(QFuture<void>())) ResultType;
+        QtPrivate::ContinuationTask<void, Function, ResultType> *task =
+            new QtPrivate::ContinuationTask<void, Function, ResultType>(function);
+        QFuture<ResultType> future = task->future();
+        d.addContinuation(task, pool);
+        return future;
+    }
+#endif
+
+#ifndef QT_NO_EXCEPTIONS
+    template <typename Function>
+    QFuture<void> onFailed(Function function)
+    { return onFailed(QThreadPool::globalInstance(), function); }
+
+    template <typename Function>
+    QFuture<void> onFailed(QThreadPool *pool, Function function)
+    {
+        QtPrivate::FailureHandlerTask<void, Function> *task =
+            new QtPrivate::FailureHandlerTask<void, Function>(function);
+        QFuture<void> future = task->future();
+        d.addContinuation(task, pool);
+        return future;
+    }
+#endif
+
 private:
     friend class QFutureWatcher<void>;
+    friend struct QtPrivate::Continuations;
 
 #ifdef QFUTURE_TEST
 public:
@@ -259,6 +339,262 @@ QFuture<void> qToVoidFuture(const QFuture<T> &future)
     return QFuture<void>(future.d);
 }
 
+namespace QtPrivate {
+
+struct Continuations
+{
+    template <typename T>
+    static QFutureInterfaceBase &futureInterface(const QFuture<T> &future) { return future.d; }
+
+    // The future of the finished \a parent passed to ContinuationBase::setParent().
+    template <typename T>
+    static QFuture<T> future(const QFutureInterfaceBase &parent) { return QFutureInterface<T>(parent).future(); }
+
+    // Makes \a promise fail the same way as the canceled \a parent did.
+    static void propagateFailure(QFutureInterfaceBase &parent, QFutureInterfaceBase &promise)
+    {
+#ifndef QT_NO_EXCEPTIONS
+        QtPrivate::ExceptionStore &store = parent.exceptionStore();
+        if (store.hasException()) {
+            promise.reportException(*store.exception().exception());
+            return;
+        }
+#endif
+        promise.reportCanceled();
+    }
+
+    template <typename ResultType>
+    struct Invoke
+    {
+        template <typename Function, typename Arg>
+        static void call(QFutureInterface<ResultType> &promise, Function &function, const Arg &arg)
+        { promise.reportResult(function(arg)); }
+    };
+
+    template <typename T>
+    struct Forward
+    {
+        static void results(QFutureInterface<T> &promise, const QFuture<T> &parent)
+        {
+            const QList<T> results = parent.results();
+            if (!results.isEmpty())
+                promise.reportResults(results.toVector());
+        }
+    };
+};
+
+template <>
+struct Continuations::Invoke<void>
+{
+    template <typename Function, typename Arg>
+    static void call(QFutureInterface<void> &, Function &function, const Arg &arg)
+    { function(arg); }
+};
+
+template <>
+struct Continuations::Forward<void>
+{
+    static void results(QFutureInterface<void> &, const QFuture<void> &) { }
+};
+
+template <typename T, typename Function, typename ResultType>
+class ContinuationTask : public ContinuationBase
+{
+public:
+    explicit ContinuationTask(Function function)
+        : function(function)
+    { promise.reportStarted(); }
+
+    QFuture<ResultType> future() { return promise.future(); }
+
+    void setParent(const QFutureInterfaceBase &p) Q_DECL_OVERRIDE
+    { parent = Continuations::future<T>(p); }
+
+    void run() Q_DECL_OVERRIDE
+    {
+        if (parent.isCanceled()) {
+            Continuations::propagateFailure(Continuations::futureInterface(parent), promise);
+            promise.reportFinished();
+            return;
+        }
+#ifndef QT_NO_EXCEPTIONS
+        try {
+#endif
+            Continuations::Invoke<ResultType>::call(promise, function, parent);
+#ifndef QT_NO_EXCEPTIONS
+        } catch (QException &e) {
+            promise.reportException(e);
+        } catch (...) {
+            promise.reportException(QUnhandledException());
+        }
+#endif
+        promise.reportFinished();
+    }
+
+private:
+    QFuture<T> parent;
+    Function function;
+    QFutureInterface<ResultType> promise;
+};
+
+#ifndef QT_NO_EXCEPTIONS
+
+template <typename T, typename Function>
+class FailureHandlerTask : public ContinuationBase
+{
+public:
+    explicit FailureHandlerTask(Function function)
+        : function(function)
+    { promise.reportStarted(); }
+
+    QFuture<T> future() { return promise.future(); }
+
+    void setParent(const QFutureInterfaceBase &p) Q_DECL_OVERRIDE
+    { parent = Continuations::future<T>(p); }
+
+    void run() Q_DECL_OVERRIDE
+    {
+        if (!parent.isCanceled()) {
+            Continuations::Forward<T>::results(promise, parent);
+            promise.reportFinished();
+            return;
+        }
+
+        QtPrivate::ExceptionHolder holder = Continuations::futureInterface(parent).exceptionStore().exception();
+        if (!holder.exception()) {
+            // canceled without an exception; there is nothing to handle
+            promise.reportCanceled();
+            promise.reportFinished();
+            return;
+        }
+
+        try {
+            Continuations::Invoke<T>::call(promise, function, *holder.exception());
+        } catch (QException &e) {
+            promise.reportException(e);
+        } catch (...) {
+            promise.reportException(QUnhandledException());
+        }
+        promise.reportFinished();
+    }
+
+private:
+    QFuture<T> parent;
+    Function function;
+    QFutureInterface<T> promise;
+};
+
+#endif // QT_NO_EXCEPTIONS
+
+template <typename T>
+struct WhenAllState
+{
+    QFutureInterface<QList<QFuture<T> > > promise;
+    // filled in as the futures finish, so that they don't keep the state alive
+    QList<QFuture<T> > futures;
+    QAtomicInt remaining;
+
+    void release()
+    {
+        if (remaining.deref())
+            return;
+        promise.reportResult(futures);
+        promise.reportFinished();
+        delete this;
+    }
+};
+
+template <typename T>
+class WhenAllTask : public ContinuationBase
+{
+public:
+    WhenAllTask(WhenAllState<T> *state, int index) : state(state), index(index) { }
+
+    void setParent(const QFutureInterfaceBase &parent) Q_DECL_OVERRIDE
+    { state->futures[index] = Continuations::future<T>(parent); }
+
+    void run() Q_DECL_OVERRIDE { state->release(); }
+
+private:
+    WhenAllState<T> *state;
+    int index;
+};
+
+struct WhenAnyState
+{
+    QFutureInterface<int> promise;
+    QAtomicInt remaining;
+    QAtomicInt reported;
+};
+
+class WhenAnyTask : public ContinuationBase
+{
+public:
+    WhenAnyTask(WhenAnyState *state, int index) : state(state), index(index) { }
+
+    void setParent(const QFutureInterfaceBase &) Q_DECL_OVERRIDE { }
+
+    void run() Q_DECL_OVERRIDE
+    {
+        if (state->reported.testAndSetRelaxed(0, 1)) {
+            state->promise.reportResult(index);
+            state->promise.reportFinished();
+        }
+        if (!state->remaining.deref())
+            delete state;
+    }
+
+private:
+    WhenAnyState *state;
+    int index;
+};
+
+} // namespace QtPrivate
+
+namespace QtFuture {
+
+template <typename T>
+QFuture<QList<QFuture<T> > > whenAll(const QList<QFuture<T> > &futures)
+{
+    QtPrivate::WhenAllState<T> *state = new QtPrivate::WhenAllState<T>;
+    for (int i = 0; i < futures.count(); ++i)
+        state->futures.append(QFuture<T>());
+    state->remaining.store(futures.count() + 1);
+    state->promise.reportStarted();
+    QFuture<QList<QFuture<T> > > result = state->promise.future();
+
+    for (int i = 0; i < futures.count(); ++i) {
+        QtPrivate::Continuations::futureInterface(futures.at(i))
+            .addContinuation(new QtPrivate::WhenAllTask<T>(state, i), Q_NULLPTR);
+    }
+    // drop the extra count that kept the state alive while registering
+    state->release();
+    return result;
+}
+
+template <typename T>
+QFuture<int> whenAny(const QList<QFuture<T> > &futures)
+{
+    QtPrivate::WhenAnyState *state = new QtPrivate::WhenAnyState;
+    state->remaining.store(futures.count() + 1);
+    state->promise.reportStarted();
+    QFuture<int> result = state->promise.future();
+
+    for (int i = 0; i < futures.count(); ++i) {
+        QtPrivate::Continuations::futureInterface(futures.at(i))
+            .addContinuation(new QtPrivate::WhenAnyTask(state, i), Q_NULLPTR);
+    }
+    if (futures.isEmpty()) {
+        state->promise.reportResult(-1);
+        state->promise.reportFinished();
+    }
+    if (!state->remaining.deref())
+        delete state;
+    return result;
+}
+
+} // namespace QtFuture
+
 QT_END_NAMESPACE
 
 #endif // QT_NO_QFUTURE
@@ -83,6 +83,9 @@ void QFutureInterfaceBase::cancel()
     if (d->state & Canceled)
         return;
 
+    // results reported before the cancellation are kept
+    d->internal_flushPendingResults();
+
     d->state = State((d->state & ~Paused) | Canceled);
     d->waitCondition.wakeAll();
     d->pausedWaitCondition.wakeAll();
@@ -193,6 +196,11 @@ void QFutureInterfaceBase::waitForResume()
 
 int QFutureInterfaceBase::progressValue() const
 {
+    // results reported without the mutex advance the progress when they are flushed
+    if (d->pendingResults.load() && !d->manualProgress) {
+        QMutexLocker lock(&d->m_mutex);
+        d->internal_flushPendingResults();
+    }
     return d->m_progressValue;
 }
 
@@ -246,6 +254,7 @@ void QFutureInterfaceBase::reportException(const QException &exception)
     if ((d->state & Canceled) || (d->state & Finished))
         return;
 
+    d->internal_flushPendingResults();
     d->m_exceptionStore.setException(exception);
     d->state = State(d->state | Canceled);
     d->waitCondition.wakeAll();
@@ -256,12 +265,19 @@ void QFutureInterfaceBase::reportException(const QException &exception)
 
 void QFutureInterfaceBase::reportFinished()
 {
+    QList<QFutureInterfaceBasePrivate::Continuation> continuations;
     QMutexLocker locker(&d->m_mutex);
     if (!(d->state & Finished)) {
+        d->internal_flushPendingResults();
         d->state = State((d->state & ~Running) | Finished);
         d->waitCondition.wakeAll();
         d->sendCallOut(QFutureCallOutEvent(QFutureCallOutEvent::Finished));
+        continuations.swap(d->continuations);
     }
+    locker.unlock();
+
+    for (int i = 0; i < continuations.count(); ++i)
+        QFutureInterfaceBasePrivate::startContinuation(continuations.at(i).first, continuations.at(i).second, *this);
 }
 
 void QFutureInterfaceBase::setExpectedResultCount(int resultCount)
@@ -300,8 +316,10 @@ void QFutureInterfaceBase::waitForResult(int resultIndex)
         return;
 
     const int waitIndex = (resultIndex == -1) ? INT_MAX : resultIndex;
+    d->internal_addResultListener();
     while ((d->state & Running) && d->internal_isResultReadyAt(waitIndex) == false)
         d->waitCondition.wait(&d->m_mutex);
+    d->internal_removeResultListener();
 
     d->m_exceptionStore.throwPossibleException();
 }
@@ -326,28 +344,26 @@ void QFutureInterfaceBase::waitForFinished()
 
 void QFutureInterfaceBase::reportResultsReady(int beginIndex, int endIndex)
 {
-    if ((d->state & Canceled) || (d->state & Finished) || beginIndex == endIndex)
-        return;
-
-    d->waitCondition.wakeAll();
+    d->internal_reportResultsReady(beginIndex, endIndex);
+}
 
-    if (d->manualProgress == false) {
-        if (d->internal_updateProgress(d->m_progressValue + endIndex - beginIndex) == false) {
-            d->sendCallOut(QFutureCallOutEvent(QFutureCallOutEvent::ResultsReady,
-                                               beginIndex,
-                                               endIndex));
-            return;
-        }
+bool QFutureInterfaceBase::canReportWithoutLock() const
+{
+    return !(d->state & (Canceled | Finished)) && !d->m_results.filterMode();
+}
 
-        d->sendCallOuts(QFutureCallOutEvent(QFutureCallOutEvent::Progress,
-                                            d->m_progressValue,
-                                            d->m_progressText),
-                        QFutureCallOutEvent(QFutureCallOutEvent::ResultsReady,
-                                            beginIndex,
-                                            endIndex));
-        return;
+// Hands the result or vector of results that \a link belongs to over to the
+// store without taking the mutex. \a link is part of the ResultHolder that
+// holds the result, which the store takes ownership of. Must not be used in
+// filter mode.
+void QFutureInterfaceBase::reportResultWithoutLock(QtPrivate::ResultLink *link)
+{
+    if (d->pushPendingResult(link)) {
+        // someone is waiting for results, tell them now; results pushed
+        // while this thread waits for the mutex are flushed with this one
+        QMutexLocker locker(&d->m_mutex);
+        d->internal_flushPendingResults();
     }
-    d->sendCallOut(QFutureCallOutEvent(QFutureCallOutEvent::ResultsReady, beginIndex, endIndex));
 }
 
 void QFutureInterfaceBase::setRunnable(QRunnable *runnable)
@@ -360,10 +376,34 @@ void QFutureInterfaceBase::setThreadPool(QThreadPool *pool)
     d->m_pool = pool;
 }
 
+/*
+    Starts \a continuation on \a pool once this future has finished, or right
+    away if it has finished already. If \a pool is null, the continuation is
+    run by the thread that finishes the future instead. Continuations do not
+    go through the event loop, so they work without one and are not delayed
+    by a busy main thread.
+
+    The continuation is only given this future, with setParent(), when it is
+    started, so that the two do not keep each other alive. If the future is
+    destroyed without having finished, the continuation is started with a
+    canceled future instead.
+*/
+void QFutureInterfaceBase::addContinuation(QtPrivate::ContinuationBase *continuation, QThreadPool *pool)
+{
+    QMutexLocker locker(&d->m_mutex);
+    if (!(d->state & Finished)) {
+        d->continuations.append(qMakePair(continuation, pool));
+        return;
+    }
+    locker.unlock();
+    QFutureInterfaceBasePrivate::startContinuation(continuation, pool, *this);
+}
+
 void QFutureInterfaceBase::setFilterMode(bool enable)
 {
     QMutexLocker locker(&d->m_mutex);
-    resultStoreBase().setFilterMode(enable);
+    d->internal_flushPendingResults();
+    d->m_results.setFilterMode(enable);
 }
 
 void QFutureInterfaceBase::setProgressRange(int minimum, int maximum)
@@ -408,13 +448,16 @@ QtPrivate::ExceptionStore &QFutureInterfaceBase::exceptionStore()
     return d->m_exceptionStore;
 }
 
+// The mutex must be held, results reported without it are moved into the store first.
 QtPrivate::ResultStoreBase &QFutureInterfaceBase::resultStoreBase()
 {
+    d->internal_flushPendingResults();
     return d->m_results;
 }
 
 const QtPrivate::ResultStoreBase &QFutureInterfaceBase::resultStoreBase() const
 {
+    d->internal_flushPendingResults();
     return d->m_results;
 }
 
@@ -440,32 +483,154 @@ bool QFutureInterfaceBase::derefT() const
 QFutureInterfaceBasePrivate::QFutureInterfaceBasePrivate(QFutureInterfaceBase::State initialState)
     : refCount(1), m_progressValue(0), m_progressMinimum(0), m_progressMaximum(0),
       state(initialState),
-      manualProgress(false), m_expectedResultCount(0), runnable(0), m_pool(0)
+      manualProgress(false), m_expectedResultCount(0), runnable(0), m_pool(0),
+      pendingResults(0), resultListeners(0)
 {
     progressTime.invalidate();
 }
 
-int QFutureInterfaceBasePrivate::internal_resultCount() const
+QFutureInterfaceBasePrivate::~QFutureInterfaceBasePrivate()
+{
+    // pending results are owned by the ResultStore<T>, which has flushed
+    // them when it was cleared
+    Q_ASSERT(!untagged(pendingResults.load()));
+
+    if (!continuations.isEmpty()) {
+        // nobody can finish the future any more
+        const QFutureInterfaceBase canceled(QFutureInterfaceBase::State(
+                QFutureInterfaceBase::Started | QFutureInterfaceBase::Finished | QFutureInterfaceBase::Canceled));
+        for (int i = 0; i < continuations.count(); ++i)
+            startContinuation(continuations.at(i).first, continuations.at(i).second, canceled);
+    }
+}
+
+void QFutureInterfaceBasePrivate::startContinuation(QtPrivate::ContinuationBase *continuation,
+                                                    QThreadPool *pool,
+                                                    const QFutureInterfaceBase &parent)
 {
+    continuation->setParent(parent);
+    if (pool) {
+        pool->start(continuation);
+        return;
+    }
+    const bool autoDelete = continuation->autoDelete();
+    continuation->run();
+    if (autoDelete)
+        delete continuation;
+}
+
+int QFutureInterfaceBasePrivate::internal_resultCount()
+{
+    internal_flushPendingResults();
     return m_results.count(); // ### subtract canceled results.
 }
 
-bool QFutureInterfaceBasePrivate::internal_isResultReadyAt(int index) const
+bool QFutureInterfaceBasePrivate::internal_isResultReadyAt(int index)
 {
+    internal_flushPendingResults();
     return (m_results.contains(index));
 }
 
+// Moves the results pushed by reportResultWithoutLock() into m_results in
+// the order they were reported, and reports them as ready.
+void QFutureInterfaceBasePrivate::internal_flushPendingResults()
+{
+    if (!untagged(pendingResults.load()))
+        return;
+
+    // the tag only changes under the mutex, so it is safe to keep it like this
+    QtPrivate::ResultLink *head = pendingResults.fetchAndStoreAcquire(
+                reinterpret_cast<QtPrivate::ResultLink *>(quintptr(resultListeners ? ListenedTag : 0)));
+    QtPrivate::ResultLink *link = untagged(head);
+    QtPrivate::ResultLink *oldest = 0;
+    while (link) {
+        QtPrivate::ResultLink *next = link->next;
+        link->next = oldest;
+        oldest = link;
+        link = next;
+    }
+
+    // the links are part of the results, so read them before the store
+    // owns them
+    while (oldest) {
+        QtPrivate::ResultLink *next = oldest->next;
+        const int index = oldest->index;
+        const QtPrivate::ResultItem item = oldest->item;
+        const int insertIndex = item.isVector()
+                ? m_results.addResults(index, item.result, item.m_count, item.m_count)
+                : m_results.addResult(index, item.result);
+        internal_reportResultsReady(insertIndex, insertIndex + item.count());
+        oldest = next;
+    }
+}
+
+// While there are listeners, reporters flush their results under the mutex
+// instead of leaving them for the next reader.
+void QFutureInterfaceBasePrivate::internal_addResultListener()
+{
+    if (resultListeners++)
+        return;
+    QtPrivate::ResultLink *head = pendingResults.load();
+    while (!pendingResults.testAndSetOrdered(head,
+                reinterpret_cast<QtPrivate::ResultLink *>(quintptr(head) | ListenedTag), head))
+        ;
+    // results pushed before the tag was set have nobody to flush them
+    internal_flushPendingResults();
+}
+
+void QFutureInterfaceBasePrivate::internal_removeResultListener()
+{
+    Q_ASSERT(resultListeners > 0);
+    if (--resultListeners)
+        return;
+    QtPrivate::ResultLink *head = pendingResults.load();
+    while (!pendingResults.testAndSetOrdered(head, untagged(head), head))
+        ;
+}
+
 bool QFutureInterfaceBasePrivate::internal_waitForNextResult()
 {
+    internal_flushPendingResults();
     if (m_results.hasNextResult())
         return true;
 
-    while ((state & QFutureInterfaceBase::Running) && m_results.hasNextResult() == false)
+    internal_addResultListener();
+    while ((state & QFutureInterfaceBase::Running) && m_results.hasNextResult() == false) {
         waitCondition.wait(&m_mutex);
+        internal_flushPendingResults();
+    }
+    internal_removeResultListener();
 
     return (!(state & QFutureInterfaceBase::Canceled) && m_results.hasNextResult());
 }
 
+void QFutureInterfaceBasePrivate::internal_reportResultsReady(int beginIndex, int endIndex)
+{
+    if ((state & QFutureInterfaceBase::Canceled) || (state & QFutureInterfaceBase::Finished)
+        || beginIndex == endIndex)
+        return;
+
+    waitCondition.wakeAll();
+
+    if (manualProgress == false) {
+        if (internal_updateProgress(m_progressValue + endIndex - beginIndex) == false) {
+            sendCallOut(QFutureCallOutEvent(QFutureCallOutEvent::ResultsReady,
+                                            beginIndex,
+                                            endIndex));
+            return;
+        }
+
+        sendCallOuts(QFutureCallOutEvent(QFutureCallOutEvent::Progress,
+                                         m_progressValue,
+                                         m_progressText),
+                     QFutureCallOutEvent(QFutureCallOutEvent::ResultsReady,
+                                         beginIndex,
+                                         endIndex));
+        return;
+    }
+    sendCallOut(QFutureCallOutEvent(QFutureCallOutEvent::ResultsReady, beginIndex, endIndex));
+}
+
 bool QFutureInterfaceBasePrivate::internal_updateProgress(int progress,
                                                           const QString &progressText)
 {
@@ -540,6 +705,7 @@ void QFutureInterfaceBasePrivate::connectOutputInterface(QFutureCallOutInterface
                                                         m_progressText));
     }
 
+    internal_flushPendingResults();
     QtPrivate::ResultIteratorBase it = m_results.begin();
     while (it != m_results.end()) {
         const int begin = it.resultIndex();
@@ -560,6 +726,7 @@ void QFutureInterfaceBasePrivate::connectOutputInterface(QFutureCallOutInterface
         interface->postCallOutEvent(QFutureCallOutEvent(QFutureCallOutEvent::Finished));
 
     outputConnections.append(interface);
+    internal_addResultListener();
 }
 
 void QFutureInterfaceBasePrivate::disconnectOutputInterface(QFutureCallOutInterface *interface)
@@ -569,6 +736,7 @@ void QFutureInterfaceBasePrivate::disconnectOutputInterface(QFutureCallOutInterf
     if (index == -1)
         return;
     outputConnections.removeAt(index);
+    internal_removeResultListener();
 
     interface->callOutInterfaceDisconnected();
 }
@@ -47,6 +47,9 @@ QT_BEGIN_NAMESPACE
 
 template <typename T> class QFuture;
 class QThreadPool;
+namespace QtPrivate {
+class ContinuationBase;
+}
 class QFutureInterfaceBasePrivate;
 class QFutureWatcherBase;
 class QFutureWatcherBasePrivate;
@@ -79,6 +82,7 @@ public:
 
     void setRunnable(QRunnable *runnable);
     void setThreadPool(QThreadPool *pool);
+    void addContinuation(QtPrivate::ContinuationBase *continuation, QThreadPool *pool);
     void setFilterMode(bool enable);
     void setProgressRange(int minimum, int maximum);
     int progressMinimum() const;
@@ -124,6 +128,8 @@ public:
 protected:
     bool refT() const;
     bool derefT() const;
+    bool canReportWithoutLock() const;
+    void reportResultWithoutLock(QtPrivate::ResultLink *link);
 public:
 
 #ifndef QFUTURE_TEST
@@ -136,6 +142,18 @@ private:
     friend class QFutureWatcherBasePrivate;
 };
 
+namespace QtPrivate {
+
+// A runnable that continues a future; see QFutureInterfaceBase::addContinuation().
+class ContinuationBase : public QRunnable
+{
+public:
+    // Called with the finished future right before the continuation starts.
+    virtual void setParent(const QFutureInterfaceBase &parent) = 0;
+};
+
+} // namespace QtPrivate
+
 template <typename T>
 class QFutureInterface : public QFutureInterfaceBase
 {
@@ -150,6 +168,11 @@ public:
     {
         refT();
     }
+    explicit QFutureInterface(const QFutureInterfaceBase &other) // internal
+        : QFutureInterfaceBase(other)
+    {
+        refT();
+    }
     ~QFutureInterface()
     {
         if (!derefT())
@@ -188,6 +211,14 @@ private:
 template <typename T>
 inline void QFutureInterface<T>::reportResult(const T *result, int index)
 {
+    if (result && this->canReportWithoutLock()) {
+        QtPrivate::ResultHolder<T> *holder = new QtPrivate::ResultHolder<T>(*result);
+        holder->link.index = index;
+        holder->link.item = QtPrivate::ResultItem(&holder->value);
+        this->reportResultWithoutLock(&holder->link);
+        return;
+    }
+
     QMutexLocker locker(mutex());
     if (this->queryState(Canceled) || this->queryState(Finished)) {
         return;
@@ -215,6 +246,14 @@ inline void QFutureInterface<T>::reportResult(const T &result, int index)
 template <typename T>
 inline void QFutureInterface<T>::reportResults(const QVector<T> &_results, int beginIndex, int count)
 {
+    if (!_results.isEmpty() && this->canReportWithoutLock()) {
+        QtPrivate::ResultHolder<QVector<T> > *holder = new QtPrivate::ResultHolder<QVector<T> >(_results);
+        holder->link.index = beginIndex;
+        holder->link.item = QtPrivate::ResultItem(&holder->value, _results.count());
+        this->reportResultWithoutLock(&holder->link);
+        return;
+    }
+
     QMutexLocker locker(mutex());
     if (this->queryState(Canceled) || this->queryState(Finished)) {
         return;
@@ -285,6 +324,9 @@ public:
     QFutureInterface<void>(const QFutureInterface<void> &other)
         : QFutureInterfaceBase(other)
     { }
+    explicit QFutureInterface<void>(const QFutureInterfaceBase &other) // internal
+        : QFutureInterfaceBase(other)
+    { }
 
     static QFutureInterface<void> canceledResult()
     { return QFutureInterface(State(Started | Finished | Canceled)); }
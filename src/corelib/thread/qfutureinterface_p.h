@@ -48,6 +48,7 @@
 #include <QtCore/qelapsedtimer.h>
 #include <QtCore/qcoreevent.h>
 #include <QtCore/qlist.h>
+#include <QtCore/qpair.h>
 #include <QtCore/qwaitcondition.h>
 #include <QtCore/qrunnable.h>
 #include <QtCore/qthreadpool.h>
@@ -121,6 +122,7 @@ class QFutureInterfaceBasePrivate
 {
 public:
     QFutureInterfaceBasePrivate(QFutureInterfaceBase::State initialState);
+    ~QFutureInterfaceBasePrivate();
 
     // When the last QFuture<T> reference is removed, we need to make
     // sure that data stored in the ResultStore is cleaned out.
@@ -164,13 +166,51 @@ public:
     QRunnable *runnable;
     QThreadPool *m_pool;
 
+    // Runnables added with addContinuation(), started once the future finishes.
+    // A null pool means the continuation runs in the thread that finished it.
+    typedef QPair<QtPrivate::ContinuationBase *, QThreadPool *> Continuation;
+    QList<Continuation> continuations;
+
+    // Results reported outside filter mode are pushed onto this lock-free
+    // stack by reportResultWithoutLock(). Whoever holds the mutex next moves
+    // them into m_results with internal_flushPendingResults(). Bit 0 of the
+    // pointer is set while resultListeners is non-zero. Then the reporter
+    // that pushes onto an empty stack flushes it under the mutex, so that
+    // waiters and watchers hear about the results right away; reporters
+    // that push behind it leave their results to that flush.
+    QAtomicPointer<QtPrivate::ResultLink> pendingResults;
+    int resultListeners; // protected by m_mutex
+
+    enum { ListenedTag = 0x1 };
+
+    static inline QtPrivate::ResultLink *untagged(QtPrivate::ResultLink *p)
+    { return reinterpret_cast<QtPrivate::ResultLink *>(quintptr(p) & ~quintptr(ListenedTag)); }
+    static inline bool isListened(QtPrivate::ResultLink *p)
+    { return quintptr(p) & ListenedTag; }
+
+    // returns true if the caller has to flush the pending results
+    bool pushPendingResult(QtPrivate::ResultLink *link)
+    {
+        QtPrivate::ResultLink *head = pendingResults.load();
+        QtPrivate::ResultLink *tagged;
+        do {
+            link->next = untagged(head);
+            tagged = reinterpret_cast<QtPrivate::ResultLink *>(quintptr(link) | (quintptr(head) & ListenedTag));
+        } while (!pendingResults.testAndSetRelease(head, tagged, head));
+        return isListened(head) && !untagged(head);
+    }
+
     inline QThreadPool *pool() const
     { return m_pool ? m_pool : QThreadPool::globalInstance(); }
 
     // Internal functions that does not change the mutex state.
     // The mutex must be locked when calling these.
-    int internal_resultCount() const;
-    bool internal_isResultReadyAt(int index) const;
+    int internal_resultCount();
+    bool internal_isResultReadyAt(int index);
+    void internal_flushPendingResults();
+    void internal_addResultListener();
+    void internal_removeResultListener();
+    void internal_reportResultsReady(int beginIndex, int endIndex);
     bool internal_waitForNextResult();
     bool internal_updateProgress(int progress, const QString &progressText = QString());
     void internal_setThrottled(bool enable);
@@ -180,6 +220,9 @@ public:
     void disconnectOutputInterface(QFutureCallOutInterface *iface);
 
     void setState(QFutureInterfaceBase::State state);
+
+    static void startContinuation(QtPrivate::ContinuationBase *continuation, QThreadPool *pool,
+                                  const QFutureInterfaceBase &parent);
 };
 
 QT_END_NAMESPACE
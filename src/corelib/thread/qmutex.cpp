@@ -552,7 +552,7 @@ void QBasicMutex::unlockInternal() Q_DECL_NOTHROW
 //The freelist management
 namespace {
 struct FreeListConstants : QFreeListDefaultConstants {
-    enum { BlockCount = 4, MaxIndex=0xffff };
+    enum { BlockCount = 4, MaxIndex=0xffff, MagazineSize = 16 };
     static const int Sizes[BlockCount];
 };
 const int FreeListConstants::Sizes[FreeListConstants::BlockCount] = {
@@ -38,13 +38,12 @@
 #ifndef QT_NO_THREAD
 #include "qatomic.h"
 #include "qmutex_p.h"
+#include "qfutex_p.h"
 #include "qelapsedtimer.h"
+#include "qthread.h"
 
-#include <linux/futex.h>
-#include <sys/syscall.h>
-#include <unistd.h>
-#include <errno.h>
-#include <asm/unistd.h>
+#include <limits.h>
+#include <stdlib.h>
 
 #ifndef QT_LINUX_FUTEX
 # error "Qt build is broken: qmutex_linux.cpp is being built but futex support is not wanted"
@@ -94,6 +93,16 @@ QT_BEGIN_NAMESPACE
  * If it fails, unlockInternal() is called. The only possibility is that the
  * mutex value was 0x3, which indicates some other thread is waiting or was
  * waiting in the past. We then set the mutex to 0x0 and perform a FUTEX_WAKE.
+ *
+ * SPINNING:
+ *
+ * Before setting the waiting bit, lockInternal spins for a short while
+ * according to QMutexSpinPolicy, trying to take the mutex from 0x0 to 0x1.
+ * Critical sections are usually short, so the owner often releases the
+ * mutex before a sleep/wake-up round trip through the kernel would
+ * complete. A thread that acquires the mutex this way while others are
+ * asleep does not lose their wake-up: the woken thread sets the value
+ * back to 0x3 before sleeping again.
  */
 
 static QBasicAtomicInt futexFlagSupport = Q_BASIC_ATOMIC_INITIALIZER(-1);
@@ -124,7 +133,7 @@ static int checkFutexPrivateSupport()
     return value;
 }
 
-static inline int futexFlags()
+int QtLinuxFutex::futexFlags() Q_DECL_NOTHROW
 {
     int value = futexFlagSupport.load();
     if (Q_LIKELY(value != -1))
@@ -138,12 +147,7 @@ static inline int _q_futex(void *addr, int op, int val, const struct timespec *t
 #if Q_BYTE_ORDER == Q_BIG_ENDIAN && QT_POINTER_SIZE == 8
     int_addr++; //We want a pointer to the 32 least significant bit of QMutex::d
 #endif
-    int *addr2 = 0;
-    int val2 = 0;
-
-    // we use __NR_futex because some libcs (like Android's bionic) don't
-    // provide SYS_futex etc.
-    return syscall(__NR_futex, int_addr, op | futexFlags(), val, timeout, addr2, val2);
+    return QtLinuxFutex::_q_futex(int_addr, op, val, timeout);
 }
 
 static inline QMutexData *dummyFutexValue()
@@ -151,6 +155,75 @@ static inline QMutexData *dummyFutexValue()
     return reinterpret_cast<QMutexData *>(quintptr(3));
 }
 
+static QBasicAtomicInt mutexSpinLimit = Q_BASIC_ATOMIC_INITIALIZER(-1);
+
+int QMutexSpinPolicy::spinLimit() Q_DECL_NOTHROW
+{
+    int limit = mutexSpinLimit.loadAcquire();
+    if (Q_LIKELY(limit >= 0))
+        return limit;
+
+    // Not qEnvironmentVariableIntValue(): it locks a QBasicMutex, which may
+    // be the contended one we are called for.
+    limit = -1;
+    if (const char *env = ::getenv("QT_MUTEX_SPIN_LIMIT")) {
+        char *end;
+        const long value = ::strtol(env, &end, 0);
+        if (end != env && !*end && value >= 0 && value <= INT_MAX)
+            limit = int(value);
+    }
+    if (limit < 0)
+        limit = QThread::idealThreadCount() > 1 ? int(DefaultSpinLimit) : 0;
+    mutexSpinLimit.storeRelease(limit);
+    return limit;
+}
+
+void QMutexSpinPolicy::setSpinLimit(int limit) Q_DECL_NOTHROW
+{
+    mutexSpinLimit.storeRelease(qMax(limit, -1));
+}
+
+#ifdef Q_COMPILER_THREAD_LOCAL
+static thread_local int currentSpinBudget = -1;
+#endif
+
+int QMutexSpinPolicy::spinBudget() Q_DECL_NOTHROW
+{
+    const int limit = spinLimit();
+#ifdef Q_COMPILER_THREAD_LOCAL
+    if (currentSpinBudget >= 0 && currentSpinBudget < limit)
+        return currentSpinBudget;
+#endif
+    return limit;
+}
+
+void QMutexSpinPolicy::adaptSpinBudget(bool acquired) Q_DECL_NOTHROW
+{
+#ifdef Q_COMPILER_THREAD_LOCAL
+    const int budget = spinBudget();
+    if (acquired)
+        currentSpinBudget = qMin(budget * 2, spinLimit());
+    else
+        currentSpinBudget = qMax(budget / 2, qMin(int(MinimumBudget), spinLimit()));
+#else
+    Q_UNUSED(acquired);
+#endif
+}
+
+namespace {
+struct MutexTryLock
+{
+    QBasicAtomicPointer<QMutexData> &d_ptr;
+
+    bool operator()() const Q_DECL_NOTHROW
+    {
+        // same value as QBasicMutex::dummyLocked()
+        return d_ptr.load() == 0
+                && d_ptr.testAndSetAcquire(0, reinterpret_cast<QMutexData *>(quintptr(1)));
+    }
+};
+} // unnamed namespace
+
 template <bool IsTimed> static inline
 bool lockInternal_helper(QBasicAtomicPointer<QMutexData> &d_ptr, int timeout = -1, QElapsedTimer *elapsedTimer = 0) Q_DECL_NOTHROW
 {
@@ -161,6 +234,10 @@ bool lockInternal_helper(QBasicAtomicPointer<QMutexData> &d_ptr, int timeout = -
     if (timeout == 0)
         return false;
 
+    const MutexTryLock tryLock = { d_ptr };
+    if (QMutexSpinPolicy::spin(tryLock))
+        return true;
+
     struct timespec ts, *pts = 0;
     if (IsTimed && timeout > 0) {
         ts.tv_sec = timeout / 1000;
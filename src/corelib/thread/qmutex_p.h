@@ -130,6 +130,69 @@ public:
 };
 #endif //QT_LINUX_FUTEX
 
+#ifdef QT_LINUX_FUTEX
+// tells the CPU we are in a spin-wait loop
+static inline void qYieldCpu() Q_DECL_NOTHROW
+{
+#if defined(Q_CC_GNU) && defined(Q_PROCESSOR_X86)
+    __builtin_ia32_pause();
+#elif defined(Q_CC_GNU) && defined(Q_PROCESSOR_ARM) && Q_PROCESSOR_ARM >= 7
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+/*
+ * Spinning phase of the futex-based locks (QMutex and QReadWriteLock).
+ *
+ * A thread that finds the lock taken retries for a while, executing an
+ * exponentially growing number of pause instructions between attempts,
+ * before it goes to sleep in the kernel. Each thread adapts its own spin
+ * budget: it doubles whenever spinning acquired the lock and halves
+ * whenever the thread had to sleep anyway. The budget is capped by the
+ * global spin limit, which defaults to 0 (no spinning) on single-CPU
+ * machines and can be overridden with the QT_MUTEX_SPIN_LIMIT environment
+ * variable or setSpinLimit().
+ */
+class Q_CORE_EXPORT QMutexSpinPolicy
+{
+public:
+    enum {
+        DefaultSpinLimit = 256,
+        MinimumBudget = 8,
+        MaximumBackoff = 16
+    };
+
+    static int spinLimit() Q_DECL_NOTHROW;
+    static void setSpinLimit(int limit) Q_DECL_NOTHROW; // negative restores the default
+
+    // tryLock is called between the pauses and returns true if it acquired the lock
+    template <typename TryLock>
+    static bool spin(const TryLock &tryLock) Q_DECL_NOTHROW
+    {
+        const int budget = spinBudget();
+        if (budget <= 0)
+            return false;
+
+        int pauses = 1;
+        for (int spun = 0; spun < budget; spun += pauses) {
+            for (int i = 0; i < pauses; ++i)
+                qYieldCpu();
+            if (tryLock()) {
+                adaptSpinBudget(true);
+                return true;
+            }
+            if (pauses < MaximumBackoff)
+                pauses *= 2;
+        }
+        adaptSpinBudget(false);
+        return false;
+    }
+
+private:
+    static int spinBudget() Q_DECL_NOTHROW;
+    static void adaptSpinBudget(bool acquired) Q_DECL_NOTHROW;
+};
+#endif // QT_LINUX_FUTEX
 
 #ifdef Q_OS_UNIX
 // helper functions for qmutex_unix.cpp and qwaitcondition_unix.cpp
@@ -38,11 +38,210 @@
 #include "qmutex.h"
 #include "qthread.h"
 #include "qwaitcondition.h"
+#include "qelapsedtimer.h"
 
 #include "qreadwritelock_p.h"
+#ifdef QT_LINUX_FUTEX
+#  include "qfutex_p.h"
+#endif
 
 QT_BEGIN_NAMESPACE
 
+#ifdef QT_LINUX_FUTEX
+// returns false if the timeout has already expired
+static bool remainingTime(int timeout, const QElapsedTimer &timer, struct timespec *ts) Q_DECL_NOTHROW
+{
+    qint64 remaining = qint64(timeout) * 1000 * 1000 - timer.nsecsElapsed();
+    if (remaining <= 0)
+        return false;
+    ts->tv_sec = remaining / (Q_INT64_C(1000) * 1000 * 1000);
+    ts->tv_nsec = remaining % (Q_INT64_C(1000) * 1000 * 1000);
+    return true;
+}
+
+static inline bool canLockForRead(uint s) Q_DECL_NOTHROW
+{
+    // readers also give way to waiting writers, so that those don't starve
+    return !(s & (QReadWriteLockPrivate::WriterHeld | QReadWriteLockPrivate::WaitingWritersMask));
+}
+
+static inline bool canLockForWrite(uint s) Q_DECL_NOTHROW
+{
+    return !(s & (QReadWriteLockPrivate::WriterHeld | QReadWriteLockPrivate::ReaderMask));
+}
+
+namespace {
+struct ReadTryLock
+{
+    QBasicAtomicInteger<uint> &state;
+
+    bool operator()() const Q_DECL_NOTHROW
+    {
+        uint s = state.load();
+        return canLockForRead(s) && state.testAndSetAcquire(s, s + 1);
+    }
+};
+
+struct WriteTryLock
+{
+    QBasicAtomicInteger<uint> &state;
+
+    bool operator()() const Q_DECL_NOTHROW
+    {
+        uint s = state.load();
+        return canLockForWrite(s) && state.testAndSetAcquire(s, s | QReadWriteLockPrivate::WriterHeld);
+    }
+};
+} // unnamed namespace
+
+bool QReadWriteLockPrivate::lockForReadFutex(int timeout) Q_DECL_NOTHROW
+{
+    uint s = state.load();
+    while (canLockForRead(s)) {
+        Q_ASSERT_X((s & ReaderMask) != ReaderMask, "QReadWriteLock::lockForRead()",
+                   "Overflow in lock counter");
+        if (state.testAndSetAcquire(s, s + 1, s))
+            return true;
+    }
+    if (timeout == 0)
+        return false;
+
+    const ReadTryLock tryLock = { state };
+    if (QMutexSpinPolicy::spin(tryLock))
+        return true;
+
+    QElapsedTimer timer;
+    if (timeout > 0)
+        timer.start();
+
+    struct timespec ts;
+    forever {
+        // read the sequence number before checking the state: whoever makes
+        // the lock available again changes it before waking us up
+        int seq = readerSeq.loadAcquire();
+        s = state.loadAcquire();
+        if (canLockForRead(s)) {
+            if (state.testAndSetAcquire(s, s + 1))
+                return true;
+            continue;
+        }
+        if (!(s & ReadersWaiting) && !state.testAndSetOrdered(s, s | ReadersWaiting))
+            continue;
+
+        const struct timespec *pts = 0;
+        if (timeout > 0) {
+            if (!remainingTime(timeout, timer, &ts))
+                return false;
+            pts = &ts;
+        }
+        if (!QtLinuxFutex::futexWait(readerSeq, seq, pts))
+            return false;
+    }
+}
+
+bool QReadWriteLockPrivate::lockForWriteFutex(int timeout) Q_DECL_NOTHROW
+{
+    uint s = state.load();
+    while (canLockForWrite(s)) {
+        if (state.testAndSetAcquire(s, s | WriterHeld, s))
+            return true;
+    }
+    if (timeout == 0)
+        return false;
+
+    const WriteTryLock tryLock = { state };
+    if (QMutexSpinPolicy::spin(tryLock))
+        return true;
+
+    s = state.fetchAndAddOrdered(WriterWaitingUnit);
+    Q_ASSERT_X((s & WaitingWritersMask) != WaitingWritersMask, "QReadWriteLock::lockForWrite()",
+               "Overflow in lock counter");
+
+    QElapsedTimer timer;
+    if (timeout > 0)
+        timer.start();
+
+    struct timespec ts;
+    forever {
+        int seq = writerSeq.loadAcquire();
+        s = state.loadAcquire();
+        if (canLockForWrite(s)) {
+            if (state.testAndSetAcquire(s, (s - WriterWaitingUnit) | WriterHeld))
+                return true;
+            continue;
+        }
+
+        const struct timespec *pts = 0;
+        if (timeout > 0) {
+            if (!remainingTime(timeout, timer, &ts))
+                break;
+            pts = &ts;
+        }
+        if (!QtLinuxFutex::futexWait(writerSeq, seq, pts))
+            break;
+    }
+
+    // timed out: stop waiting and hand over any wake-up we may have consumed
+    uint newState;
+    s = state.load();
+    do {
+        newState = s - WriterWaitingUnit;
+        if (!(newState & (WriterHeld | WaitingWritersMask)))
+            newState &= ~ReadersWaiting;
+    } while (!state.testAndSetOrdered(s, newState, s));
+
+    if (!(newState & WriterHeld)) {
+        if (newState & WaitingWritersMask) {
+            if (!(newState & ReaderMask))
+                wakeWriter();
+        } else if (s & ReadersWaiting) {
+            wakeReaders();
+        }
+    }
+    return false;
+}
+
+void QReadWriteLockPrivate::unlockFutex() Q_DECL_NOTHROW
+{
+    uint s = state.load();
+    Q_ASSERT_X(s & (WriterHeld | ReaderMask), "QReadWriteLock::unlock()",
+               "Cannot unlock an unlocked lock");
+
+    if (s & WriterHeld) {
+        // writers take precedence; the readers stay flagged until the last
+        // waiting writer is done
+        uint newState;
+        do {
+            newState = s & ~WriterHeld;
+            if (!(newState & WaitingWritersMask))
+                newState &= ~ReadersWaiting;
+        } while (!state.testAndSetOrdered(s, newState, s));
+
+        if (newState & WaitingWritersMask)
+            wakeWriter();
+        else if (s & ReadersWaiting)
+            wakeReaders();
+        return;
+    }
+
+    s = state.fetchAndSubOrdered(1);
+    if ((s & ReaderMask) == 1 && (s & WaitingWritersMask))
+        wakeWriter();
+}
+
+void QReadWriteLockPrivate::wakeReaders() Q_DECL_NOTHROW
+{
+    readerSeq.fetchAndAddRelease(1);
+    QtLinuxFutex::futexWakeAll(readerSeq);
+}
+
+void QReadWriteLockPrivate::wakeWriter() Q_DECL_NOTHROW
+{
+    writerSeq.fetchAndAddRelease(1);
+    QtLinuxFutex::futexWakeOne(writerSeq);
+}
+#endif // QT_LINUX_FUTEX
+
 /*! \class QReadWriteLock
     \inmodule QtCore
     \brief The QReadWriteLock class provides read-write locking.
@@ -134,6 +333,12 @@ QReadWriteLock::~QReadWriteLock()
 */
 void QReadWriteLock::lockForRead()
 {
+#ifdef QT_LINUX_FUTEX
+    if (!d->recursive) {
+        d->lockForReadFutex(-1);
+        return;
+    }
+#endif
     QMutexLocker lock(&d->mutex);
 
     while (d->accessCount < 0 || d->waitingWriters) {
@@ -164,6 +369,19 @@ void QReadWriteLock::lockForRead()
 */
 bool QReadWriteLock::tryLockForRead()
 {
+#ifdef QT_LINUX_FUTEX
+    if (!d->recursive) {
+        // unlike the timed overload, this does not give way to waiting writers
+        uint s = d->state.load();
+        while (!(s & QReadWriteLockPrivate::WriterHeld)) {
+            Q_ASSERT_X((s & QReadWriteLockPrivate::ReaderMask) != QReadWriteLockPrivate::ReaderMask,
+                       "QReadWriteLock::tryLockForRead()", "Overflow in lock counter");
+            if (d->state.testAndSetAcquire(s, s + 1, s))
+                return true;
+        }
+        return false;
+    }
+#endif
     QMutexLocker lock(&d->mutex);
 
     if (d->accessCount < 0)
@@ -196,6 +414,10 @@ bool QReadWriteLock::tryLockForRead()
 */
 bool QReadWriteLock::tryLockForRead(int timeout)
 {
+#ifdef QT_LINUX_FUTEX
+    if (!d->recursive)
+        return d->lockForReadFutex(timeout);
+#endif
     QMutexLocker lock(&d->mutex);
 
     while (d->accessCount < 0 || d->waitingWriters) {
@@ -225,6 +447,12 @@ bool QReadWriteLock::tryLockForRead(int timeout)
 */
 void QReadWriteLock::lockForWrite()
 {
+#ifdef QT_LINUX_FUTEX
+    if (!d->recursive) {
+        d->lockForWriteFutex(-1);
+        return;
+    }
+#endif
     QMutexLocker lock(&d->mutex);
 
     Qt::HANDLE self = 0;
@@ -268,6 +496,10 @@ void QReadWriteLock::lockForWrite()
 */
 bool QReadWriteLock::tryLockForWrite()
 {
+#ifdef QT_LINUX_FUTEX
+    if (!d->recursive)
+        return d->lockForWriteFutex(0);
+#endif
     QMutexLocker lock(&d->mutex);
 
     Qt::HANDLE self = 0;
@@ -315,6 +547,10 @@ bool QReadWriteLock::tryLockForWrite()
 */
 bool QReadWriteLock::tryLockForWrite(int timeout)
 {
+#ifdef QT_LINUX_FUTEX
+    if (!d->recursive)
+        return d->lockForWriteFutex(timeout);
+#endif
     QMutexLocker lock(&d->mutex);
 
     Qt::HANDLE self = 0;
@@ -357,6 +593,12 @@ bool QReadWriteLock::tryLockForWrite(int timeout)
 */
 void QReadWriteLock::unlock()
 {
+#ifdef QT_LINUX_FUTEX
+    if (!d->recursive) {
+        d->unlockFutex();
+        return;
+    }
+#endif
     QMutexLocker lock(&d->mutex);
 
     Q_ASSERT_X(d->accessCount != 0, "QReadWriteLock::unlock()", "Cannot unlock an unlocked lock");
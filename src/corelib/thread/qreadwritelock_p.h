@@ -50,6 +50,8 @@
 
 #ifndef QT_NO_THREAD
 
+#include "qmutex_p.h"
+
 QT_BEGIN_NAMESPACE
 
 struct QReadWriteLockPrivate
@@ -57,7 +59,58 @@ struct QReadWriteLockPrivate
     QReadWriteLockPrivate(QReadWriteLock::RecursionMode recursionMode)
         : accessCount(0), waitingReaders(0), waitingWriters(0),
           recursive(recursionMode == QReadWriteLock::Recursive), currentWriter(0)
-    { }
+    {
+#ifdef QT_LINUX_FUTEX
+        state.store(0);
+        readerSeq.store(0);
+        writerSeq.store(0);
+#endif
+    }
+
+#ifdef QT_LINUX_FUTEX
+    /*
+     * Non-recursive locks on Linux keep their whole state in one word and
+     * only enter the kernel when a thread has to sleep:
+     *
+     *  bits  0-19  number of readers holding the lock
+     *  bits 20-29  number of writers waiting for the lock
+     *  bit     30  at least one reader may be sleeping on readerSeq
+     *  bit     31  the lock is held by a writer
+     *
+     * Sleeping readers and writers wait on separate sequence counters, so
+     * that releasing a write lock wakes either one writer or all readers.
+     */
+    enum {
+        ReaderMask = 0x000fffffU,
+        WriterWaitingUnit = 0x00100000U,
+        WaitingWritersMask = 0x3ff00000U,
+        ReadersWaiting = 0x40000000U,
+        WriterHeld = 0x80000000U
+    };
+
+    QBasicAtomicInteger<uint> state;
+    QBasicAtomicInt readerSeq;
+    QBasicAtomicInt writerSeq;
+
+    bool lockForReadFutex(int timeout) Q_DECL_NOTHROW;
+    bool lockForWriteFutex(int timeout) Q_DECL_NOTHROW;
+    void unlockFutex() Q_DECL_NOTHROW;
+    void wakeReaders() Q_DECL_NOTHROW;
+    void wakeWriter() Q_DECL_NOTHROW;
+#endif
+
+    // same encoding as accessCount: 0 if unlocked, the number of readers if
+    // read-locked, minus the recursion depth if write-locked
+    int currentAccessCount() const Q_DECL_NOTHROW
+    {
+#ifdef QT_LINUX_FUTEX
+        if (!recursive) {
+            uint s = state.load();
+            return (s & WriterHeld) ? -1 : int(s & ReaderMask);
+        }
+#endif
+        return accessCount;
+    }
 
     QMutex mutex;
     QWaitCondition readerWait;
@@ -69,6 +69,31 @@ public:
     const void *result; // if count is 0 it's a result, otherwise it's a vector.
 };
 
+// Links a result that is reported without the mutex of its future into
+// the queue of results waiting for the store.
+struct ResultLink
+{
+    ResultLink *next;
+    int index;
+    ResultItem item;
+};
+
+// The allocation of a result owned by ResultStore<T>: the result, or the
+// vector of results, followed by the link it is queued with, so that
+// reporting it takes no allocation of its own. The result comes first, so
+// ResultItem::result points to the start of the holder.
+template <typename T>
+struct ResultHolder
+{
+    explicit ResultHolder(const T &v) : value(v) { }
+
+    T value;
+    ResultLink link;
+
+    static const void *create(const T &v) { return &(new ResultHolder(v))->value; }
+    static void destroy(const void *result) { delete static_cast<const ResultHolder *>(result); }
+};
+
 class Q_CORE_EXPORT ResultIteratorBase
 {
 public:
@@ -157,12 +182,12 @@ public:
         if (result == 0)
             return ResultStoreBase::addResult(index, result);
         else
-            return ResultStoreBase::addResult(index, new T(*result));
+            return ResultStoreBase::addResult(index, ResultHolder<T>::create(*result));
     }
 
     int addResults(int index, const QVector<T> *results)
     {
-        return ResultStoreBase::addResults(index, new QVector<T>(*results), results->count(), results->count());
+        return ResultStoreBase::addResults(index, ResultHolder<QVector<T> >::create(*results), results->count(), results->count());
     }
 
     int addResults(int index, const QVector<T> *results, int totalCount)
@@ -170,7 +195,7 @@ public:
         if (m_filterMode == true && results->count() != totalCount && 0 == results->count())
             return ResultStoreBase::addResults(index, 0, 0, totalCount);
         else
-            return ResultStoreBase::addResults(index, new QVector<T>(*results), results->count(), totalCount);
+            return ResultStoreBase::addResults(index, ResultHolder<QVector<T> >::create(*results), results->count(), totalCount);
     }
 
     int addCanceledResult(int index)
@@ -204,9 +229,9 @@ public:
         QMap<int, ResultItem>::const_iterator mapIterator = m_results.constBegin();
         while (mapIterator != m_results.constEnd()) {
             if (mapIterator.value().isVector())
-                delete reinterpret_cast<const QVector<T> *>(mapIterator.value().result);
+                ResultHolder<QVector<T> >::destroy(mapIterator.value().result);
             else
-                delete reinterpret_cast<const T *>(mapIterator.value().result);
+                ResultHolder<T>::destroy(mapIterator.value().result);
             ++mapIterator;
         }
         resultCount = 0;
@@ -74,6 +74,7 @@ QThreadData::~QThreadData()
     thread = 0;
     delete t;
 
+    postEventList.addIncomingEvents();
     for (int i = 0; i < postEventList.size(); ++i) {
         const QPostEvent &pe = postEventList.at(i);
         if (pe.event) {
@@ -86,6 +87,23 @@ QThreadData::~QThreadData()
     // fprintf(stderr, "QThreadData %p destroyed\n", this);
 }
 
+/*
+    Moves the events posted through the lock-free queue into the list, in
+    the order they were posted. Must be called with the mutex held.
+*/
+void QPostEventList::addIncomingEvents()
+{
+    QPostEventNode *node = takeIncoming();
+    while (node) {
+        addEvent(QPostEvent(node->receiver, node->event, Qt::NormalEventPriority));
+        ++QObjectPrivate::get(node->receiver)->postedEvents;
+
+        QPostEventNode *next = node->next;
+        delete node;
+        node = next;
+    }
+}
+
 void QThreadData::ref()
 {
 #ifndef QT_NO_THREAD
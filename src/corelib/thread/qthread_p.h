@@ -92,6 +92,14 @@ inline bool operator<(const QPostEvent &first, const QPostEvent &second)
     return first.priority > second.priority;
 }
 
+// A posted event waiting in the lock-free queue of a QPostEventList.
+struct QPostEventNode
+{
+    QPostEventNode *next;
+    QObject *receiver;
+    QEvent *event;
+};
+
 // This class holds the list of posted events.
 //  The list has to be kept sorted by priority
 class QPostEventList : public QVector<QPostEvent>
@@ -107,10 +115,42 @@ public:
 
     QMutex mutex;
 
+    // Queued calls of the default priority are pushed onto this lock-free
+    // stack by postEvent() without taking the mutex. Whoever holds the
+    // mutex next moves them into the list with addIncomingEvents(), so
+    // that they are never overtaken by events posted after them.
+    QAtomicPointer<QPostEventNode> incoming;
+    // number of postEvent() calls currently pushing onto the stack
+    QAtomicInt incomingPosters;
+
     inline QPostEventList()
         : QVector<QPostEvent>(), recursion(0), startOffset(0), insertionOffset(0)
     { }
 
+    void pushIncoming(QPostEventNode *node)
+    {
+        QPostEventNode *head = incoming.load();
+        do {
+            node->next = head;
+        } while (!incoming.testAndSetRelease(head, node, head));
+    }
+
+    // returns the events pushed so far, oldest first; the mutex must be held
+    QPostEventNode *takeIncoming()
+    {
+        QPostEventNode *node = incoming.fetchAndStoreAcquire(0);
+        QPostEventNode *oldest = 0;
+        while (node) {
+            QPostEventNode *next = node->next;
+            node->next = oldest;
+            oldest = node;
+            node = next;
+        }
+        return oldest;
+    }
+
+    void addIncomingEvents();
+
     void addEvent(const QPostEvent &ev) {
         int priority = ev.priority;
         if (isEmpty() ||
@@ -238,7 +278,7 @@ public:
     bool canWaitLocked()
     {
         QMutexLocker locker(&postEventList.mutex);
-        return canWait;
+        return canWait && !postEventList.incoming.load();
     }
 
     // This class provides per-thread (by way of being a QThreadData
@@ -43,6 +43,9 @@
 #  if !defined(QT_NO_GLIB)
 #    include "../kernel/qeventdispatcher_glib_p.h"
 #  endif
+#  if !defined(QT_NO_EPOLL)
+#    include <private/qeventdispatcher_epoll_p.h>
+#  endif
 #  include <private/qeventdispatcher_unix_p.h>
 #endif
 
@@ -252,12 +255,22 @@ void QThreadPrivate::createEventDispatcher(QThreadData *data)
 #if defined(Q_OS_BLACKBERRY)
     data->eventDispatcher.storeRelease(new QEventDispatcherBlackberry);
 #else
+#if !defined(QT_NO_EPOLL)
+    if (QEventDispatcherEpoll::isRequested())
+        data->eventDispatcher.storeRelease(new QEventDispatcherEpoll);
+    else
+#endif
 #if !defined(QT_NO_GLIB)
     if (qEnvironmentVariableIsEmpty("QT_NO_GLIB")
         && qEnvironmentVariableIsEmpty("QT_NO_THREADED_GLIB")
         && QEventDispatcherGlib::versionSupported())
         data->eventDispatcher.storeRelease(new QEventDispatcherGlib);
     else
+#endif
+#if !defined(QT_NO_EPOLL)
+    if (QEventDispatcherEpoll::isPreferred())
+        data->eventDispatcher.storeRelease(new QEventDispatcherEpoll);
+    else
 #endif
     data->eventDispatcher.storeRelease(new QEventDispatcherUNIX);
 #endif
@@ -34,11 +34,18 @@
 #include "qthreadpool.h"
 #include "qthreadpool_p.h"
 #include "qelapsedtimer.h"
+#include "private/qmutexpool_p.h"
 
 #include <algorithm>
 
 #ifndef QT_NO_THREAD
 
+#if defined(Q_OS_LINUX)
+#  include <sched.h>
+#elif defined(Q_OS_WIN) && !defined(Q_OS_WINRT)
+#  include <qt_windows.h>
+#endif
+
 QT_BEGIN_NAMESPACE
 
 Q_GLOBAL_STATIC(QThreadPool, theInstance)
@@ -52,12 +59,25 @@ public:
     QThreadPoolThread(QThreadPoolPrivate *manager);
     void run() Q_DECL_OVERRIDE;
     void registerThreadInactive();
+    QRunnable *takeQueuedTask();
+    bool cpuAffinityChanged(QList<int> *cpus);
+    void applyCpuAffinity(const QList<int> &cpus);
 
     QWaitCondition runnableReady;
     QThreadPoolPrivate *manager;
     QRunnable *runnable;
+    int cpuAffinitySerial;
+
+    // tasks handed to this thread in a batch from the pool's queue, in
+    // priority order; other threads steal from it when they run out of work
+    QMutex queueMutex;
+    QList<QPair<QRunnable *, int> > queue;
+    QAtomicInt queueSize;
 };
 
+// the most tasks a thread takes from the pool's queue at a time
+static const int MaxTaskBatch = 16;
+
 /*
     QThreadPool private class.
 */
@@ -67,7 +87,7 @@ public:
     \internal
 */
 QThreadPoolThread::QThreadPoolThread(QThreadPoolPrivate *manager)
-    :manager(manager), runnable(0)
+    :manager(manager), runnable(0), cpuAffinitySerial(0)
 { }
 
 /*
@@ -82,35 +102,44 @@ void QThreadPoolThread::run()
 
         do {
             if (r) {
-                const bool autoDelete = r->autoDelete();
-
+                QList<int> cpus;
+                const bool updateCpuAffinity = cpuAffinityChanged(&cpus);
 
-                // run the task
+                // run the task, and the ones queued on this thread after it,
+                // without holding the pool's mutex
                 locker.unlock();
+                if (updateCpuAffinity)
+                    applyCpuAffinity(cpus);
+                do {
+                    const bool autoDelete = r->autoDelete();
+
 #ifndef QT_NO_EXCEPTIONS
-                try {
+                    try {
 #endif
-                    r->run();
+                        r->run();
 #ifndef QT_NO_EXCEPTIONS
-                } catch (...) {
-                    qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
-                             "This is not supported, exceptions thrown in worker threads must be\n"
-                             "caught before control returns to Qt Concurrent.");
-                    registerThreadInactive();
-                    throw;
-                }
+                    } catch (...) {
+                        qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
+                                 "This is not supported, exceptions thrown in worker threads must be\n"
+                                 "caught before control returns to Qt Concurrent.");
+                        locker.relock();
+                        manager->requeueTasks(this);
+                        registerThreadInactive();
+                        throw;
+                    }
 #endif
-                locker.relock();
 
-                if (autoDelete && !--r->ref)
-                    delete r;
+                    if (autoDelete && QThreadPoolPrivate::derefRunnable(r))
+                        delete r;
+                } while ((r = takeQueuedTask()) != 0);
+                locker.relock();
             }
 
             // if too many threads are active, expire this thread
             if (manager->tooManyThreadsActive())
                 break;
 
-            r = !manager->queue.isEmpty() ? manager->queue.takeFirst().first : 0;
+            r = manager->takeTasks(this);
         } while (r != 0);
 
         if (manager->isExiting) {
@@ -137,6 +166,70 @@ void QThreadPoolThread::run()
     }
 }
 
+/*
+    Takes the next task handed to this thread, or returns 0 if there are
+    none left. Only needs the thread's own queue mutex.
+*/
+QRunnable *QThreadPoolThread::takeQueuedTask()
+{
+    if (queueSize.load() == 0)
+        return 0;
+    QMutexLocker locker(&queueMutex);
+    if (queue.isEmpty())
+        return 0;
+    queueSize.store(queue.size() - 1);
+    return queue.takeFirst().first;
+}
+
+/*
+    Returns \c true and stores the pool's CPU affinity in \a cpus if it
+    changed since this thread last applied it. Must be called with the
+    pool's mutex locked.
+*/
+bool QThreadPoolThread::cpuAffinityChanged(QList<int> *cpus)
+{
+    if (cpuAffinitySerial == manager->cpuAffinitySerial)
+        return false;
+    cpuAffinitySerial = manager->cpuAffinitySerial;
+    *cpus = manager->cpuAffinity;
+    return true;
+}
+
+/*
+    Restricts this thread to \a cpus, or gives it back the affinity the
+    pool was created with if \a cpus is empty. Does not need the pool's
+    mutex.
+*/
+void QThreadPoolThread::applyCpuAffinity(const QList<int> &cpus)
+{
+#if defined(Q_OS_LINUX)
+    cpu_set_t set = manager->inheritedCpuAffinity;
+    if (!cpus.isEmpty()) {
+        CPU_ZERO(&set);
+        for (int i = 0; i < cpus.count(); ++i) {
+            if (cpus.at(i) >= 0 && cpus.at(i) < CPU_SETSIZE)
+                CPU_SET(cpus.at(i), &set);
+        }
+    }
+    if (sched_setaffinity(0, sizeof(set), &set) != 0)
+        qWarning("QThreadPool: Cannot set the CPU affinity of a pool thread");
+#elif defined(Q_OS_WIN) && !defined(Q_OS_WINRT)
+    DWORD_PTR mask = 0;
+    for (int i = 0; i < cpus.count(); ++i) {
+        if (cpus.at(i) >= 0 && cpus.at(i) < int(sizeof(mask) * 8))
+            mask |= DWORD_PTR(1) << cpus.at(i);
+    }
+    if (!mask) {
+        DWORD_PTR systemMask;
+        GetProcessAffinityMask(GetCurrentProcess(), &mask, &systemMask);
+    }
+    if (!SetThreadAffinityMask(GetCurrentThread(), mask))
+        qWarning("QThreadPool: Cannot set the CPU affinity of a pool thread");
+#else
+    Q_UNUSED(cpus);
+#endif
+}
+
 void QThreadPoolThread::registerThreadInactive()
 {
     if (--manager->activeThreads == 0)
@@ -152,8 +245,17 @@ QThreadPoolPrivate:: QThreadPoolPrivate()
       expiryTimeout(30000),
       maxThreadCount(qAbs(QThread::idealThreadCount())),
       reservedThreads(0),
-      activeThreads(0)
-{ }
+      activeThreads(0),
+      cpuAffinitySerial(0)
+{
+#if defined(Q_OS_LINUX)
+    CPU_ZERO(&inheritedCpuAffinity);
+    if (sched_getaffinity(0, sizeof(inheritedCpuAffinity), &inheritedCpuAffinity) != 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+            CPU_SET(cpu, &inheritedCpuAffinity);
+    }
+#endif
+}
 
 bool QThreadPoolPrivate::tryStart(QRunnable *task)
 {
@@ -182,7 +284,7 @@ bool QThreadPoolPrivate::tryStart(QRunnable *task)
         ++activeThreads;
 
         if (task->autoDelete())
-            ++task->ref;
+            refRunnable(task);
         thread->runnable = task;
         thread->start();
         return true;
@@ -201,7 +303,7 @@ inline bool operator<(const QPair<QRunnable *, int> &p, int priority)
 void QThreadPoolPrivate::enqueueTask(QRunnable *runnable, int priority)
 {
     if (runnable->autoDelete())
-        ++runnable->ref;
+        refRunnable(runnable);
 
     // put it on the queue
     QList<QPair<QRunnable *, int> >::const_iterator begin = queue.constBegin();
@@ -243,7 +345,7 @@ void QThreadPoolPrivate::startThread(QRunnable *runnable)
     ++activeThreads;
 
     if (runnable->autoDelete())
-        ++runnable->ref;
+        refRunnable(runnable);
     thread->runnable = runnable;
     thread.take()->start();
 }
@@ -299,13 +401,115 @@ bool QThreadPoolPrivate::waitForDone(int msecs)
 void QThreadPoolPrivate::clear()
 {
     QMutexLocker locker(&mutex);
-    for (QList<QPair<QRunnable *, int> >::const_iterator it = queue.constBegin();
-         it != queue.constEnd(); ++it) {
+    QList<QPair<QRunnable *, int> > tasks;
+    tasks.swap(queue);
+    foreach (QThreadPoolThread *thread, allThreads) {
+        QMutexLocker queueLocker(&thread->queueMutex);
+        tasks += thread->queue;
+        thread->queue.clear();
+        thread->queueSize.store(0);
+    }
+
+    for (QList<QPair<QRunnable *, int> >::const_iterator it = tasks.constBegin();
+         it != tasks.constEnd(); ++it) {
         QRunnable* r = it->first;
-        if (r->autoDelete() && !--r->ref)
+        if (r->autoDelete() && derefRunnable(r))
             delete r;
     }
-    queue.clear();
+}
+
+/*!
+    \internal
+    Called with the pool's mutex held by \a thread when it has run out of
+    work. Hands the thread a batch of tasks of the same priority from the
+    front of the queue, or steals the oldest task queued on another thread
+    if that one has a higher priority. Returns the first task to run, or 0
+    if there is nothing left to do.
+*/
+QRunnable *QThreadPoolPrivate::takeTasks(QThreadPoolThread *thread)
+{
+    Q_ASSERT(thread->queue.isEmpty());
+
+    for (;;) {
+        // find the most urgent task queued on another thread
+        QThreadPoolThread *victim = 0;
+        int victimPriority = 0;
+        foreach (QThreadPoolThread *other, allThreads) {
+            if (other == thread || other->queueSize.load() == 0)
+                continue;
+            QMutexLocker queueLocker(&other->queueMutex);
+            if (!other->queue.isEmpty() && (!victim || other->queue.first().second > victimPriority)) {
+                victim = other;
+                victimPriority = other->queue.first().second;
+            }
+        }
+
+        if (!queue.isEmpty() && (!victim || queue.first().second > victimPriority)) {
+            // share the queue between the running threads, so that the
+            // others still find something to steal
+            const int priority = queue.first().second;
+            const int runningThreads = allThreads.count() - waitingThreads.count() - expiredThreads.count();
+            int count = qBound(1, queue.count() / qMax(1, runningThreads), MaxTaskBatch);
+
+            QRunnable *r = queue.takeFirst().first;
+            QMutexLocker queueLocker(&thread->queueMutex);
+            while (--count > 0 && !queue.isEmpty() && queue.first().second == priority)
+                thread->queue.append(queue.takeFirst());
+            thread->queueSize.store(thread->queue.size());
+            return r;
+        }
+
+        if (!victim)
+            return 0;
+
+        // the victim may have taken the task itself in the meantime
+        QMutexLocker queueLocker(&victim->queueMutex);
+        if (!victim->queue.isEmpty()) {
+            victim->queueSize.store(victim->queue.size() - 1);
+            return victim->queue.takeFirst().first;
+        }
+    }
+}
+
+/*!
+    \internal
+    Puts the tasks queued on \a thread back into the pool's queue, for a
+    thread that is about to exit. Must be called with the pool's mutex held.
+*/
+void QThreadPoolPrivate::requeueTasks(QThreadPoolThread *thread)
+{
+    QMutexLocker queueLocker(&thread->queueMutex);
+    while (!thread->queue.isEmpty()) {
+        const QPair<QRunnable *, int> task = thread->queue.takeLast();
+        QList<QPair<QRunnable *, int> >::const_iterator begin = queue.constBegin();
+        QList<QPair<QRunnable *, int> >::const_iterator it = std::lower_bound(begin, queue.constEnd(), task.second);
+        queue.insert(it - begin, task);
+    }
+    thread->queueSize.store(0);
+}
+
+/*!
+    \internal
+    The reference count of an auto-deleting QRunnable counts how often it is
+    queued or running. Threads drop their reference without holding the
+    pool's mutex, so all changes to it are serialized through the global
+    mutex pool instead.
+*/
+void QThreadPoolPrivate::refRunnable(QRunnable *runnable)
+{
+    QMutexLocker locker(QMutexPool::globalInstanceGet(runnable));
+    ++runnable->ref;
+}
+
+/*!
+    \internal
+    Drops a reference to \a runnable, returning \c true if it was the last
+    one and the runnable should be deleted.
+*/
+bool QThreadPoolPrivate::derefRunnable(QRunnable *runnable)
+{
+    QMutexLocker locker(QMutexPool::globalInstanceGet(runnable));
+    return !--runnable->ref;
 }
 
 /*!
@@ -329,6 +533,18 @@ bool QThreadPoolPrivate::stealRunnable(QRunnable *runnable)
             }
             ++it;
         }
+
+        // it may have been handed to a thread already, but not started yet
+        foreach (QThreadPoolThread *thread, allThreads) {
+            QMutexLocker queueLocker(&thread->queueMutex);
+            for (int i = 0; i < thread->queue.count(); ++i) {
+                if (thread->queue.at(i).first == runnable) {
+                    thread->queue.removeAt(i);
+                    thread->queueSize.store(thread->queue.size());
+                    return true;
+                }
+            }
+        }
     }
 
     return false;
@@ -345,7 +561,7 @@ void QThreadPoolPrivate::stealAndRunRunnable(QRunnable *runnable)
     if (!stealRunnable(runnable))
         return;
     const bool autoDelete = runnable->autoDelete();
-    bool del = autoDelete && !--runnable->ref;
+    bool del = autoDelete && derefRunnable(runnable);
 
     runnable->run();
 
@@ -566,6 +782,48 @@ int QThreadPool::activeThreadCount() const
     return d->activeThreadCount();
 }
 
+/*!
+    \since 5.6
+
+    Returns the CPUs the threads of this pool may run on, as set with
+    setCpuAffinity(). An empty list means that the threads are not
+    restricted by the pool.
+
+    \sa setCpuAffinity()
+*/
+QList<int> QThreadPool::cpuAffinity() const
+{
+    Q_D(const QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    return d->cpuAffinity;
+}
+
+/*!
+    \since 5.6
+
+    Restricts the threads of this pool to the CPUs in \a cpus, numbered from
+    0 like the CPUs of the operating system. Pinning the threads of a pool to
+    the CPUs of one NUMA node keeps them close to the memory they work on,
+    and keeps pools for different kinds of work off each other's CPUs. An
+    empty list removes the restriction again; on Linux the threads get back
+    the CPU affinity of the thread that created the pool.
+
+    Threads that are busy pick up the new affinity when they next fetch
+    tasks from the pool. The affinity is only applied on Linux and
+    Windows; on other platforms this function has no effect.
+
+    \sa cpuAffinity()
+*/
+void QThreadPool::setCpuAffinity(const QList<int> &cpus)
+{
+    Q_D(QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    if (cpus == d->cpuAffinity)
+        return;
+    d->cpuAffinity = cpus;
+    ++d->cpuAffinitySerial;
+}
+
 /*!
     Reserves one thread, disregarding activeThreadCount() and maxThreadCount().
 
@@ -649,7 +907,7 @@ void QThreadPool::cancel(QRunnable *runnable)
     Q_D(QThreadPool);
     if (!d->stealRunnable(runnable))
         return;
-    if (runnable->autoDelete() && !--runnable->ref) {
+    if (runnable->autoDelete() && d->derefRunnable(runnable)) {
         delete runnable;
     }
 }
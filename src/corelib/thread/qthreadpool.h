@@ -71,6 +71,9 @@ public:
 
     int activeThreadCount() const;
 
+    QList<int> cpuAffinity() const;
+    void setCpuAffinity(const QList<int> &cpus);
+
     void reserveThread();
     void releaseThread();
 
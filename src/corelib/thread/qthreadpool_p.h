@@ -54,6 +54,10 @@
 
 #ifndef QT_NO_THREAD
 
+#if defined(Q_OS_LINUX)
+#  include <sched.h>
+#endif
+
 QT_BEGIN_NAMESPACE
 
 class QThreadPoolThread;
@@ -78,6 +82,11 @@ public:
     void clear();
     bool stealRunnable(QRunnable *runnable);
     void stealAndRunRunnable(QRunnable *runnable);
+    QRunnable *takeTasks(QThreadPoolThread *thread);
+    void requeueTasks(QThreadPoolThread *thread);
+
+    static void refRunnable(QRunnable *runnable);
+    static bool derefRunnable(QRunnable *runnable);
 
     mutable QMutex mutex;
     QSet<QThreadPoolThread *> allThreads;
@@ -91,6 +100,17 @@ public:
     int maxThreadCount;
     int reservedThreads;
     int activeThreads;
+
+    // CPUs the pool's threads are restricted to, empty for no restriction.
+    // The serial is bumped on every change; threads compare it with the
+    // one they last applied.
+    QList<int> cpuAffinity;
+    int cpuAffinitySerial;
+#if defined(Q_OS_LINUX)
+    // the affinity of the thread that created the pool, restored when
+    // cpuAffinity is set back to an empty list
+    cpu_set_t inheritedCpuAffinity;
+#endif
 };
 
 QT_END_NAMESPACE
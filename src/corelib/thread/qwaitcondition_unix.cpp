@@ -214,9 +214,9 @@ bool QWaitCondition::wait(QMutex *mutex, unsigned long time)
 
 bool QWaitCondition::wait(QReadWriteLock *readWriteLock, unsigned long time)
 {
-    if (!readWriteLock || readWriteLock->d->accessCount == 0)
+    if (!readWriteLock || readWriteLock->d->currentAccessCount() == 0)
         return false;
-    if (readWriteLock->d->accessCount < -1) {
+    if (readWriteLock->d->currentAccessCount() < -1) {
         qWarning("QWaitCondition: cannot wait on QReadWriteLocks with recursive lockForWrite()");
         return false;
     }
@@ -224,7 +224,7 @@ bool QWaitCondition::wait(QReadWriteLock *readWriteLock, unsigned long time)
     report_error(pthread_mutex_lock(&d->mutex), "QWaitCondition::wait()", "mutex lock");
     ++d->waiters;
 
-    int previousAccessCount = readWriteLock->d->accessCount;
+    int previousAccessCount = readWriteLock->d->currentAccessCount();
     readWriteLock->unlock();
 
     bool returnValue = d->wait(time);
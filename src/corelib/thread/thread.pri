@@ -20,7 +20,8 @@ HEADERS += thread/qmutex.h \
            thread/qgenericatomic.h
 
 # private headers
-HEADERS += thread/qmutex_p.h \
+HEADERS += thread/qfutex_p.h \
+           thread/qmutex_p.h \
            thread/qmutexpool_p.h \
            thread/qfutureinterface_p.h \
            thread/qfuturewatcher_p.h \
@@ -0,0 +1,674 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QFLATHASH_H
+#define QFLATHASH_H
+
+#include <QtCore/qiterator.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qrefcount.h>
+#include <QtCore/qhashfunctions.h>
+
+#include <new>
+
+#ifdef Q_COMPILER_INITIALIZER_LISTS
+#include <initializer_list>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+struct Q_CORE_EXPORT QFlatHashData
+{
+    QtPrivate::RefCount ref;
+    int size;
+    int numBuckets;     // 0 or a power of two
+    int numBits;
+    uint seed;
+    struct Bucket
+    {
+        uint probe;     // 0 if empty, else the distance from the home bucket + 1
+        uint hash;      // qHash() of the key, if not empty
+    };
+
+    Bucket *buckets;
+    void *nodes;
+
+    static QFlatHashData *allocate(int numBits, int nodeSize, int nodeAlign);
+    static void deallocate(QFlatHashData *d, int nodeAlign);
+    static int numBitsForCapacity(int capacity);
+
+    inline int capacity() const { return numBuckets - numBuckets / 8; }
+    // qHash() of integers is little more than the identity; folding the high
+    // half in first keeps keys that are multiples of the Fibonacci constant
+    // from all landing together
+    inline int bucketOf(uint h) const
+    { return numBits ? int(((h ^ (h >> 16)) * 0x9e3779b9U) >> (32 - numBits)) : 0; }
+
+    // the first bucket that does not continue a run of the bucket before it;
+    // iterating from there, removals never move entries back past the start
+    inline int firstBucket() const
+    {
+        for (int i = 0; i < numBuckets; ++i) {
+            if (buckets[i].probe <= 1)
+                return i;
+        }
+        return 0;
+    }
+
+    static const QFlatHashData shared_null;
+};
+
+template <class Key, class T>
+class QFlatHash
+{
+    struct Node
+    {
+        Key key;
+        T value;
+
+        inline Node(const Key &key0, const T &value0) : key(key0), value(value0) {}
+    };
+
+    QFlatHashData *d;
+
+    static inline Node *nodesOf(const QFlatHashData *x) { return static_cast<Node *>(x->nodes); }
+    inline Node *nodes() const { return nodesOf(d); }
+
+public:
+    inline QFlatHash() Q_DECL_NOTHROW : d(const_cast<QFlatHashData *>(&QFlatHashData::shared_null)) { }
+#ifdef Q_COMPILER_INITIALIZER_LISTS
+    inline QFlatHash(std::initializer_list<std::pair<Key,T> > list)
+        : d(const_cast<QFlatHashData *>(&QFlatHashData::shared_null))
+    {
+        reserve(int(list.size()));
+        for (typename std::initializer_list<std::pair<Key,T> >::const_iterator it = list.begin(); it != list.end(); ++it)
+            insert(it->first, it->second);
+    }
+#endif
+    inline QFlatHash(const QFlatHash &other) : d(other.d) { if (!d->ref.ref()) detach_helper(); }
+    inline ~QFlatHash() { if (!d->ref.deref()) freeData(d); }
+
+    QFlatHash &operator=(const QFlatHash &other);
+#ifdef Q_COMPILER_RVALUE_REFS
+    inline QFlatHash(QFlatHash &&other) Q_DECL_NOTHROW
+        : d(other.d) { other.d = const_cast<QFlatHashData *>(&QFlatHashData::shared_null); }
+    inline QFlatHash &operator=(QFlatHash &&other) Q_DECL_NOTHROW
+    { QFlatHash moved(std::move(other)); swap(moved); return *this; }
+#endif
+    inline void swap(QFlatHash &other) Q_DECL_NOTHROW { qSwap(d, other.d); }
+
+    bool operator==(const QFlatHash &other) const;
+    inline bool operator!=(const QFlatHash &other) const { return !(*this == other); }
+
+    inline int size() const { return d->size; }
+    inline int count() const { return d->size; }
+    inline bool isEmpty() const { return d->size == 0; }
+
+    inline int capacity() const { return d->capacity(); }
+    void reserve(int size);
+    void squeeze();
+
+    inline void detach() { if (d->ref.isShared()) detach_helper(); }
+    inline bool isDetached() const { return !d->ref.isShared(); }
+    inline bool isSharedWith(const QFlatHash &other) const { return d == other.d; }
+
+    void clear();
+
+    int remove(const Key &key);
+    T take(const Key &key);
+
+    inline bool contains(const Key &key) const { return findBucket(key) >= 0; }
+    inline int count(const Key &key) const { return findBucket(key) >= 0 ? 1 : 0; }
+    const Key key(const T &value) const;
+    const Key key(const T &value, const Key &defaultKey) const;
+    const T value(const Key &key) const;
+    const T value(const Key &key, const T &defaultValue) const;
+    T &operator[](const Key &key);
+    const T operator[](const Key &key) const;
+
+    QList<Key> keys() const;
+    QList<T> values() const;
+
+    class const_iterator;
+
+    class iterator
+    {
+        friend class QFlatHash;
+        friend class const_iterator;
+        QFlatHashData *d;
+        int start;
+        int pos;    // in buckets from start; d->numBuckets at the end
+
+        inline iterator(QFlatHashData *d0, int start0, int pos0) : d(d0), start(start0), pos(pos0) {}
+        inline int bucket() const { return (start + pos) & (d->numBuckets - 1); }
+        inline Node *node() const { return nodesOf(d) + bucket(); }
+
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef qptrdiff difference_type;
+        typedef T value_type;
+        typedef T *pointer;
+        typedef T &reference;
+
+        inline iterator() : d(0), start(0), pos(0) { }
+
+        inline const Key &key() const { return node()->key; }
+        inline T &value() const { return node()->value; }
+        inline T &operator*() const { return node()->value; }
+        inline T *operator->() const { return &node()->value; }
+        inline bool operator==(const iterator &o) const { return pos == o.pos; }
+        inline bool operator!=(const iterator &o) const { return pos != o.pos; }
+
+        inline iterator &operator++()
+        {
+            do {
+                ++pos;
+            } while (pos < d->numBuckets && !d->buckets[bucket()].probe);
+            return *this;
+        }
+        inline iterator operator++(int) { iterator r = *this; ++*this; return r; }
+        inline iterator &operator--()
+        {
+            do {
+                --pos;
+            } while (pos > 0 && !d->buckets[bucket()].probe);
+            return *this;
+        }
+        inline iterator operator--(int) { iterator r = *this; --*this; return r; }
+
+        inline bool operator==(const const_iterator &o) const { return pos == o.pos; }
+        inline bool operator!=(const const_iterator &o) const { return pos != o.pos; }
+    };
+    friend class iterator;
+
+    class const_iterator
+    {
+        friend class QFlatHash;
+        friend class iterator;
+        const QFlatHashData *d;
+        int start;
+        int pos;
+
+        inline const_iterator(const QFlatHashData *d0, int start0, int pos0) : d(d0), start(start0), pos(pos0) {}
+        inline int bucket() const { return (start + pos) & (d->numBuckets - 1); }
+        inline const Node *node() const { return nodesOf(d) + bucket(); }
+
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef qptrdiff difference_type;
+        typedef T value_type;
+        typedef const T *pointer;
+        typedef const T &reference;
+
+        inline const_iterator() : d(0), start(0), pos(0) { }
+        inline const_iterator(const iterator &o) : d(o.d), start(o.start), pos(o.pos) { }
+
+        inline const Key &key() const { return node()->key; }
+        inline const T &value() const { return node()->value; }
+        inline const T &operator*() const { return node()->value; }
+        inline const T *operator->() const { return &node()->value; }
+        inline bool operator==(const const_iterator &o) const { return pos == o.pos; }
+        inline bool operator!=(const const_iterator &o) const { return pos != o.pos; }
+
+        inline const_iterator &operator++()
+        {
+            do {
+                ++pos;
+            } while (pos < d->numBuckets && !d->buckets[bucket()].probe);
+            return *this;
+        }
+        inline const_iterator operator++(int) { const_iterator r = *this; ++*this; return r; }
+        inline const_iterator &operator--()
+        {
+            do {
+                --pos;
+            } while (pos > 0 && !d->buckets[bucket()].probe);
+            return *this;
+        }
+        inline const_iterator operator--(int) { const_iterator r = *this; --*this; return r; }
+    };
+    friend class const_iterator;
+
+    // STL style
+    inline iterator begin() { detach(); return iterator(d, d->firstBucket(), firstPos()); }
+    inline const_iterator begin() const { return const_iterator(d, d->firstBucket(), firstPos()); }
+    inline const_iterator cbegin() const { return begin(); }
+    inline const_iterator constBegin() const { return begin(); }
+    inline iterator end() { detach(); return iterator(d, 0, d->numBuckets); }
+    inline const_iterator end() const { return const_iterator(d, 0, d->numBuckets); }
+    inline const_iterator cend() const { return end(); }
+    inline const_iterator constEnd() const { return end(); }
+    iterator erase(iterator it);
+    inline iterator erase(const_iterator it) { return erase(iterator(d, it.start, it.pos)); }
+
+    iterator find(const Key &key);
+    const_iterator find(const Key &key) const;
+    inline const_iterator constFind(const Key &key) const { return find(key); }
+    iterator insert(const Key &key, const T &value);
+
+    // STL compatibility
+    typedef T mapped_type;
+    typedef Key key_type;
+    typedef qptrdiff difference_type;
+    typedef int size_type;
+
+    inline bool empty() const { return isEmpty(); }
+
+private:
+    void detach_helper();
+    void rehash(int numBits);
+    static void freeData(QFlatHashData *x);
+    static int place(QFlatHashData *x, Node &carry, uint h);
+    inline uint hashOf(const Key &key) const { return qHash(key, d->seed); }
+    int findBucket(const Key &key, uint h) const;
+    inline int findBucket(const Key &key) const { return findBucket(key, hashOf(key)); }
+    int insertNew(const Key &key, const T &value, uint h);
+    void eraseBucket(int bucket);
+
+    inline int firstPos() const
+    {
+        const int start = d->firstBucket();
+        int pos = 0;
+        while (pos < d->numBuckets && !d->buckets[(start + pos) & (d->numBuckets - 1)].probe)
+            ++pos;
+        return pos;
+    }
+    inline int posOf(int bucket) const { return (bucket - d->firstBucket()) & (d->numBuckets - 1); }
+};
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE QFlatHash<Key, T> &QFlatHash<Key, T>::operator=(const QFlatHash &other)
+{
+    if (d != other.d) {
+        QFlatHashData *o = other.d;
+        o->ref.ref();
+        if (!d->ref.deref())
+            freeData(d);
+        d = o;
+        if (!d->ref.isSharable())
+            detach_helper();
+    }
+    return *this;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE void QFlatHash<Key, T>::freeData(QFlatHashData *x)
+{
+    if (QTypeInfo<Key>::isComplex || QTypeInfo<T>::isComplex) {
+        Node *n = nodesOf(x);
+        for (int i = 0; i < x->numBuckets; ++i) {
+            if (x->buckets[i].probe)
+                n[i].~Node();
+        }
+    }
+    QFlatHashData::deallocate(x, Q_ALIGNOF(Node));
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE void QFlatHash<Key, T>::detach_helper()
+{
+    if (!d->numBuckets) {
+        // nothing to copy; the shared null is never written to
+        if (d != &QFlatHashData::shared_null && !d->ref.deref())
+            freeData(d);
+        d = const_cast<QFlatHashData *>(&QFlatHashData::shared_null);
+        return;
+    }
+
+    QFlatHashData *x = QFlatHashData::allocate(d->numBits, sizeof(Node), Q_ALIGNOF(Node));
+    x->seed = d->seed;
+    Node *src = nodes();
+    Node *dst = nodesOf(x);
+    QT_TRY {
+        for (int i = 0; i < d->numBuckets; ++i) {
+            if (d->buckets[i].probe) {
+                new (dst + i) Node(src[i]);
+                x->buckets[i] = d->buckets[i];
+                ++x->size;
+            }
+        }
+    } QT_CATCH(...) {
+        freeData(x);
+        QT_RETHROW;
+    }
+    if (!d->ref.deref())
+        freeData(d);
+    d = x;
+}
+
+/*
+    Robin hood insertion: an entry takes the place of any entry that is
+    closer to its home bucket, and that one moves on. Returns the bucket
+    \a carry (whose key hashes to \a h) ends up in; \a carry is left moved from.
+*/
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE int QFlatHash<Key, T>::place(QFlatHashData *x, Node &carry, uint h)
+{
+    Node *n = nodesOf(x);
+    const int mask = x->numBuckets - 1;
+    int i = x->bucketOf(h);
+    int placed = -1;
+    for (uint probe = 1; ; ++probe, i = (i + 1) & mask) {
+        QFlatHashData::Bucket &b = x->buckets[i];
+        if (!b.probe) {
+            new (n + i) Node(qMove(carry));
+            b.probe = probe;
+            b.hash = h;
+            ++x->size;
+            return placed < 0 ? i : placed;
+        }
+        if (b.probe < probe) {
+            qSwap(n[i], carry);
+            qSwap(b.probe, probe);
+            qSwap(b.hash, h);
+            if (placed < 0)
+                placed = i;
+        }
+    }
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE void QFlatHash<Key, T>::rehash(int numBits)
+{
+    QFlatHashData *x = QFlatHashData::allocate(numBits, sizeof(Node), Q_ALIGNOF(Node));
+    if (d->numBuckets)
+        x->seed = d->seed;
+
+    const bool shared = d->ref.isShared();
+    Node *n = nodes();
+    for (int i = 0; i < d->numBuckets; ++i) {
+        if (!d->buckets[i].probe)
+            continue;
+        if (shared) {
+            Node carry(n[i]);
+            place(x, carry, d->buckets[i].hash);
+        } else {
+            Node carry(qMove(n[i]));
+            n[i].~Node();
+            d->buckets[i].probe = 0;
+            place(x, carry, d->buckets[i].hash);
+        }
+    }
+
+    if (!d->ref.deref())
+        freeData(d);
+    d = x;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE int QFlatHash<Key, T>::findBucket(const Key &key, uint h) const
+{
+    if (!d->size)
+        return -1;
+    const Node *n = nodes();
+    const int mask = d->numBuckets - 1;
+    int i = d->bucketOf(h);
+    for (uint probe = 1; ; ++probe, i = (i + 1) & mask) {
+        const QFlatHashData::Bucket &b = d->buckets[i];
+        if (b.probe < probe)
+            return -1;
+        if (b.probe == probe && b.hash == h && n[i].key == key)
+            return i;
+    }
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE int QFlatHash<Key, T>::insertNew(const Key &key, const T &value, uint h)
+{
+    if (d->size >= d->capacity()) {
+        const uint seed = d->seed;
+        rehash(qMax(d->numBits + 1, QFlatHashData::numBitsForCapacity(d->size + 1)));
+        if (d->seed != seed) // the first allocation picks the seed
+            h = hashOf(key);
+    }
+    Node carry(key, value);
+    return place(d, carry, h);
+}
+
+/*
+    Removes the entry in \a bucket and shifts the entries after it that are
+    not in their home bucket one bucket back, so that no tombstones are left.
+*/
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE void QFlatHash<Key, T>::eraseBucket(int bucket)
+{
+    Node *n = nodes();
+    const int mask = d->numBuckets - 1;
+    int i = bucket;
+    n[i].~Node();
+    for (int j = (i + 1) & mask; d->buckets[j].probe > 1; i = j, j = (j + 1) & mask) {
+        new (n + i) Node(qMove(n[j]));
+        n[j].~Node();
+        d->buckets[i].probe = d->buckets[j].probe - 1;
+        d->buckets[i].hash = d->buckets[j].hash;
+    }
+    d->buckets[i].probe = 0;
+    --d->size;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE void QFlatHash<Key, T>::reserve(int asize)
+{
+    const int numBits = QFlatHashData::numBitsForCapacity(asize);
+    if (numBits > d->numBits)
+        rehash(numBits);
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE void QFlatHash<Key, T>::squeeze()
+{
+    if (!d->size) {
+        clear();
+        return;
+    }
+    const int numBits = QFlatHashData::numBitsForCapacity(d->size);
+    if (numBits < d->numBits)
+        rehash(numBits);
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE void QFlatHash<Key, T>::clear()
+{
+    *this = QFlatHash();
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE int QFlatHash<Key, T>::remove(const Key &key)
+{
+    if (isEmpty()) // prevents detaching shared null
+        return 0;
+    detach();
+    const int i = findBucket(key);
+    if (i < 0)
+        return 0;
+    eraseBucket(i);
+    return 1;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE T QFlatHash<Key, T>::take(const Key &key)
+{
+    if (isEmpty()) // prevents detaching shared null
+        return T();
+    detach();
+    const int i = findBucket(key);
+    if (i < 0)
+        return T();
+    T t = qMove(nodes()[i].value);
+    eraseBucket(i);
+    return t;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE const Key QFlatHash<Key, T>::key(const T &avalue) const
+{
+    return key(avalue, Key());
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE const Key QFlatHash<Key, T>::key(const T &avalue, const Key &defaultKey) const
+{
+    for (const_iterator it = begin(); it != end(); ++it) {
+        if (it.value() == avalue)
+            return it.key();
+    }
+    return defaultKey;
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE const T QFlatHash<Key, T>::value(const Key &akey) const
+{
+    const int i = findBucket(akey);
+    return i < 0 ? T() : nodes()[i].value;
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE const T QFlatHash<Key, T>::value(const Key &akey, const T &defaultValue) const
+{
+    const int i = findBucket(akey);
+    return i < 0 ? defaultValue : nodes()[i].value;
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE T &QFlatHash<Key, T>::operator[](const Key &akey)
+{
+    detach();
+    const uint h = hashOf(akey);
+    int i = findBucket(akey, h);
+    if (i < 0)
+        i = insertNew(akey, T(), h);
+    return nodes()[i].value;
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE const T QFlatHash<Key, T>::operator[](const Key &akey) const
+{
+    return value(akey);
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE QList<Key> QFlatHash<Key, T>::keys() const
+{
+    QList<Key> res;
+    res.reserve(size());
+    for (const_iterator it = begin(); it != end(); ++it)
+        res.append(it.key());
+    return res;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE QList<T> QFlatHash<Key, T>::values() const
+{
+    QList<T> res;
+    res.reserve(size());
+    for (const_iterator it = begin(); it != end(); ++it)
+        res.append(it.value());
+    return res;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE typename QFlatHash<Key, T>::iterator QFlatHash<Key, T>::erase(iterator it)
+{
+    if (it == end())
+        return it;
+
+    if (d->ref.isShared()) {
+        const Key key = it.key();
+        detach();
+        it = find(key);
+    }
+
+    // entries only move back within the iteration order, so whatever took
+    // the place of the erased entry has not been visited yet
+    const int bucket = it.bucket();
+    eraseBucket(bucket);
+    iterator next(d, it.start, it.pos);
+    if (!d->buckets[bucket].probe)
+        ++next;
+    return next;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE typename QFlatHash<Key, T>::iterator QFlatHash<Key, T>::find(const Key &akey)
+{
+    detach();
+    const int i = findBucket(akey);
+    if (i < 0)
+        return end();
+    return iterator(d, d->firstBucket(), posOf(i));
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE typename QFlatHash<Key, T>::const_iterator QFlatHash<Key, T>::find(const Key &akey) const
+{
+    const int i = findBucket(akey);
+    if (i < 0)
+        return end();
+    return const_iterator(d, d->firstBucket(), posOf(i));
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE typename QFlatHash<Key, T>::iterator QFlatHash<Key, T>::insert(const Key &akey, const T &avalue)
+{
+    detach();
+    const uint h = hashOf(akey);
+    int i = findBucket(akey, h);
+    if (i >= 0)
+        nodes()[i].value = avalue;
+    else
+        i = insertNew(akey, avalue, h);
+    return iterator(d, d->firstBucket(), posOf(i));
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE bool QFlatHash<Key, T>::operator==(const QFlatHash &other) const
+{
+    if (size() != other.size())
+        return false;
+    if (d == other.d)
+        return true;
+
+    for (const_iterator it = begin(); it != end(); ++it) {
+        const int i = other.findBucket(it.key());
+        if (i < 0 || !(other.nodes()[i].value == it.value()))
+            return false;
+    }
+    return true;
+}
+
+Q_DECLARE_ASSOCIATIVE_ITERATOR(FlatHash)
+Q_DECLARE_MUTABLE_ASSOCIATIVE_ITERATOR(FlatHash)
+
+QT_END_NAMESPACE
+
+#endif // QFLATHASH_H
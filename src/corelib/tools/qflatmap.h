@@ -0,0 +1,503 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QFLATMAP_H
+#define QFLATMAP_H
+
+#include <QtCore/qiterator.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qmap.h>
+#include <QtCore/qpair.h>
+#include <QtCore/qvector.h>
+
+#include <algorithm>
+
+#ifdef Q_COMPILER_INITIALIZER_LISTS
+#include <initializer_list>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+template <class Key, class T>
+class QFlatMap
+{
+    // keys and values live in separate arrays, so that a lookup only has to
+    // binary search through the keys
+    QVector<Key> m_keys;
+    QVector<T> m_values;
+
+    static inline bool lessThan(const Key &key1, const Key &key2) { return qMapLessThanKey(key1, key2); }
+
+    struct KeyLessThan
+    {
+        inline bool operator()(const Key &key1, const Key &key2) const { return lessThan(key1, key2); }
+    };
+
+public:
+    inline QFlatMap() Q_DECL_NOTHROW { }
+#ifdef Q_COMPILER_INITIALIZER_LISTS
+    inline QFlatMap(std::initializer_list<std::pair<Key,T> > list)
+    {
+        QVector<QPair<Key, T> > pairs;
+        pairs.reserve(int(list.size()));
+        for (typename std::initializer_list<std::pair<Key,T> >::const_iterator it = list.begin(); it != list.end(); ++it)
+            pairs.append(qMakePair(it->first, it->second));
+        assign(pairs);
+    }
+#endif
+    explicit QFlatMap(const QMap<Key, T> &map);
+
+    inline void swap(QFlatMap &other) Q_DECL_NOTHROW
+    {
+        m_keys.swap(other.m_keys);
+        m_values.swap(other.m_values);
+    }
+
+    static QFlatMap<Key, T> fromVector(const QVector<QPair<Key, T> > &pairs);
+    QMap<Key, T> toMap() const;
+
+    inline bool operator==(const QFlatMap &other) const
+    { return m_keys == other.m_keys && m_values == other.m_values; }
+    inline bool operator!=(const QFlatMap &other) const { return !(*this == other); }
+
+    inline int size() const { return m_keys.size(); }
+    inline int count() const { return m_keys.size(); }
+    inline bool isEmpty() const { return m_keys.isEmpty(); }
+
+    inline int capacity() const { return m_keys.capacity(); }
+    inline void reserve(int size) { m_keys.reserve(size); m_values.reserve(size); }
+    inline void squeeze() { m_keys.squeeze(); m_values.squeeze(); }
+
+    inline void detach()
+    {
+        if (!isEmpty()) { // an empty map has nothing to write to
+            m_keys.detach();
+            m_values.detach();
+        }
+    }
+    inline bool isDetached() const { return m_keys.isDetached() && m_values.isDetached(); }
+    inline bool isSharedWith(const QFlatMap &other) const
+    { return m_keys.isSharedWith(other.m_keys) && m_values.isSharedWith(other.m_values); }
+
+    inline void clear() { *this = QFlatMap(); }
+
+    int remove(const Key &key);
+    T take(const Key &key);
+
+    inline bool contains(const Key &key) const { return indexOf(key) >= 0; }
+    inline int count(const Key &key) const { return indexOf(key) >= 0 ? 1 : 0; }
+    const Key key(const T &value, const Key &defaultKey = Key()) const;
+    const T value(const Key &key, const T &defaultValue = T()) const;
+    T &operator[](const Key &key);
+    const T operator[](const Key &key) const;
+
+    QList<Key> keys() const;
+    QList<Key> keys(const T &value) const;
+    QList<T> values() const;
+
+    inline const Key &firstKey() const { Q_ASSERT(!isEmpty()); return m_keys.first(); }
+    inline const Key &lastKey() const { Q_ASSERT(!isEmpty()); return m_keys.last(); }
+
+    inline T &first() { Q_ASSERT(!isEmpty()); return m_values.first(); }
+    inline const T &first() const { Q_ASSERT(!isEmpty()); return m_values.first(); }
+    inline T &last() { Q_ASSERT(!isEmpty()); return m_values.last(); }
+    inline const T &last() const { Q_ASSERT(!isEmpty()); return m_values.last(); }
+
+    class const_iterator;
+
+    class iterator
+    {
+        friend class QFlatMap;
+        friend class const_iterator;
+        const Key *k;
+        T *v;
+
+        inline iterator(const Key *k0, T *v0) : k(k0), v(v0) { }
+
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef qptrdiff difference_type;
+        typedef T value_type;
+        typedef T *pointer;
+        typedef T &reference;
+
+        inline iterator() : k(0), v(0) { }
+
+        inline const Key &key() const { return *k; }
+        inline T &value() const { return *v; }
+        inline T &operator*() const { return *v; }
+        inline T *operator->() const { return v; }
+        inline bool operator==(const iterator &o) const { return k == o.k; }
+        inline bool operator!=(const iterator &o) const { return k != o.k; }
+        inline bool operator<(const iterator &o) const { return k < o.k; }
+
+        inline iterator &operator++() { ++k; ++v; return *this; }
+        inline iterator operator++(int) { iterator r = *this; ++k; ++v; return r; }
+        inline iterator &operator--() { --k; --v; return *this; }
+        inline iterator operator--(int) { iterator r = *this; --k; --v; return r; }
+        inline iterator &operator+=(difference_type j) { k += j; v += j; return *this; }
+        inline iterator &operator-=(difference_type j) { k -= j; v -= j; return *this; }
+        inline iterator operator+(difference_type j) const { return iterator(k + j, v + j); }
+        inline iterator operator-(difference_type j) const { return iterator(k - j, v - j); }
+        inline difference_type operator-(const iterator &o) const { return k - o.k; }
+
+        inline bool operator==(const const_iterator &o) const { return k == o.k; }
+        inline bool operator!=(const const_iterator &o) const { return k != o.k; }
+    };
+    friend class iterator;
+
+    class const_iterator
+    {
+        friend class QFlatMap;
+        friend class iterator;
+        const Key *k;
+        const T *v;
+
+        inline const_iterator(const Key *k0, const T *v0) : k(k0), v(v0) { }
+
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef qptrdiff difference_type;
+        typedef T value_type;
+        typedef const T *pointer;
+        typedef const T &reference;
+
+        inline const_iterator() : k(0), v(0) { }
+        inline const_iterator(const iterator &o) : k(o.k), v(o.v) { }
+
+        inline const Key &key() const { return *k; }
+        inline const T &value() const { return *v; }
+        inline const T &operator*() const { return *v; }
+        inline const T *operator->() const { return v; }
+        inline bool operator==(const const_iterator &o) const { return k == o.k; }
+        inline bool operator!=(const const_iterator &o) const { return k != o.k; }
+        inline bool operator<(const const_iterator &o) const { return k < o.k; }
+
+        inline const_iterator &operator++() { ++k; ++v; return *this; }
+        inline const_iterator operator++(int) { const_iterator r = *this; ++k; ++v; return r; }
+        inline const_iterator &operator--() { --k; --v; return *this; }
+        inline const_iterator operator--(int) { const_iterator r = *this; --k; --v; return r; }
+        inline const_iterator &operator+=(difference_type j) { k += j; v += j; return *this; }
+        inline const_iterator &operator-=(difference_type j) { k -= j; v -= j; return *this; }
+        inline const_iterator operator+(difference_type j) const { return const_iterator(k + j, v + j); }
+        inline const_iterator operator-(difference_type j) const { return const_iterator(k - j, v - j); }
+        inline difference_type operator-(const const_iterator &o) const { return k - o.k; }
+    };
+    friend class const_iterator;
+
+    // STL style
+    inline iterator begin() { detach(); return iteratorAt(0); }
+    inline const_iterator begin() const { return constIteratorAt(0); }
+    inline const_iterator cbegin() const { return begin(); }
+    inline const_iterator constBegin() const { return begin(); }
+    inline iterator end() { detach(); return iteratorAt(size()); }
+    inline const_iterator end() const { return constIteratorAt(size()); }
+    inline const_iterator cend() const { return end(); }
+    inline const_iterator constEnd() const { return end(); }
+    iterator erase(iterator it);
+    inline iterator erase(const_iterator it) { return erase(iteratorAt(positionOf(it))); }
+
+    iterator find(const Key &key);
+    const_iterator find(const Key &key) const;
+    inline const_iterator constFind(const Key &key) const { return find(key); }
+    inline iterator lowerBound(const Key &key) { detach(); return iteratorAt(lowerBoundIndex(key)); }
+    inline const_iterator lowerBound(const Key &key) const { return constIteratorAt(lowerBoundIndex(key)); }
+    inline iterator upperBound(const Key &key) { detach(); return iteratorAt(upperBoundIndex(key)); }
+    inline const_iterator upperBound(const Key &key) const { return constIteratorAt(upperBoundIndex(key)); }
+    iterator insert(const Key &key, const T &value);
+
+    // STL compatibility
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef qptrdiff difference_type;
+    typedef int size_type;
+
+    inline bool empty() const { return isEmpty(); }
+
+private:
+    struct PositionLessThan
+    {
+        const QVector<QPair<Key, T> > &pairs;
+        inline bool operator()(int i, int j) const { return lessThan(pairs.at(i).first, pairs.at(j).first); }
+    };
+
+    void assign(const QVector<QPair<Key, T> > &pairs);
+
+    // For cheap keys, binary searches that narrow the range by moving its
+    // start only, which compilers turn into conditional moves: unlike the
+    // branches of std::lower_bound(), those cannot be mispredicted. Complex
+    // keys are slow to compare, and there speculating past each comparison
+    // wins.
+    inline int lowerBoundIndex(const Key &key) const
+    {
+        if (QTypeInfo<Key>::isComplex)
+            return int(std::lower_bound(m_keys.constBegin(), m_keys.constEnd(), key, KeyLessThan()) - m_keys.constBegin());
+        const Key *first = m_keys.constData();
+        const Key *base = first;
+        int n = m_keys.size();
+        if (!n)
+            return 0;
+        while (n > 1) {
+            const int half = n / 2;
+            base = lessThan(base[half], key) ? base + half : base;
+            n -= half;
+        }
+        return int(base - first) + int(lessThan(*base, key));
+    }
+    inline int upperBoundIndex(const Key &key) const
+    {
+        if (QTypeInfo<Key>::isComplex)
+            return int(std::upper_bound(m_keys.constBegin(), m_keys.constEnd(), key, KeyLessThan()) - m_keys.constBegin());
+        const Key *first = m_keys.constData();
+        const Key *base = first;
+        int n = m_keys.size();
+        if (!n)
+            return 0;
+        while (n > 1) {
+            const int half = n / 2;
+            base = lessThan(key, base[half]) ? base : base + half;
+            n -= half;
+        }
+        return int(base - first) + int(!lessThan(key, *base));
+    }
+    inline int indexOf(const Key &key) const
+    {
+        const int i = lowerBoundIndex(key);
+        return i < size() && !lessThan(key, m_keys.at(i)) ? i : -1;
+    }
+    inline int positionOf(const_iterator it) const { return int(it.k - m_keys.constData()); }
+
+    // only valid after detach(): data() would detach again otherwise
+    inline iterator iteratorAt(int i)
+    { return iterator(m_keys.constData() + i, const_cast<T *>(m_values.constData()) + i); }
+    inline const_iterator constIteratorAt(int i) const
+    { return const_iterator(m_keys.constData() + i, m_values.constData() + i); }
+};
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE QFlatMap<Key, T>::QFlatMap(const QMap<Key, T> &map)
+{
+    reserve(map.size());
+    for (typename QMap<Key, T>::const_iterator it = map.constBegin(); it != map.constEnd(); ++it) {
+        // of several values inserted with insertMulti(), the first one
+        // is the one QMap::value() returns
+        if (!m_keys.isEmpty() && !lessThan(m_keys.last(), it.key()))
+            continue;
+        m_keys.append(it.key());
+        m_values.append(it.value());
+    }
+}
+
+/*
+    Fills the empty map from \a pairs in one go: sorting once is much
+    cheaper than inserting into the middle of the arrays over and over.
+    Of equal keys the last one wins, as with repeated insert().
+*/
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE void QFlatMap<Key, T>::assign(const QVector<QPair<Key, T> > &pairs)
+{
+    Q_ASSERT(isEmpty());
+    const int n = pairs.size();
+    reserve(n);
+
+    bool sorted = true;
+    for (int i = 1; i < n && sorted; ++i)
+        sorted = lessThan(pairs.at(i - 1).first, pairs.at(i).first);
+    if (sorted) {
+        for (int i = 0; i < n; ++i) {
+            m_keys.append(pairs.at(i).first);
+            m_values.append(pairs.at(i).second);
+        }
+        return;
+    }
+
+    // sort positions rather than the pairs, so that no key or value is
+    // copied more than once
+    QVector<int> order(n);
+    for (int i = 0; i < n; ++i)
+        order[i] = i;
+    const PositionLessThan positionLessThan = { pairs };
+    std::stable_sort(order.begin(), order.end(), positionLessThan);
+
+    for (int i = 0; i < n; ++i) {
+        if (i + 1 < n && !positionLessThan(order.at(i), order.at(i + 1)))
+            continue;
+        const QPair<Key, T> &pair = pairs.at(order.at(i));
+        m_keys.append(pair.first);
+        m_values.append(pair.second);
+    }
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE QFlatMap<Key, T> QFlatMap<Key, T>::fromVector(const QVector<QPair<Key, T> > &pairs)
+{
+    QFlatMap<Key, T> map;
+    map.assign(pairs);
+    return map;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE QMap<Key, T> QFlatMap<Key, T>::toMap() const
+{
+    QMap<Key, T> map;
+    for (int i = size() - 1; i >= 0; --i)
+        map.insert(map.constBegin(), m_keys.at(i), m_values.at(i));
+    return map;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE int QFlatMap<Key, T>::remove(const Key &akey)
+{
+    const int i = indexOf(akey);
+    if (i < 0)
+        return 0;
+    m_keys.remove(i);
+    m_values.remove(i);
+    return 1;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE T QFlatMap<Key, T>::take(const Key &akey)
+{
+    const int i = indexOf(akey);
+    if (i < 0)
+        return T();
+    T t = m_values.at(i);
+    m_keys.remove(i);
+    m_values.remove(i);
+    return t;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE const Key QFlatMap<Key, T>::key(const T &avalue, const Key &defaultKey) const
+{
+    const int i = m_values.indexOf(avalue);
+    return i < 0 ? defaultKey : m_keys.at(i);
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE const T QFlatMap<Key, T>::value(const Key &akey, const T &defaultValue) const
+{
+    const int i = indexOf(akey);
+    return i < 0 ? defaultValue : m_values.at(i);
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE T &QFlatMap<Key, T>::operator[](const Key &akey)
+{
+    const int i = lowerBoundIndex(akey);
+    if (i == size() || lessThan(akey, m_keys.at(i))) {
+        m_keys.insert(i, akey);
+        m_values.insert(i, T());
+    }
+    return m_values[i];
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE const T QFlatMap<Key, T>::operator[](const Key &akey) const
+{
+    return value(akey);
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE QList<Key> QFlatMap<Key, T>::keys() const
+{
+    return m_keys.toList();
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE QList<Key> QFlatMap<Key, T>::keys(const T &avalue) const
+{
+    QList<Key> res;
+    for (int i = 0; i < size(); ++i) {
+        if (m_values.at(i) == avalue)
+            res.append(m_keys.at(i));
+    }
+    return res;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE QList<T> QFlatMap<Key, T>::values() const
+{
+    return m_values.toList();
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE typename QFlatMap<Key, T>::iterator QFlatMap<Key, T>::erase(iterator it)
+{
+    // positions survive detaching, so map the iterator over in case it
+    // was taken from a copy that has been detached from since
+    const int i = positionOf(it);
+    if (i == size())
+        return it;
+    m_keys.remove(i);
+    m_values.remove(i);
+    detach();
+    return iteratorAt(i);
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE typename QFlatMap<Key, T>::iterator QFlatMap<Key, T>::find(const Key &akey)
+{
+    detach();
+    const int i = indexOf(akey);
+    return iteratorAt(i < 0 ? size() : i);
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE typename QFlatMap<Key, T>::const_iterator QFlatMap<Key, T>::find(const Key &akey) const
+{
+    const int i = indexOf(akey);
+    return constIteratorAt(i < 0 ? size() : i);
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE typename QFlatMap<Key, T>::iterator QFlatMap<Key, T>::insert(const Key &akey, const T &avalue)
+{
+    const int i = lowerBoundIndex(akey);
+    if (i < size() && !lessThan(akey, m_keys.at(i))) {
+        m_values[i] = avalue;
+    } else {
+        m_keys.insert(i, akey);
+        m_values.insert(i, avalue);
+    }
+    detach();
+    return iteratorAt(i);
+}
+
+Q_DECLARE_ASSOCIATIVE_ITERATOR(FlatMap)
+Q_DECLARE_MUTABLE_ASSOCIATIVE_ITERATOR(FlatMap)
+
+QT_END_NAMESPACE
+
+#endif // QFLATMAP_H
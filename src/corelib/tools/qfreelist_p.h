@@ -47,6 +47,8 @@
 
 #include <QtCore/qatomic.h>
 
+#include <string.h>
+
 QT_BEGIN_NAMESPACE
 
 
@@ -102,6 +104,8 @@ struct QFreeListElement<void>
 
     - Sizes static int[] array to define the size of each block.
 
+    - No per-thread magazines are used (MagazineSize is zero), see QFreeList.
+
     It is possible to define your own constants struct/class and give this to
     QFreeList to customize/tune the behavior.
 */
@@ -114,7 +118,8 @@ struct Q_AUTOTEST_EXPORT QFreeListDefaultConstants
         SerialMask = ~IndexMask & ~0x80000000,
         SerialCounter = IndexMask + 1,
         MaxIndex = IndexMask,
-        BlockCount = 4
+        BlockCount = 4,
+        MagazineSize = 0
     };
 
     static const int Sizes[BlockCount];
@@ -136,6 +141,16 @@ struct Q_AUTOTEST_EXPORT QFreeListDefaultConstants
     The ConstantsType type defaults to QFreeListDefaultConstants above. You can
     define your custom ConstantsType, see above for details on what needs to be
     available.
+
+    If ConstantsType::MagazineSize is not zero, every thread keeps a magazine
+    of up to that many free ids in front of the shared list. next() and
+    release() then only touch the shared list, which all threads contend
+    for, once every MagazineSize / 2 calls, and move that many ids in a
+    single atomic operation. The magazines of a thread serve the first
+    instance of the QFreeList type that was used in that thread; other
+    instances use the shared list directly. Ids cached by a thread are given
+    back when it exits, so magazines are meant for free lists with static
+    storage duration, like Q_GLOBAL_STATIC ones.
 */
 template <typename T, typename ConstantsType = QFreeListDefaultConstants>
 class QFreeList
@@ -182,6 +197,64 @@ class QFreeList
     // QFreeList is not copyable
     Q_DISABLE_COPY(QFreeList)
 
+    // returns the element for the index \a x, or 0 if its block has not been allocated
+    inline ElementType *elementIfAllocated(int x) const
+    {
+        const int block = blockfor(x);
+        ElementType *v = _v[block].loadAcquire();
+        return v ? v + x : 0;
+    }
+
+    // returns the element for the index \a x, allocating its block if needed
+    inline ElementType *element(int x)
+    {
+        const int offset = x;
+        const int block = blockfor(x);
+        ElementType *v = _v[block].loadAcquire();
+        if (!v) {
+            v = allocate(offset - x, ConstantsType::Sizes[block]);
+            if (!_v[block].testAndSetRelease(0, v)) {
+                // race with another thread lost
+                delete [] v;
+                v = _v[block].loadAcquire();
+                Q_ASSERT(v != 0);
+            }
+        }
+        return v + x;
+    }
+
+    inline int nextShared();
+    inline int takeShared(int *ids, int count);
+    inline void releaseShared(const int *ids, int count);
+
+#ifdef Q_COMPILER_THREAD_LOCAL
+    struct Magazine
+    {
+        QFreeList *owner;
+        int count;
+        int ids[int(ConstantsType::MagazineSize) > 0 ? int(ConstantsType::MagazineSize) : 1];
+
+        ~Magazine()
+        {
+            // the free list may have been destroyed already at exit
+            if (owner && count && owner->_v[0].load())
+                owner->releaseShared(ids, count);
+        }
+    };
+
+    // returns the magazine of the current thread if it serves this free list, or 0
+    inline Magazine *magazine()
+    {
+        static thread_local Magazine m = { 0, 0, { 0 } };
+        if (m.owner != this) {
+            if (m.owner)
+                return 0;
+            m.owner = this;
+        }
+        return &m;
+    }
+#endif
+
 public:
     Q_DECL_CONSTEXPR inline QFreeList();
     inline ~QFreeList();
@@ -206,8 +279,10 @@ Q_DECL_CONSTEXPR inline QFreeList<T, ConstantsType>::QFreeList()
 template <typename T, typename ConstantsType>
 inline QFreeList<T, ConstantsType>::~QFreeList()
 {
-    for (int i = 0; i < ConstantsType::BlockCount; ++i)
+    for (int i = 0; i < ConstantsType::BlockCount; ++i) {
         delete [] _v[i].load();
+        _v[i].store(0);
+    }
 }
 
 template <typename T, typename ConstantsType>
@@ -227,26 +302,47 @@ inline typename QFreeList<T, ConstantsType>::ReferenceType QFreeList<T, Constant
 template <typename T, typename ConstantsType>
 inline int QFreeList<T, ConstantsType>::next()
 {
-    int id, newid, at;
-    ElementType *v;
-    do {
-        id = _next.load();
-
-        at = id & ConstantsType::IndexMask;
-        const int block = blockfor(at);
-        v = _v[block].loadAcquire();
+#ifdef Q_COMPILER_THREAD_LOCAL
+    if (int(ConstantsType::MagazineSize) > 0) {
+        if (Magazine *m = magazine()) {
+            if (!m->count)
+                m->count = takeShared(m->ids, qMax(int(ConstantsType::MagazineSize) / 2, 1));
+            return m->ids[--m->count];
+        }
+    }
+#endif
+    return nextShared();
+}
 
-        if (!v) {
-            v = allocate((id & ConstantsType::IndexMask) - at, ConstantsType::Sizes[block]);
-            if (!_v[block].testAndSetRelease(0, v)) {
-                // race with another thread lost
-                delete [] v;
-                v = _v[block].loadAcquire();
-                Q_ASSERT(v != 0);
+template <typename T, typename ConstantsType>
+inline void QFreeList<T, ConstantsType>::release(int id)
+{
+#ifdef Q_COMPILER_THREAD_LOCAL
+    if (int(ConstantsType::MagazineSize) > 0) {
+        if (Magazine *m = magazine()) {
+            if (m->count == ConstantsType::MagazineSize) {
+                // give the older half back
+                const int half = qMax(int(ConstantsType::MagazineSize) / 2, 1);
+                releaseShared(m->ids, half);
+                m->count -= half;
+                memmove(m->ids, m->ids + half, m->count * sizeof(int));
             }
+            m->ids[m->count++] = id & ConstantsType::IndexMask;
+            return;
         }
+    }
+#endif
+    releaseShared(&id, 1);
+}
 
-        newid = v[at].next.load() | (id & ~ConstantsType::IndexMask);
+template <typename T, typename ConstantsType>
+inline int QFreeList<T, ConstantsType>::nextShared()
+{
+    int id, newid;
+    do {
+        id = _next.load();
+        ElementType *e = element(id & ConstantsType::IndexMask);
+        newid = e->next.load() | (id & ~ConstantsType::IndexMask);
     } while (!_next.testAndSetRelaxed(id, newid));
     // qDebug("QFreeList::next(): returning %d (_next now %d, serial %d)",
     //        id & ConstantsType::IndexMask,
@@ -255,22 +351,48 @@ inline int QFreeList<T, ConstantsType>::next()
     return id & ConstantsType::IndexMask;
 }
 
+// Takes up to \a count ids from the shared list at once, stores them in \a ids
+// and returns how many were taken, at least one. Fewer are taken when the list
+// would need a new block for them.
 template <typename T, typename ConstantsType>
-inline void QFreeList<T, ConstantsType>::release(int id)
+inline int QFreeList<T, ConstantsType>::takeShared(int *ids, int count)
 {
-    int at = id & ConstantsType::IndexMask;
-    const int block = blockfor(at);
-    ElementType *v = _v[block].load();
+    int id, newid, n;
+    do {
+        id = _next.loadAcquire();
+        int x = id & ConstantsType::IndexMask;
+        ElementType *e = element(x);
+        n = 0;
+        for (;;) {
+            ids[n++] = x;
+            // the links may change under our feet, but then the serial
+            // number changes too and the exchange below fails
+            x = e->next.load() & ConstantsType::IndexMask;
+            if (n == count || x >= ConstantsType::MaxIndex || !(e = elementIfAllocated(x)))
+                break;
+        }
+        newid = x | (id & ~ConstantsType::IndexMask);
+    } while (!_next.testAndSetAcquire(id, newid));
+    return n;
+}
+
+// Gives the \a count ids in \a ids back to the shared list at once.
+template <typename T, typename ConstantsType>
+inline void QFreeList<T, ConstantsType>::releaseShared(const int *ids, int count)
+{
+    for (int i = 0; i < count - 1; ++i)
+        element(ids[i] & ConstantsType::IndexMask)->next.store(ids[i + 1] & ConstantsType::IndexMask);
+    ElementType *last = element(ids[count - 1] & ConstantsType::IndexMask);
 
     int x, newid;
     do {
         x = _next.loadAcquire();
-        v[at].next.store(x & ConstantsType::IndexMask);
+        last->next.store(x & ConstantsType::IndexMask);
 
-        newid = incrementserial(x, id);
+        newid = incrementserial(x, ids[0]);
     } while (!_next.testAndSetRelease(x, newid));
     // qDebug("QFreeList::release(%d): _next now %d (was %d), serial %d",
-    //        id & ConstantsType::IndexMask,
+    //        ids[0] & ConstantsType::IndexMask,
     //        newid & ConstantsType::IndexMask,
     //        x & ConstantsType::IndexMask,
     //        (newid & ~ConstantsType::IndexMask) >> 24);
@@ -41,6 +41,7 @@
 #include <stdlib.h>
 
 #include "qhash.h"
+#include "qflathash.h"
 
 #ifdef truncate
 #undef truncate
@@ -56,6 +57,7 @@
 
 #ifndef QT_BOOTSTRAPPED
 #include <qcoreapplication.h>
+#include <qmonotonicarena.h>
 #endif // QT_BOOTSTRAPPED
 
 #ifdef Q_OS_UNIX
@@ -390,18 +392,36 @@ static int countBits(int hint)
 const int MinNumBits = 4;
 
 const QHashData QHashData::shared_null = {
-    0, 0, Q_REFCOUNT_INITIALIZE_STATIC, 0, 0, MinNumBits, 0, 0, 0, true, false, 0
+    0, 0, Q_REFCOUNT_INITIALIZE_STATIC, 0, 0, MinNumBits, 0, 0, 0, true, false, false, 0
 };
 
+#ifndef QT_BOOTSTRAPPED
+// A QHashData allocated from an arena is preceded by a pointer to the arena,
+// which its nodes come from.
+static QMonotonicArena *arenaOf(QHashData *d)
+{
+    Q_ASSERT(d->arenaAllocated);
+    return reinterpret_cast<QMonotonicArena **>(d)[-1];
+}
+#endif
+
 void *QHashData::allocateNode(int nodeAlign)
 {
-    void *ptr = strictAlignment ? qMallocAligned(nodeSize, nodeAlign) : malloc(nodeSize);
+    void *ptr;
+#ifndef QT_BOOTSTRAPPED
+    if (arenaAllocated)
+        ptr = arenaOf(this)->allocate(nodeSize, qMax(nodeAlign, int(sizeof(void *))));
+    else
+#endif
+        ptr = strictAlignment ? qMallocAligned(nodeSize, nodeAlign) : malloc(nodeSize);
     Q_CHECK_PTR(ptr);
     return ptr;
 }
 
 void QHashData::freeNode(void *node)
 {
+    if (arenaAllocated)
+        return;
     if (strictAlignment)
         qFreeAligned(node);
     else
@@ -412,6 +432,17 @@ QHashData *QHashData::detach_helper(void (*node_duplicate)(Node *, void *),
                                     void (*node_delete)(Node *),
                                     int nodeSize,
                                     int nodeAlign)
+{
+    return detach_helper(node_duplicate, node_delete, nodeSize, nodeAlign, Q_NULLPTR);
+}
+
+// With an arena, the copy and all nodes that are ever added to it are
+// allocated from the arena; the bucket array still comes from the heap.
+QHashData *QHashData::detach_helper(void (*node_duplicate)(Node *, void *),
+                                    void (*node_delete)(Node *),
+                                    int nodeSize,
+                                    int nodeAlign,
+                                    QMonotonicArena *arena)
 {
     union {
         QHashData *d;
@@ -419,7 +450,21 @@ QHashData *QHashData::detach_helper(void (*node_duplicate)(Node *, void *),
     };
     if (this == &shared_null)
         qt_initialize_qhash_seed(); // may throw
-    d = new QHashData;
+#ifndef QT_BOOTSTRAPPED
+    if (arena) {
+        Q_STATIC_ASSERT(Q_ALIGNOF(QHashData) <= sizeof(void *));
+        void **ptr = static_cast<void **>(arena->allocate(sizeof(void *) + sizeof(QHashData),
+                                                          sizeof(void *)));
+        Q_CHECK_PTR(ptr);
+        *ptr = arena;
+        d = new (ptr + 1) QHashData;
+    } else
+#else
+    Q_UNUSED(arena);
+#endif
+    {
+        d = new QHashData;
+    }
     d->fakeNext = 0;
     d->buckets = 0;
     d->ref.initializeOwned();
@@ -431,6 +476,7 @@ QHashData *QHashData::detach_helper(void (*node_duplicate)(Node *, void *),
     d->seed = (this == &shared_null) ? uint(qt_qhash_seed.load()) : seed;
     d->sharable = true;
     d->strictAlignment = nodeAlign > 8;
+    d->arenaAllocated = arena != 0;
     d->reserved = 0;
 
     if (numBuckets) {
@@ -450,12 +496,12 @@ QHashData *QHashData::detach_helper(void (*node_duplicate)(Node *, void *),
             Node *oldNode = buckets[i];
             while (oldNode != this_e) {
                 QT_TRY {
-                    Node *dup = static_cast<Node *>(allocateNode(nodeAlign));
+                    Node *dup = static_cast<Node *>(d->allocateNode(nodeAlign));
 
                     QT_TRY {
                         node_duplicate(oldNode, dup);
                     } QT_CATCH(...) {
-                        freeNode( dup );
+                        d->freeNode( dup );
                         QT_RETHROW;
                     }
 
@@ -495,7 +541,8 @@ void QHashData::free_helper(void (*node_delete)(Node *))
         }
     }
     delete [] buckets;
-    delete this;
+    if (!arenaAllocated)
+        delete this;
 }
 
 QHashData::Node *QHashData::nextNode(Node *node)
@@ -654,6 +701,86 @@ void QHashData::checkSanity()
 }
 #endif
 
+/*
+    A QFlatHash has at least pow(2, MinFlatNumBits) buckets, and at most
+    pow(2, MaxFlatNumBits) so that the bucket count fits in an int.
+*/
+const int MinFlatNumBits = 3;
+const int MaxFlatNumBits = 30;
+
+const QFlatHashData QFlatHashData::shared_null = {
+    Q_REFCOUNT_INITIALIZE_STATIC, 0, 0, 0, 0, 0, 0
+};
+
+/*!
+    \internal
+
+    Allocates the data of a QFlatHash with pow(2, \a numBits) empty buckets
+    for nodes of \a nodeSize bytes, all in one block: the bucket array comes
+    first, so lookups scan probe distances and hashes before touching any node.
+    Calls qBadAlloc() if the block does not fit in the address space.
+*/
+QFlatHashData *QFlatHashData::allocate(int numBits, int nodeSize, int nodeAlign)
+{
+    qt_initialize_qhash_seed(); // may throw
+
+    if (numBits > MaxFlatNumBits)
+        qBadAlloc();
+    const int numBuckets = 1 << numBits;
+    nodeAlign = qMax<int>(nodeAlign, Q_ALIGNOF(QFlatHashData));
+    const size_t bucketsOffset = sizeof(QFlatHashData);
+    if (size_t(numBuckets) > (size_t(-1) / 2 - bucketsOffset - nodeAlign) / (sizeof(Bucket) + nodeSize))
+        qBadAlloc();
+    const size_t nodesOffset = (bucketsOffset + numBuckets * sizeof(Bucket) + nodeAlign - 1)
+            & ~size_t(nodeAlign - 1);
+    const size_t allocSize = nodesOffset + size_t(numBuckets) * nodeSize;
+
+    void *ptr = nodeAlign > 8 ? qMallocAligned(allocSize, nodeAlign) : ::malloc(allocSize);
+    Q_CHECK_PTR(ptr);
+
+    QFlatHashData *d = static_cast<QFlatHashData *>(ptr);
+    d->ref.initializeOwned();
+    d->size = 0;
+    d->numBuckets = numBuckets;
+    d->numBits = numBits;
+    d->seed = uint(qt_qhash_seed.load());
+    d->buckets = reinterpret_cast<Bucket *>(static_cast<char *>(ptr) + bucketsOffset);
+    d->nodes = static_cast<char *>(ptr) + nodesOffset;
+    memset(d->buckets, 0, numBuckets * sizeof(Bucket));
+    return d;
+}
+
+/*!
+    \internal
+
+    Frees the block of \a d. The nodes must have been destroyed already.
+*/
+void QFlatHashData::deallocate(QFlatHashData *d, int nodeAlign)
+{
+    nodeAlign = qMax<int>(nodeAlign, Q_ALIGNOF(QFlatHashData));
+    if (nodeAlign > 8)
+        qFreeAligned(d);
+    else
+        ::free(d);
+}
+
+/*!
+    \internal
+
+    Returns the number of bits of the smallest bucket count that holds
+    \a capacity entries without exceeding the maximum load factor. Calls
+    qBadAlloc() if no bucket count an int can hold is large enough.
+*/
+int QFlatHashData::numBitsForCapacity(int capacity)
+{
+    int numBits = MinFlatNumBits;
+    while ((1 << numBits) - (1 << numBits) / 8 < capacity) {
+        if (++numBits > MaxFlatNumBits)
+            qBadAlloc();
+    }
+    return numBits;
+}
+
 /*!
     \fn uint qHash(const QPair<T1, T2> &key, uint seed = 0)
     \since 5.0
@@ -53,6 +53,8 @@
 
 QT_BEGIN_NAMESPACE
 
+class QMonotonicArena;
+
 struct Q_CORE_EXPORT QHashData
 {
     struct Node {
@@ -71,12 +73,15 @@ struct Q_CORE_EXPORT QHashData
     uint seed;
     uint sharable : 1;
     uint strictAlignment : 1;
-    uint reserved : 30;
+    uint arenaAllocated : 1;
+    uint reserved : 29;
 
     void *allocateNode(int nodeAlign);
     void freeNode(void *node);
     QHashData *detach_helper(void (*node_duplicate)(Node *, void *), void (*node_delete)(Node *),
                              int nodeSize, int nodeAlign);
+    QHashData *detach_helper(void (*node_duplicate)(Node *, void *), void (*node_delete)(Node *),
+                             int nodeSize, int nodeAlign, QMonotonicArena *arena);
     bool willGrow();
     void hasShrunk();
     void rehash(int hint);
@@ -472,6 +477,7 @@ private:
 #endif
     }
     friend class QSet<Key>;
+    friend class QMonotonicArena;
 };
 
 
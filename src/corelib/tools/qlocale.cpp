@@ -2764,10 +2764,12 @@ QString QLocaleData::doubleToString(const QChar _zero, const QChar plus, const Q
     // Handle normal numbers
     if (!special_number) {
         int decpt, sign;
-        QString digits;
+        const bool shortest = precision == QLocale::FloatingPointShortest;
 
         int mode;
-        if (form == DFDecimal)
+        if (shortest)
+            mode = 0;
+        else if (form == DFDecimal)
             mode = 3;
         else
             mode = 2;
@@ -2782,17 +2784,7 @@ QString QLocaleData::doubleToString(const QChar _zero, const QChar plus, const Q
         if (form == DFExponent)
             ++pr;
 
-        char *rve = 0;
-        char *buff = 0;
-        QT_TRY {
-            digits = QLatin1String(qdtoa(d, mode, pr, &decpt, &sign, &rve, &buff));
-        } QT_CATCH(...) {
-            if (buff != 0)
-                free(buff);
-            QT_RETHROW;
-        }
-        if (buff != 0)
-            free(buff);
+        QString digits = qdtoaDigits(d, mode, pr, &decpt, &sign);
 
         if (_zero.unicode() != '0') {
             ushort z = _zero.unicode() - '0';
@@ -2800,6 +2792,11 @@ QString QLocaleData::doubleToString(const QChar _zero, const QChar plus, const Q
                 reinterpret_cast<ushort *>(digits.data())[i] += z;
         }
 
+        // With the shortest representation, the digits are all there is to
+        // show; don't pad them with zeros.
+        if (shortest)
+            precision = 0;
+
         bool always_show_decpt = (flags & Alternate || flags & ForcePoint);
         switch (form) {
             case DFExponent: {
@@ -2818,7 +2815,11 @@ QString QLocaleData::doubleToString(const QChar _zero, const QChar plus, const Q
                 PrecisionMode mode = (flags & Alternate) ?
                             PMSignificantDigits : PMChopTrailingZeros;
 
-                if (decpt != digits.length() && (decpt <= -4 || decpt > precision))
+                // The shortest representation of a double never needs more
+                // than 17 significant digits, so integers up to that size are
+                // still written out in full.
+                const int cutoff = shortest ? 17 : precision;
+                if (decpt != digits.length() && (decpt <= -4 || decpt > cutoff))
                     num_str = exponentForm(_zero, decimal, exponential, group, plus, minus,
                                            digits, decpt, precision, mode,
                                            always_show_decpt);
@@ -2883,6 +2884,12 @@ QString QLocaleData::longLongToString(const QChar zero, const QChar group,
         precision = 1;
     }
 
+    // plain decimal numbers are by far the most common case; format them,
+    // sign included, without the temporaries of the general path below
+    if (base == 10 && precision_not_specified
+            && !(flags & (ThousandsGroup | ZeroPadded | AlwaysShowSign | BlankBeforePositive)))
+        return qlltoa_decimal(l, zero, minus);
+
     bool negative = l < 0;
     if (base != 10) {
         // these are not supported by sprintf for octal and hex
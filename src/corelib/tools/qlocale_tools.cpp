@@ -42,6 +42,7 @@
 #include <limits.h>
 #include <math.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 
 #ifdef Q_OS_WINCE
@@ -117,11 +118,10 @@ qstrtoll(const char * nptr, const char **endptr, int base, bool *ok)
 static char *_qdtoa( NEEDS_VOLATILE double d, int mode, int ndigits, int *decpt,
                         int *sign, char **rve, char **digits_str);
 
-QString qulltoa(qulonglong l, int base, const QChar _zero)
+// writes the digits of \a l backwards, ending just before \a p, and
+// returns a pointer to the first digit
+static ushort *qulltoa_helper(ushort *p, qulonglong l, int base, const QChar _zero)
 {
-    ushort buff[65]; // length of MAX_ULLONG in base 2
-    ushort *p = buff + 65;
-
     if (base != 10 || _zero.unicode() == '0') {
         while (l != 0) {
             int c = l % base;
@@ -145,6 +145,13 @@ QString qulltoa(qulonglong l, int base, const QChar _zero)
             l /= base;
         }
     }
+    return p;
+}
+
+QString qulltoa(qulonglong l, int base, const QChar _zero)
+{
+    ushort buff[65]; // length of MAX_ULLONG in base 2
+    ushort *p = qulltoa_helper(buff + 65, l, base, _zero);
 
     return QString(reinterpret_cast<QChar *>(p), 65 - (p - buff));
 }
@@ -154,6 +161,24 @@ QString qlltoa(qlonglong l, int base, const QChar zero)
     return qulltoa(l < 0 ? -l : l, base, zero);
 }
 
+/*
+    Formats \a l as a plain decimal number, with \a minus in front of it if
+    it is negative. Unlike qlltoa() followed by a prepend, this allocates the
+    result only once.
+*/
+QString qlltoa_decimal(qlonglong l, const QChar zero, const QChar minus)
+{
+    ushort buff[21]; // sign + length of MIN_LLONG in base 10
+    ushort *p = qulltoa_helper(buff + 21, l < 0 ? 0 - qulonglong(l) : qulonglong(l), 10, zero);
+
+    if (p == buff + 21)
+        *(--p) = zero.unicode();
+    else if (l < 0)
+        *(--p) = minus.unicode();
+
+    return QString(reinterpret_cast<QChar *>(p), 21 - (p - buff));
+}
+
 QString &decimalForm(QChar zero, QChar decimal, QChar group,
                      QString &digits, int decpt, uint precision,
                      PrecisionMode pm,
@@ -225,6 +250,626 @@ QString &exponentForm(QChar zero, QChar decimal, QChar exponential,
     return digits;
 }
 
+/*
+    Fast paths for converting between doubles and decimal digits.
+
+    The formatter uses Florian Loitsch's Grisu3 ("Printing Floating-Point
+    Numbers Quickly and Accurately with Integers", PLDI 2010) for both the
+    shortest representation and a requested number of digits. The parser
+    uses the Eisel-Lemire algorithm (Daniel Lemire, "Number Parsing at a
+    Gigabyte per Second", 2021). Both scale the number by an entry from
+    the table of powers of ten below. Those entries are truncated to 64
+    bits, so the scaled values are only known to within a few units in
+    the last place. Whenever that could change the outcome, the fast path
+    gives up and the netlib code further down computes the result exactly.
+    The fast paths therefore always produce the same output as the netlib
+    code; they only get there sooner.
+*/
+
+enum {
+    PowersOfTenMinExponent = -348,
+    PowersOfTenMaxExponent = 347
+};
+
+// The upper 64 bits of 10^e for e in [PowersOfTenMinExponent,
+// PowersOfTenMaxExponent], rounded towards zero. The binary exponent of an
+// entry is given by powerOfTenBinaryExponent().
+static const quint64 powersOfTen[PowersOfTenMaxExponent - PowersOfTenMinExponent + 1] = {
+    Q_UINT64_C(0xfa8fd5a0081c0288), Q_UINT64_C(0x9c99e58405118195), Q_UINT64_C(0xc3c05ee50655e1fa),
+    Q_UINT64_C(0xf4b0769e47eb5a78), Q_UINT64_C(0x98ee4a22ecf3188b), Q_UINT64_C(0xbf29dcaba82fdeae),
+    Q_UINT64_C(0xeef453d6923bd65a), Q_UINT64_C(0x9558b4661b6565f8), Q_UINT64_C(0xbaaee17fa23ebf76),
+    Q_UINT64_C(0xe95a99df8ace6f53), Q_UINT64_C(0x91d8a02bb6c10594), Q_UINT64_C(0xb64ec836a47146f9),
+    Q_UINT64_C(0xe3e27a444d8d98b7), Q_UINT64_C(0x8e6d8c6ab0787f72), Q_UINT64_C(0xb208ef855c969f4f),
+    Q_UINT64_C(0xde8b2b66b3bc4723), Q_UINT64_C(0x8b16fb203055ac76), Q_UINT64_C(0xaddcb9e83c6b1793),
+    Q_UINT64_C(0xd953e8624b85dd78), Q_UINT64_C(0x87d4713d6f33aa6b), Q_UINT64_C(0xa9c98d8ccb009506),
+    Q_UINT64_C(0xd43bf0effdc0ba48), Q_UINT64_C(0x84a57695fe98746d), Q_UINT64_C(0xa5ced43b7e3e9188),
+    Q_UINT64_C(0xcf42894a5dce35ea), Q_UINT64_C(0x818995ce7aa0e1b2), Q_UINT64_C(0xa1ebfb4219491a1f),
+    Q_UINT64_C(0xca66fa129f9b60a6), Q_UINT64_C(0xfd00b897478238d0), Q_UINT64_C(0x9e20735e8cb16382),
+    Q_UINT64_C(0xc5a890362fddbc62), Q_UINT64_C(0xf712b443bbd52b7b), Q_UINT64_C(0x9a6bb0aa55653b2d),
+    Q_UINT64_C(0xc1069cd4eabe89f8), Q_UINT64_C(0xf148440a256e2c76), Q_UINT64_C(0x96cd2a865764dbca),
+    Q_UINT64_C(0xbc807527ed3e12bc), Q_UINT64_C(0xeba09271e88d976b), Q_UINT64_C(0x93445b8731587ea3),
+    Q_UINT64_C(0xb8157268fdae9e4c), Q_UINT64_C(0xe61acf033d1a45df), Q_UINT64_C(0x8fd0c16206306bab),
+    Q_UINT64_C(0xb3c4f1ba87bc8696), Q_UINT64_C(0xe0b62e2929aba83c), Q_UINT64_C(0x8c71dcd9ba0b4925),
+    Q_UINT64_C(0xaf8e5410288e1b6f), Q_UINT64_C(0xdb71e91432b1a24a), Q_UINT64_C(0x892731ac9faf056e),
+    Q_UINT64_C(0xab70fe17c79ac6ca), Q_UINT64_C(0xd64d3d9db981787d), Q_UINT64_C(0x85f0468293f0eb4e),
+    Q_UINT64_C(0xa76c582338ed2621), Q_UINT64_C(0xd1476e2c07286faa), Q_UINT64_C(0x82cca4db847945ca),
+    Q_UINT64_C(0xa37fce126597973c), Q_UINT64_C(0xcc5fc196fefd7d0c), Q_UINT64_C(0xff77b1fcbebcdc4f),
+    Q_UINT64_C(0x9faacf3df73609b1), Q_UINT64_C(0xc795830d75038c1d), Q_UINT64_C(0xf97ae3d0d2446f25),
+    Q_UINT64_C(0x9becce62836ac577), Q_UINT64_C(0xc2e801fb244576d5), Q_UINT64_C(0xf3a20279ed56d48a),
+    Q_UINT64_C(0x9845418c345644d6), Q_UINT64_C(0xbe5691ef416bd60c), Q_UINT64_C(0xedec366b11c6cb8f),
+    Q_UINT64_C(0x94b3a202eb1c3f39), Q_UINT64_C(0xb9e08a83a5e34f07), Q_UINT64_C(0xe858ad248f5c22c9),
+    Q_UINT64_C(0x91376c36d99995be), Q_UINT64_C(0xb58547448ffffb2d), Q_UINT64_C(0xe2e69915b3fff9f9),
+    Q_UINT64_C(0x8dd01fad907ffc3b), Q_UINT64_C(0xb1442798f49ffb4a), Q_UINT64_C(0xdd95317f31c7fa1d),
+    Q_UINT64_C(0x8a7d3eef7f1cfc52), Q_UINT64_C(0xad1c8eab5ee43b66), Q_UINT64_C(0xd863b256369d4a40),
+    Q_UINT64_C(0x873e4f75e2224e68), Q_UINT64_C(0xa90de3535aaae202), Q_UINT64_C(0xd3515c2831559a83),
+    Q_UINT64_C(0x8412d9991ed58091), Q_UINT64_C(0xa5178fff668ae0b6), Q_UINT64_C(0xce5d73ff402d98e3),
+    Q_UINT64_C(0x80fa687f881c7f8e), Q_UINT64_C(0xa139029f6a239f72), Q_UINT64_C(0xc987434744ac874e),
+    Q_UINT64_C(0xfbe9141915d7a922), Q_UINT64_C(0x9d71ac8fada6c9b5), Q_UINT64_C(0xc4ce17b399107c22),
+    Q_UINT64_C(0xf6019da07f549b2b), Q_UINT64_C(0x99c102844f94e0fb), Q_UINT64_C(0xc0314325637a1939),
+    Q_UINT64_C(0xf03d93eebc589f88), Q_UINT64_C(0x96267c7535b763b5), Q_UINT64_C(0xbbb01b9283253ca2),
+    Q_UINT64_C(0xea9c227723ee8bcb), Q_UINT64_C(0x92a1958a7675175f), Q_UINT64_C(0xb749faed14125d36),
+    Q_UINT64_C(0xe51c79a85916f484), Q_UINT64_C(0x8f31cc0937ae58d2), Q_UINT64_C(0xb2fe3f0b8599ef07),
+    Q_UINT64_C(0xdfbdcece67006ac9), Q_UINT64_C(0x8bd6a141006042bd), Q_UINT64_C(0xaecc49914078536d),
+    Q_UINT64_C(0xda7f5bf590966848), Q_UINT64_C(0x888f99797a5e012d), Q_UINT64_C(0xaab37fd7d8f58178),
+    Q_UINT64_C(0xd5605fcdcf32e1d6), Q_UINT64_C(0x855c3be0a17fcd26), Q_UINT64_C(0xa6b34ad8c9dfc06f),
+    Q_UINT64_C(0xd0601d8efc57b08b), Q_UINT64_C(0x823c12795db6ce57), Q_UINT64_C(0xa2cb1717b52481ed),
+    Q_UINT64_C(0xcb7ddcdda26da268), Q_UINT64_C(0xfe5d54150b090b02), Q_UINT64_C(0x9efa548d26e5a6e1),
+    Q_UINT64_C(0xc6b8e9b0709f109a), Q_UINT64_C(0xf867241c8cc6d4c0), Q_UINT64_C(0x9b407691d7fc44f8),
+    Q_UINT64_C(0xc21094364dfb5636), Q_UINT64_C(0xf294b943e17a2bc4), Q_UINT64_C(0x979cf3ca6cec5b5a),
+    Q_UINT64_C(0xbd8430bd08277231), Q_UINT64_C(0xece53cec4a314ebd), Q_UINT64_C(0x940f4613ae5ed136),
+    Q_UINT64_C(0xb913179899f68584), Q_UINT64_C(0xe757dd7ec07426e5), Q_UINT64_C(0x9096ea6f3848984f),
+    Q_UINT64_C(0xb4bca50b065abe63), Q_UINT64_C(0xe1ebce4dc7f16dfb), Q_UINT64_C(0x8d3360f09cf6e4bd),
+    Q_UINT64_C(0xb080392cc4349dec), Q_UINT64_C(0xdca04777f541c567), Q_UINT64_C(0x89e42caaf9491b60),
+    Q_UINT64_C(0xac5d37d5b79b6239), Q_UINT64_C(0xd77485cb25823ac7), Q_UINT64_C(0x86a8d39ef77164bc),
+    Q_UINT64_C(0xa8530886b54dbdeb), Q_UINT64_C(0xd267caa862a12d66), Q_UINT64_C(0x8380dea93da4bc60),
+    Q_UINT64_C(0xa46116538d0deb78), Q_UINT64_C(0xcd795be870516656), Q_UINT64_C(0x806bd9714632dff6),
+    Q_UINT64_C(0xa086cfcd97bf97f3), Q_UINT64_C(0xc8a883c0fdaf7df0), Q_UINT64_C(0xfad2a4b13d1b5d6c),
+    Q_UINT64_C(0x9cc3a6eec6311a63), Q_UINT64_C(0xc3f490aa77bd60fc), Q_UINT64_C(0xf4f1b4d515acb93b),
+    Q_UINT64_C(0x991711052d8bf3c5), Q_UINT64_C(0xbf5cd54678eef0b6), Q_UINT64_C(0xef340a98172aace4),
+    Q_UINT64_C(0x9580869f0e7aac0e), Q_UINT64_C(0xbae0a846d2195712), Q_UINT64_C(0xe998d258869facd7),
+    Q_UINT64_C(0x91ff83775423cc06), Q_UINT64_C(0xb67f6455292cbf08), Q_UINT64_C(0xe41f3d6a7377eeca),
+    Q_UINT64_C(0x8e938662882af53e), Q_UINT64_C(0xb23867fb2a35b28d), Q_UINT64_C(0xdec681f9f4c31f31),
+    Q_UINT64_C(0x8b3c113c38f9f37e), Q_UINT64_C(0xae0b158b4738705e), Q_UINT64_C(0xd98ddaee19068c76),
+    Q_UINT64_C(0x87f8a8d4cfa417c9), Q_UINT64_C(0xa9f6d30a038d1dbc), Q_UINT64_C(0xd47487cc8470652b),
+    Q_UINT64_C(0x84c8d4dfd2c63f3b), Q_UINT64_C(0xa5fb0a17c777cf09), Q_UINT64_C(0xcf79cc9db955c2cc),
+    Q_UINT64_C(0x81ac1fe293d599bf), Q_UINT64_C(0xa21727db38cb002f), Q_UINT64_C(0xca9cf1d206fdc03b),
+    Q_UINT64_C(0xfd442e4688bd304a), Q_UINT64_C(0x9e4a9cec15763e2e), Q_UINT64_C(0xc5dd44271ad3cdba),
+    Q_UINT64_C(0xf7549530e188c128), Q_UINT64_C(0x9a94dd3e8cf578b9), Q_UINT64_C(0xc13a148e3032d6e7),
+    Q_UINT64_C(0xf18899b1bc3f8ca1), Q_UINT64_C(0x96f5600f15a7b7e5), Q_UINT64_C(0xbcb2b812db11a5de),
+    Q_UINT64_C(0xebdf661791d60f56), Q_UINT64_C(0x936b9fcebb25c995), Q_UINT64_C(0xb84687c269ef3bfb),
+    Q_UINT64_C(0xe65829b3046b0afa), Q_UINT64_C(0x8ff71a0fe2c2e6dc), Q_UINT64_C(0xb3f4e093db73a093),
+    Q_UINT64_C(0xe0f218b8d25088b8), Q_UINT64_C(0x8c974f7383725573), Q_UINT64_C(0xafbd2350644eeacf),
+    Q_UINT64_C(0xdbac6c247d62a583), Q_UINT64_C(0x894bc396ce5da772), Q_UINT64_C(0xab9eb47c81f5114f),
+    Q_UINT64_C(0xd686619ba27255a2), Q_UINT64_C(0x8613fd0145877585), Q_UINT64_C(0xa798fc4196e952e7),
+    Q_UINT64_C(0xd17f3b51fca3a7a0), Q_UINT64_C(0x82ef85133de648c4), Q_UINT64_C(0xa3ab66580d5fdaf5),
+    Q_UINT64_C(0xcc963fee10b7d1b3), Q_UINT64_C(0xffbbcfe994e5c61f), Q_UINT64_C(0x9fd561f1fd0f9bd3),
+    Q_UINT64_C(0xc7caba6e7c5382c8), Q_UINT64_C(0xf9bd690a1b68637b), Q_UINT64_C(0x9c1661a651213e2d),
+    Q_UINT64_C(0xc31bfa0fe5698db8), Q_UINT64_C(0xf3e2f893dec3f126), Q_UINT64_C(0x986ddb5c6b3a76b7),
+    Q_UINT64_C(0xbe89523386091465), Q_UINT64_C(0xee2ba6c0678b597f), Q_UINT64_C(0x94db483840b717ef),
+    Q_UINT64_C(0xba121a4650e4ddeb), Q_UINT64_C(0xe896a0d7e51e1566), Q_UINT64_C(0x915e2486ef32cd60),
+    Q_UINT64_C(0xb5b5ada8aaff80b8), Q_UINT64_C(0xe3231912d5bf60e6), Q_UINT64_C(0x8df5efabc5979c8f),
+    Q_UINT64_C(0xb1736b96b6fd83b3), Q_UINT64_C(0xddd0467c64bce4a0), Q_UINT64_C(0x8aa22c0dbef60ee4),
+    Q_UINT64_C(0xad4ab7112eb3929d), Q_UINT64_C(0xd89d64d57a607744), Q_UINT64_C(0x87625f056c7c4a8b),
+    Q_UINT64_C(0xa93af6c6c79b5d2d), Q_UINT64_C(0xd389b47879823479), Q_UINT64_C(0x843610cb4bf160cb),
+    Q_UINT64_C(0xa54394fe1eedb8fe), Q_UINT64_C(0xce947a3da6a9273e), Q_UINT64_C(0x811ccc668829b887),
+    Q_UINT64_C(0xa163ff802a3426a8), Q_UINT64_C(0xc9bcff6034c13052), Q_UINT64_C(0xfc2c3f3841f17c67),
+    Q_UINT64_C(0x9d9ba7832936edc0), Q_UINT64_C(0xc5029163f384a931), Q_UINT64_C(0xf64335bcf065d37d),
+    Q_UINT64_C(0x99ea0196163fa42e), Q_UINT64_C(0xc06481fb9bcf8d39), Q_UINT64_C(0xf07da27a82c37088),
+    Q_UINT64_C(0x964e858c91ba2655), Q_UINT64_C(0xbbe226efb628afea), Q_UINT64_C(0xeadab0aba3b2dbe5),
+    Q_UINT64_C(0x92c8ae6b464fc96f), Q_UINT64_C(0xb77ada0617e3bbcb), Q_UINT64_C(0xe55990879ddcaabd),
+    Q_UINT64_C(0x8f57fa54c2a9eab6), Q_UINT64_C(0xb32df8e9f3546564), Q_UINT64_C(0xdff9772470297ebd),
+    Q_UINT64_C(0x8bfbea76c619ef36), Q_UINT64_C(0xaefae51477a06b03), Q_UINT64_C(0xdab99e59958885c4),
+    Q_UINT64_C(0x88b402f7fd75539b), Q_UINT64_C(0xaae103b5fcd2a881), Q_UINT64_C(0xd59944a37c0752a2),
+    Q_UINT64_C(0x857fcae62d8493a5), Q_UINT64_C(0xa6dfbd9fb8e5b88e), Q_UINT64_C(0xd097ad07a71f26b2),
+    Q_UINT64_C(0x825ecc24c873782f), Q_UINT64_C(0xa2f67f2dfa90563b), Q_UINT64_C(0xcbb41ef979346bca),
+    Q_UINT64_C(0xfea126b7d78186bc), Q_UINT64_C(0x9f24b832e6b0f436), Q_UINT64_C(0xc6ede63fa05d3143),
+    Q_UINT64_C(0xf8a95fcf88747d94), Q_UINT64_C(0x9b69dbe1b548ce7c), Q_UINT64_C(0xc24452da229b021b),
+    Q_UINT64_C(0xf2d56790ab41c2a2), Q_UINT64_C(0x97c560ba6b0919a5), Q_UINT64_C(0xbdb6b8e905cb600f),
+    Q_UINT64_C(0xed246723473e3813), Q_UINT64_C(0x9436c0760c86e30b), Q_UINT64_C(0xb94470938fa89bce),
+    Q_UINT64_C(0xe7958cb87392c2c2), Q_UINT64_C(0x90bd77f3483bb9b9), Q_UINT64_C(0xb4ecd5f01a4aa828),
+    Q_UINT64_C(0xe2280b6c20dd5232), Q_UINT64_C(0x8d590723948a535f), Q_UINT64_C(0xb0af48ec79ace837),
+    Q_UINT64_C(0xdcdb1b2798182244), Q_UINT64_C(0x8a08f0f8bf0f156b), Q_UINT64_C(0xac8b2d36eed2dac5),
+    Q_UINT64_C(0xd7adf884aa879177), Q_UINT64_C(0x86ccbb52ea94baea), Q_UINT64_C(0xa87fea27a539e9a5),
+    Q_UINT64_C(0xd29fe4b18e88640e), Q_UINT64_C(0x83a3eeeef9153e89), Q_UINT64_C(0xa48ceaaab75a8e2b),
+    Q_UINT64_C(0xcdb02555653131b6), Q_UINT64_C(0x808e17555f3ebf11), Q_UINT64_C(0xa0b19d2ab70e6ed6),
+    Q_UINT64_C(0xc8de047564d20a8b), Q_UINT64_C(0xfb158592be068d2e), Q_UINT64_C(0x9ced737bb6c4183d),
+    Q_UINT64_C(0xc428d05aa4751e4c), Q_UINT64_C(0xf53304714d9265df), Q_UINT64_C(0x993fe2c6d07b7fab),
+    Q_UINT64_C(0xbf8fdb78849a5f96), Q_UINT64_C(0xef73d256a5c0f77c), Q_UINT64_C(0x95a8637627989aad),
+    Q_UINT64_C(0xbb127c53b17ec159), Q_UINT64_C(0xe9d71b689dde71af), Q_UINT64_C(0x9226712162ab070d),
+    Q_UINT64_C(0xb6b00d69bb55c8d1), Q_UINT64_C(0xe45c10c42a2b3b05), Q_UINT64_C(0x8eb98a7a9a5b04e3),
+    Q_UINT64_C(0xb267ed1940f1c61c), Q_UINT64_C(0xdf01e85f912e37a3), Q_UINT64_C(0x8b61313bbabce2c6),
+    Q_UINT64_C(0xae397d8aa96c1b77), Q_UINT64_C(0xd9c7dced53c72255), Q_UINT64_C(0x881cea14545c7575),
+    Q_UINT64_C(0xaa242499697392d2), Q_UINT64_C(0xd4ad2dbfc3d07787), Q_UINT64_C(0x84ec3c97da624ab4),
+    Q_UINT64_C(0xa6274bbdd0fadd61), Q_UINT64_C(0xcfb11ead453994ba), Q_UINT64_C(0x81ceb32c4b43fcf4),
+    Q_UINT64_C(0xa2425ff75e14fc31), Q_UINT64_C(0xcad2f7f5359a3b3e), Q_UINT64_C(0xfd87b5f28300ca0d),
+    Q_UINT64_C(0x9e74d1b791e07e48), Q_UINT64_C(0xc612062576589dda), Q_UINT64_C(0xf79687aed3eec551),
+    Q_UINT64_C(0x9abe14cd44753b52), Q_UINT64_C(0xc16d9a0095928a27), Q_UINT64_C(0xf1c90080baf72cb1),
+    Q_UINT64_C(0x971da05074da7bee), Q_UINT64_C(0xbce5086492111aea), Q_UINT64_C(0xec1e4a7db69561a5),
+    Q_UINT64_C(0x9392ee8e921d5d07), Q_UINT64_C(0xb877aa3236a4b449), Q_UINT64_C(0xe69594bec44de15b),
+    Q_UINT64_C(0x901d7cf73ab0acd9), Q_UINT64_C(0xb424dc35095cd80f), Q_UINT64_C(0xe12e13424bb40e13),
+    Q_UINT64_C(0x8cbccc096f5088cb), Q_UINT64_C(0xafebff0bcb24aafe), Q_UINT64_C(0xdbe6fecebdedd5be),
+    Q_UINT64_C(0x89705f4136b4a597), Q_UINT64_C(0xabcc77118461cefc), Q_UINT64_C(0xd6bf94d5e57a42bc),
+    Q_UINT64_C(0x8637bd05af6c69b5), Q_UINT64_C(0xa7c5ac471b478423), Q_UINT64_C(0xd1b71758e219652b),
+    Q_UINT64_C(0x83126e978d4fdf3b), Q_UINT64_C(0xa3d70a3d70a3d70a), Q_UINT64_C(0xcccccccccccccccc),
+    Q_UINT64_C(0x8000000000000000), Q_UINT64_C(0xa000000000000000), Q_UINT64_C(0xc800000000000000),
+    Q_UINT64_C(0xfa00000000000000), Q_UINT64_C(0x9c40000000000000), Q_UINT64_C(0xc350000000000000),
+    Q_UINT64_C(0xf424000000000000), Q_UINT64_C(0x9896800000000000), Q_UINT64_C(0xbebc200000000000),
+    Q_UINT64_C(0xee6b280000000000), Q_UINT64_C(0x9502f90000000000), Q_UINT64_C(0xba43b74000000000),
+    Q_UINT64_C(0xe8d4a51000000000), Q_UINT64_C(0x9184e72a00000000), Q_UINT64_C(0xb5e620f480000000),
+    Q_UINT64_C(0xe35fa931a0000000), Q_UINT64_C(0x8e1bc9bf04000000), Q_UINT64_C(0xb1a2bc2ec5000000),
+    Q_UINT64_C(0xde0b6b3a76400000), Q_UINT64_C(0x8ac7230489e80000), Q_UINT64_C(0xad78ebc5ac620000),
+    Q_UINT64_C(0xd8d726b7177a8000), Q_UINT64_C(0x878678326eac9000), Q_UINT64_C(0xa968163f0a57b400),
+    Q_UINT64_C(0xd3c21bcecceda100), Q_UINT64_C(0x84595161401484a0), Q_UINT64_C(0xa56fa5b99019a5c8),
+    Q_UINT64_C(0xcecb8f27f4200f3a), Q_UINT64_C(0x813f3978f8940984), Q_UINT64_C(0xa18f07d736b90be5),
+    Q_UINT64_C(0xc9f2c9cd04674ede), Q_UINT64_C(0xfc6f7c4045812296), Q_UINT64_C(0x9dc5ada82b70b59d),
+    Q_UINT64_C(0xc5371912364ce305), Q_UINT64_C(0xf684df56c3e01bc6), Q_UINT64_C(0x9a130b963a6c115c),
+    Q_UINT64_C(0xc097ce7bc90715b3), Q_UINT64_C(0xf0bdc21abb48db20), Q_UINT64_C(0x96769950b50d88f4),
+    Q_UINT64_C(0xbc143fa4e250eb31), Q_UINT64_C(0xeb194f8e1ae525fd), Q_UINT64_C(0x92efd1b8d0cf37be),
+    Q_UINT64_C(0xb7abc627050305ad), Q_UINT64_C(0xe596b7b0c643c719), Q_UINT64_C(0x8f7e32ce7bea5c6f),
+    Q_UINT64_C(0xb35dbf821ae4f38b), Q_UINT64_C(0xe0352f62a19e306e), Q_UINT64_C(0x8c213d9da502de45),
+    Q_UINT64_C(0xaf298d050e4395d6), Q_UINT64_C(0xdaf3f04651d47b4c), Q_UINT64_C(0x88d8762bf324cd0f),
+    Q_UINT64_C(0xab0e93b6efee0053), Q_UINT64_C(0xd5d238a4abe98068), Q_UINT64_C(0x85a36366eb71f041),
+    Q_UINT64_C(0xa70c3c40a64e6c51), Q_UINT64_C(0xd0cf4b50cfe20765), Q_UINT64_C(0x82818f1281ed449f),
+    Q_UINT64_C(0xa321f2d7226895c7), Q_UINT64_C(0xcbea6f8ceb02bb39), Q_UINT64_C(0xfee50b7025c36a08),
+    Q_UINT64_C(0x9f4f2726179a2245), Q_UINT64_C(0xc722f0ef9d80aad6), Q_UINT64_C(0xf8ebad2b84e0d58b),
+    Q_UINT64_C(0x9b934c3b330c8577), Q_UINT64_C(0xc2781f49ffcfa6d5), Q_UINT64_C(0xf316271c7fc3908a),
+    Q_UINT64_C(0x97edd871cfda3a56), Q_UINT64_C(0xbde94e8e43d0c8ec), Q_UINT64_C(0xed63a231d4c4fb27),
+    Q_UINT64_C(0x945e455f24fb1cf8), Q_UINT64_C(0xb975d6b6ee39e436), Q_UINT64_C(0xe7d34c64a9c85d44),
+    Q_UINT64_C(0x90e40fbeea1d3a4a), Q_UINT64_C(0xb51d13aea4a488dd), Q_UINT64_C(0xe264589a4dcdab14),
+    Q_UINT64_C(0x8d7eb76070a08aec), Q_UINT64_C(0xb0de65388cc8ada8), Q_UINT64_C(0xdd15fe86affad912),
+    Q_UINT64_C(0x8a2dbf142dfcc7ab), Q_UINT64_C(0xacb92ed9397bf996), Q_UINT64_C(0xd7e77a8f87daf7fb),
+    Q_UINT64_C(0x86f0ac99b4e8dafd), Q_UINT64_C(0xa8acd7c0222311bc), Q_UINT64_C(0xd2d80db02aabd62b),
+    Q_UINT64_C(0x83c7088e1aab65db), Q_UINT64_C(0xa4b8cab1a1563f52), Q_UINT64_C(0xcde6fd5e09abcf26),
+    Q_UINT64_C(0x80b05e5ac60b6178), Q_UINT64_C(0xa0dc75f1778e39d6), Q_UINT64_C(0xc913936dd571c84c),
+    Q_UINT64_C(0xfb5878494ace3a5f), Q_UINT64_C(0x9d174b2dcec0e47b), Q_UINT64_C(0xc45d1df942711d9a),
+    Q_UINT64_C(0xf5746577930d6500), Q_UINT64_C(0x9968bf6abbe85f20), Q_UINT64_C(0xbfc2ef456ae276e8),
+    Q_UINT64_C(0xefb3ab16c59b14a2), Q_UINT64_C(0x95d04aee3b80ece5), Q_UINT64_C(0xbb445da9ca61281f),
+    Q_UINT64_C(0xea1575143cf97226), Q_UINT64_C(0x924d692ca61be758), Q_UINT64_C(0xb6e0c377cfa2e12e),
+    Q_UINT64_C(0xe498f455c38b997a), Q_UINT64_C(0x8edf98b59a373fec), Q_UINT64_C(0xb2977ee300c50fe7),
+    Q_UINT64_C(0xdf3d5e9bc0f653e1), Q_UINT64_C(0x8b865b215899f46c), Q_UINT64_C(0xae67f1e9aec07187),
+    Q_UINT64_C(0xda01ee641a708de9), Q_UINT64_C(0x884134fe908658b2), Q_UINT64_C(0xaa51823e34a7eede),
+    Q_UINT64_C(0xd4e5e2cdc1d1ea96), Q_UINT64_C(0x850fadc09923329e), Q_UINT64_C(0xa6539930bf6bff45),
+    Q_UINT64_C(0xcfe87f7cef46ff16), Q_UINT64_C(0x81f14fae158c5f6e), Q_UINT64_C(0xa26da3999aef7749),
+    Q_UINT64_C(0xcb090c8001ab551c), Q_UINT64_C(0xfdcb4fa002162a63), Q_UINT64_C(0x9e9f11c4014dda7e),
+    Q_UINT64_C(0xc646d63501a1511d), Q_UINT64_C(0xf7d88bc24209a565), Q_UINT64_C(0x9ae757596946075f),
+    Q_UINT64_C(0xc1a12d2fc3978937), Q_UINT64_C(0xf209787bb47d6b84), Q_UINT64_C(0x9745eb4d50ce6332),
+    Q_UINT64_C(0xbd176620a501fbff), Q_UINT64_C(0xec5d3fa8ce427aff), Q_UINT64_C(0x93ba47c980e98cdf),
+    Q_UINT64_C(0xb8a8d9bbe123f017), Q_UINT64_C(0xe6d3102ad96cec1d), Q_UINT64_C(0x9043ea1ac7e41392),
+    Q_UINT64_C(0xb454e4a179dd1877), Q_UINT64_C(0xe16a1dc9d8545e94), Q_UINT64_C(0x8ce2529e2734bb1d),
+    Q_UINT64_C(0xb01ae745b101e9e4), Q_UINT64_C(0xdc21a1171d42645d), Q_UINT64_C(0x899504ae72497eba),
+    Q_UINT64_C(0xabfa45da0edbde69), Q_UINT64_C(0xd6f8d7509292d603), Q_UINT64_C(0x865b86925b9bc5c2),
+    Q_UINT64_C(0xa7f26836f282b732), Q_UINT64_C(0xd1ef0244af2364ff), Q_UINT64_C(0x8335616aed761f1f),
+    Q_UINT64_C(0xa402b9c5a8d3a6e7), Q_UINT64_C(0xcd036837130890a1), Q_UINT64_C(0x802221226be55a64),
+    Q_UINT64_C(0xa02aa96b06deb0fd), Q_UINT64_C(0xc83553c5c8965d3d), Q_UINT64_C(0xfa42a8b73abbf48c),
+    Q_UINT64_C(0x9c69a97284b578d7), Q_UINT64_C(0xc38413cf25e2d70d), Q_UINT64_C(0xf46518c2ef5b8cd1),
+    Q_UINT64_C(0x98bf2f79d5993802), Q_UINT64_C(0xbeeefb584aff8603), Q_UINT64_C(0xeeaaba2e5dbf6784),
+    Q_UINT64_C(0x952ab45cfa97a0b2), Q_UINT64_C(0xba756174393d88df), Q_UINT64_C(0xe912b9d1478ceb17),
+    Q_UINT64_C(0x91abb422ccb812ee), Q_UINT64_C(0xb616a12b7fe617aa), Q_UINT64_C(0xe39c49765fdf9d94),
+    Q_UINT64_C(0x8e41ade9fbebc27d), Q_UINT64_C(0xb1d219647ae6b31c), Q_UINT64_C(0xde469fbd99a05fe3),
+    Q_UINT64_C(0x8aec23d680043bee), Q_UINT64_C(0xada72ccc20054ae9), Q_UINT64_C(0xd910f7ff28069da4),
+    Q_UINT64_C(0x87aa9aff79042286), Q_UINT64_C(0xa99541bf57452b28), Q_UINT64_C(0xd3fa922f2d1675f2),
+    Q_UINT64_C(0x847c9b5d7c2e09b7), Q_UINT64_C(0xa59bc234db398c25), Q_UINT64_C(0xcf02b2c21207ef2e),
+    Q_UINT64_C(0x8161afb94b44f57d), Q_UINT64_C(0xa1ba1ba79e1632dc), Q_UINT64_C(0xca28a291859bbf93),
+    Q_UINT64_C(0xfcb2cb35e702af78), Q_UINT64_C(0x9defbf01b061adab), Q_UINT64_C(0xc56baec21c7a1916),
+    Q_UINT64_C(0xf6c69a72a3989f5b), Q_UINT64_C(0x9a3c2087a63f6399), Q_UINT64_C(0xc0cb28a98fcf3c7f),
+    Q_UINT64_C(0xf0fdf2d3f3c30b9f), Q_UINT64_C(0x969eb7c47859e743), Q_UINT64_C(0xbc4665b596706114),
+    Q_UINT64_C(0xeb57ff22fc0c7959), Q_UINT64_C(0x9316ff75dd87cbd8), Q_UINT64_C(0xb7dcbf5354e9bece),
+    Q_UINT64_C(0xe5d3ef282a242e81), Q_UINT64_C(0x8fa475791a569d10), Q_UINT64_C(0xb38d92d760ec4455),
+    Q_UINT64_C(0xe070f78d3927556a), Q_UINT64_C(0x8c469ab843b89562), Q_UINT64_C(0xaf58416654a6babb),
+    Q_UINT64_C(0xdb2e51bfe9d0696a), Q_UINT64_C(0x88fcf317f22241e2), Q_UINT64_C(0xab3c2fddeeaad25a),
+    Q_UINT64_C(0xd60b3bd56a5586f1), Q_UINT64_C(0x85c7056562757456), Q_UINT64_C(0xa738c6bebb12d16c),
+    Q_UINT64_C(0xd106f86e69d785c7), Q_UINT64_C(0x82a45b450226b39c), Q_UINT64_C(0xa34d721642b06084),
+    Q_UINT64_C(0xcc20ce9bd35c78a5), Q_UINT64_C(0xff290242c83396ce), Q_UINT64_C(0x9f79a169bd203e41),
+    Q_UINT64_C(0xc75809c42c684dd1), Q_UINT64_C(0xf92e0c3537826145), Q_UINT64_C(0x9bbcc7a142b17ccb),
+    Q_UINT64_C(0xc2abf989935ddbfe), Q_UINT64_C(0xf356f7ebf83552fe), Q_UINT64_C(0x98165af37b2153de),
+    Q_UINT64_C(0xbe1bf1b059e9a8d6), Q_UINT64_C(0xeda2ee1c7064130c), Q_UINT64_C(0x9485d4d1c63e8be7),
+    Q_UINT64_C(0xb9a74a0637ce2ee1), Q_UINT64_C(0xe8111c87c5c1ba99), Q_UINT64_C(0x910ab1d4db9914a0),
+    Q_UINT64_C(0xb54d5e4a127f59c8), Q_UINT64_C(0xe2a0b5dc971f303a), Q_UINT64_C(0x8da471a9de737e24),
+    Q_UINT64_C(0xb10d8e1456105dad), Q_UINT64_C(0xdd50f1996b947518), Q_UINT64_C(0x8a5296ffe33cc92f),
+    Q_UINT64_C(0xace73cbfdc0bfb7b), Q_UINT64_C(0xd8210befd30efa5a), Q_UINT64_C(0x8714a775e3e95c78),
+    Q_UINT64_C(0xa8d9d1535ce3b396), Q_UINT64_C(0xd31045a8341ca07c), Q_UINT64_C(0x83ea2b892091e44d),
+    Q_UINT64_C(0xa4e4b66b68b65d60), Q_UINT64_C(0xce1de40642e3f4b9), Q_UINT64_C(0x80d2ae83e9ce78f3),
+    Q_UINT64_C(0xa1075a24e4421730), Q_UINT64_C(0xc94930ae1d529cfc), Q_UINT64_C(0xfb9b7cd9a4a7443c),
+    Q_UINT64_C(0x9d412e0806e88aa5), Q_UINT64_C(0xc491798a08a2ad4e), Q_UINT64_C(0xf5b5d7ec8acb58a2),
+    Q_UINT64_C(0x9991a6f3d6bf1765), Q_UINT64_C(0xbff610b0cc6edd3f), Q_UINT64_C(0xeff394dcff8a948e),
+    Q_UINT64_C(0x95f83d0a1fb69cd9), Q_UINT64_C(0xbb764c4ca7a4440f), Q_UINT64_C(0xea53df5fd18d5513),
+    Q_UINT64_C(0x92746b9be2f8552c), Q_UINT64_C(0xb7118682dbb66a77), Q_UINT64_C(0xe4d5e82392a40515),
+    Q_UINT64_C(0x8f05b1163ba6832d), Q_UINT64_C(0xb2c71d5bca9023f8), Q_UINT64_C(0xdf78e4b2bd342cf6),
+    Q_UINT64_C(0x8bab8eefb6409c1a), Q_UINT64_C(0xae9672aba3d0c320), Q_UINT64_C(0xda3c0f568cc4f3e8),
+    Q_UINT64_C(0x8865899617fb1871), Q_UINT64_C(0xaa7eebfb9df9de8d), Q_UINT64_C(0xd51ea6fa85785631),
+    Q_UINT64_C(0x8533285c936b35de), Q_UINT64_C(0xa67ff273b8460356), Q_UINT64_C(0xd01fef10a657842c),
+    Q_UINT64_C(0x8213f56a67f6b29b), Q_UINT64_C(0xa298f2c501f45f42), Q_UINT64_C(0xcb3f2f7642717713),
+    Q_UINT64_C(0xfe0efb53d30dd4d7), Q_UINT64_C(0x9ec95d1463e8a506), Q_UINT64_C(0xc67bb4597ce2ce48),
+    Q_UINT64_C(0xf81aa16fdc1b81da), Q_UINT64_C(0x9b10a4e5e9913128), Q_UINT64_C(0xc1d4ce1f63f57d72),
+    Q_UINT64_C(0xf24a01a73cf2dccf), Q_UINT64_C(0x976e41088617ca01), Q_UINT64_C(0xbd49d14aa79dbc82),
+    Q_UINT64_C(0xec9c459d51852ba2), Q_UINT64_C(0x93e1ab8252f33b45), Q_UINT64_C(0xb8da1662e7b00a17),
+    Q_UINT64_C(0xe7109bfba19c0c9d), Q_UINT64_C(0x906a617d450187e2), Q_UINT64_C(0xb484f9dc9641e9da),
+    Q_UINT64_C(0xe1a63853bbd26451), Q_UINT64_C(0x8d07e33455637eb2), Q_UINT64_C(0xb049dc016abc5e5f),
+    Q_UINT64_C(0xdc5c5301c56b75f7), Q_UINT64_C(0x89b9b3e11b6329ba), Q_UINT64_C(0xac2820d9623bf429),
+    Q_UINT64_C(0xd732290fbacaf133), Q_UINT64_C(0x867f59a9d4bed6c0), Q_UINT64_C(0xa81f301449ee8c70),
+    Q_UINT64_C(0xd226fc195c6a2f8c), Q_UINT64_C(0x83585d8fd9c25db7), Q_UINT64_C(0xa42e74f3d032f525),
+    Q_UINT64_C(0xcd3a1230c43fb26f), Q_UINT64_C(0x80444b5e7aa7cf85), Q_UINT64_C(0xa0555e361951c366),
+    Q_UINT64_C(0xc86ab5c39fa63440), Q_UINT64_C(0xfa856334878fc150), Q_UINT64_C(0x9c935e00d4b9d8d2),
+    Q_UINT64_C(0xc3b8358109e84f07), Q_UINT64_C(0xf4a642e14c6262c8), Q_UINT64_C(0x98e7e9cccfbd7dbd),
+    Q_UINT64_C(0xbf21e44003acdd2c), Q_UINT64_C(0xeeea5d5004981478), Q_UINT64_C(0x95527a5202df0ccb),
+    Q_UINT64_C(0xbaa718e68396cffd), Q_UINT64_C(0xe950df20247c83fd), Q_UINT64_C(0x91d28b7416cdd27e),
+    Q_UINT64_C(0xb6472e511c81471d), Q_UINT64_C(0xe3d8f9e563a198e5), Q_UINT64_C(0x8e679c2f5e44ff8f),
+    Q_UINT64_C(0xb201833b35d63f73), Q_UINT64_C(0xde81e40a034bcf4f), Q_UINT64_C(0x8b112e86420f6191),
+    Q_UINT64_C(0xadd57a27d29339f6), Q_UINT64_C(0xd94ad8b1c7380874), Q_UINT64_C(0x87cec76f1c830548),
+    Q_UINT64_C(0xa9c2794ae3a3c69a), Q_UINT64_C(0xd433179d9c8cb841), Q_UINT64_C(0x849feec281d7f328),
+    Q_UINT64_C(0xa5c7ea73224deff3), Q_UINT64_C(0xcf39e50feae16bef), Q_UINT64_C(0x81842f29f2cce375),
+    Q_UINT64_C(0xa1e53af46f801c53), Q_UINT64_C(0xca5e89b18b602368), Q_UINT64_C(0xfcf62c1dee382c42),
+    Q_UINT64_C(0x9e19db92b4e31ba9), Q_UINT64_C(0xc5a05277621be293), Q_UINT64_C(0xf70867153aa2db38),
+    Q_UINT64_C(0x9a65406d44a5c903), Q_UINT64_C(0xc0fe908895cf3b44), Q_UINT64_C(0xf13e34aabb430a15),
+    Q_UINT64_C(0x96c6e0eab509e64d), Q_UINT64_C(0xbc789925624c5fe0), Q_UINT64_C(0xeb96bf6ebadf77d8),
+    Q_UINT64_C(0x933e37a534cbaae7), Q_UINT64_C(0xb80dc58e81fe95a1), Q_UINT64_C(0xe61136f2227e3b09),
+    Q_UINT64_C(0x8fcac257558ee4e6), Q_UINT64_C(0xb3bd72ed2af29e1f), Q_UINT64_C(0xe0accfa875af45a7),
+    Q_UINT64_C(0x8c6c01c9498d8b88), Q_UINT64_C(0xaf87023b9bf0ee6a), Q_UINT64_C(0xdb68c2ca82ed2a05),
+    Q_UINT64_C(0x892179be91d43a43), Q_UINT64_C(0xab69d82e364948d4), Q_UINT64_C(0xd6444e39c3db9b09),
+    Q_UINT64_C(0x85eab0e41a6940e5), Q_UINT64_C(0xa7655d1d2103911f), Q_UINT64_C(0xd13eb46469447567),
+};
+
+// floor(e * log2(10)) - 63, so that 10^e is about powersOfTen[e] * 2^result
+static inline int powerOfTenBinaryExponent(int e)
+{
+    return ((e * 217706) >> 16) - 63;
+}
+
+static inline quint64 multiplyHigh(quint64 a, quint64 b, quint64 *low)
+{
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 quint128;
+    const quint128 product = quint128(a) * b;
+    *low = quint64(product);
+    return quint64(product >> 64);
+#else
+    const quint64 aLow = a & 0xffffffff, aHigh = a >> 32;
+    const quint64 bLow = b & 0xffffffff, bHigh = b >> 32;
+    const quint64 lowLow = aLow * bLow;
+    const quint64 lowHigh = aLow * bHigh;
+    const quint64 highLow = aHigh * bLow;
+    const quint64 middle = (lowLow >> 32) + (lowHigh & 0xffffffff) + (highLow & 0xffffffff);
+    *low = (middle << 32) | (lowLow & 0xffffffff);
+    return aHigh * bHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+#endif
+}
+
+static inline quint64 multiplyRounded(quint64 a, quint64 b)
+{
+    quint64 low;
+    const quint64 high = multiplyHigh(a, b, &low);
+    return high + (low >> 63);
+}
+
+static const quint32 smallPowersOfTen[] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+
+static inline int decimalLength(quint32 n)
+{
+    int length = 1;
+    while (length < 10 && n >= smallPowersOfTen[length])
+        ++length;
+    return length;
+}
+
+/*
+    Grisu's round_weed: moves the last digit of \a buffer towards the
+    scaled value w as long as that stays within the rounding interval, and
+    then checks that the result is unambiguously the closest shortest one.
+*/
+static bool roundWeedShortest(char *buffer, int length, quint64 distanceTooHighW,
+                              quint64 unsafeInterval, quint64 rest, quint64 tenKappa,
+                              quint64 unit)
+{
+    const quint64 smallDistance = distanceTooHighW - unit;
+    const quint64 bigDistance = distanceTooHighW + unit;
+
+    while (rest < smallDistance
+           && unsafeInterval - rest >= tenKappa
+           && (rest + tenKappa < smallDistance
+               || smallDistance - rest >= rest + tenKappa - smallDistance)) {
+        --buffer[length - 1];
+        rest += tenKappa;
+    }
+
+    if (rest < bigDistance
+            && unsafeInterval - rest >= tenKappa
+            && (rest + tenKappa < bigDistance
+                || bigDistance - rest > rest + tenKappa - bigDistance)) {
+        return false;
+    }
+
+    return 2 * unit <= rest && rest <= unsafeInterval - 4 * unit;
+}
+
+/*
+    Rounds the digits in \a buffer, whose remainder is \a rest out of
+    \a tenKappa, to the nearest. Fails if the error \a unit could make it
+    go either way, which includes all exact ties.
+*/
+static bool roundWeedCounted(char *buffer, int length, quint64 rest, quint64 tenKappa,
+                             quint64 unit, int *kappa)
+{
+    if (unit >= tenKappa || tenKappa - unit <= unit)
+        return false;
+    if (tenKappa - rest > rest && tenKappa - 2 * rest >= 2 * unit)
+        return true;
+    if (rest > unit && tenKappa - (rest - unit) <= rest - unit) {
+        ++buffer[length - 1];
+        for (int i = length - 1; i > 0 && buffer[i] == '0' + 10; --i) {
+            buffer[i] = '0';
+            ++buffer[i - 1];
+        }
+        if (buffer[0] == '0' + 10) {
+            buffer[0] = '1';
+            ++*kappa;
+        }
+        return true;
+    }
+    return false;
+}
+
+/*
+    Computes the digits qdtoa() would produce for the positive, finite and
+    non-zero \a d in \a mode 0 (shortest round-trip representation), 2
+    (\a ndigits significant digits) or 3 (\a ndigits digits after the
+    decimal point). \a buffer must have room for 17 digits. Returns the
+    number of digits, trailing zeros removed, or 0 if the result could not
+    be determined this way.
+*/
+static int grisuDoubleToDigits(double d, int mode, int ndigits, char *buffer, int *decpt)
+{
+    enum { MinTargetExponent = -60, MaxTargetExponent = -32 };
+
+    quint64 bits;
+    memcpy(&bits, &d, sizeof(bits));
+    const quint64 hiddenBit = Q_UINT64_C(1) << 52;
+    const int biasedExponent = int(bits >> 52);
+    quint64 f = bits & (hiddenBit - 1);
+    int e;
+    if (biasedExponent) {
+        f |= hiddenBit;
+        e = biasedExponent - 1075;
+    } else {
+        e = -1074;
+    }
+
+    // The error of the scaled values, in units in the last place: less
+    // than one half from rounding the product and less than one from the
+    // truncated power of ten.
+    quint64 unit = 2;
+
+    const int wShift = int(qCountLeadingZeroBits(f));
+    const quint64 w = f << wShift;
+    const int wExponent = e - wShift;
+
+    // Pick the power of ten 10^k that brings the scaled exponent into
+    // [MinTargetExponent, MaxTargetExponent].
+    const int minPowerExponent = MinTargetExponent - (wExponent + 64);
+    const int k = ((minPowerExponent + 63) * 78913 + (1 << 18) - 1) >> 18;
+    const quint64 power = powersOfTen[k - PowersOfTenMinExponent];
+    const int shift = -(wExponent + powerOfTenBinaryExponent(k) + 64);
+    Q_ASSERT(shift >= -MaxTargetExponent && shift <= -MinTargetExponent);
+    const quint64 one = Q_UINT64_C(1) << shift;
+
+    int length = 0;
+    int kappa;
+
+    if (mode == 0) {
+        // The boundaries of the interval that rounds to d, normalized to the
+        // exponent of w. The lower one is closer for powers of two.
+        const bool lowerBoundaryIsCloser = (bits & (hiddenBit - 1)) == 0 && biasedExponent > 1;
+        const quint64 plus = ((f << 1) + 1) << (wShift - 1);
+        const quint64 minus = lowerBoundaryIsCloser ? ((f << 2) - 1) << (wShift - 2)
+                                                    : ((f << 1) - 1) << (wShift - 1);
+
+        const quint64 scaledW = multiplyRounded(w, power);
+        const quint64 tooLow = multiplyRounded(minus, power) - unit;
+        const quint64 tooHigh = multiplyRounded(plus, power) + unit;
+        quint64 unsafeInterval = tooHigh - tooLow;
+        quint64 distanceTooHighW = tooHigh - scaledW;
+
+        quint32 integrals = quint32(tooHigh >> shift);
+        quint64 fractionals = tooHigh & (one - 1);
+        kappa = decimalLength(integrals);
+        quint32 divisor = smallPowersOfTen[kappa - 1];
+
+        for (;;) {
+            if (kappa > 0) {
+                buffer[length++] = char('0' + integrals / divisor);
+                integrals %= divisor;
+                --kappa;
+                const quint64 rest = (quint64(integrals) << shift) + fractionals;
+                if (rest < unsafeInterval) {
+                    if (!roundWeedShortest(buffer, length, distanceTooHighW, unsafeInterval,
+                                           rest, quint64(divisor) << shift, unit)) {
+                        return 0;
+                    }
+                    break;
+                }
+                divisor /= 10;
+            } else {
+                fractionals *= 10;
+                unit *= 10;
+                unsafeInterval *= 10;
+                distanceTooHighW *= 10;
+                buffer[length++] = char('0' + (fractionals >> shift));
+                fractionals &= one - 1;
+                --kappa;
+                if (fractionals < unsafeInterval) {
+                    if (!roundWeedShortest(buffer, length, distanceTooHighW, unsafeInterval,
+                                           fractionals, one, unit)) {
+                        return 0;
+                    }
+                    break;
+                }
+            }
+        }
+    } else {
+        const quint64 scaledW = multiplyRounded(w, power);
+        quint32 integrals = quint32(scaledW >> shift);
+        quint64 fractionals = scaledW & (one - 1);
+        kappa = decimalLength(integrals);
+        quint32 divisor = smallPowersOfTen[kappa - 1];
+
+        int requested = mode == 3 ? kappa - k + ndigits : qMax(ndigits, 1);
+        if (requested <= 0 || requested > 17)
+            return 0;
+
+        while (kappa > 0) {
+            buffer[length++] = char('0' + integrals / divisor);
+            integrals %= divisor;
+            --kappa;
+            if (--requested == 0) {
+                const quint64 rest = (quint64(integrals) << shift) + fractionals;
+                if (!roundWeedCounted(buffer, length, rest, quint64(divisor) << shift,
+                                      unit, &kappa)) {
+                    return 0;
+                }
+                break;
+            }
+            divisor /= 10;
+        }
+        if (requested) {
+            while (requested > 0 && fractionals > unit) {
+                fractionals *= 10;
+                unit *= 10;
+                buffer[length++] = char('0' + (fractionals >> shift));
+                fractionals &= one - 1;
+                --kappa;
+                --requested;
+            }
+            if (requested || !roundWeedCounted(buffer, length, fractionals, one, unit, &kappa))
+                return 0;
+        }
+    }
+
+    *decpt = length + kappa - k;
+    while (length > 1 && buffer[length - 1] == '0')
+        --length;
+    return length;
+}
+
+/*
+    The Eisel-Lemire algorithm: converts \a mantissa * 10^\a exponent to the
+    bits of the nearest double. Fails for ties, results that are subnormal
+    or overflow, and whenever the truncation of the power of ten could
+    affect the result.
+*/
+static bool eiselLemire(quint64 mantissa, int exponent, quint64 *bits)
+{
+    const int leadingZeros = int(qCountLeadingZeroBits(mantissa));
+    mantissa <<= leadingZeros;
+
+    quint64 low;
+    const quint64 high = multiplyHigh(mantissa, powersOfTen[exponent - PowersOfTenMinExponent],
+                                      &low);
+    // The exact product is larger by less than mantissa in the low half;
+    // that must not carry into the bits we keep.
+    if ((high & 0x1ff) == 0x1ff && low + mantissa < low)
+        return false;
+
+    const int msb = int(high >> 63);
+    quint64 result = high >> (msb + 9);
+    int binaryExponent = ((exponent * 217706) >> 16) + 64 + 1023 - leadingZeros - (1 ^ msb);
+
+    // Possibly halfway between two doubles: let the exact code break the tie.
+    if (low == 0 && (high & 0x1ff) == 0 && (result & 3) == 1)
+        return false;
+
+    result += result & 1;
+    result >>= 1;
+    if (result >> 53) {
+        result >>= 1;
+        ++binaryExponent;
+    }
+    if (binaryExponent <= 0 || binaryExponent >= 0x7ff)
+        return false;
+
+    *bits = (quint64(binaryExponent) << 52) | (result & ((Q_UINT64_C(1) << 52) - 1));
+    return true;
+}
+
+/*
+    Parses the common forms of numbers qstrtod() accepts: an optional sign,
+    at most 19 significant digits with an optional decimal point and an
+    optional exponent. Returns \c false, without touching \a se, for anything
+    else or if eiselLemire() can't decide.
+*/
+static bool fastStrtod(const char *s, const char **se, double *result)
+{
+    bool negative = false;
+    if (*s == '-') {
+        negative = true;
+        ++s;
+    } else if (*s == '+') {
+        ++s;
+    }
+
+    quint64 mantissa = 0;
+    int significantDigits = 0;
+    int exponent = 0;
+    bool anyDigits = false;
+
+    for (; uint(*s - '0') < 10; ++s) {
+        anyDigits = true;
+        if (mantissa || *s != '0') {
+            if (++significantDigits > 19)
+                return false;
+            mantissa = 10 * mantissa + uint(*s - '0');
+        }
+    }
+    if (*s == '.') {
+        for (++s; uint(*s - '0') < 10; ++s) {
+            anyDigits = true;
+            --exponent;
+            if (mantissa || *s != '0') {
+                if (++significantDigits > 19)
+                    return false;
+                mantissa = 10 * mantissa + uint(*s - '0');
+            }
+        }
+    }
+    if (!anyDigits)
+        return false;
+
+    if (*s == 'e' || *s == 'E') {
+        const char *p = s + 1;
+        bool negativeExponent = false;
+        if (*p == '-') {
+            negativeExponent = true;
+            ++p;
+        } else if (*p == '+') {
+            ++p;
+        }
+        if (uint(*p - '0') >= 10)
+            return false;
+        int explicitExponent = 0;
+        for (; uint(*p - '0') < 10; ++p) {
+            if (explicitExponent < 100000)
+                explicitExponent = 10 * explicitExponent + (*p - '0');
+        }
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+        s = p;
+    }
+
+    quint64 bits = 0;
+    if (mantissa) {
+        if (exponent < PowersOfTenMinExponent || exponent > PowersOfTenMaxExponent)
+            return false;
+        if (!eiselLemire(mantissa, exponent, &bits))
+            return false;
+    }
+    if (negative)
+        bits |= Q_UINT64_C(1) << 63;
+
+    memcpy(result, &bits, sizeof(*result));
+    if (se)
+        *se = s;
+    return true;
+}
+
 /*        From: NetBSD: strtod.c,v 1.26 1998/02/03 18:44:21 perry Exp */
 /* $FreeBSD: src/lib/libc/stdlib/netbsd_strtod.c,v 1.2.2.2 2001/03/02 17:14:15 tegge Exp $        */
 
@@ -1287,6 +1932,9 @@ Q_CORE_EXPORT double qstrtod(const char *s00, const char **se, bool *ok)
     if (ok != 0)
         *ok = true;
 
+    if (fastStrtod(s00, se, &rv))
+        return rv;
+
     const char decimal_point = '.';
 
     sign = nz0 = nz = 0;
@@ -2009,6 +2657,45 @@ Q_CORE_EXPORT char *qdtoa ( double d, int mode, int ndigits, int *decpt, int *si
     return s;
 }
 
+/*
+    Returns the digits of \a d as qdtoa() computes them, without requiring
+    the caller to free anything. Uses the Grisu fast path when it can.
+*/
+QString qdtoaDigits(double d, int mode, int ndigits, int *decpt, int *sign)
+{
+    quint64 bits;
+    memcpy(&bits, &d, sizeof(bits));
+    *sign = int(bits >> 63);
+    bits &= ~(Q_UINT64_C(1) << 63);
+
+    if (bits == 0) {
+        *decpt = 1;
+        return QString(QLatin1Char('0'));
+    }
+
+    if ((bits >> 52) != 0x7ff) {
+        char buffer[17];
+        double magnitude;
+        memcpy(&magnitude, &bits, sizeof(magnitude));
+        const int length = grisuDoubleToDigits(magnitude, mode, ndigits, buffer, decpt);
+        if (length)
+            return QString::fromLatin1(buffer, length);
+    }
+
+    QString digits;
+    char *buff = 0;
+    QT_TRY {
+        digits = QLatin1String(qdtoa(d, mode, ndigits, decpt, sign, 0, &buff));
+    } QT_CATCH(...) {
+        if (buff != 0)
+            free(buff);
+        QT_RETHROW;
+    }
+    if (buff != 0)
+        free(buff);
+    return digits;
+}
+
 static char *_qdtoa( NEEDS_VOLATILE double d, int mode, int ndigits, int *decpt, int *sign, char **rve, char **resultp)
 {
     /*
@@ -68,6 +68,7 @@ QT_BEGIN_NAMESPACE
 
 QString qulltoa(qulonglong l, int base, const QChar _zero);
 QString qlltoa(qlonglong l, int base, const QChar zero);
+QString qlltoa_decimal(qlonglong l, const QChar zero, const QChar minus);
 
 enum PrecisionMode {
     PMDecimalDigits =             0x01,
@@ -98,6 +99,7 @@ inline bool isZero(double d)
 
 Q_CORE_EXPORT char *qdtoa(double d, int mode, int ndigits, int *decpt,
                           int *sign, char **rve, char **digits_str);
+QString qdtoaDigits(double d, int mode, int ndigits, int *decpt, int *sign);
 Q_CORE_EXPORT double qstrtod(const char *s00, char const **se, bool *ok);
 qlonglong qstrtoll(const char *nptr, const char **endptr, int base, bool *ok);
 qulonglong qstrtoull(const char *nptr, const char **endptr, int base, bool *ok);
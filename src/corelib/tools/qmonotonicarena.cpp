@@ -0,0 +1,251 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qmonotonicarena.h"
+
+#include <stdlib.h>
+
+QT_BEGIN_NAMESPACE
+
+enum {
+    // Blocks double in size up to this, so that a large arena neither
+    // wastes much of its last block nor consists of many small ones.
+    MaxBlockSize = 1024 * 1024,
+    BlockAlignment = 2 * sizeof(void *)
+};
+
+struct QMonotonicArena::Block
+{
+    Block *next;
+    char *end;
+
+    char *data() { return reinterpret_cast<char *>(this) + HeaderSize; }
+    const char *data() const { return reinterpret_cast<const char *>(this) + HeaderSize; }
+
+    enum { HeaderSize = (2 * sizeof(void *) + BlockAlignment - 1) & ~(BlockAlignment - 1) };
+};
+
+/*!
+    \class QMonotonicArena
+    \inmodule QtCore
+    \since 5.6
+    \brief The QMonotonicArena class provides memory that is released all at once.
+
+    \ingroup tools
+    \reentrant
+
+    A QMonotonicArena hands out memory from large blocks, moving a pointer
+    forward for each allocation. Individual allocations are never freed:
+    all memory goes back at once when release() is called or the arena is
+    destroyed. Allocating is therefore very cheap, and since every thread
+    uses its own arena, threads do not contend for the allocator.
+
+    The arena can also hold the nodes of a QHash, which are otherwise
+    allocated one by one. createHash() returns an empty hash whose nodes
+    come from the arena. This suits request-scoped work, where a message
+    is parsed into temporary hashes that are all discarded afterwards:
+
+    \snippet code/src_corelib_tools_qmonotonicarena.cpp 0
+
+    Only hashes created that way use the arena; all other containers
+    allocate from the heap as usual. The data of such a hash records that
+    it belongs to an arena, so freeing its nodes is a no-op, whatever
+    thread it happens in. Copies share the data until one of them is
+    modified, at which point it gets a copy on the heap. The bucket array
+    of the hash is always on the heap.
+
+    The implicitly shared array classes, QString, QByteArray and QVector,
+    cannot use an arena: their allocation is partly inline in the
+    application, so their data layout cannot record where it came from.
+
+    \warning Hashes that use an arena must be destroyed, or must have
+    been detached to the heap, before the arena is released or destroyed.
+    This includes copies of them, which share their data.
+
+    QMonotonicArena itself is not thread-safe: allocate() must be called
+    from one thread at a time. Since a QHash created by an arena allocates
+    from it whenever an item is inserted, such a hash must only be
+    modified in the thread that uses the arena.
+*/
+
+/*!
+    Constructs an empty arena. The first block of memory is allocated on
+    first use and holds \a initialBlockSize bytes; each further block is
+    twice as large as the previous one, up to one megabyte.
+*/
+QMonotonicArena::QMonotonicArena(size_t initialBlockSize)
+    : m_blocks(Q_NULLPTR),
+      m_pos(Q_NULLPTR),
+      m_end(Q_NULLPTR),
+      m_nextBlockSize(qBound(size_t(256), initialBlockSize, size_t(MaxBlockSize))),
+      m_bytesAllocated(0)
+{
+}
+
+/*!
+    Destroys the arena, and frees all memory that was allocated from it.
+*/
+QMonotonicArena::~QMonotonicArena()
+{
+    freeBlocks(m_blocks);
+}
+
+/*!
+    Returns a pointer to \a size bytes of memory aligned to \a alignment,
+    which must be a power of two, or a null pointer if no memory is
+    available. The memory remains valid until release() is called or the
+    arena is destroyed.
+*/
+void *QMonotonicArena::allocate(size_t size, size_t alignment) Q_DECL_NOTHROW
+{
+    Q_ASSERT(alignment && !(alignment & (alignment - 1)));
+    if (!size)
+        size = 1;
+
+    quintptr pos = (quintptr(m_pos) + alignment - 1) & ~quintptr(alignment - 1);
+    if (!m_pos || pos > quintptr(m_end) || size > quintptr(m_end) - pos) {
+        if (size > size_t(MaxBlockSize)) {
+            // too large to share a block: give it one of its own, behind
+            // the current one, which may still have room for small requests
+            Block *block = newBlock(size + alignment - 1 + Block::HeaderSize);
+            if (!block)
+                return Q_NULLPTR;
+            if (m_blocks) {
+                block->next = m_blocks->next;
+                m_blocks->next = block;
+            } else {
+                m_blocks = block;
+            }
+            m_bytesAllocated += size;
+            return reinterpret_cast<void *>((quintptr(block->data()) + alignment - 1)
+                                            & ~quintptr(alignment - 1));
+        }
+        if (!addBlock(size + alignment - 1))
+            return Q_NULLPTR;
+        pos = (quintptr(m_pos) + alignment - 1) & ~quintptr(alignment - 1);
+    }
+
+    m_pos = reinterpret_cast<char *>(pos + size);
+    m_bytesAllocated += size;
+    return reinterpret_cast<void *>(pos);
+}
+
+/*!
+    Returns \c true if \a ptr points into memory that was allocated from
+    this arena; otherwise returns \c false.
+*/
+bool QMonotonicArena::owns(const void *ptr) const Q_DECL_NOTHROW
+{
+    const char *p = static_cast<const char *>(ptr);
+    for (const Block *block = m_blocks; block; block = block->next) {
+        if (p >= block->data() && p < block->end)
+            return true;
+    }
+    return false;
+}
+
+/*!
+    Releases all memory that was allocated from the arena, so that it can
+    be handed out again. The block that small allocations were last made
+    from is kept for reuse, and the others are freed.
+
+    \sa bytesAllocated()
+*/
+void QMonotonicArena::release() Q_DECL_NOTHROW
+{
+    // keep the block that small allocations are made from, if there is one
+    Block *kept = m_pos ? m_blocks : Q_NULLPTR;
+    if (kept) {
+        freeBlocks(kept->next);
+        kept->next = Q_NULLPTR;
+        m_pos = kept->data();
+    } else {
+        freeBlocks(m_blocks);
+    }
+    m_blocks = kept;
+    m_bytesAllocated = 0;
+}
+
+/*!
+    \fn size_t QMonotonicArena::bytesAllocated() const
+
+    Returns the number of bytes that were allocated from the arena since
+    it was constructed or last released, not counting alignment padding.
+*/
+
+/*!
+    \fn QHash<Key, T> QMonotonicArena::createHash(int capacity)
+
+    Returns an empty hash whose items are all allocated from the arena. If
+    \a capacity is positive, the hash reserves space for that many items.
+
+    \sa QHash::reserve()
+*/
+
+QMonotonicArena::Block *QMonotonicArena::newBlock(size_t size) Q_DECL_NOTHROW
+{
+    if (size < Block::HeaderSize)
+        return Q_NULLPTR; // overflow
+    Block *block = static_cast<Block *>(::malloc(size));
+    if (block) {
+        block->next = Q_NULLPTR;
+        block->end = reinterpret_cast<char *>(block) + size;
+    }
+    return block;
+}
+
+void QMonotonicArena::freeBlocks(Block *block) Q_DECL_NOTHROW
+{
+    while (block) {
+        Block *next = block->next;
+        ::free(block);
+        block = next;
+    }
+}
+
+bool QMonotonicArena::addBlock(size_t minimumSize) Q_DECL_NOTHROW
+{
+    Block *block = newBlock(qMax(m_nextBlockSize, minimumSize + Block::HeaderSize));
+    if (!block)
+        return false;
+
+    block->next = m_blocks;
+    m_blocks = block;
+    m_pos = block->data();
+    m_end = block->end;
+    m_nextBlockSize = qMin(2 * m_nextBlockSize, size_t(MaxBlockSize));
+    return true;
+}
+
+QT_END_NAMESPACE
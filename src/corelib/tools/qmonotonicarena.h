@@ -0,0 +1,86 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QMONOTONICARENA_H
+#define QMONOTONICARENA_H
+
+#include <QtCore/qhash.h>
+
+QT_BEGIN_NAMESPACE
+
+class Q_CORE_EXPORT QMonotonicArena
+{
+public:
+    explicit QMonotonicArena(size_t initialBlockSize = 4096);
+    ~QMonotonicArena();
+
+    void *allocate(size_t size, size_t alignment) Q_DECL_NOTHROW Q_REQUIRED_RESULT;
+    bool owns(const void *ptr) const Q_DECL_NOTHROW;
+    void release() Q_DECL_NOTHROW;
+
+    size_t bytesAllocated() const Q_DECL_NOTHROW { return m_bytesAllocated; }
+
+    template <typename Key, typename T>
+    QHash<Key, T> createHash(int capacity = 0);
+
+private:
+    Q_DISABLE_COPY(QMonotonicArena)
+
+    struct Block;
+    static Block *newBlock(size_t size) Q_DECL_NOTHROW;
+    static void freeBlocks(Block *block) Q_DECL_NOTHROW;
+    bool addBlock(size_t minimumSize) Q_DECL_NOTHROW;
+
+    Block *m_blocks;
+    char *m_pos;
+    char *m_end;
+    size_t m_nextBlockSize;
+    size_t m_bytesAllocated;
+};
+
+template <typename Key, typename T>
+QHash<Key, T> QMonotonicArena::createHash(int capacity)
+{
+    typedef QHash<Key, T> Hash;
+    Hash hash;
+    hash.d = hash.d->detach_helper(Hash::duplicateNode, Hash::deleteNode2,
+                                   sizeof(typename Hash::Node), Hash::alignOfNode(), this);
+    if (capacity > 0)
+        hash.reserve(capacity);
+    return hash;
+}
+
+QT_END_NAMESPACE
+
+#endif // QMONOTONICARENA_H
@@ -302,6 +302,16 @@ static inline uint detectProcessorFeatures()
             features |= AVX2;
     }
 
+    if ((xgetbvA & AVX512State) == AVX512State) {
+        // support for ZMM and opmask registers is enabled
+        if (cpuid0700EBX & (1u << 16)) {
+            features |= AVX512F;
+
+            if (cpuid0700EBX & (1u << 30))
+                features |= AVX512BW;
+        }
+    }
+
     if (cpuid0700EBX & (1u << 4))
         features |= HLE; // Hardware Lock Ellision
     if (cpuid0700EBX & (1u << 11))
@@ -469,6 +479,8 @@ static inline uint detectProcessorFeatures()
  rtm
  dsp
  dspr2
+ avx512f
+ avx512bw
   */
 
 // begin generated
@@ -486,11 +498,13 @@ static const char features_string[] =
     " rtm\0"
     " dsp\0"
     " dspr2\0"
+    " avx512f\0"
+    " avx512bw\0"
     "\0";
 
 static const int features_indices[] = {
     0,    1,    7,   13,   19,   26,   34,   42,
-   47,   53,   58,   63,   68,   -1
+   47,   53,   58,   63,   68,   75,   84,   -1
 };
 // end generated
 
@@ -73,6 +73,7 @@
  *  SSE4_2   | x86  | I & C | I & C    | I only |
  *  AVX      | x86  | I & C | I & C    | I & C  |
  *  AVX2     | x86  | I & C | I & C    | I only |
+ *  AVX512BW | x86  | I & C | I & C    | I only |
  * I = intrinsics; C = code generation
  *
  * Code can use the following constructs to determine compiler support & status:
@@ -198,6 +199,7 @@
 // AVX intrinsics
 #define QT_FUNCTION_TARGET_STRING_AVX       "avx"
 #define QT_FUNCTION_TARGET_STRING_AVX2      "avx2"
+#define QT_FUNCTION_TARGET_STRING_AVX512BW  "avx512f,avx512bw"
 #if defined(__AVX__) || (defined(QT_COMPILER_SUPPORTS_AVX) && defined(QT_COMPILER_SUPPORTS_SIMD_ALWAYS))
 // immintrin.h is the ultimate header, we don't need anything else after this
 #include <immintrin.h>
@@ -256,6 +258,8 @@ enum CPUFeatures {
     RTM         = 0x400,
     DSP         = 0x800,
     DSPR2       = 0x1000,
+    AVX512F     = 0x2000,
+    AVX512BW    = 0x4000,
 
     // used only to indicate that the CPU detection was initialised
     QSimdInitialized = 0x80000000
@@ -268,6 +272,12 @@ static const uint qCompilerCpuFeatures = 0
 #if defined __HLE__
         | HLE
 #endif
+#if defined __AVX512BW__
+        | AVX512BW
+#endif
+#if defined __AVX512F__
+        | AVX512F
+#endif
 #if defined __AVX2__
         | AVX2
 #endif
@@ -202,9 +202,74 @@ inline RetType UnrollTailLoop<0>::exec(int, RetType returnIfExited, Functor1, Fu
 }
 #endif
 
+/*
+    The AVX2 and AVX-512 BW versions of the kernels below are selected at
+    runtime with qCpuHasFeature(), so a Qt built for plain SSE2 still uses
+    the wider registers when the processor has them.
+
+    The AVX2 versions require at least one full vector of input and handle
+    the tail by redoing the last full vector, which may overlap the previous
+    one. The last vector is done after the loop instead of by clamping the
+    offset inside it, which would add a dependency to every iteration. The
+    AVX-512 versions handle the tail with masked loads and stores, which do
+    not fault on the masked-out elements.
+*/
+#if QT_COMPILER_SUPPORTS_HERE(AVX512BW)
+static inline __mmask32 tailMask32(qptrdiff count)
+{
+    Q_ASSERT(count > 0 && count < 32);
+    return __mmask32((1u << count) - 1);
+}
+#endif
+
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+QT_FUNCTION_TARGET(AVX2)
+static inline void qt_from_latin1_block_avx2(ushort *dst, const char *str)
+{
+    const __m128i chunk = _mm_loadu_si128((const __m128i *)str);
+    _mm256_storeu_si256((__m256i *)dst, _mm256_cvtepu8_epi16(chunk));
+}
+
+QT_FUNCTION_TARGET(AVX2)
+static void qt_from_latin1_avx2(ushort *dst, const char *str, qptrdiff size)
+{
+    Q_ASSERT(size >= 16);
+    const qptrdiff last = size - 16;
+    for (qptrdiff offset = 0; offset < last; offset += 16)
+        qt_from_latin1_block_avx2(dst + offset, str + offset);
+    qt_from_latin1_block_avx2(dst + last, str + last);
+}
+#endif
+
+#if QT_COMPILER_SUPPORTS_HERE(AVX512BW)
+QT_FUNCTION_TARGET(AVX512BW)
+static void qt_from_latin1_avx512bw(ushort *dst, const char *str, qptrdiff size)
+{
+    qptrdiff offset = 0;
+    for ( ; offset + 32 <= size; offset += 32) {
+        const __m256i chunk = _mm256_loadu_si256((const __m256i *)(str + offset));
+        _mm512_storeu_si512(dst + offset, _mm512_cvtepu8_epi16(chunk));
+    }
+    if (offset < size) {
+        const __mmask32 mask = tailMask32(size - offset);
+        const __m256i chunk = _mm512_castsi512_si256(_mm512_maskz_loadu_epi8(mask, str + offset));
+        _mm512_mask_storeu_epi16(dst + offset, mask, _mm512_cvtepu8_epi16(chunk));
+    }
+}
+#endif
+
 // conversion between Latin 1 and UTF-16
 void qt_from_latin1(ushort *dst, const char *str, size_t size)
 {
+#if QT_COMPILER_SUPPORTS_HERE(AVX512BW)
+    if (size >= 32 && qCpuHasFeature(AVX512BW))
+        return qt_from_latin1_avx512bw(dst, str, size);
+#endif
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (size >= 16 && qCpuHasFeature(AVX2))
+        return qt_from_latin1_avx2(dst, str, size);
+#endif
+
     /* SIMD:
      * Unpacking with SSE has been shown to improve performance on recent CPUs
      * The same method gives no improvement with NEON.
@@ -308,8 +373,69 @@ static inline __m128i mergeQuestionMarks(__m128i chunk)
 }
 #endif
 
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+QT_FUNCTION_TARGET(AVX2)
+static inline __m128i qt_to_latin1_block_avx2(const ushort *src)
+{
+    const __m256i questionMark = _mm256_set1_epi16('?');
+    const __m256i latin1Max = _mm256_set1_epi16(0xff);
+    __m256i chunk = _mm256_loadu_si256((const __m256i *)src);
+
+    // replace the non-Latin 1 characters with question marks
+    const __m256i inLimit = _mm256_cmpeq_epi16(_mm256_min_epu16(chunk, latin1Max), chunk);
+    chunk = _mm256_blendv_epi8(questionMark, chunk, inLimit);
+
+    // pack the two halves to 16 x 8bits elements
+    return _mm_packus_epi16(_mm256_castsi256_si128(chunk), _mm256_extracti128_si256(chunk, 1));
+}
+
+QT_FUNCTION_TARGET(AVX2)
+static void qt_to_latin1_avx2(uchar *dst, const ushort *src, qptrdiff length)
+{
+    Q_ASSERT(length >= 16);
+    // QString::toLatin1() converts in place when it can, so the stores may
+    // overwrite the source of the overlapping last vector: convert it first
+    const qptrdiff last = length - 16;
+    const __m128i lastChunk = qt_to_latin1_block_avx2(src + last);
+    for (qptrdiff offset = 0; offset < last; offset += 16)
+        _mm_storeu_si128((__m128i *)(dst + offset), qt_to_latin1_block_avx2(src + offset));
+    _mm_storeu_si128((__m128i *)(dst + last), lastChunk);
+}
+#endif
+
+#if QT_COMPILER_SUPPORTS_HERE(AVX512BW)
+QT_FUNCTION_TARGET(AVX512BW)
+static void qt_to_latin1_avx512bw(uchar *dst, const ushort *src, qptrdiff length)
+{
+    const __m512i questionMark = _mm512_set1_epi16('?');
+    const __m512i latin1Max = _mm512_set1_epi16(0xff);
+    qptrdiff offset = 0;
+    for ( ; offset + 32 <= length; offset += 32) {
+        __m512i chunk = _mm512_loadu_si512(src + offset);
+        chunk = _mm512_mask_mov_epi16(chunk, _mm512_cmpgt_epu16_mask(chunk, latin1Max), questionMark);
+        _mm256_storeu_si256((__m256i *)(dst + offset), _mm512_cvtepi16_epi8(chunk));
+    }
+    if (offset < length) {
+        const __mmask32 mask = tailMask32(length - offset);
+        __m512i chunk = _mm512_maskz_loadu_epi16(mask, src + offset);
+        chunk = _mm512_mask_mov_epi16(chunk, _mm512_cmpgt_epu16_mask(chunk, latin1Max), questionMark);
+        const __m512i result = _mm512_castsi256_si512(_mm512_cvtepi16_epi8(chunk));
+        _mm512_mask_storeu_epi8(dst + offset, mask, result);
+    }
+}
+#endif
+
 static void qt_to_latin1(uchar *dst, const ushort *src, int length)
 {
+#if QT_COMPILER_SUPPORTS_HERE(AVX512BW)
+    if (length >= 32 && qCpuHasFeature(AVX512BW))
+        return qt_to_latin1_avx512bw(dst, src, length);
+#endif
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (length >= 16 && qCpuHasFeature(AVX2))
+        return qt_to_latin1_avx2(dst, src, length);
+#endif
+
 #if defined(__SSE2__)
     uchar *e = dst + length;
     qptrdiff offset = 0;
@@ -368,6 +494,105 @@ static void qt_to_latin1(uchar *dst, const ushort *src, int length)
 #endif
 }
 
+/*
+    The vectorized case-insensitive comparisons only deal with ASCII, whose
+    case folding is a matter of setting bit 5 of 'A' to 'Z'. They skip the
+    leading blocks that compare equal and return true with the result if
+    they found a difference in a block of ASCII characters. Otherwise they
+    return false, with \a a and \a b advanced to the first block that was
+    not ASCII, and the caller compares the rest with full case folding.
+    Since the characters before that point are ASCII, none of them can be
+    the high half of a surrogate pair, so the caller can start afresh.
+*/
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+QT_FUNCTION_TARGET(AVX2)
+static inline __m256i foldAsciiCase_avx2(__m256i chunk)
+{
+    const __m256i offset = _mm256_sub_epi16(chunk, _mm256_set1_epi16('A'));
+    const __m256i isUpper = _mm256_cmpeq_epi16(_mm256_min_epu16(offset, _mm256_set1_epi16('Z' - 'A')),
+                                               offset);
+    return _mm256_or_si256(chunk, _mm256_and_si256(isUpper, _mm256_set1_epi16(0x20)));
+}
+
+// returns false if the block is not all ASCII, otherwise sets *mask to the
+// bytes that differ after case folding
+QT_FUNCTION_TARGET(AVX2)
+static inline bool ucstricmp_ascii_block_avx2(const ushort *a, const ushort *b, uint *mask)
+{
+    const __m256i a_data = _mm256_loadu_si256((const __m256i *)a);
+    const __m256i b_data = _mm256_loadu_si256((const __m256i *)b);
+    if (!_mm256_testz_si256(_mm256_or_si256(a_data, b_data), _mm256_set1_epi16(short(0xff80))))
+        return false;
+
+    const __m256i equal = _mm256_cmpeq_epi16(foldAsciiCase_avx2(a_data), foldAsciiCase_avx2(b_data));
+    *mask = ~_mm256_movemask_epi8(equal);
+    return true;
+}
+
+QT_FUNCTION_TARGET(AVX2)
+static bool ucstricmp_ascii_avx2(const ushort *&a, const ushort *&b, const ushort *e, int *result)
+{
+    Q_ASSERT(e - a >= 16);
+    const ushort *last = e - 16;
+    for (uint mask; ; a += 16, b += 16) {
+        if (a >= last) {
+            // redo the last full block
+            b -= a - last;
+            a = last;
+        }
+        if (!ucstricmp_ascii_block_avx2(a, b, &mask))
+            return false;
+        if (mask) {
+            const uint idx = uint(_bit_scan_forward(mask)) / 2;
+            *result = foldCase(a[idx]) - foldCase(b[idx]);
+            return true;
+        }
+        if (a == last) {
+            a += 16;
+            b += 16;
+            return false;
+        }
+    }
+}
+#endif
+
+#if QT_COMPILER_SUPPORTS_HERE(AVX512BW)
+QT_FUNCTION_TARGET(AVX512BW)
+static inline __m512i foldAsciiCase_avx512bw(__m512i chunk)
+{
+    const __m512i offset = _mm512_sub_epi16(chunk, _mm512_set1_epi16('A'));
+    const __mmask32 isUpper = _mm512_cmple_epu16_mask(offset, _mm512_set1_epi16('Z' - 'A'));
+    return _mm512_mask_add_epi16(chunk, isUpper, chunk, _mm512_set1_epi16(0x20));
+}
+
+QT_FUNCTION_TARGET(AVX512BW)
+static bool ucstricmp_ascii_avx512bw(const ushort *&a, const ushort *&b, const ushort *e, int *result)
+{
+    const __m512i nonAscii = _mm512_set1_epi16(short(0xff80));
+    while (a < e) {
+        const qptrdiff count = e - a;
+        const __mmask32 valid = count < 32 ? tailMask32(count) : __mmask32(~0u);
+        const __m512i a_data = _mm512_maskz_loadu_epi16(valid, a);
+        const __m512i b_data = _mm512_maskz_loadu_epi16(valid, b);
+        if (_mm512_test_epi16_mask(_mm512_or_si512(a_data, b_data), nonAscii))
+            return false;
+
+        const __mmask32 mask = _mm512_cmpneq_epi16_mask(foldAsciiCase_avx512bw(a_data),
+                                                        foldAsciiCase_avx512bw(b_data));
+        if (mask) {
+            const uint idx = uint(_bit_scan_forward(mask));
+            *result = foldCase(a[idx]) - foldCase(b[idx]);
+            return true;
+        }
+
+        const qptrdiff step = qMin<qptrdiff>(count, 32);
+        a += step;
+        b += step;
+    }
+    return false;
+}
+#endif
+
 // Unicode case-insensitive comparison
 static int ucstricmp(const ushort *a, const ushort *ae, const ushort *b, const ushort *be)
 {
@@ -382,6 +607,21 @@ static int ucstricmp(const ushort *a, const ushort *ae, const ushort *b, const u
     if (be - b < ae - a)
         e = a + (be - b);
 
+#if QT_COMPILER_SUPPORTS_HERE(AVX512BW)
+    if (e - a >= 32 && qCpuHasFeature(AVX512BW)) {
+        int result;
+        if (ucstricmp_ascii_avx512bw(a, b, e, &result))
+            return result;
+    }
+#endif
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (e - a >= 16 && qCpuHasFeature(AVX2)) {
+        int result;
+        if (ucstricmp_ascii_avx2(a, b, e, &result))
+            return result;
+    }
+#endif
+
     uint alast = 0;
     uint blast = 0;
     while (a < e) {
@@ -439,9 +679,99 @@ extern "C" int qt_ucstrncmp_mips_dsp_asm(const ushort *a,
                                          unsigned len);
 #endif
 
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+// returns the bytes of the 16 characters at a and b that differ
+QT_FUNCTION_TARGET(AVX2)
+static inline uint ucstrncmp_block_avx2(const ushort *a, const ushort *b)
+{
+    const __m256i a_data = _mm256_loadu_si256((const __m256i *)a);
+    const __m256i b_data = _mm256_loadu_si256((const __m256i *)b);
+    return ~_mm256_movemask_epi8(_mm256_cmpeq_epi16(a_data, b_data));
+}
+
+QT_FUNCTION_TARGET(AVX2)
+static inline uint ucstrncmp_block_avx2(const ushort *uc, const uchar *c)
+{
+    const __m256i ldata = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)c));
+    const __m256i ucdata = _mm256_loadu_si256((const __m256i *)uc);
+    return ~_mm256_movemask_epi8(_mm256_cmpeq_epi16(ldata, ucdata));
+}
+
+template <typename Char>
+QT_FUNCTION_TARGET(AVX2)
+static int ucstrncmp_avx2(const ushort *a, const Char *b, qptrdiff l)
+{
+    Q_ASSERT(l >= 16);
+    const qptrdiff last = l - 16;
+    qptrdiff offset = 0;
+    uint mask = 0;
+    for ( ; offset < last; offset += 16) {
+        if ((mask = ucstrncmp_block_avx2(a + offset, b + offset)))
+            break;
+    }
+    if (!mask) {
+        offset = last;
+        if (!(mask = ucstrncmp_block_avx2(a + offset, b + offset)))
+            return 0;
+    }
+
+    // found a different character
+    const qptrdiff idx = offset + _bit_scan_forward(mask) / 2;
+    return a[idx] - b[idx];
+}
+#endif
+
+#if QT_COMPILER_SUPPORTS_HERE(AVX512BW)
+QT_FUNCTION_TARGET(AVX512BW)
+static int ucstrncmp_avx512bw(const ushort *a, const ushort *b, qptrdiff l)
+{
+    for (qptrdiff offset = 0; offset < l; offset += 32) {
+        const qptrdiff count = l - offset;
+        const __mmask32 valid = count < 32 ? tailMask32(count) : __mmask32(~0u);
+        const __m512i a_data = _mm512_maskz_loadu_epi16(valid, a + offset);
+        const __m512i b_data = _mm512_maskz_loadu_epi16(valid, b + offset);
+        const __mmask32 mask = _mm512_cmpneq_epi16_mask(a_data, b_data);
+        if (mask) {
+            // found a different character
+            const qptrdiff idx = offset + _bit_scan_forward(mask);
+            return a[idx] - b[idx];
+        }
+    }
+    return 0;
+}
+
+QT_FUNCTION_TARGET(AVX512BW)
+static int ucstrncmp_avx512bw(const ushort *uc, const uchar *c, qptrdiff l)
+{
+    for (qptrdiff offset = 0; offset < l; offset += 32) {
+        const qptrdiff count = l - offset;
+        const __mmask32 valid = count < 32 ? tailMask32(count) : __mmask32(~0u);
+        const __m256i chunk = _mm512_castsi512_si256(_mm512_maskz_loadu_epi8(valid, c + offset));
+        const __m512i ucdata = _mm512_maskz_loadu_epi16(valid, uc + offset);
+        const __mmask32 mask = _mm512_cmpneq_epi16_mask(_mm512_cvtepu8_epi16(chunk), ucdata);
+        if (mask) {
+            // found a different character
+            const qptrdiff idx = offset + _bit_scan_forward(mask);
+            return uc[idx] - c[idx];
+        }
+    }
+    return 0;
+}
+#endif
+
 // Unicode case-sensitive compare two same-sized strings
 static int ucstrncmp(const QChar *a, const QChar *b, int l)
 {
+#if QT_COMPILER_SUPPORTS_HERE(AVX512BW)
+    if (l >= 32 && qCpuHasFeature(AVX512BW))
+        return ucstrncmp_avx512bw(reinterpret_cast<const ushort *>(a),
+                                  reinterpret_cast<const ushort *>(b), l);
+#endif
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (l >= 16 && qCpuHasFeature(AVX2))
+        return ucstrncmp_avx2(reinterpret_cast<const ushort *>(a),
+                              reinterpret_cast<const ushort *>(b), l);
+#endif
 #if defined(__mips_dsp)
     if (l >= 8) {
         return qt_ucstrncmp_mips_dsp_asm(reinterpret_cast<const ushort*>(a),
@@ -532,6 +862,15 @@ static int ucstrncmp(const QChar *a, const uchar *c, int l)
     const ushort *uc = reinterpret_cast<const ushort *>(a);
     const ushort *e = uc + l;
 
+#if QT_COMPILER_SUPPORTS_HERE(AVX512BW)
+    if (l >= 32 && qCpuHasFeature(AVX512BW))
+        return ucstrncmp_avx512bw(uc, c, l);
+#endif
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (l >= 16 && qCpuHasFeature(AVX2))
+        return ucstrncmp_avx2(uc, c, l);
+#endif
+
 #ifdef __SSE2__
     __m128i nullmask = _mm_setzero_si128();
     qptrdiff offset = 0;
@@ -648,6 +987,48 @@ static int ucstrcmp(const QChar *a, int alen, const uchar *b, int blen)
     return cmp ? cmp : (alen-blen);
 }
 
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+QT_FUNCTION_TARGET(AVX2)
+static inline uint findChar_block_avx2(const ushort *n, __m256i mch)
+{
+    const __m256i data = _mm256_loadu_si256((const __m256i *)n);
+    return _mm256_movemask_epi8(_mm256_cmpeq_epi16(data, mch));
+}
+
+QT_FUNCTION_TARGET(AVX2)
+static int findChar_avx2(const ushort *s, const ushort *n, const ushort *e, ushort c)
+{
+    Q_ASSERT(e - n >= 16);
+    const __m256i mch = _mm256_set1_epi16(c);
+    const ushort *last = e - 16;
+    uint mask;
+    for ( ; n < last; n += 16) {
+        if ((mask = findChar_block_avx2(n, mch)))
+            return n - s + _bit_scan_forward(mask) / 2;
+    }
+    if ((mask = findChar_block_avx2(last, mch)))
+        return last - s + _bit_scan_forward(mask) / 2;
+    return -1;
+}
+#endif
+
+#if QT_COMPILER_SUPPORTS_HERE(AVX512BW)
+QT_FUNCTION_TARGET(AVX512BW)
+static int findChar_avx512bw(const ushort *s, const ushort *n, const ushort *e, ushort c)
+{
+    const __m512i mch = _mm512_set1_epi16(c);
+    for ( ; n < e; n += 32) {
+        const qptrdiff count = e - n;
+        const __mmask32 valid = count < 32 ? tailMask32(count) : __mmask32(~0u);
+        const __m512i data = _mm512_maskz_loadu_epi16(valid, n);
+        const __mmask32 mask = _mm512_mask_cmpeq_epi16_mask(valid, data, mch);
+        if (mask)
+            return n - s + _bit_scan_forward(mask);
+    }
+    return -1;
+}
+#endif
+
 /*!
     \internal
 
@@ -667,6 +1048,14 @@ static int findChar(const QChar *str, int len, QChar ch, int from,
         const ushort *n = s + from;
         const ushort *e = s + len;
         if (cs == Qt::CaseSensitive) {
+#if QT_COMPILER_SUPPORTS_HERE(AVX512BW)
+            if (e - n >= 32 && qCpuHasFeature(AVX512BW))
+                return findChar_avx512bw(s, n, e, c);
+#endif
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+            if (e - n >= 16 && qCpuHasFeature(AVX2))
+                return findChar_avx2(s, n, e, c);
+#endif
 #ifdef __SSE2__
             __m128i mch = _mm_set1_epi32(c | (c << 16));
 
@@ -1091,7 +1480,9 @@ const QString::Null QString::null = { };
     the 'e', 'E', and 'f' formats, the \e precision represents the
     number of digits \e after the decimal point. For the 'g' and 'G'
     formats, the \e precision represents the maximum number of
-    significant digits (trailing zeroes are omitted).
+    significant digits (trailing zeroes are omitted). A \e precision
+    of QLocale::FloatingPointShortest gives as many digits as are needed
+    to read the exact same number back, and no more.
 
     \section1 More Efficient String Construction
 
@@ -2961,6 +3352,70 @@ int QString::indexOf(QLatin1String str, int from, Qt::CaseSensitivity cs) const
     return qt_find_latin1_string(unicode(), size(), str, from, cs);
 }
 
+/*
+    The vectorized substring searches compare the first and the last
+    character of the needle with a block of candidate positions at once and
+    only compare the whole needle at the candidates where both matched.
+    \a h is the first and \a end is one past the last candidate position.
+*/
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+QT_FUNCTION_TARGET(AVX2)
+static int qFindString_avx2(const ushort *haystack0, const ushort *h, const ushort *end,
+                            const ushort *needle, int sl)
+{
+    Q_ASSERT(end - h >= 16 && sl >= 2);
+    const __m256i first = _mm256_set1_epi16(needle[0]);
+    const __m256i last = _mm256_set1_epi16(needle[sl - 1]);
+    const ushort *lastBlock = end - 16;
+    for (bool done = false; !done; h += 16) {
+        if (h >= lastBlock) {
+            // redo the last full block
+            h = lastBlock;
+            done = true;
+        }
+        const __m256i blockFirst = _mm256_loadu_si256((const __m256i *)h);
+        const __m256i blockLast = _mm256_loadu_si256((const __m256i *)(h + sl - 1));
+        uint mask = _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi16(blockFirst, first),
+                                                          _mm256_cmpeq_epi16(blockLast, last)));
+        while (mask) {
+            const uint idx = uint(_bit_scan_forward(mask)) / 2;
+            if (ucstrncmp(reinterpret_cast<const QChar *>(needle + 1),
+                          reinterpret_cast<const QChar *>(h + idx + 1), sl - 2) == 0)
+                return h + idx - haystack0;
+            mask &= ~(3u << (idx * 2));
+        }
+    }
+    return -1;
+}
+#endif
+
+#if QT_COMPILER_SUPPORTS_HERE(AVX512BW)
+QT_FUNCTION_TARGET(AVX512BW)
+static int qFindString_avx512bw(const ushort *haystack0, const ushort *h, const ushort *end,
+                                const ushort *needle, int sl)
+{
+    Q_ASSERT(sl >= 2);
+    const __m512i first = _mm512_set1_epi16(needle[0]);
+    const __m512i last = _mm512_set1_epi16(needle[sl - 1]);
+    for ( ; h < end; h += 32) {
+        const qptrdiff count = end - h;
+        const __mmask32 valid = count < 32 ? tailMask32(count) : __mmask32(~0u);
+        const __m512i blockFirst = _mm512_maskz_loadu_epi16(valid, h);
+        const __m512i blockLast = _mm512_maskz_loadu_epi16(valid, h + sl - 1);
+        __mmask32 mask = _mm512_mask_cmpeq_epi16_mask(valid, blockFirst, first);
+        mask = _mm512_mask_cmpeq_epi16_mask(mask, blockLast, last);
+        while (mask) {
+            const uint idx = uint(_bit_scan_forward(mask));
+            if (ucstrncmp(reinterpret_cast<const QChar *>(needle + 1),
+                          reinterpret_cast<const QChar *>(h + idx + 1), sl - 2) == 0)
+                return h + idx - haystack0;
+            mask &= mask - 1;
+        }
+    }
+    return -1;
+}
+#endif
+
 int qFindString(
     const QChar *haystack0, int haystackLen, int from,
     const QChar *needle0, int needleLen, Qt::CaseSensitivity cs)
@@ -2979,6 +3434,20 @@ int qFindString(
     if (sl == 1)
         return findChar(haystack0, haystackLen, needle0[0], from, cs);
 
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (cs == Qt::CaseSensitive) {
+        const ushort *h = reinterpret_cast<const ushort *>(haystack0);
+        const ushort *n = reinterpret_cast<const ushort *>(needle0);
+        const int candidates = l - sl - from + 1;
+#  if QT_COMPILER_SUPPORTS_HERE(AVX512BW)
+        if (candidates >= 32 && qCpuHasFeature(AVX512BW))
+            return qFindString_avx512bw(h, h + from, h + from + candidates, n, sl);
+#  endif
+        if (candidates >= 16 && qCpuHasFeature(AVX2))
+            return qFindString_avx2(h, h + from, h + from + candidates, n, sl);
+    }
+#endif
+
     /*
         We use the Boyer-Moore algorithm in cases where the overhead
         for the skip table should pay off, otherwise we use a simple
@@ -0,0 +1,641 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qstringrope.h"
+#include "qtextcodec.h"
+#include "private/qutfcodec_p.h"
+
+QT_BEGIN_NAMESPACE
+
+enum {
+    // Short appends are copied into chunks whose capacity doubles up to
+    // MaxChunkCapacity, so that building a large text neither reallocates
+    // what is already there nor fragments it into many tiny pieces.
+    MinChunkCapacity = 256,
+    MaxChunkCapacity = 64 * 1024,
+
+    // Strings at least this long are shared instead of copied.
+    SharingThreshold = 1024,
+
+    // An insertion that leaves a piece at most this long is merged into it.
+    MergeThreshold = 256
+};
+
+/*!
+    \class QStringRope
+    \inmodule QtCore
+    \since 5.6
+    \brief The QStringRope class builds and edits large texts in chunks.
+
+    \ingroup tools
+    \ingroup shared
+    \ingroup string-processing
+    \reentrant
+
+    Appending to a QString reallocates and copies the whole string whenever
+    its capacity runs out. QStringBuilder avoids that only within one
+    expression. QStringRope keeps its text as a sequence of chunks instead.
+    Appending copies short strings into the last chunk, and starts a new
+    chunk when that one is full. Long strings become chunks of their own,
+    sharing the data of the QString they were appended from. Text already in
+    the rope is never copied again, however large it grows.
+
+    Inserting, removing and taking a mid() of the rope split chunks at the
+    positions involved; they share the characters rather than copying them.
+    QStringRope is \l{implicitly shared}, so copies of it are cheap as well.
+
+    When the text is complete, toString(), toUtf8() and toLatin1() flatten
+    it with a single allocation. The text can also be written without
+    flattening it: with QTextStream::operator<<() or QIODevice::write().
+    The chunks themselves are available through chunkCount() and chunk().
+
+    \snippet code/src_corelib_tools_qstringrope.cpp 0
+
+    Accessing a character by position with at() is a binary search through
+    the chunks, so it's slower than QString::at().
+
+    \sa QString, QStringBuilder, QTextStream
+*/
+
+/*!
+    \fn QStringRope::QStringRope()
+
+    Constructs an empty rope.
+*/
+
+/*!
+    Constructs a rope containing \a str. The data of \a str is shared
+    if it is long enough, and copied otherwise.
+*/
+QStringRope::QStringRope(const QString &str)
+{
+    append(str);
+}
+
+/*!
+    Constructs a rope containing the Latin-1 string \a str.
+*/
+QStringRope::QStringRope(QLatin1String str)
+{
+    append(str);
+}
+
+/*!
+    \fn void QStringRope::swap(QStringRope &other)
+
+    Swaps rope \a other with this rope. This operation is very fast and
+    never fails.
+*/
+
+/*!
+    \fn int QStringRope::size() const
+
+    Returns the number of characters in the rope.
+*/
+
+/*!
+    \fn int QStringRope::length() const
+
+    Same as size().
+*/
+
+/*!
+    \fn bool QStringRope::isEmpty() const
+
+    Returns \c true if the rope has no characters; otherwise returns \c false.
+*/
+
+/*!
+    \fn void QStringRope::clear()
+
+    Removes all characters from the rope.
+*/
+
+/*!
+    \fn int QStringRope::chunkCount() const
+
+    Returns the number of chunks the text of the rope is stored in.
+
+    \sa chunk()
+*/
+
+/*!
+    Returns chunk \a i of the rope, which must be a valid index
+    (0 <= \a i < chunkCount()). Chunks are never empty.
+
+    The returned reference is invalidated by any change to the rope.
+
+    \sa chunkCount()
+*/
+QStringRef QStringRope::chunk(int i) const
+{
+    Q_ASSERT_X(i >= 0 && i < m_pieces.size(), "QStringRope::chunk", "index out of range");
+    const Piece &piece = m_pieces.at(i);
+    return QStringRef(&piece.string, piece.offset, piece.size);
+}
+
+/*!
+    Returns the character at index position \a i in the rope, which must
+    be valid (0 <= \a i < size()).
+*/
+QChar QStringRope::at(int i) const
+{
+    Q_ASSERT_X(i >= 0 && i < size(), "QStringRope::at", "index out of range");
+    const Piece &piece = m_pieces.at(pieceAt(i));
+    return piece.string.at(piece.offset + i - (piece.end - piece.size));
+}
+
+/*!
+    \fn const QChar QStringRope::operator[](int i) const
+
+    Same as at(\a i).
+*/
+
+/*!
+    Appends \a str to the end of the rope and returns a reference to it.
+*/
+QStringRope &QStringRope::append(const QString &str)
+{
+    if (str.size() >= SharingThreshold) {
+        appendPiece(str, 0, str.size());
+        return *this;
+    }
+    return append(str.constData(), str.size());
+}
+
+/*!
+    \overload
+*/
+QStringRope &QStringRope::append(const QStringRef &str)
+{
+    if (str.size() >= SharingThreshold && str.string()) {
+        appendPiece(*str.string(), str.position(), str.size());
+        return *this;
+    }
+    return append(str.unicode(), str.size());
+}
+
+/*!
+    \overload
+
+    Appends \a len characters from the array \a str to the rope.
+*/
+QStringRope &QStringRope::append(const QChar *str, int len)
+{
+    if (len <= 0)
+        return *this;
+
+    appendableChunk(len)->append(str, len);
+    Piece &last = m_pieces.last();
+    last.size += len;
+    last.end += len;
+    return *this;
+}
+
+/*!
+    \overload
+*/
+QStringRope &QStringRope::append(QLatin1String str)
+{
+    const int len = str.size();
+    if (len <= 0)
+        return *this;
+
+    appendableChunk(len)->append(str);
+    Piece &last = m_pieces.last();
+    last.size += len;
+    last.end += len;
+    return *this;
+}
+
+/*!
+    \overload
+*/
+QStringRope &QStringRope::append(QChar ch)
+{
+    return append(&ch, 1);
+}
+
+/*!
+    \overload
+
+    Appends the rope \a other to this rope. The chunks of \a other are
+    shared, unless it is short enough to be copied.
+*/
+QStringRope &QStringRope::append(const QStringRope &other)
+{
+    // copy the list of pieces, in case other is this rope
+    const QVector<Piece> pieces = other.m_pieces;
+    const bool share = other.size() >= SharingThreshold;
+    for (QVector<Piece>::const_iterator it = pieces.constBegin(); it != pieces.constEnd(); ++it) {
+        if (share)
+            appendPiece(it->string, it->offset, it->size);
+        else
+            append(it->string.constData() + it->offset, it->size);
+    }
+    return *this;
+}
+
+/*!
+    \fn QStringRope &QStringRope::prepend(const QString &str)
+
+    Inserts \a str at the beginning of the rope and returns a reference
+    to it.
+
+    \sa insert()
+*/
+
+/*!
+    \fn QStringRope &QStringRope::prepend(const QStringRope &other)
+    \overload
+*/
+
+/*!
+    Inserts \a str at index \a position in the rope and returns a
+    reference to it. \a position must be valid (0 <= \a position <= size()).
+
+    A short insertion is merged into the chunk it falls in. Otherwise that
+    chunk is split in two, sharing its data, and \a str becomes a chunk in
+    between.
+*/
+QStringRope &QStringRope::insert(int position, const QString &str)
+{
+    Q_ASSERT_X(position >= 0 && position <= size(), "QStringRope::insert", "position out of range");
+    if (str.isEmpty())
+        return *this;
+    if (position == size())
+        return append(str);
+
+    int i = pieceAt(position);
+    const Piece &piece = m_pieces.at(i);
+    if (piece.size + str.size() <= MergeThreshold) {
+        const int split = position - (piece.end - piece.size);
+        const QChar *data = piece.string.constData() + piece.offset;
+        QString merged;
+        merged.reserve(piece.size + str.size());
+        merged.append(data, split);
+        merged.append(str);
+        merged.append(data + split, piece.size - split);
+
+        Piece &mergedPiece = m_pieces[i];
+        mergedPiece.string = merged;
+        mergedPiece.offset = 0;
+        mergedPiece.size = merged.size();
+    } else {
+        i = splitAt(position);
+        const Piece inserted = { str, 0, str.size(), 0 };
+        m_pieces.insert(i, inserted);
+    }
+    updateEnds(i);
+    return *this;
+}
+
+/*!
+    \overload
+
+    Inserts the rope \a other at index \a position, sharing its chunks.
+*/
+QStringRope &QStringRope::insert(int position, const QStringRope &other)
+{
+    Q_ASSERT_X(position >= 0 && position <= size(), "QStringRope::insert", "position out of range");
+    if (other.isEmpty())
+        return *this;
+    if (position == size())
+        return append(other);
+
+    const QVector<Piece> inserted = other.m_pieces;
+    const int i = splitAt(position);
+
+    QVector<Piece> pieces;
+    pieces.reserve(m_pieces.size() + inserted.size());
+    for (int j = 0; j < i; ++j)
+        pieces.append(m_pieces.at(j));
+    pieces += inserted;
+    for (int j = i; j < m_pieces.size(); ++j)
+        pieces.append(m_pieces.at(j));
+    m_pieces.swap(pieces);
+
+    updateEnds(i);
+    return *this;
+}
+
+/*!
+    Removes \a n characters from the rope, starting at index \a position,
+    and returns a reference to the rope.
+
+    If \a position is outside the rope, nothing happens. If \a position + \a n
+    is beyond the end of the rope, the rope is truncated at \a position.
+*/
+QStringRope &QStringRope::remove(int position, int n)
+{
+    if (position < 0 || position >= size() || n <= 0)
+        return *this;
+    n = qMin(n, size() - position);
+
+    const int first = splitAt(position);
+    const int last = splitAt(position + n);
+    m_pieces.remove(first, last - first);
+    updateEnds(first);
+    return *this;
+}
+
+/*!
+    \fn QStringRope &QStringRope::operator+=(const QString &str)
+
+    Same as append(\a str).
+*/
+
+/*!
+    \fn QStringRope &QStringRope::operator+=(const QStringRef &str)
+    \overload
+*/
+
+/*!
+    \fn QStringRope &QStringRope::operator+=(QLatin1String str)
+    \overload
+*/
+
+/*!
+    \fn QStringRope &QStringRope::operator+=(QChar ch)
+    \overload
+*/
+
+/*!
+    \fn QStringRope &QStringRope::operator+=(const QStringRope &other)
+    \overload
+*/
+
+/*!
+    Returns a rope that contains \a n characters of this rope, starting at
+    index \a position. It shares the chunks of this rope.
+
+    If \a n is -1 (the default), or \a position + \a n is beyond the end of
+    the rope, the returned rope contains all characters from \a position
+    on. If \a position is beyond the end of the rope, the returned rope is
+    empty.
+
+    \sa left(), right()
+*/
+QStringRope QStringRope::mid(int position, int n) const
+{
+    using namespace QtPrivate;
+    switch (QContainerImplHelper::mid(size(), &position, &n)) {
+    case QContainerImplHelper::Null:
+    case QContainerImplHelper::Empty:
+        return QStringRope();
+    case QContainerImplHelper::Full:
+        return *this;
+    case QContainerImplHelper::Subset:
+        break;
+    }
+
+    QStringRope result;
+    const int end = position + n;
+    for (int i = pieceAt(position); i < m_pieces.size(); ++i) {
+        const Piece &piece = m_pieces.at(i);
+        const int start = piece.end - piece.size;
+        if (start >= end)
+            break;
+        const int from = qMax(start, position);
+        const int to = qMin(piece.end, end);
+        result.appendPiece(piece.string, piece.offset + from - start, to - from);
+    }
+    return result;
+}
+
+/*!
+    \fn QStringRope QStringRope::left(int n) const
+
+    Returns a rope that contains the first \a n characters of this rope.
+
+    \sa mid(), right()
+*/
+
+/*!
+    \fn QStringRope QStringRope::right(int n) const
+
+    Returns a rope that contains the last \a n characters of this rope.
+
+    \sa mid(), left()
+*/
+
+/*!
+    Returns the text of the rope as a QString. If the rope consists of a
+    single complete string, that string is returned without copying it.
+    Otherwise the text is copied once into a string of the right size.
+*/
+QString QStringRope::toString() const
+{
+    if (m_pieces.isEmpty())
+        return QString();
+    if (m_pieces.size() == 1) {
+        const Piece &piece = m_pieces.first();
+        if (piece.offset == 0 && piece.size == piece.string.size())
+            return piece.string;
+    }
+
+    QString result(size(), Qt::Uninitialized);
+    QChar *out = result.data();
+    for (QVector<Piece>::const_iterator it = m_pieces.constBegin(); it != m_pieces.constEnd(); ++it) {
+        memcpy(out, it->string.constData() + it->offset, it->size * sizeof(QChar));
+        out += it->size;
+    }
+    return result;
+}
+
+/*!
+    Returns a Latin-1 representation of the text of the rope. Characters
+    that cannot be represented are replaced with a question mark.
+
+    \sa QString::toLatin1()
+*/
+QByteArray QStringRope::toLatin1() const
+{
+    QByteArray result;
+    result.reserve(size());
+    for (int i = 0; i < m_pieces.size(); ++i)
+        result += chunk(i).toLatin1();
+    return result;
+}
+
+/*!
+    Returns a UTF-8 representation of the text of the rope. A surrogate
+    pair split across chunks is encoded correctly.
+
+    \sa QString::toUtf8()
+*/
+QByteArray QStringRope::toUtf8() const
+{
+    if (m_pieces.isEmpty())
+        return QByteArray();
+
+    // worst case: three bytes per character
+    QByteArray result(3 * size() + 1, Qt::Uninitialized);
+    char *const begin = result.data();
+    char *out = begin;
+    QTextCodec::ConverterState state;
+    for (QVector<Piece>::const_iterator it = m_pieces.constBegin(); it != m_pieces.constEnd(); ++it)
+        out = QUtf8::convertFromUnicode(out, it->string.constData() + it->offset, it->size, &state);
+    // like QString::toUtf8(), replace a high surrogate at the very end
+    if (state.remainingChars)
+        *out++ = '?';
+    result.truncate(int(out - begin));
+    return result;
+}
+
+/*!
+    Returns \c true if this rope contains the same text as \a other;
+    otherwise returns \c false. How the texts are split into chunks does
+    not matter.
+*/
+bool QStringRope::operator==(const QStringRope &other) const
+{
+    if (size() != other.size())
+        return false;
+
+    int i = 0, j = 0;
+    int inPiece = 0, inOther = 0;
+    while (i < m_pieces.size()) {
+        const Piece &piece = m_pieces.at(i);
+        const Piece &otherPiece = other.m_pieces.at(j);
+        const int n = qMin(piece.size - inPiece, otherPiece.size - inOther);
+        const QChar *a = piece.string.constData() + piece.offset + inPiece;
+        const QChar *b = otherPiece.string.constData() + otherPiece.offset + inOther;
+        if (a != b && memcmp(a, b, n * sizeof(QChar)) != 0)
+            return false;
+        inPiece += n;
+        inOther += n;
+        if (inPiece == piece.size) {
+            ++i;
+            inPiece = 0;
+        }
+        if (inOther == otherPiece.size) {
+            ++j;
+            inOther = 0;
+        }
+    }
+    return true;
+}
+
+/*!
+    \fn bool QStringRope::operator!=(const QStringRope &other) const
+
+    Returns \c true if this rope contains a different text than \a other;
+    otherwise returns \c false.
+*/
+
+// Returns the index of the piece containing position, or the number of
+// pieces if position is the size of the rope.
+int QStringRope::pieceAt(int position) const
+{
+    int low = 0;
+    int high = m_pieces.size();
+    while (low < high) {
+        const int middle = (low + high) / 2;
+        if (m_pieces.at(middle).end <= position)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return low;
+}
+
+// Makes sure a piece starts at position, splitting the one that contains
+// it if necessary, and returns the index of that piece.
+int QStringRope::splitAt(int position)
+{
+    const int i = pieceAt(position);
+    if (i == m_pieces.size())
+        return i;
+
+    Piece tail = m_pieces.at(i);
+    const int start = tail.end - tail.size;
+    if (position == start)
+        return i;
+
+    tail.offset += position - start;
+    tail.size = tail.end - position;
+
+    Piece &head = m_pieces[i];
+    head.size = position - start;
+    head.end = position;
+    m_pieces.insert(i + 1, tail);
+    return i + 1;
+}
+
+// Recomputes the end of each piece from index from on.
+void QStringRope::updateEnds(int from)
+{
+    if (from >= m_pieces.size())
+        return;
+    Piece *piece = m_pieces.data() + from;
+    Piece *const last = m_pieces.data() + m_pieces.size();
+    int end = from ? piece[-1].end : 0;
+    for (; piece != last; ++piece) {
+        end += piece->size;
+        piece->end = end;
+    }
+}
+
+void QStringRope::appendPiece(const QString &string, int offset, int size)
+{
+    if (size <= 0)
+        return;
+    const Piece piece = { string, offset, size, this->size() + size };
+    m_pieces.append(piece);
+}
+
+// Returns the last chunk if len characters can be appended to it in place,
+// which requires that nothing else shares it. Otherwise starts a new, empty
+// chunk for them, with twice the capacity of a full last chunk.
+QString *QStringRope::appendableChunk(int len)
+{
+    int capacity = MinChunkCapacity;
+    if (!m_pieces.isEmpty() && m_pieces.isDetached()) {
+        Piece &last = m_pieces.last();
+        if (last.string.isDetached() && last.offset + last.size == last.string.size()) {
+            if (last.string.capacity() - last.string.size() >= len)
+                return &last.string;
+            capacity = qMin(2 * last.string.capacity(), int(MaxChunkCapacity));
+        }
+    }
+
+    QString newChunk;
+    newChunk.reserve(qMax(len, capacity));
+    const Piece piece = { newChunk, 0, 0, size() };
+    m_pieces.append(piece);
+    return &m_pieces.last().string;
+}
+
+QT_END_NAMESPACE
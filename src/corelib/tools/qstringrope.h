@@ -0,0 +1,120 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QSTRINGROPE_H
+#define QSTRINGROPE_H
+
+#include <QtCore/qstring.h>
+#include <QtCore/qvector.h>
+
+QT_BEGIN_NAMESPACE
+
+
+class Q_CORE_EXPORT QStringRope
+{
+public:
+    inline QStringRope() Q_DECL_NOTHROW {}
+    explicit QStringRope(const QString &str);
+    explicit QStringRope(QLatin1String str);
+
+    inline void swap(QStringRope &other) Q_DECL_NOTHROW { qSwap(m_pieces, other.m_pieces); }
+
+    inline int size() const { return m_pieces.isEmpty() ? 0 : m_pieces.last().end; }
+    inline int length() const { return size(); }
+    inline bool isEmpty() const { return m_pieces.isEmpty(); }
+    inline void clear() { m_pieces.clear(); }
+
+    inline int chunkCount() const { return m_pieces.size(); }
+    QStringRef chunk(int i) const;
+
+    QChar at(int i) const;
+    inline const QChar operator[](int i) const { return at(i); }
+
+    QStringRope &append(const QString &str);
+    QStringRope &append(const QStringRef &str);
+    QStringRope &append(QLatin1String str);
+    QStringRope &append(const QChar *str, int len);
+    QStringRope &append(QChar ch);
+    QStringRope &append(const QStringRope &other);
+
+    QStringRope &prepend(const QString &str) { return insert(0, str); }
+    QStringRope &prepend(const QStringRope &other) { return insert(0, other); }
+    QStringRope &insert(int position, const QString &str);
+    QStringRope &insert(int position, const QStringRope &other);
+    QStringRope &remove(int position, int n);
+
+    inline QStringRope &operator+=(const QString &str) { return append(str); }
+    inline QStringRope &operator+=(const QStringRef &str) { return append(str); }
+    inline QStringRope &operator+=(QLatin1String str) { return append(str); }
+    inline QStringRope &operator+=(QChar ch) { return append(ch); }
+    inline QStringRope &operator+=(const QStringRope &other) { return append(other); }
+
+    QStringRope mid(int position, int n = -1) const;
+    inline QStringRope left(int n) const { return mid(0, n); }
+    inline QStringRope right(int n) const { return n >= size() ? *this : mid(size() - qMax(n, 0)); }
+
+    QString toString() const;
+    QByteArray toLatin1() const;
+    QByteArray toUtf8() const;
+
+    bool operator==(const QStringRope &other) const;
+    inline bool operator!=(const QStringRope &other) const { return !(*this == other); }
+
+private:
+    // A piece refers to the characters [offset, offset + size) of string,
+    // which may be shared with QStrings outside the rope and with other
+    // ropes. end is the position in the rope just after the piece.
+    struct Piece {
+        QString string;
+        int offset;
+        int size;
+        int end;
+    };
+    friend class QTypeInfo<Piece>;
+
+    QVector<Piece> m_pieces;
+
+    int pieceAt(int position) const;
+    int splitAt(int position);
+    void updateEnds(int from);
+    void appendPiece(const QString &string, int offset, int size);
+    QString *appendableChunk(int len);
+};
+
+Q_DECLARE_TYPEINFO(QStringRope::Piece, Q_MOVABLE_TYPE);
+Q_DECLARE_SHARED(QStringRope)
+
+QT_END_NAMESPACE
+
+#endif // QSTRINGROPE_H
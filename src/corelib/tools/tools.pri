@@ -25,6 +25,8 @@ HEADERS +=  \
         tools/qdatetime_p.h \
         tools/qdatetimeparser_p.h \
         tools/qeasingcurve.h \
+        tools/qflathash.h \
+        tools/qflatmap.h \
         tools/qfreelist_p.h \
         tools/qhash.h \
         tools/qhashfunctions.h \
@@ -39,6 +41,7 @@ HEADERS +=  \
         tools/qmap.h \
         tools/qmargins.h \
         tools/qmessageauthenticationcode.h \
+        tools/qmonotonicarena.h \
         tools/qcontiguouscache.h \
         tools/qpodlist_p.h \
         tools/qpair.h \
@@ -64,6 +67,7 @@ HEADERS +=  \
         tools/qstringiterator_p.h \
         tools/qstringlist.h \
         tools/qstringmatcher.h \
+        tools/qstringrope.h \
         tools/qtextboundaryfinder.h \
         tools/qtimeline.h \
         tools/qtimezone.h \
@@ -103,6 +107,7 @@ SOURCES += \
         tools/qmap.cpp \
         tools/qmargins.cpp \
         tools/qmessageauthenticationcode.cpp \
+        tools/qmonotonicarena.cpp \
         tools/qcontiguouscache.cpp \
         tools/qrect.cpp \
         tools/qregexp.cpp \
@@ -115,6 +120,7 @@ SOURCES += \
         tools/qstring.cpp \
         tools/qstringbuilder.cpp \
         tools/qstringlist.cpp \
+        tools/qstringrope.cpp \
         tools/qtextboundaryfinder.cpp \
         tools/qtimeline.cpp \
         tools/qtimezone.cpp \
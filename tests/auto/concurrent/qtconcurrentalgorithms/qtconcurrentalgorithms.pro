@@ -0,0 +1,5 @@
+CONFIG += testcase parallel_test
+TARGET = tst_qtconcurrentalgorithms
+QT = core testlib concurrent
+SOURCES = tst_qtconcurrentalgorithms.cpp
+DEFINES += QT_STRICT_ITERATORS
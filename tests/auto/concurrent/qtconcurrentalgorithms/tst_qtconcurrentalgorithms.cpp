@@ -0,0 +1,181 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <qtconcurrentalgorithms.h>
+
+#include <QtTest/QtTest>
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+
+class tst_QtConcurrentAlgorithms: public QObject
+{
+    Q_OBJECT
+private slots:
+    void blockingFor();
+    void blockingTransformReduce();
+    void blockingSort_data();
+    void blockingSort();
+    void blockingInclusiveScan_data() { blockingSort_data(); }
+    void blockingInclusiveScan();
+    void blockingExclusiveScan_data() { blockingSort_data(); }
+    void blockingExclusiveScan();
+};
+
+static QVector<int> randomVector(int size)
+{
+    QVector<int> vector(size);
+    for (int i = 0; i < size; ++i)
+        vector[i] = qrand() % 1000;
+    return vector;
+}
+
+struct MarkIndex
+{
+    QAtomicInt *counts;
+
+    void operator()(int index)
+    {
+        counts[index].ref();
+    }
+};
+
+void tst_QtConcurrentAlgorithms::blockingFor()
+{
+    const int size = 10000;
+    QVector<QAtomicInt> counts(size);
+    MarkIndex mark = { counts.data() };
+
+    QtConcurrent::blockingFor(0, size, mark);
+    for (int i = 0; i < size; ++i)
+        QCOMPARE(counts.at(i).load(), 1);
+
+    // empty and partial ranges
+    QtConcurrent::blockingFor(5, 5, mark);
+    QtConcurrent::blockingFor(10, 0, mark);
+    QtConcurrent::blockingFor(100, 200, mark);
+    for (int i = 0; i < size; ++i)
+        QCOMPARE(counts.at(i).load(), (i >= 100 && i < 200) ? 2 : 1);
+}
+
+static qint64 square(int index)
+{
+    return qint64(index) * index;
+}
+
+static void sum(qint64 &result, const qint64 &value)
+{
+    result += value;
+}
+
+void tst_QtConcurrentAlgorithms::blockingTransformReduce()
+{
+    const int size = 100000;
+    qint64 expected = 0;
+    for (int i = 0; i < size; ++i)
+        expected += square(i);
+
+    QCOMPARE(QtConcurrent::blockingTransformReduce(0, size, square, sum), expected);
+    QCOMPARE(QtConcurrent::blockingTransformReduce<qint64>(0, size, square, sum,
+                                                           QtConcurrent::ParallelReduce),
+             expected);
+    QCOMPARE(QtConcurrent::blockingTransformReduce(10, 10, square, sum), qint64(0));
+}
+
+void tst_QtConcurrentAlgorithms::blockingSort_data()
+{
+    QTest::addColumn<int>("size");
+
+    QTest::newRow("empty") << 0;
+    QTest::newRow("one") << 1;
+    QTest::newRow("small") << 100;
+    QTest::newRow("one chunk") << 2048;
+    QTest::newRow("few chunks") << 5000;
+    QTest::newRow("many chunks") << 100001;
+}
+
+void tst_QtConcurrentAlgorithms::blockingSort()
+{
+    QFETCH(int, size);
+
+    const QVector<int> input = randomVector(size);
+    QVector<int> expected = input;
+    std::sort(expected.begin(), expected.end());
+
+    QVector<int> sorted = input;
+    QtConcurrent::blockingSort(sorted);
+    QCOMPARE(sorted, expected);
+
+    std::reverse(expected.begin(), expected.end());
+    sorted = input;
+    QtConcurrent::blockingSort(sorted.begin(), sorted.end(), std::greater<int>());
+    QCOMPARE(sorted, expected);
+}
+
+static int add(int a, int b)
+{
+    return a + b;
+}
+
+void tst_QtConcurrentAlgorithms::blockingInclusiveScan()
+{
+    QFETCH(int, size);
+
+    const QVector<int> input = randomVector(size);
+    QVector<int> expected = input;
+    std::partial_sum(expected.begin(), expected.end(), expected.begin());
+
+    QVector<int> scanned = input;
+    QtConcurrent::blockingInclusiveScan(scanned, add);
+    QCOMPARE(scanned, expected);
+}
+
+void tst_QtConcurrentAlgorithms::blockingExclusiveScan()
+{
+    QFETCH(int, size);
+
+    const QVector<int> input = randomVector(size);
+    QVector<int> expected(size);
+    int total = 7;
+    for (int i = 0; i < size; ++i) {
+        expected[i] = total;
+        total += input.at(i);
+    }
+
+    QVector<int> scanned = input;
+    QtConcurrent::blockingExclusiveScan(scanned, 7, add);
+    QCOMPARE(scanned, expected);
+}
+
+QTEST_MAIN(tst_QtConcurrentAlgorithms)
+#include "tst_qtconcurrentalgorithms.moc"
@@ -39,6 +39,8 @@
 
 #include <QtTest/QtTest>
 
+#include <algorithm>
+
 #include "functions.h"
 
 class tst_QtConcurrentMap: public QObject
@@ -61,6 +63,7 @@ private slots:
     void stlContainers();
     void qFutureAssignmentLeak();
     void stressTest();
+    void parallelReduce();
     void persistentResultTest();
 public slots:
     void throttling();
@@ -2382,6 +2385,44 @@ void tst_QtConcurrentMap::stressTest()
     }
 }
 
+void appendToList(QList<int> &result, const int &value)
+{
+    result.append(value);
+}
+
+void tst_QtConcurrentMap::parallelReduce()
+{
+    const int listSize = 10000;
+    const int sum = (listSize - 1) * (listSize / 2);
+    QList<int> list;
+    for (int i = 0; i < listSize; ++i)
+        list.append(i);
+
+    for (int i = 0; i < 100; ++i) {
+        int result = QtConcurrent::blockingMappedReduced(list, echo, add, QtConcurrent::ParallelReduce);
+        QCOMPARE(result, sum);
+    }
+
+    {
+        const QList<int> shortList = list.mid(0, 1000);
+        int result = QtConcurrent::mappedReduced<int>(shortList, IntSquare(), IntSumReduce(),
+                                                      QtConcurrent::ParallelReduce);
+        int expected = 0;
+        foreach (int x, shortList)
+            expected += x * x;
+        QCOMPARE(result, expected);
+    }
+
+    // the reduce function cannot merge partial lists, falls back to a sequential reduction
+    {
+        QList<int> result = QtConcurrent::blockingMappedReduced(list, echo, appendToList,
+                                                                QtConcurrent::ParallelReduce);
+        QCOMPARE(result.count(), listSize);
+        std::sort(result.begin(), result.end());
+        QCOMPARE(result, list);
+    }
+}
+
 struct LockedCounter
 {
     LockedCounter(QMutex *mutex, QAtomicInt *ai)
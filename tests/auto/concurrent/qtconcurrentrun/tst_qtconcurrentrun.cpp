@@ -32,6 +32,7 @@
 ****************************************************************************/
 #include <qtconcurrentrun.h>
 #include <qfuture.h>
+#include <QSemaphore>
 #include <QString>
 #include <QtTest/QtTest>
 
@@ -58,8 +59,17 @@ private slots:
 #ifdef Q_COMPILER_LAMBDA
     void lambda();
 #endif
+#if defined(Q_COMPILER_LAMBDA) && defined(Q_COMPILER_DECLTYPE) && defined(Q_COMPILER_AUTO_FUNCTION)
+    void priority();
+#endif
+    void cancellationToken();
 };
 
+static void semaphoreAcquire(QSemaphore *sem)
+{
+    sem->acquire();
+}
+
 void light()
 {
     qDebug("in function");
@@ -579,5 +589,74 @@ void tst_QtConcurrentRun::lambda()
 }
 #endif
 
+#if defined(Q_COMPILER_LAMBDA) && defined(Q_COMPILER_DECLTYPE) && defined(Q_COMPILER_AUTO_FUNCTION)
+// the priority overloads need decltype and trailing return types
+void tst_QtConcurrentRun::priority()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(1);
+
+    // keep the only thread busy until everything is queued
+    QSemaphore sem;
+    QFuture<void> holder = QtConcurrent::run(&pool, [&sem](){ sem.acquire(); });
+
+    QMutex mutex;
+    QList<int> order;
+    QList<QFuture<void> > futures;
+    for (int priority = 0; priority < 3; ++priority) {
+        futures << QtConcurrent::run(&pool, priority, [&mutex, &order](int value) {
+            QMutexLocker locker(&mutex);
+            order << value;
+        }, priority);
+    }
+
+    sem.release();
+    holder.waitForFinished();
+    foreach (QFuture<void> future, futures)
+        future.waitForFinished();
+    QCOMPARE(order, QList<int>() << 2 << 1 << 0);
+
+    QCOMPARE(QtConcurrent::run(&pool, 5, [](int a, int b){ return a + b; }, 1, 2).result(), 3);
+}
+#endif
+
+static QSemaphore cancellationStarted;
+static QAtomicInt cancellationSeen;
+
+static void waitForCancellation()
+{
+    QtConcurrent::CancellationToken token = QtConcurrent::CancellationToken::current();
+    cancellationStarted.release();
+    while (!token.isCanceled())
+        QThread::msleep(1);
+    cancellationSeen.store(1);
+}
+
+void tst_QtConcurrentRun::cancellationToken()
+{
+    // outside of a task, the token is never canceled
+    QVERIFY(!QtConcurrent::CancellationToken::current().isCanceled());
+
+    QThreadPool pool;
+    cancellationSeen.store(0);
+    QFuture<void> future = QtConcurrent::run(&pool, waitForCancellation);
+    cancellationStarted.acquire();
+    future.cancel();
+    QVERIFY(pool.waitForDone(10000));
+    QCOMPARE(cancellationSeen.load(), 1);
+    QVERIFY(future.isCanceled());
+
+    // a function canceled before it starts does not run
+    pool.setMaxThreadCount(1);
+    QSemaphore sem;
+    QtConcurrent::run(&pool, semaphoreAcquire, &sem);
+    cancellationSeen.store(0);
+    future = QtConcurrent::run(&pool, waitForCancellation);
+    future.cancel();
+    sem.release();
+    QVERIFY(pool.waitForDone(10000));
+    QCOMPARE(cancellationSeen.load(), 0);
+}
+
 QTEST_MAIN(tst_QtConcurrentRun)
 #include "tst_qtconcurrentrun.moc"
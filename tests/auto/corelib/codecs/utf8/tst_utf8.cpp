@@ -60,9 +60,15 @@ private slots:
     void charByChar_data();
     void charByChar();
 
+    void atEveryPosition_data();
+    void atEveryPosition();
+
     void invalidUtf8_data();
     void invalidUtf8();
 
+    void invalidUtf8AtEveryPosition_data();
+    void invalidUtf8AtEveryPosition();
+
     void nonCharacters_data();
     void nonCharacters();
 };
@@ -210,6 +216,56 @@ void tst_Utf8::charByChar()
     }
 }
 
+// the converters work on blocks of 16 bytes or 8 characters, so place the
+// test data at every offset inside text that is not ASCII either
+static const char paddingUtf8[] = "\303\251\342\202\254x\320\226\343\201\202y";
+static const ushort paddingUtf16[] = { 0xe9, 0x20ac, 'x', 0x416, 0x3042, 'y' };
+
+static QByteArray padUtf8(const QByteArray &utf8, int ascii, int wide)
+{
+    QByteArray result(ascii, 'a');
+    for (int i = 0; i < wide; ++i)
+        result += "\342\202\254";
+    result += utf8;
+    for (int i = 0; i < 5; ++i)
+        result += paddingUtf8;
+    return result;
+}
+
+void tst_Utf8::atEveryPosition_data()
+{
+    roundTrip_data();
+}
+
+void tst_Utf8::atEveryPosition()
+{
+    QFETCH(QByteArray, utf8);
+    QFETCH(QString, utf16);
+
+    QString padding;
+    for (int i = 0; i < 5; ++i)
+        padding += QString::fromUtf16(paddingUtf16, sizeof(paddingUtf16) / sizeof(paddingUtf16[0]));
+
+    for (int wide = 0; wide < 3; ++wide) {
+        for (int ascii = 0; ascii < 20; ++ascii) {
+            const QByteArray paddedUtf8 = padUtf8(utf8, ascii, wide);
+            const QString paddedUtf16 = QString(ascii, QLatin1Char('a')) + QString(wide, QChar(0x20ac))
+                    + utf16 + padding;
+
+            QCOMPARE(from8Bit(paddedUtf8), paddedUtf16);
+            QCOMPARE(to8Bit(paddedUtf16), paddedUtf8);
+
+            QSharedPointer<QTextDecoder> decoder(codec->makeDecoder());
+            QCOMPARE(decoder->toUnicode(paddedUtf8), paddedUtf16);
+            QVERIFY(!decoder->hasFailure());
+
+            QSharedPointer<QTextEncoder> encoder(codec->makeEncoder(QTextCodec::IgnoreHeader));
+            QCOMPARE(encoder->fromUnicode(paddedUtf16), paddedUtf8);
+            QVERIFY(!encoder->hasFailure());
+        }
+    }
+}
+
 void tst_Utf8::invalidUtf8_data()
 {
     QTest::addColumn<QByteArray>("utf8");
@@ -236,6 +292,39 @@ void tst_Utf8::invalidUtf8()
         qWarning("System codec does not report failure when it should. Should report bug upstream.");
 }
 
+void tst_Utf8::invalidUtf8AtEveryPosition_data()
+{
+    invalidUtf8_data();
+}
+
+void tst_Utf8::invalidUtf8AtEveryPosition()
+{
+    QFETCH(QByteArray, utf8);
+    QFETCH_GLOBAL(bool, useLocale);
+    if (useLocale)
+        QSKIP("Only our UTF-8 decoder is tested");
+
+    // strings this short are never converted in blocks; the padding starts
+    // with a lead byte, which ends an unterminated sequence the same way
+    QString decoded = from8Bit(utf8 + 'x');
+    decoded.chop(1);
+    for (int i = 0; i < 5; ++i)
+        decoded += QString::fromUtf16(paddingUtf16, sizeof(paddingUtf16) / sizeof(paddingUtf16[0]));
+
+    for (int wide = 0; wide < 3; ++wide) {
+        for (int ascii = 0; ascii < 20; ++ascii) {
+            const QByteArray padded = padUtf8(utf8, ascii, wide);
+            const QString expected = QString(ascii, QLatin1Char('a')) + QString(wide, QChar(0x20ac)) + decoded;
+
+            QCOMPARE(from8Bit(padded), expected);
+
+            QSharedPointer<QTextDecoder> decoder(codec->makeDecoder());
+            QCOMPARE(decoder->toUnicode(padded), expected);
+            QVERIFY(decoder->hasFailure());
+        }
+    }
+}
+
 void tst_Utf8::nonCharacters_data()
 {
     QTest::addColumn<QByteArray>("utf8");
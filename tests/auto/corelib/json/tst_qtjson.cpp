@@ -105,6 +105,7 @@ private Q_SLOTS:
     void toAndFromBinary();
     void parseNumbers();
     void parseStrings();
+    void parseStringsAndSpaceRuns();
     void parseDuplicateKeys();
     void testParser();
 
@@ -1408,19 +1409,16 @@ void tst_QtJson::toJsonLargeNumericValues()
             "    \"Array\": [\n"
             "        1.234567,\n"
             "        1.7976931348623157e+308,\n"
-            //     ((4.9406564584124654e-324 == 5e-324) == true)
-            // I can only think JavaScript has a special formatter to
-            //  emit this value for this IEEE754 bit pattern.
-            "        4.9406564584124654e-324,\n"
+            "        5e-324,\n"
             "        2.2250738585072014e-308,\n"
             "        1.7976931348623157e+308,\n"
-            "        2.2204460492503131e-16,\n"
-            "        4.9406564584124654e-324,\n"
+            "        2.220446049250313e-16,\n"
+            "        5e-324,\n"
             "        0,\n"
             "        -2.2250738585072014e-308,\n"
             "        -1.7976931348623157e+308,\n"
-            "        -2.2204460492503131e-16,\n"
-            "        -4.9406564584124654e-324,\n"
+            "        -2.220446049250313e-16,\n"
+            "        -5e-324,\n"
             "        0,\n"
             "        9007199254740992,\n"
             "        -9007199254740992\n"
@@ -1922,6 +1920,46 @@ void tst_QtJson::parseStrings()
 
 }
 
+void tst_QtJson::parseStringsAndSpaceRuns()
+{
+    // the parser scans strings and whitespace in blocks of 16 and 32
+    // bytes; put the interesting characters at every position of a block
+    struct Special {
+        const char *in;
+        QString out;
+    };
+    const Special specials[] = {
+        { "\\\"", QStringLiteral("\"") },
+        { "\\n", QStringLiteral("\n") },
+        { "\\u0041", QStringLiteral("A") },
+        { "\xc3\xa9", QString(QChar(0xe9)) },
+        { UNICODE_DJE, QString(QChar(0x402)) },
+        { "\x7f", QString(QChar(0x7f)) }
+    };
+
+    for (int i = 0; i < int(sizeof(specials) / sizeof(specials[0])); ++i) {
+        for (int length = 0; length < 70; ++length) {
+            const QByteArray plain(length, 'a');
+            const QByteArray space(length, ' ');
+            const QByteArray json = "[" + space + "\"" + plain + specials[i].in + plain + "\"" + space
+                    + ",\n" + space + "\"" + plain + "\"" + space + "]";
+
+            QJsonParseError error;
+            const QJsonDocument doc = QJsonDocument::fromJson(json, &error);
+            QCOMPARE(error.error, QJsonParseError::NoError);
+            const QJsonArray array = doc.array();
+            QCOMPARE(array.size(), 2);
+            QCOMPARE(array.at(0).toString(), QString(plain) + specials[i].out + QString(plain));
+            QCOMPARE(array.at(1).toString(), QString(plain));
+        }
+    }
+
+    // an unterminated string ending in a long run of plain characters
+    QJsonParseError error;
+    QJsonDocument::fromJson("[\"" + QByteArray(100, 'a'), &error);
+    QCOMPARE(error.error, QJsonParseError::UnterminatedString);
+}
+
 void tst_QtJson::parseDuplicateKeys()
 {
     const char *json = "{ \"B\": true, \"A\": null, \"B\": false }";
@@ -71,6 +71,7 @@ private slots:
     void sendPostedEvents_data();
     void sendPostedEvents();
     void processEventsOnlySendsQueuedEvents();
+    void hasPendingEventsPostedFromOtherThread();
 };
 
 bool tst_QEventDispatcher::event(QEvent *e)
@@ -244,5 +245,37 @@ void tst_QEventDispatcher::processEventsOnlySendsQueuedEvents()
     QCOMPARE(object.eventsReceived, 4);
 }
 
+class PostingThread : public QThread
+{
+public:
+    QObject *receiver;
+
+    inline PostingThread(QObject *receiver) : receiver(receiver) {}
+
+    void run() Q_DECL_OVERRIDE
+    {
+        QCoreApplication::postEvent(receiver, new QEvent(QEvent::User));
+    }
+};
+
+void tst_QEventDispatcher::hasPendingEventsPostedFromOtherThread()
+{
+    // drain whatever is pending already
+    while (eventDispatcher->processEvents(QEventLoop::AllEvents))
+        ;
+
+    // events posted from another thread wait on a lock-free stack until
+    // the receiving thread picks them up; they are pending all the same
+    receivedEventType = -1;
+    PostingThread thread(this);
+    thread.start();
+    QVERIFY(thread.wait(60000));
+    QVERIFY(eventDispatcher->hasPendingEvents());
+    QCOMPARE(receivedEventType, -1);
+
+    QVERIFY(eventDispatcher->processEvents(QEventLoop::AllEvents));
+    QCOMPARE(receivedEventType, int(QEvent::User));
+}
+
 QTEST_MAIN(tst_QEventDispatcher)
 #include "tst_qeventdispatcher.moc"
@@ -75,6 +75,7 @@ private slots:
     void connectDisconnectNotify_shadowing();
     void emitInDefinedOrder();
     void customTypes();
+    void queuedArguments();
     void streamCustomTypes();
     void metamethod();
     void namespaces();
@@ -94,6 +95,7 @@ private slots:
     void recursiveSignalEmission();
     void signalBlocking();
     void blockingQueuedConnection();
+    void batchedConnection();
     void childEvents();
     void installEventFilter();
     void deleteSelfInSlot();
@@ -115,6 +117,7 @@ private slots:
     void connectConstructorByMetaMethod();
     void disconnectByMetaMethod();
     void disconnectNotSignalMetaMethod();
+    void disconnectManyByHandle();
     void autoConnectionBehavior();
     void baseDestroyed();
     void pointerConnect();
@@ -1456,6 +1459,71 @@ void tst_QObject::customTypes()
     QCOMPARE(instanceCount, 3);
 }
 
+class QueuedArgumentChecker : public QObject
+{
+    Q_OBJECT
+
+public:
+    QueuedArgumentChecker() : calls(0) {}
+
+signals:
+    void fewArguments(CustomType a, const QString &b);
+    void manyArguments(CustomType a, const QString &b, double c, const QByteArray &d,
+                       CustomType e, CustomType f, CustomType g);
+
+public slots:
+    void fewArgumentsSlot(CustomType a, const QString &b)
+    {
+        QCOMPARE(a.value(), 6);
+        QCOMPARE(b, QStringLiteral("few"));
+        ++calls;
+    }
+    void manyArgumentsSlot(CustomType a, const QString &b, double c, const QByteArray &d,
+                           CustomType e, CustomType f, CustomType g)
+    {
+        QCOMPARE(a.value(), 6);
+        QCOMPARE(b, QStringLiteral("many"));
+        QCOMPARE(c, 2.5);
+        QCOMPARE(d, QByteArray("bytes"));
+        QCOMPARE(e.value(), 7);
+        QCOMPARE(f.value(), 8);
+        QCOMPARE(g.value(), 9);
+        ++calls;
+    }
+
+public:
+    int calls;
+};
+
+void tst_QObject::queuedArguments()
+{
+    qRegisterMetaType<CustomType>("CustomType");
+    const CustomType a(1, 2, 3), e(2, 2, 3), f(3, 2, 3), g(4, 2, 3);
+    const int instances = instanceCount;
+
+    {
+        QueuedArgumentChecker checker;
+        connect(&checker, SIGNAL(fewArguments(CustomType,QString)),
+                &checker, SLOT(fewArgumentsSlot(CustomType,QString)), Qt::QueuedConnection);
+        connect(&checker, &QueuedArgumentChecker::manyArguments,
+                &checker, &QueuedArgumentChecker::manyArgumentsSlot, Qt::QueuedConnection);
+
+        emit checker.fewArguments(a, QStringLiteral("few"));
+        emit checker.manyArguments(a, QStringLiteral("many"), 2.5, QByteArray("bytes"), e, f, g);
+        QCOMPARE(instanceCount, instances + 5);
+
+        QCoreApplication::processEvents();
+        QCOMPARE(checker.calls, 2);
+        QCOMPARE(instanceCount, instances);
+
+        // arguments of calls that are never made are destroyed as well
+        emit checker.fewArguments(a, QStringLiteral("few"));
+        emit checker.manyArguments(a, QStringLiteral("many"), 2.5, QByteArray("bytes"), e, f, g);
+        QCOMPARE(instanceCount, instances + 5);
+    }
+    QCOMPARE(instanceCount, instances);
+}
+
 QDataStream &operator<<(QDataStream &stream, const CustomType &ct)
 {
     stream << ct.i1 << ct.i2 << ct.i3;
@@ -3050,6 +3118,130 @@ void tst_QObject::blockingQueuedConnection()
     }
 }
 
+class BatchReceiver : public QObject
+{
+    Q_OBJECT
+
+public:
+    BatchReceiver() : metaCallEvents(0), deleteAt(-1), deliveries(0) {}
+
+    bool event(QEvent *e) Q_DECL_OVERRIDE
+    {
+        if (e->type() == QEvent::MetaCall)
+            ++metaCallEvents;
+        return QObject::event(e);
+    }
+
+    int metaCallEvents;
+    int deleteAt;
+    int *deliveries;
+    QList<int> values;
+    QList<QObject *> senders;
+
+public slots:
+    void slot(int value, const QString &text)
+    {
+        QCOMPARE(text, QString::number(value));
+        values << value;
+        senders << sender();
+        if (deliveries)
+            ++*deliveries;
+        if (value == deleteAt)
+            delete this;
+    }
+};
+
+class BatchEmitterThread : public QThread
+{
+    Q_OBJECT
+
+protected:
+    void run() Q_DECL_OVERRIDE
+    {
+        for (int i = 0; i < 1000; ++i)
+            emit signal7(i, QString::number(i));
+    }
+
+signals:
+    void signal7(int, const QString &);
+};
+
+void tst_QObject::batchedConnection()
+{
+    SenderObject sender1;
+    SenderObject sender2;
+
+    {
+        BatchReceiver receiver;
+        connect(&sender1, SIGNAL(signal7(int,QString)),
+                &receiver, SLOT(slot(int,QString)), Qt::BatchedConnection);
+        connect(&sender2, &SenderObject::signal7, &receiver, &BatchReceiver::slot,
+                Qt::BatchedConnection);
+
+        for (int i = 0; i < 100; ++i)
+            emit (i % 2 ? sender2 : sender1).signal7(i, QString::number(i));
+        QVERIFY(receiver.values.isEmpty());
+
+        QCoreApplication::sendPostedEvents(&receiver, QEvent::MetaCall);
+        QCOMPARE(receiver.metaCallEvents, 1);
+        QCOMPARE(receiver.values.size(), 100);
+        for (int i = 0; i < 100; ++i) {
+            QCOMPARE(receiver.values.at(i), i);
+            QCOMPARE(receiver.senders.at(i), i % 2 ? &sender2 : &sender1);
+        }
+
+        // a delivered batch does not take new emissions
+        emit sender1.signal7(100, QString::number(100));
+        QCoreApplication::sendPostedEvents(&receiver, QEvent::MetaCall);
+        QCOMPARE(receiver.metaCallEvents, 2);
+        QCOMPARE(receiver.values.size(), 101);
+        QCOMPARE(receiver.values.last(), 100);
+    }
+
+    {
+        // a pending batch is dropped with its receiver
+        BatchReceiver *receiver = new BatchReceiver;
+        connect(&sender1, &SenderObject::signal7, receiver, &BatchReceiver::slot,
+                Qt::BatchedConnection);
+        emit sender1.signal7(0, QString::number(0));
+        emit sender1.signal7(1, QString::number(1));
+        delete receiver;
+        emit sender1.signal7(2, QString::number(2));
+        QCoreApplication::sendPostedEvents();
+    }
+
+    {
+        // the rest of a batch is dropped when a slot deletes the receiver
+        int deliveries = 0;
+        BatchReceiver *receiver = new BatchReceiver;
+        receiver->deleteAt = 1;
+        receiver->deliveries = &deliveries;
+        connect(&sender1, &SenderObject::signal7, receiver, &BatchReceiver::slot,
+                Qt::BatchedConnection);
+        for (int i = 0; i < 4; ++i)
+            emit sender1.signal7(i, QString::number(i));
+        QPointer<BatchReceiver> guard(receiver);
+        QCoreApplication::sendPostedEvents();
+        QVERIFY(!guard);
+        QCOMPARE(deliveries, 2);
+    }
+
+    {
+        BatchEmitterThread thread;
+        BatchReceiver receiver;
+        connect(&thread, &BatchEmitterThread::signal7, &receiver, &BatchReceiver::slot,
+                Qt::BatchedConnection);
+        thread.start();
+        QVERIFY(thread.wait());
+
+        QCoreApplication::sendPostedEvents(&receiver, QEvent::MetaCall);
+        QCOMPARE(receiver.metaCallEvents, 1);
+        QCOMPARE(receiver.values.size(), 1000);
+        for (int i = 0; i < 1000; ++i)
+            QCOMPARE(receiver.values.at(i), i);
+    }
+}
+
 class EventSpy : public QObject
 {
     Q_OBJECT
@@ -4245,6 +4437,69 @@ void tst_QObject::disconnectByMetaMethod()
     delete s;
 }
 
+class HandleReceiver : public QObject
+{
+    Q_OBJECT
+public:
+    HandleReceiver() : called(0), toDisconnect(0) {}
+
+    int called;
+    QMetaObject::Connection *toDisconnect;
+
+public slots:
+    void slot()
+    {
+        ++called;
+        if (toDisconnect)
+            QObject::disconnect(*toDisconnect);
+    }
+};
+
+void tst_QObject::disconnectManyByHandle()
+{
+    const int count = 1000;
+    SenderObject sender;
+    QVector<HandleReceiver *> receivers;
+    QVector<QMetaObject::Connection> connections;
+    for (int i = 0; i < count; ++i) {
+        receivers.append(new HandleReceiver);
+        connections.append(connect(&sender, &SenderObject::signal1,
+                                   receivers.last(), &HandleReceiver::slot));
+    }
+
+    // disconnect every other one, then the ends of the list
+    for (int i = 1; i < count; i += 2)
+        QVERIFY(QObject::disconnect(connections[i]));
+    QVERIFY(QObject::disconnect(connections[0]));
+    QVERIFY(!QObject::disconnect(connections[0]));
+    sender.emitSignal1();
+    for (int i = 0; i < count; ++i)
+        QCOMPARE(receivers.at(i)->called, (i % 2 || i == 0) ? 0 : 1);
+
+    // disconnecting during the emission, both a receiver that was already
+    // called and one that was not, does not disturb the others
+    receivers.at(2)->toDisconnect = &connections[4];
+    receivers.at(6)->toDisconnect = &connections[2];
+    sender.emitSignal1();
+    QCOMPARE(receivers.at(2)->called, 2);
+    QCOMPARE(receivers.at(4)->called, 1);
+    QCOMPARE(receivers.at(6)->called, 2);
+    QCOMPARE(receivers.at(8)->called, 2);
+    QCOMPARE(receivers.at(count - 2)->called, 2);
+
+    // new connections go after the remaining ones
+    connections[1] = connect(&sender, &SenderObject::signal1,
+                             receivers.at(1), &HandleReceiver::slot);
+    sender.emitSignal1();
+    QCOMPARE(receivers.at(1)->called, 1);
+    QCOMPARE(receivers.at(2)->called, 2);
+    QCOMPARE(receivers.at(4)->called, 1);
+    QCOMPARE(receivers.at(6)->called, 3);
+
+    qDeleteAll(receivers);
+    sender.emitSignal1();
+}
+
 void tst_QObject::disconnectNotSignalMetaMethod()
 {
     SenderObject s;
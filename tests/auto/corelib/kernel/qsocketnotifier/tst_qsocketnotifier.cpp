@@ -49,6 +49,12 @@
 #ifdef Q_OS_UNIX
 #include <private/qnet_unix_p.h>
 #include <sys/select.h>
+#include <sys/resource.h>
+#endif
+#if defined(Q_OS_UNIX) && !defined(QT_NO_EPOLL)
+#include <QtCore/QSemaphore>
+#include <QtCore/QThread>
+#include <private/qeventdispatcher_epoll_p.h>
 #endif
 #include <limits>
 
@@ -66,6 +72,9 @@ private slots:
 #ifdef Q_OS_UNIX
     void posixSockets();
 #endif
+#if defined(Q_OS_UNIX) && !defined(QT_NO_EPOLL)
+    void epollManyNotifiers();
+#endif
 };
 
 class UnexpectedDisconnectTester : public QObject
@@ -299,5 +308,97 @@ void tst_QSocketNotifier::posixSockets()
 }
 #endif
 
+#if defined(Q_OS_UNIX) && !defined(QT_NO_EPOLL)
+class EpollTester : public QObject
+{
+    Q_OBJECT
+public:
+    QVector<int> readFds;
+    QVector<int> activatedFds;
+    QSemaphore activated;
+
+public slots:
+    void createNotifiers()
+    {
+        foreach (int fd, readFds) {
+            QSocketNotifier *notifier = new QSocketNotifier(fd, QSocketNotifier::Read, this);
+            connect(notifier, SIGNAL(activated(int)), SLOT(handleActivated(int)));
+        }
+    }
+
+    void destroyNotifiers()
+    {
+        qDeleteAll(findChildren<QSocketNotifier *>());
+    }
+
+    void handleActivated(int fd)
+    {
+        char c;
+        qt_safe_read(fd, &c, 1);
+        activatedFds.append(fd);
+        activated.release();
+    }
+};
+
+// Restores the process' descriptor limit when the test returns
+class FileLimitRestorer
+{
+public:
+    explicit FileLimitRestorer(const struct rlimit &limit) : saved(limit) {}
+    ~FileLimitRestorer() { setrlimit(RLIMIT_NOFILE, &saved); }
+private:
+    const struct rlimit saved;
+};
+
+void tst_QSocketNotifier::epollManyNotifiers()
+{
+    // use more descriptors than select() can handle, if we are allowed to
+    struct rlimit limit;
+    QCOMPARE(getrlimit(RLIMIT_NOFILE, &limit), 0);
+    const FileLimitRestorer restorer(limit);
+    if (limit.rlim_max == RLIM_INFINITY || limit.rlim_max > 2 * FD_SETSIZE + 256)
+        limit.rlim_cur = 2 * FD_SETSIZE + 256;
+    else
+        limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &limit);
+    QCOMPARE(getrlimit(RLIMIT_NOFILE, &limit), 0);
+    const int count = qMin(int(limit.rlim_cur - 128) / 2, FD_SETSIZE);
+    QVERIFY(count > 0);
+
+    EpollTester tester;
+    QVector<int> writeFds;
+    for (int i = 0; i < count; ++i) {
+        int pipefd[2];
+        QVERIFY(qt_safe_pipe(pipefd, O_NONBLOCK) == 0);
+        tester.readFds.append(pipefd[0]);
+        writeFds.append(pipefd[1]);
+    }
+
+    QThread thread;
+    thread.setEventDispatcher(new QEventDispatcherEpoll);
+    thread.start();
+    tester.moveToThread(&thread);
+    QMetaObject::invokeMethod(&tester, "createNotifiers", Qt::BlockingQueuedConnection);
+
+    const int indexes[] = { 0, count / 2, count - 1 };
+    for (int i = 0; i < 3; ++i)
+        QCOMPARE(qt_safe_write(writeFds.at(indexes[i]), "x", 1), qint64(1));
+    QVERIFY(tester.activated.tryAcquire(3, 5000));
+
+    QMetaObject::invokeMethod(&tester, "destroyNotifiers", Qt::BlockingQueuedConnection);
+    thread.quit();
+    QVERIFY(thread.wait(5000));
+
+    QCOMPARE(tester.activatedFds.size(), 3);
+    for (int i = 0; i < 3; ++i)
+        QVERIFY(tester.activatedFds.contains(tester.readFds.at(indexes[i])));
+
+    foreach (int fd, tester.readFds)
+        qt_safe_close(fd);
+    foreach (int fd, writeFds)
+        qt_safe_close(fd);
+}
+#endif
+
 QTEST_MAIN(tst_QSocketNotifier)
 #include <tst_qsocketnotifier.moc>
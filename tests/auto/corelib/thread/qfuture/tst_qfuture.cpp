@@ -60,6 +60,7 @@ private slots:
     void statePropagation();
     void multipleResults();
     void indexedResults();
+    void concurrentResults();
     void progress();
     void progressText();
     void resultsAfterFinished();
@@ -69,9 +70,15 @@ private slots:
     void pause();
     void throttling();
     void voidConversions();
+#if defined(Q_COMPILER_DECLTYPE) && defined(Q_COMPILER_AUTO_FUNCTION)
+    void continuations();
+#endif
+    void whenAll();
+    void whenAny();
 #ifndef QT_NO_EXCEPTIONS
     void exceptions();
     void nestedExceptions();
+    void onFailed();
 #endif
     void nonGlobalThreadPool();
 };
@@ -865,6 +872,62 @@ void tst_QFuture::indexedResults()
     }
 }
 
+class ResultReporterThread : public QThread
+{
+    QFutureInterface<int> iface;
+    int first, stride, count;
+public:
+    ResultReporterThread(const QFutureInterface<int> &iface, int first, int stride, int count)
+        : iface(iface), first(first), stride(stride), count(count)
+    { }
+    void run() Q_DECL_OVERRIDE
+    {
+        // report backwards, so that most results arrive out of order
+        for (int i = first + (count - 1) * stride; i >= first; i -= stride) {
+            if (i % 3 == 0) {
+                iface.reportResults(QVector<int>() << i * 10, i);
+            } else {
+                iface.reportResult(i * 10, i);
+            }
+        }
+    }
+};
+
+void tst_QFuture::concurrentResults()
+{
+    const int threadCount = 4;
+    const int resultsPerThread = 2500;
+    const int resultCount = threadCount * resultsPerThread;
+
+    QFutureInterface<int> iface;
+    iface.reportStarted();
+    QFuture<int> f = iface.future();
+
+    QVector<ResultReporterThread *> threads;
+    for (int i = 0; i < threadCount; ++i)
+        threads.append(new ResultReporterThread(iface, i, threadCount, resultsPerThread));
+    foreach (ResultReporterThread *thread, threads)
+        thread->start();
+
+    // waits for the result while the other threads report
+    QCOMPARE(f.resultAt(0), 0);
+
+    foreach (ResultReporterThread *thread, threads)
+        thread->wait();
+    qDeleteAll(threads);
+
+    QCOMPARE(f.resultCount(), resultCount);
+    QCOMPARE(f.progressValue(), resultCount);
+
+    iface.reportResult(resultCount * 10); // no index
+    iface.reportFinished();
+
+    const QList<int> results = f.results();
+    QCOMPARE(results.count(), resultCount + 1);
+    for (int i = 0; i <= resultCount; ++i)
+        QCOMPARE(results.at(i), i * 10);
+}
+
 void tst_QFuture::progress()
 {
     QFutureInterface<QChar> result;
@@ -1274,6 +1337,162 @@ void tst_QFuture::voidConversions()
 }
 
 
+static int doubleResult(const QFuture<int> &future)
+{
+    return future.result() * 2;
+}
+
+static QString describe(const QFuture<int> &future)
+{
+    return QString::number(future.result());
+}
+
+static QAtomicInt voidContinuationRuns;
+
+static void countRun(const QFuture<void> &)
+{
+    voidContinuationRuns.ref();
+}
+
+#if defined(Q_COMPILER_DECLTYPE) && defined(Q_COMPILER_AUTO_FUNCTION)
+void tst_QFuture::continuations()
+{
+    // continuations added before the future finishes
+    {
+        QFutureInterface<int> i;
+        i.reportStarted();
+        QFuture<QString> f = i.future().then(doubleResult).then(describe);
+        QVERIFY(!f.isFinished());
+
+        i.reportResult(21);
+        i.reportFinished();
+        QCOMPARE(f.result(), QString("42"));
+    }
+
+    // continuations added after the future finished
+    {
+        QFutureInterface<int> i;
+        i.reportStarted();
+        i.reportResult(4);
+        i.reportFinished();
+        QCOMPARE(i.future().then(doubleResult).result(), 8);
+    }
+
+    // a null pool runs the continuation in the thread that finishes the future
+    {
+        QFutureInterface<int> i;
+        i.reportStarted();
+        QFuture<int> f = i.future().then(static_cast<QThreadPool *>(0), doubleResult);
+        i.reportResult(5);
+        i.reportFinished();
+        QVERIFY(f.isFinished());
+        QCOMPARE(f.result(), 10);
+    }
+
+    // void futures and a custom pool
+    {
+        QThreadPool pool;
+        voidContinuationRuns.store(0);
+        QFutureInterface<void> i;
+        i.reportStarted();
+        QFuture<void> f = i.future().then(&pool, countRun).then(&pool, countRun);
+        i.reportFinished();
+        f.waitForFinished();
+        QCOMPARE(voidContinuationRuns.load(), 2);
+    }
+
+    // cancellation is propagated without calling the continuation
+    {
+        voidContinuationRuns.store(0);
+        QFutureInterface<void> i;
+        i.reportStarted();
+        QFuture<void> f = i.future().then(countRun);
+        i.reportCanceled();
+        i.reportFinished();
+        f.waitForFinished();
+        QVERIFY(f.isCanceled());
+        QCOMPARE(voidContinuationRuns.load(), 0);
+    }
+
+    // continuations of a future that can no longer finish are canceled
+    {
+        QFuture<int> f;
+        {
+            QFutureInterface<int> i;
+            i.reportStarted();
+            f = i.future().then(doubleResult);
+            QVERIFY(!f.isFinished());
+        }
+        QVERIFY(f.isFinished());
+        QVERIFY(f.isCanceled());
+    }
+}
+#endif
+
+void tst_QFuture::whenAll()
+{
+    QFutureInterface<int> i1;
+    QFutureInterface<int> i2;
+    i1.reportStarted();
+    i2.reportStarted();
+
+    QList<QFuture<int> > futures;
+    futures << i1.future() << i2.future();
+    QFuture<QList<QFuture<int> > > all = QtFuture::whenAll(futures);
+    QVERIFY(!all.isFinished());
+
+    i2.reportResult(2);
+    i2.reportFinished();
+    QVERIFY(!all.isFinished());
+    i1.reportResult(1);
+    i1.reportFinished();
+    QVERIFY(all.isFinished());
+
+    const QList<QFuture<int> > results = all.result();
+    QCOMPARE(results.count(), 2);
+    QCOMPARE(results.at(0).result(), 1);
+    QCOMPARE(results.at(1).result(), 2);
+
+    // futures that are dropped before finishing are reported canceled
+    {
+        QFuture<QList<QFuture<int> > > dropped;
+        {
+            QFutureInterface<int> i;
+            i.reportStarted();
+            dropped = QtFuture::whenAll(QList<QFuture<int> >() << i.future());
+        }
+        QVERIFY(dropped.isFinished());
+        QVERIFY(dropped.result().at(0).isCanceled());
+    }
+
+    // an empty list finishes right away
+    QFuture<QList<QFuture<void> > > none = QtFuture::whenAll(QList<QFuture<void> >());
+    QVERIFY(none.isFinished());
+    QVERIFY(none.result().isEmpty());
+}
+
+void tst_QFuture::whenAny()
+{
+    QFutureInterface<void> i1;
+    QFutureInterface<void> i2;
+    i1.reportStarted();
+    i2.reportStarted();
+
+    QList<QFuture<void> > futures;
+    futures << i1.future() << i2.future();
+    QFuture<int> any = QtFuture::whenAny(futures);
+    QVERIFY(!any.isFinished());
+
+    i2.reportFinished();
+    QVERIFY(any.isFinished());
+    QCOMPARE(any.result(), 1);
+    i1.reportFinished();
+    QCOMPARE(any.resultCount(), 1);
+
+    QCOMPARE(QtFuture::whenAny(QList<QFuture<int> >()).result(), -1);
+}
+
+
 #ifndef QT_NO_EXCEPTIONS
 
 QFuture<void> createExceptionFuture()
@@ -1438,6 +1657,64 @@ void tst_QFuture::nestedExceptions()
     QVERIFY(MyClass::caught);
 }
 
+static int recoverFromFailure(const QException &)
+{
+    return -1;
+}
+
+static int throwFromContinuation(const QFuture<int> &)
+{
+    throw QException();
+}
+
+void tst_QFuture::onFailed()
+{
+    // the handler replaces the result of a failed future
+    QCOMPARE(createExceptionResultFuture().onFailed(recoverFromFailure).result(), -1);
+
+    // results of a successful future are passed through
+    {
+        QFutureInterface<int> i;
+        i.reportStarted();
+        QFuture<int> f = i.future().onFailed(recoverFromFailure);
+        i.reportResult(7);
+        i.reportFinished();
+        QCOMPARE(f.results(), QList<int>() << 7);
+    }
+
+#if defined(Q_COMPILER_DECLTYPE) && defined(Q_COMPILER_AUTO_FUNCTION)
+    // exceptions propagate through continuations until they are handled
+    {
+        QFuture<int> f = createExceptionResultFuture().then(doubleResult);
+        bool caught = false;
+        try {
+            f.waitForFinished();
+        } catch (QException &) {
+            caught = true;
+        }
+        QVERIFY(caught);
+
+        QFutureInterface<int> i;
+        i.reportStarted();
+        f = i.future().then(throwFromContinuation).onFailed(recoverFromFailure);
+        i.reportResult(1);
+        i.reportFinished();
+        QCOMPARE(f.result(), -1);
+    }
+#endif
+
+    // a future canceled without an exception stays canceled
+    {
+        QFutureInterface<int> i;
+        i.reportStarted();
+        QFuture<int> f = i.future().onFailed(recoverFromFailure);
+        i.reportCanceled();
+        i.reportFinished();
+        f.waitForFinished();
+        QVERIFY(f.isCanceled());
+    }
+}
+
 void tst_QFuture::nonGlobalThreadPool()
 {
     static Q_CONSTEXPR int Answer = 42;
@@ -37,6 +37,7 @@
 #include <qmutex.h>
 #include <qthread.h>
 #include <qwaitcondition.h>
+#include <qsemaphore.h>
 
 #ifdef Q_OS_UNIX
 #include <unistd.h>
@@ -92,6 +93,7 @@ private slots:
     void countingTest();
     void limitedReaders();
     void deleteOnUnlock();
+    void writeLockTimeoutWakesReaders();
 
 /*
     Performance tests
@@ -895,6 +897,101 @@ void tst_QReadWriteLock::deleteOnUnlock()
     }
 }
 
+/*
+    tryLockForWrite(timeout) fails
+*/
+class TimedWriteLockThread : public QThread
+{
+public:
+    QReadWriteLock &testRwlock;
+    const int timeout;
+    QAtomicInt locked;
+    inline TimedWriteLockThread(QReadWriteLock &l, int t) : testRwlock(l), timeout(t) { }
+    void run()
+    {
+        if (testRwlock.tryLockForWrite(timeout)) {
+            locked.store(1);
+            testRwlock.unlock();
+        }
+    }
+};
+
+/*
+    read-lock
+    release acquired
+    wait for release==true
+    unlock
+*/
+class ReadLockSignallingThread : public QThread
+{
+public:
+    QReadWriteLock &testRwlock;
+    QSemaphore &acquired;
+    inline ReadLockSignallingThread(QReadWriteLock &l, QSemaphore &a) : testRwlock(l), acquired(a) { }
+    void run()
+    {
+        testRwlock.lockForRead();
+        acquired.release();
+        while (release.load() == false) {
+            RWTESTSLEEP
+        }
+        testRwlock.unlock();
+    }
+};
+
+/*
+    A reader holds the lock while a writer waits for it with a timeout, and
+    more readers queue up behind the writer. When the writer gives up, the
+    queued readers must be woken, as nothing else would wake them while the
+    first reader holds on to the lock.
+*/
+void tst_QReadWriteLock::writeLockTimeoutWakesReaders()
+{
+    const int readerCount = 4;
+    QReadWriteLock testLock;
+    QSemaphore acquired;
+    release.store(false);
+
+    testLock.lockForRead();
+
+    TimedWriteLockThread writer(testLock, 1000);
+    writer.start();
+
+    // wait until the writer is queued, which keeps new readers out
+    QTime t;
+    t.start();
+    bool writerQueued = false;
+    while (!writerQueued && t.elapsed() < 10000) {
+        writerQueued = !testLock.tryLockForRead();
+        if (!writerQueued) {
+            testLock.unlock();
+            QThread::yieldCurrentThread();
+        }
+    }
+    if (!writerQueued) {
+        testLock.unlock();
+        writer.wait();
+        QFAIL("the writer never started waiting");
+    }
+
+    ReadLockSignallingThread *readers[readerCount];
+    for (int i = 0; i < readerCount; ++i) {
+        readers[i] = new ReadLockSignallingThread(testLock, acquired);
+        readers[i]->start();
+    }
+
+    QVERIFY(writer.wait(10000));
+    QCOMPARE(writer.locked.load(), 0);
+    const bool woken = acquired.tryAcquire(readerCount, 10000);
+
+    release.store(true);
+    testLock.unlock();
+    for (int i = 0; i < readerCount; ++i) {
+        readers[i]->wait();
+        delete readers[i];
+    }
+    QVERIFY(woken);
+}
 
 void tst_QReadWriteLock::uncontendedLocks()
 {
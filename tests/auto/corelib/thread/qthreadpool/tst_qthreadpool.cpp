@@ -36,6 +36,10 @@
 #include <qstring.h>
 #include <qmutex.h>
 
+#if defined(Q_OS_LINUX)
+#  include <sched.h>
+#endif
+
 typedef void (*FunctionPointer)();
 
 class FunctionPointerTask : public QRunnable
@@ -90,9 +94,12 @@ private slots:
     void tryStartCount();
     void priorityStart_data();
     void priorityStart();
+    void cpuAffinity();
     void waitForDone();
     void clear();
     void cancel();
+    void clearBatchedTasks();
+    void cancelBatchedTasks();
     void waitForDoneTimeout();
     void destroyingWaitsForTasksToFinish();
     void stressTest();
@@ -876,6 +883,61 @@ void tst_QThreadPool::priorityStart()
     QCOMPARE(firstStarted.load(), expected);
 }
 
+void tst_QThreadPool::cpuAffinity()
+{
+    class AffinityTask : public QRunnable
+    {
+    public:
+        QAtomicInt &cpuCount;
+        AffinityTask(QAtomicInt &cpuCount) : cpuCount(cpuCount) {}
+        void run()
+        {
+#if defined(Q_OS_LINUX)
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            if (sched_getaffinity(0, sizeof(set), &set) == 0)
+                cpuCount.store(CPU_COUNT(&set));
+#endif
+        }
+    };
+
+    // the test may be restricted to some CPUs already; pick one of them
+    int cpu = 0;
+    int inheritedCpuCount = -1;
+#if defined(Q_OS_LINUX)
+    cpu_set_t inherited;
+    CPU_ZERO(&inherited);
+    QCOMPARE(sched_getaffinity(0, sizeof(inherited), &inherited), 0);
+    inheritedCpuCount = CPU_COUNT(&inherited);
+    while (cpu < CPU_SETSIZE && !CPU_ISSET(cpu, &inherited))
+        ++cpu;
+    QVERIFY(cpu < CPU_SETSIZE);
+#endif
+
+    QThreadPool threadPool;
+    QVERIFY(threadPool.cpuAffinity().isEmpty());
+
+    threadPool.setCpuAffinity(QList<int>() << cpu);
+    QCOMPARE(threadPool.cpuAffinity(), QList<int>() << cpu);
+
+    QAtomicInt cpuCount(-1);
+    threadPool.start(new AffinityTask(cpuCount));
+    QVERIFY(threadPool.waitForDone());
+#if defined(Q_OS_LINUX)
+    QCOMPARE(cpuCount.load(), 1);
+#endif
+
+    // an empty list restores the affinity the pool was created with
+    threadPool.setCpuAffinity(QList<int>());
+    QVERIFY(threadPool.cpuAffinity().isEmpty());
+    threadPool.start(new AffinityTask(cpuCount));
+    QVERIFY(threadPool.waitForDone());
+#if defined(Q_OS_LINUX)
+    QCOMPARE(cpuCount.load(), inheritedCpuCount);
+#endif
+    Q_UNUSED(inheritedCpuCount);
+}
+
 void tst_QThreadPool::waitForDone()
 {
     QTime total, pass;
@@ -1009,6 +1071,108 @@ void tst_QThreadPool::cancel()
     delete[] runnables;
 }
 
+// Blocks the pool's only thread, so that the tasks started after it pile up
+class GateRunnable : public QRunnable
+{
+public:
+    QSemaphore started;
+    QSemaphore proceed;
+    GateRunnable() { setAutoDelete(false); }
+    void run()
+    {
+        started.release();
+        proceed.acquire();
+    }
+};
+
+class BatchedRunnable : public QRunnable
+{
+public:
+    QAtomicInt &dtorCounter;
+    QAtomicInt &runCounter;
+    BatchedRunnable(QAtomicInt &d, QAtomicInt &r) : dtorCounter(d), runCounter(r) {}
+    ~BatchedRunnable() { dtorCounter.ref(); }
+    void run() { runCounter.ref(); }
+};
+
+// More tasks than a thread takes from the queue at a time (MaxTaskBatch)
+static const int batchedRuns = 2 * 16 + 1;
+
+/*
+    Queues batchedRuns tasks behind two gates on a single thread, and opens
+    the first gate, so that the thread moves the second gate and a batch of
+    the tasks into its own queue before it blocks again. The tasks listed in
+    \a kept are not auto-deleted.
+*/
+static void startBatchedTasks(QThreadPool &threadPool, GateRunnable &first, GateRunnable &second,
+                              BatchedRunnable **runnables, QAtomicInt &dtorCounter, QAtomicInt &runCounter,
+                              const QList<int> &kept = QList<int>())
+{
+    threadPool.setMaxThreadCount(1);
+    threadPool.start(&first);
+    threadPool.start(&second);
+    for (int i = 0; i < batchedRuns; ++i) {
+        runnables[i] = new BatchedRunnable(dtorCounter, runCounter);
+        runnables[i]->setAutoDelete(!kept.contains(i));
+        threadPool.start(runnables[i]);
+    }
+    QVERIFY(first.started.tryAcquire(1, 10000));
+    first.proceed.release();
+    QVERIFY(second.started.tryAcquire(1, 10000));
+}
+
+void tst_QThreadPool::clearBatchedTasks()
+{
+    GateRunnable first, second;
+    BatchedRunnable *runnables[batchedRuns];
+    QAtomicInt dtorCounter, runCounter;
+
+    QThreadPool threadPool;
+    startBatchedTasks(threadPool, first, second, runnables, dtorCounter, runCounter);
+    if (QTest::currentTestFailed()) {
+        first.proceed.release();
+        second.proceed.release();
+        return;
+    }
+
+    threadPool.clear();
+    QCOMPARE(dtorCounter.load(), batchedRuns);
+    second.proceed.release();
+    QVERIFY(threadPool.waitForDone(10000));
+    QCOMPARE(runCounter.load(), 0);
+    QCOMPARE(dtorCounter.load(), batchedRuns);
+}
+
+void tst_QThreadPool::cancelBatchedTasks()
+{
+    GateRunnable first, second;
+    BatchedRunnable *runnables[batchedRuns];
+    QAtomicInt dtorCounter, runCounter;
+
+    // one task in the thread's batch and one still in the pool's queue are
+    // not auto-deleted, so they must survive being cancelled
+    const QList<int> kept = QList<int>() << 1 << batchedRuns - 1;
+
+    QThreadPool threadPool;
+    startBatchedTasks(threadPool, first, second, runnables, dtorCounter, runCounter, kept);
+    if (QTest::currentTestFailed()) {
+        first.proceed.release();
+        second.proceed.release();
+        return;
+    }
+
+    for (int i = 0; i < batchedRuns; ++i)
+        threadPool.cancel(runnables[i]);
+    QCOMPARE(dtorCounter.load(), batchedRuns - 2);
+
+    second.proceed.release();
+    QVERIFY(threadPool.waitForDone(10000));
+    QCOMPARE(runCounter.load(), 0);
+    foreach (int i, kept)
+        delete runnables[i];
+    QCOMPARE(dtorCounter.load(), batchedRuns);
+}
+
 void tst_QThreadPool::destroyingWaitsForTasksToFinish()
 {
     QTime total, pass;
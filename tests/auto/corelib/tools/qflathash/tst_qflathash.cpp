@@ -0,0 +1,420 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <qflathash.h>
+#include <qhash.h>
+
+class tst_QFlatHash : public QObject
+{
+    Q_OBJECT
+private slots:
+    void insertAndValue();
+    void operatorBrackets();
+    void removeAndTake();
+    void compareWithQHash_data();
+    void compareWithQHash();
+    void implicitSharing();
+    void iterators();
+    void eraseWhileIterating();
+    void eraseOnSharedHash();
+    void keysAndValues();
+    void equality();
+    void reserveAndSqueeze();
+    void stringKeys();
+    void complexValues();
+    void javaStyleIterators();
+    void initializerList();
+};
+
+void tst_QFlatHash::insertAndValue()
+{
+    QFlatHash<int, int> hash;
+    QVERIFY(hash.isEmpty());
+    QCOMPARE(hash.capacity(), 0);
+    QCOMPARE(hash.value(1), 0);
+    QCOMPARE(hash.value(1, 42), 42);
+    QVERIFY(!hash.contains(1));
+
+    QFlatHash<int, int>::iterator it = hash.insert(1, 10);
+    QCOMPARE(it.key(), 1);
+    QCOMPARE(it.value(), 10);
+    QCOMPARE(hash.size(), 1);
+    QVERIFY(hash.contains(1));
+    QCOMPARE(hash.value(1), 10);
+    QCOMPARE(hash.count(1), 1);
+    QCOMPARE(hash.count(2), 0);
+
+    // inserting an existing key replaces its value
+    hash.insert(1, 11);
+    QCOMPARE(hash.size(), 1);
+    QCOMPARE(hash.value(1), 11);
+    QCOMPARE(hash.key(11), 1);
+    QCOMPARE(hash.key(12, -1), -1);
+
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(i * 1024, i);
+    QCOMPARE(hash.size(), 1001);
+    QVERIFY(hash.capacity() >= 1000);
+    for (int i = 0; i < 1000; ++i)
+        QCOMPARE(hash.value(i * 1024, -1), i);
+    QCOMPARE(hash.value(1), 11);
+}
+
+void tst_QFlatHash::operatorBrackets()
+{
+    QFlatHash<int, QString> hash;
+    hash[1] = QStringLiteral("one");
+    hash[2] += QStringLiteral("two");
+    QCOMPARE(hash.size(), 2);
+    QCOMPARE(hash[1], QStringLiteral("one"));
+    QCOMPARE(hash.value(2), QStringLiteral("two"));
+
+    const QFlatHash<int, QString> &constHash = hash;
+    QCOMPARE(constHash[3], QString());
+    QCOMPARE(hash.size(), 2);
+    QVERIFY(hash[3].isNull());
+    QCOMPARE(hash.size(), 3);
+}
+
+void tst_QFlatHash::removeAndTake()
+{
+    QFlatHash<int, int> hash;
+    QCOMPARE(hash.remove(1), 0);
+    QCOMPARE(hash.take(1), 0);
+
+    for (int i = 0; i < 100; ++i)
+        hash.insert(i, i * 2);
+    QCOMPARE(hash.remove(100), 0);
+    QCOMPARE(hash.remove(50), 1);
+    QCOMPARE(hash.remove(50), 0);
+    QCOMPARE(hash.take(60), 120);
+    QCOMPARE(hash.take(60), 0);
+    QCOMPARE(hash.size(), 98);
+    for (int i = 0; i < 100; ++i)
+        QCOMPARE(hash.contains(i), i != 50 && i != 60);
+}
+
+void tst_QFlatHash::compareWithQHash_data()
+{
+    QTest::addColumn<int>("keyRange");
+    QTest::newRow("dense") << 100;
+    QTest::newRow("sparse") << 100000;
+}
+
+void tst_QFlatHash::compareWithQHash()
+{
+    QFETCH(int, keyRange);
+
+    QFlatHash<int, int> hash;
+    QHash<int, int> reference;
+    qsrand(keyRange);
+    for (int round = 0; round < 20000; ++round) {
+        const int key = qrand() % keyRange;
+        switch (qrand() % 3) {
+        case 0:
+        case 1:
+            hash.insert(key, round);
+            reference.insert(key, round);
+            break;
+        case 2:
+            QCOMPARE(hash.remove(key), reference.remove(key));
+            break;
+        }
+        QCOMPARE(hash.size(), reference.size());
+    }
+
+    for (QHash<int, int>::const_iterator it = reference.constBegin(); it != reference.constEnd(); ++it)
+        QCOMPARE(hash.value(it.key(), -1), it.value());
+    int visited = 0;
+    for (QFlatHash<int, int>::const_iterator it = hash.constBegin(); it != hash.constEnd(); ++it) {
+        QCOMPARE(reference.value(it.key(), -1), it.value());
+        ++visited;
+    }
+    QCOMPARE(visited, reference.size());
+}
+
+void tst_QFlatHash::implicitSharing()
+{
+    QFlatHash<int, QString> hash1;
+    hash1.insert(1, QStringLiteral("one"));
+    QFlatHash<int, QString> hash2 = hash1;
+    QVERIFY(hash1.isSharedWith(hash2));
+    QVERIFY(!hash1.isDetached());
+
+    hash2.insert(2, QStringLiteral("two"));
+    QVERIFY(!hash1.isSharedWith(hash2));
+    QVERIFY(hash1.isDetached());
+    QCOMPARE(hash1.size(), 1);
+    QCOMPARE(hash2.size(), 2);
+
+    hash1 = hash2;
+    QVERIFY(hash1.isSharedWith(hash2));
+    hash1.remove(1);
+    QCOMPARE(hash1.size(), 1);
+    QCOMPARE(hash2.size(), 2);
+    QCOMPARE(hash2.value(1), QStringLiteral("one"));
+
+    QFlatHash<int, QString> empty1, empty2;
+    QVERIFY(empty1.isSharedWith(empty2));
+    empty1.clear();
+    empty1.squeeze();
+    QVERIFY(empty1.isEmpty());
+
+    hash1.swap(empty1);
+    QVERIFY(hash1.isEmpty());
+    QCOMPARE(empty1.size(), 1);
+}
+
+void tst_QFlatHash::iterators()
+{
+    QFlatHash<int, int> hash;
+    QVERIFY(hash.begin() == hash.end());
+    QVERIFY(hash.constBegin() == hash.constEnd());
+
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(i, i + 1);
+
+    QSet<int> seen;
+    for (QFlatHash<int, int>::iterator it = hash.begin(); it != hash.end(); ++it) {
+        QCOMPARE(it.value(), it.key() + 1);
+        ++*it;
+        QVERIFY(!seen.contains(it.key()));
+        seen.insert(it.key());
+    }
+    QCOMPARE(seen.size(), 1000);
+    QCOMPARE(hash.value(10), 12);
+
+    // backwards visits the same entries
+    int count = 0;
+    QFlatHash<int, int>::const_iterator it = hash.constEnd();
+    while (it != hash.constBegin()) {
+        --it;
+        QVERIFY(seen.contains(it.key()));
+        ++count;
+    }
+    QCOMPARE(count, 1000);
+
+    QFlatHash<int, int>::iterator found = hash.find(500);
+    QVERIFY(found != hash.end());
+    QCOMPARE(found.key(), 500);
+    QVERIFY(hash.find(5000) == hash.end());
+    QVERIFY(hash.constFind(5000) == hash.constEnd());
+    QCOMPARE(hash.constFind(501).value(), 503);
+}
+
+void tst_QFlatHash::eraseWhileIterating()
+{
+    // different sizes, so that runs wrap around the end of the table
+    for (int size = 1; size < 2000; size += 97) {
+        QFlatHash<int, int> hash;
+        for (int i = 0; i < size; ++i)
+            hash.insert(i * 7919, i);
+
+        int visited = 0;
+        QFlatHash<int, int>::iterator it = hash.begin();
+        while (it != hash.end()) {
+            ++visited;
+            if (it.value() % 2)
+                it = hash.erase(it);
+            else
+                ++it;
+        }
+        QCOMPARE(visited, size);
+        QCOMPARE(hash.size(), (size + 1) / 2);
+        for (int i = 0; i < size; ++i)
+            QCOMPARE(hash.contains(i * 7919), i % 2 == 0);
+    }
+}
+
+void tst_QFlatHash::eraseOnSharedHash()
+{
+    QFlatHash<int, int> hash;
+    for (int i = 0; i < 10; ++i)
+        hash.insert(i, i);
+    const QFlatHash<int, int> copy = hash;
+    QFlatHash<int, int>::const_iterator it = hash.constFind(5);
+    hash.erase(it);
+    QCOMPARE(hash.size(), 9);
+    QVERIFY(!hash.contains(5));
+    QCOMPARE(copy.size(), 10);
+    QVERIFY(copy.contains(5));
+}
+
+void tst_QFlatHash::keysAndValues()
+{
+    QFlatHash<QString, int> hash;
+    QVERIFY(hash.keys().isEmpty());
+    QVERIFY(hash.values().isEmpty());
+
+    hash.insert(QStringLiteral("a"), 1);
+    hash.insert(QStringLiteral("b"), 2);
+    hash.insert(QStringLiteral("c"), 3);
+
+    QStringList keys = hash.keys();
+    keys.sort();
+    QCOMPARE(keys, QStringList() << "a" << "b" << "c");
+    QList<int> values = hash.values();
+    std::sort(values.begin(), values.end());
+    QCOMPARE(values, QList<int>() << 1 << 2 << 3);
+}
+
+void tst_QFlatHash::equality()
+{
+    QFlatHash<int, int> hash1, hash2;
+    QVERIFY(hash1 == hash2);
+    for (int i = 0; i < 100; ++i)
+        hash1.insert(i, i);
+    for (int i = 99; i >= 0; --i)
+        hash2.insert(i, i);
+    QVERIFY(hash1 == hash2);
+    hash2.insert(5, 6);
+    QVERIFY(hash1 != hash2);
+    hash2.insert(5, 5);
+    hash2.insert(100, 100);
+    QVERIFY(hash1 != hash2);
+}
+
+void tst_QFlatHash::reserveAndSqueeze()
+{
+    QFlatHash<int, int> hash;
+    hash.reserve(1000);
+    QVERIFY(hash.capacity() >= 1000);
+    const int capacity = hash.capacity();
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(i, i);
+    QCOMPARE(hash.capacity(), capacity);
+
+    for (int i = 10; i < 1000; ++i)
+        hash.remove(i);
+    hash.squeeze();
+    QVERIFY(hash.capacity() < 100);
+    QVERIFY(hash.capacity() >= 10);
+    for (int i = 0; i < 10; ++i)
+        QCOMPARE(hash.value(i, -1), i);
+
+    hash.clear();
+    QCOMPARE(hash.capacity(), 0);
+
+#ifndef QT_NO_EXCEPTIONS
+    // no bucket count an int can hold is large enough
+    QVERIFY_EXCEPTION_THROWN(hash.reserve(std::numeric_limits<int>::max()), std::bad_alloc);
+    QCOMPARE(hash.capacity(), 0);
+#endif
+}
+
+void tst_QFlatHash::stringKeys()
+{
+    QFlatHash<QString, QByteArray> hash;
+    for (int i = 0; i < 5000; ++i)
+        hash.insert(QString::number(i), QByteArray::number(i));
+    QCOMPARE(hash.size(), 5000);
+    for (int i = 0; i < 5000; ++i)
+        QCOMPARE(hash.value(QString::number(i)), QByteArray::number(i));
+    QVERIFY(!hash.contains(QStringLiteral("5000")));
+}
+
+struct Counted
+{
+    static int instances;
+    int value;
+    Counted(int v = 0) : value(v) { ++instances; }
+    Counted(const Counted &other) : value(other.value) { ++instances; }
+    ~Counted() { --instances; }
+    Counted &operator=(const Counted &other) { value = other.value; return *this; }
+    bool operator==(const Counted &other) const { return value == other.value; }
+};
+int Counted::instances = 0;
+
+void tst_QFlatHash::complexValues()
+{
+    {
+        QFlatHash<int, Counted> hash;
+        for (int i = 0; i < 1000; ++i)
+            hash.insert(i, Counted(i));
+        QCOMPARE(Counted::instances, 1000);
+
+        QFlatHash<int, Counted> copy = hash;
+        QCOMPARE(Counted::instances, 1000);
+        copy.remove(1);
+        QCOMPARE(Counted::instances, 1999);
+
+        for (int i = 0; i < 500; ++i)
+            hash.remove(i);
+        QCOMPARE(Counted::instances, 1499);
+        QCOMPARE(hash.take(600).value, 600);
+        QCOMPARE(Counted::instances, 1498);
+        hash.squeeze();
+        QCOMPARE(Counted::instances, 1498);
+    }
+    QCOMPARE(Counted::instances, 0);
+}
+
+void tst_QFlatHash::javaStyleIterators()
+{
+    QFlatHash<int, int> hash;
+    for (int i = 0; i < 100; ++i)
+        hash.insert(i, i);
+
+    int sum = 0;
+    QFlatHashIterator<int, int> it(hash);
+    while (it.hasNext()) {
+        it.next();
+        sum += it.value();
+    }
+    QCOMPARE(sum, 4950);
+
+    QMutableFlatHashIterator<int, int> mit(hash);
+    while (mit.hasNext()) {
+        if (mit.next().key() % 10)
+            mit.remove();
+    }
+    QCOMPARE(hash.size(), 10);
+    QVERIFY(hash.contains(90));
+}
+
+void tst_QFlatHash::initializerList()
+{
+#ifdef Q_COMPILER_INITIALIZER_LISTS
+    QFlatHash<int, QString> hash = {{1, "hello"}, {2, "initializer_list"}};
+    QCOMPARE(hash.count(), 2);
+    QCOMPARE(hash[1], QString("hello"));
+    QCOMPARE(hash[2], QString("initializer_list"));
+#else
+    QSKIP("Compiler doesn't support initializer lists");
+#endif
+}
+
+QTEST_APPLESS_MAIN(tst_QFlatHash)
+#include "tst_qflathash.moc"
@@ -0,0 +1,4 @@
+CONFIG += testcase parallel_test
+TARGET = tst_qflatmap
+QT = core testlib
+SOURCES = $$PWD/tst_qflatmap.cpp
@@ -0,0 +1,471 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <qflatmap.h>
+#include <qmap.h>
+
+class tst_QFlatMap : public QObject
+{
+    Q_OBJECT
+private slots:
+    void insertAndValue();
+    void operatorBrackets();
+    void removeAndTake();
+    void compareWithQMap_data();
+    void compareWithQMap();
+    void fromVector_data();
+    void fromVector();
+    void fromMap();
+    void implicitSharing();
+    void iterators();
+    void eraseWhileIterating();
+    void eraseOnSharedMap();
+    void bounds();
+    void keysAndValues();
+    void equality();
+    void complexValues();
+    void javaStyleIterators();
+    void initializerList();
+};
+
+void tst_QFlatMap::insertAndValue()
+{
+    QFlatMap<int, int> map;
+    QVERIFY(map.isEmpty());
+    QCOMPARE(map.value(1), 0);
+    QCOMPARE(map.value(1, 42), 42);
+    QVERIFY(!map.contains(1));
+
+    QFlatMap<int, int>::iterator it = map.insert(1, 10);
+    QCOMPARE(it.key(), 1);
+    QCOMPARE(it.value(), 10);
+    QCOMPARE(map.size(), 1);
+    QVERIFY(map.contains(1));
+    QCOMPARE(map.value(1), 10);
+    QCOMPARE(map.count(1), 1);
+    QCOMPARE(map.count(2), 0);
+
+    // inserting an existing key replaces its value
+    it = map.insert(1, 11);
+    QCOMPARE(it.value(), 11);
+    QCOMPARE(map.size(), 1);
+    QCOMPARE(map.value(1), 11);
+    QCOMPARE(map.key(11), 1);
+    QCOMPARE(map.key(12, -1), -1);
+
+    for (int i = 999; i >= 0; --i)
+        map.insert(i * 7, i);
+    QCOMPARE(map.size(), 1001);
+    for (int i = 0; i < 1000; ++i)
+        QCOMPARE(map.value(i * 7, -1), i);
+    QCOMPARE(map.value(1), 11);
+    QCOMPARE(map.firstKey(), 0);
+    QCOMPARE(map.lastKey(), 999 * 7);
+    QCOMPARE(map.first(), 0);
+    QCOMPARE(map.last(), 999);
+}
+
+void tst_QFlatMap::operatorBrackets()
+{
+    QFlatMap<int, QString> map;
+    map[2] = QStringLiteral("two");
+    map[1] += QStringLiteral("one");
+    QCOMPARE(map.size(), 2);
+    QCOMPARE(map[1], QStringLiteral("one"));
+    QCOMPARE(map.value(2), QStringLiteral("two"));
+    QCOMPARE(map.firstKey(), 1);
+
+    const QFlatMap<int, QString> &constMap = map;
+    QCOMPARE(constMap[3], QString());
+    QCOMPARE(map.size(), 2);
+    QVERIFY(map[3].isNull());
+    QCOMPARE(map.size(), 3);
+}
+
+void tst_QFlatMap::removeAndTake()
+{
+    QFlatMap<int, int> map;
+    QCOMPARE(map.remove(1), 0);
+    QCOMPARE(map.take(1), 0);
+
+    for (int i = 0; i < 100; ++i)
+        map.insert(i, i * 2);
+    QCOMPARE(map.remove(100), 0);
+    QCOMPARE(map.remove(50), 1);
+    QCOMPARE(map.remove(50), 0);
+    QCOMPARE(map.size(), 99);
+    QCOMPARE(map.take(51), 102);
+    QCOMPARE(map.take(51), 0);
+    QCOMPARE(map.size(), 98);
+    QVERIFY(!map.contains(50));
+    QVERIFY(!map.contains(51));
+    QCOMPARE(map.value(49), 98);
+    QCOMPARE(map.value(52), 104);
+
+    map.clear();
+    QVERIFY(map.isEmpty());
+    QVERIFY(!map.contains(1));
+}
+
+void tst_QFlatMap::compareWithQMap_data()
+{
+    QTest::addColumn<int>("seed");
+    QTest::addColumn<int>("operations");
+
+    QTest::newRow("small") << 1 << 50;
+    QTest::newRow("medium") << 2 << 2000;
+    QTest::newRow("large") << 3 << 20000;
+}
+
+// random inserts and removals over a small key range, checked against QMap
+void tst_QFlatMap::compareWithQMap()
+{
+    QFETCH(int, seed);
+    QFETCH(int, operations);
+
+    qsrand(uint(seed));
+    QMap<int, int> reference;
+    QFlatMap<int, int> map;
+    const int range = operations / 2 + 1;
+    for (int i = 0; i < operations; ++i) {
+        const int key = qrand() % range;
+        switch (qrand() % 3) {
+        case 0:
+        case 1:
+            reference.insert(key, i);
+            map.insert(key, i);
+            break;
+        case 2:
+            QCOMPARE(map.remove(key), reference.remove(key));
+            break;
+        }
+    }
+
+    QCOMPARE(map.size(), reference.size());
+    QCOMPARE(map.keys(), reference.keys());
+    QCOMPARE(map.values(), reference.values());
+    QVERIFY(map.toMap() == reference);
+    for (int key = 0; key < range; ++key)
+        QCOMPARE(map.value(key, -1), reference.value(key, -1));
+}
+
+void tst_QFlatMap::fromVector_data()
+{
+    QTest::addColumn<QVector<int> >("keys");
+
+    QTest::newRow("empty") << QVector<int>();
+    QTest::newRow("one") << (QVector<int>() << 5);
+    QTest::newRow("sorted") << (QVector<int>() << 1 << 2 << 3 << 8);
+    QTest::newRow("reversed") << (QVector<int>() << 8 << 3 << 2 << 1);
+    QTest::newRow("duplicates") << (QVector<int>() << 3 << 1 << 3 << 2 << 1 << 3);
+    QTest::newRow("sorted-duplicates") << (QVector<int>() << 1 << 1 << 2 << 2);
+
+    QVector<int> many;
+    qsrand(4);
+    for (int i = 0; i < 5000; ++i)
+        many << qrand() % 1000;
+    QTest::newRow("random") << many;
+}
+
+void tst_QFlatMap::fromVector()
+{
+    QFETCH(QVector<int>, keys);
+
+    QVector<QPair<int, int> > pairs;
+    QMap<int, int> reference;
+    for (int i = 0; i < keys.size(); ++i) {
+        pairs << qMakePair(keys.at(i), i);
+        reference.insert(keys.at(i), i);
+    }
+
+    // the last value for each key wins, as when inserting one by one
+    const QFlatMap<int, int> map = QFlatMap<int, int>::fromVector(pairs);
+    QCOMPARE(map.size(), reference.size());
+    QCOMPARE(map.keys(), reference.keys());
+    QCOMPARE(map.values(), reference.values());
+}
+
+void tst_QFlatMap::fromMap()
+{
+    QMap<QString, int> qmap;
+    qmap.insert(QStringLiteral("b"), 2);
+    qmap.insert(QStringLiteral("a"), 1);
+    qmap.insertMulti(QStringLiteral("c"), 3);
+    qmap.insertMulti(QStringLiteral("c"), 4);
+
+    const QFlatMap<QString, int> map(qmap);
+    QCOMPARE(map.size(), 3);
+    QCOMPARE(map.keys(), QList<QString>() << "a" << "b" << "c");
+    QCOMPARE(map.value(QStringLiteral("c")), qmap.value(QStringLiteral("c")));
+
+    const QMap<QString, int> back = map.toMap();
+    QCOMPARE(back.size(), 3);
+    QCOMPARE(back.value(QStringLiteral("a")), 1);
+    QCOMPARE(back.value(QStringLiteral("c")), 4);
+}
+
+void tst_QFlatMap::implicitSharing()
+{
+    QFlatMap<int, int> map;
+    for (int i = 0; i < 10; ++i)
+        map.insert(i, i);
+
+    QFlatMap<int, int> copy = map;
+    QVERIFY(copy.isSharedWith(map));
+    QVERIFY(!map.isDetached());
+
+    // reading does not detach
+    QCOMPARE(copy.value(5), 5);
+    QVERIFY(copy.constFind(5) != copy.constEnd());
+    QVERIFY(copy.isSharedWith(map));
+
+    copy.insert(5, 50);
+    QVERIFY(!copy.isSharedWith(map));
+    QVERIFY(map.isDetached());
+    QVERIFY(copy.isDetached());
+    QCOMPARE(map.value(5), 5);
+    QCOMPARE(copy.value(5), 50);
+
+    QFlatMap<int, int> other = map;
+    other.remove(3);
+    QCOMPARE(map.size(), 10);
+    QCOMPARE(other.size(), 9);
+
+    QFlatMap<int, int> written = map;
+    written[4] = 40;
+    QCOMPARE(map.value(4), 4);
+
+    QFlatMap<int, int> iterated = map;
+    for (QFlatMap<int, int>::iterator it = iterated.begin(); it != iterated.end(); ++it)
+        *it += 1;
+    QCOMPARE(map.value(0), 0);
+    QCOMPARE(iterated.value(0), 1);
+
+    QFlatMap<int, int> empty;
+    QFlatMap<int, int> emptyCopy = empty;
+    QVERIFY(emptyCopy.begin() == emptyCopy.end());
+    emptyCopy.insert(1, 1);
+    QVERIFY(empty.isEmpty());
+}
+
+void tst_QFlatMap::iterators()
+{
+    QFlatMap<int, int> map;
+    QVERIFY(map.begin() == map.end());
+    QVERIFY(map.constBegin() == map.constEnd());
+
+    for (int i = 9; i >= 0; --i)
+        map.insert(i * 10, i);
+
+    int expected = 0;
+    for (QFlatMap<int, int>::const_iterator it = map.constBegin(); it != map.constEnd(); ++it) {
+        QCOMPARE(it.key(), expected * 10);
+        QCOMPARE(*it, expected);
+        ++expected;
+    }
+    QCOMPARE(expected, 10);
+
+    // random access
+    QFlatMap<int, int>::const_iterator it = map.constBegin();
+    QCOMPARE(map.constEnd() - it, qptrdiff(10));
+    it += 3;
+    QCOMPARE(it.key(), 30);
+    QCOMPARE((it + 2).key(), 50);
+    QCOMPARE((it - 1).key(), 20);
+    QVERIFY(map.constBegin() < it);
+    --it;
+    QCOMPARE(it.key(), 20);
+
+    QFlatMap<int, int>::iterator mit = map.find(40);
+    QCOMPARE(mit.key(), 40);
+    mit.value() = 400;
+    QCOMPARE(map.value(40), 400);
+    QVERIFY(map.find(41) == map.end());
+    QVERIFY(map.constFind(41) == map.constEnd());
+
+    // std algorithms work on the random access iterators
+    QCOMPARE(*std::max_element(map.constBegin(), map.constEnd()), 400);
+}
+
+void tst_QFlatMap::eraseWhileIterating()
+{
+    QFlatMap<int, int> map;
+    for (int i = 0; i < 100; ++i)
+        map.insert(i, i);
+
+    QFlatMap<int, int>::iterator it = map.begin();
+    while (it != map.end()) {
+        if (it.key() % 3 == 0)
+            it = map.erase(it);
+        else
+            ++it;
+    }
+    QCOMPARE(map.size(), 66);
+    for (int i = 0; i < 100; ++i)
+        QCOMPARE(map.contains(i), i % 3 != 0);
+
+    QVERIFY(map.erase(map.end()) == map.end());
+    QCOMPARE(map.size(), 66);
+}
+
+void tst_QFlatMap::eraseOnSharedMap()
+{
+    QFlatMap<int, int> map;
+    for (int i = 0; i < 10; ++i)
+        map.insert(i, i);
+
+    QFlatMap<int, int> copy = map;
+    QFlatMap<int, int>::const_iterator it = copy.constFind(5);
+    QFlatMap<int, int>::iterator next = copy.erase(it);
+    QCOMPARE(next.key(), 6);
+    QCOMPARE(copy.size(), 9);
+    QVERIFY(!copy.contains(5));
+    QCOMPARE(map.size(), 10);
+    QVERIFY(map.contains(5));
+}
+
+void tst_QFlatMap::bounds()
+{
+    QFlatMap<int, int> map;
+    QVERIFY(map.lowerBound(1) == map.end());
+    for (int i = 1; i <= 5; ++i)
+        map.insert(i * 10, i);
+
+    QCOMPARE(map.lowerBound(30).key(), 30);
+    QCOMPARE(map.upperBound(30).key(), 40);
+    QCOMPARE(map.lowerBound(31).key(), 40);
+    QCOMPARE(map.upperBound(31).key(), 40);
+    QCOMPARE(map.lowerBound(0).key(), 10);
+    QVERIFY(map.lowerBound(51) == map.end());
+    QVERIFY(map.upperBound(50) == map.end());
+
+    const QFlatMap<int, int> &constMap = map;
+    QCOMPARE(constMap.lowerBound(20).key(), 20);
+    QCOMPARE(constMap.upperBound(20).key(), 30);
+}
+
+void tst_QFlatMap::keysAndValues()
+{
+    QFlatMap<QString, int> map;
+    map.insert(QStringLiteral("c"), 1);
+    map.insert(QStringLiteral("a"), 2);
+    map.insert(QStringLiteral("b"), 1);
+
+    QCOMPARE(map.keys(), QList<QString>() << "a" << "b" << "c");
+    QCOMPARE(map.values(), QList<int>() << 2 << 1 << 1);
+    QCOMPARE(map.keys(1), QList<QString>() << "b" << "c");
+    QCOMPARE(map.key(1), QStringLiteral("b"));
+}
+
+void tst_QFlatMap::equality()
+{
+    QFlatMap<int, int> a;
+    QFlatMap<int, int> b;
+    QVERIFY(a == b);
+
+    for (int i = 0; i < 20; ++i)
+        a.insert(i, i);
+    for (int i = 19; i >= 0; --i)
+        b.insert(i, i);
+    QVERIFY(a == b);
+    QVERIFY(!(a != b));
+
+    b.insert(5, 6);
+    QVERIFY(a != b);
+    b.insert(5, 5);
+    QVERIFY(a == b);
+    b.remove(5);
+    QVERIFY(a != b);
+}
+
+void tst_QFlatMap::complexValues()
+{
+    QFlatMap<QString, QStringList> map;
+    for (int i = 0; i < 200; ++i)
+        map[QString::number(i)] << QString::number(i) << QString::number(i * 2);
+    QCOMPARE(map.size(), 200);
+    QCOMPARE(map.value(QStringLiteral("42")), QStringList() << "42" << "84");
+
+    for (int i = 0; i < 200; i += 2)
+        QCOMPARE(map.take(QString::number(i)).size(), 2);
+    QCOMPARE(map.size(), 100);
+    QVERIFY(!map.contains(QStringLiteral("42")));
+    QCOMPARE(map.value(QStringLiteral("43")).size(), 2);
+}
+
+void tst_QFlatMap::javaStyleIterators()
+{
+    QFlatMap<int, int> map;
+    for (int i = 0; i < 10; ++i)
+        map.insert(i, i * 10);
+
+    int sum = 0;
+    int expected = 0;
+    QFlatMapIterator<int, int> it(map);
+    while (it.hasNext()) {
+        it.next();
+        QCOMPARE(it.key(), expected++);
+        sum += it.value();
+    }
+    QCOMPARE(sum, 450);
+
+    QMutableFlatMapIterator<int, int> mit(map);
+    while (mit.hasNext()) {
+        mit.next();
+        if (mit.key() % 2)
+            mit.remove();
+        else
+            mit.setValue(mit.value() + 1);
+    }
+    QCOMPARE(map.size(), 5);
+    QCOMPARE(map.value(4), 41);
+    QVERIFY(!map.contains(5));
+}
+
+void tst_QFlatMap::initializerList()
+{
+#ifdef Q_COMPILER_INITIALIZER_LISTS
+    QFlatMap<int, QString> map = { { 3, "three" }, { 1, "one" }, { 2, "two" }, { 1, "uno" } };
+    QCOMPARE(map.size(), 3);
+    QCOMPARE(map.keys(), QList<int>() << 1 << 2 << 3);
+    QCOMPARE(map.value(1), QStringLiteral("uno"));
+    QCOMPARE(map.value(3), QStringLiteral("three"));
+#else
+    QSKIP("Compiler doesn't support initializer lists");
+#endif
+}
+
+QTEST_APPLESS_MAIN(tst_QFlatMap)
+#include "tst_qflatmap.moc"
@@ -47,6 +47,9 @@ private slots:
     void basicTest();
     void customized();
     void threadedTest();
+    void magazines();
+    void magazinesOfExitedThread();
+    void threadedMagazines();
 };
 
 void tst_QFreeList::basicTest()
@@ -164,5 +167,136 @@ void tst_QFreeList::threadedTest()
     delete [] threads;
 }
 
+template <int Tag>
+struct MagazineFreeListConstants : public QFreeListDefaultConstants
+{
+    enum {
+        MagazineSize = 4
+    };
+};
+
+void tst_QFreeList::magazines()
+{
+    static QFreeList<int, MagazineFreeListConstants<0> > freelist;
+    static QFreeList<int, MagazineFreeListConstants<0> > otherFreelist;
+
+    QSet<int> ids;
+    for (int i = 0; i < 10; ++i) {
+        const int id = freelist.next();
+        QVERIFY(!ids.contains(id));
+        freelist[id] = i;
+        ids.insert(id);
+    }
+    QCOMPARE(ids.size(), 10);
+    foreach (int id, ids)
+        QVERIFY(freelist.at(id) >= 0 && freelist.at(id) < 10);
+
+    // released ids are reused
+    foreach (int id, ids)
+        freelist.release(id);
+    QSet<int> reused;
+    for (int i = 0; i < 10; ++i)
+        reused.insert(freelist.next());
+    QCOMPARE(reused, ids);
+
+    // a second instance of the same type uses the shared list only
+    QCOMPARE(otherFreelist.next(), 0);
+    QCOMPARE(otherFreelist.next(), 1);
+    otherFreelist.release(0);
+    QCOMPARE(otherFreelist.next(), 0);
+}
+
+static QFreeList<void, MagazineFreeListConstants<1> > exitedThreadFreeList;
+static QSemaphore magazineReturned;
+
+#ifdef Q_COMPILER_THREAD_LOCAL
+// Thread-local objects are destroyed in the reverse order of their
+// construction, so this one goes after the magazine of its thread.
+struct MagazineReturnedGuard
+{
+    ~MagazineReturnedGuard() { magazineReturned.release(); }
+};
+#endif
+
+class MagazineThread : public QThread
+{
+public:
+    int ids[3];
+    void run() Q_DECL_OVERRIDE
+    {
+#ifdef Q_COMPILER_THREAD_LOCAL
+        static thread_local MagazineReturnedGuard guard;
+        Q_UNUSED(guard);
+#else
+        // without magazines, the ids go back to the shared list right away
+        magazineReturned.release();
+#endif
+        for (int i = 0; i < 3; ++i)
+            ids[i] = exitedThreadFreeList.next();
+        for (int i = 0; i < 3; ++i)
+            exitedThreadFreeList.release(ids[i]);
+    }
+};
+
+void tst_QFreeList::magazinesOfExitedThread()
+{
+    MagazineThread thread;
+    thread.start();
+    QVERIFY(thread.wait());
+    // wait() may return before the thread's thread-local data is destroyed
+    QVERIFY(magazineReturned.tryAcquire(1, 60000));
+
+    // the ids cached by the thread went back to the shared list
+    QList<int> next;
+    for (int i = 0; i < 4; ++i)
+        next << exitedThreadFreeList.next();
+    for (int i = 0; i < 3; ++i)
+        QVERIFY(next.contains(thread.ids[i]));
+}
+
+static QFreeList<void, MagazineFreeListConstants<2> > threadedFreeList;
+static QAtomicInt inUse[1024];
+static QAtomicInt duplicates;
+
+class MagazineStressThread : public QThread
+{
+public:
+    void run() Q_DECL_OVERRIDE
+    {
+        QElapsedTimer t;
+        t.start();
+        QVector<int> held;
+        int round = 0;
+        do {
+            // hold a varying number of ids, so that magazines overflow and run dry
+            const int count = 1 + (round++ % 13);
+            for (int i = 0; i < count; ++i) {
+                const int id = threadedFreeList.next();
+                if (id >= 1024 || !inUse[id].testAndSetRelaxed(0, 1))
+                    duplicates.ref();
+                held << id;
+            }
+            foreach (int id, held) {
+                if (id < 1024)
+                    inUse[id].store(0);
+                threadedFreeList.release(id);
+            }
+            held.clear();
+        } while (t.elapsed() < TimeLimit / 3);
+    }
+};
+
+void tst_QFreeList::threadedMagazines()
+{
+    const int ThreadCount = qMax(QThread::idealThreadCount(), 4);
+    MagazineStressThread *threads = new MagazineStressThread[ThreadCount];
+    for (int i = 0; i < ThreadCount; ++i)
+        threads[i].start();
+    for (int i = 0; i < ThreadCount; ++i)
+        threads[i].wait();
+    delete [] threads;
+    QCOMPARE(duplicates.load(), 0);
+}
+
 QTEST_MAIN(tst_QFreeList)
 #include "tst_qfreelist.moc"
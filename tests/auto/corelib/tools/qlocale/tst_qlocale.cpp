@@ -142,6 +142,9 @@ private slots:
     void matchingLocales();
     void double_conversion_data();
     void double_conversion();
+    void doubleToString_data();
+    void doubleToString();
+    void shortestRoundTrip();
     void long_long_conversion_data();
     void long_long_conversion();
     void long_long_conversion_extra();
@@ -821,6 +824,94 @@ void tst_QLocale::double_conversion()
     }
 }
 
+void tst_QLocale::doubleToString_data()
+{
+    QTest::addColumn<double>("num");
+    QTest::addColumn<char>("format");
+    QTest::addColumn<int>("precision");
+    QTest::addColumn<QString>("expected");
+
+    const int shortest = QLocale::FloatingPointShortest;
+
+    QTest::newRow("0.1 g shortest")    << 0.1 << 'g' << shortest << QString("0.1");
+    QTest::newRow("1/3 g shortest")    << 1.0 / 3 << 'g' << shortest << QString("0.3333333333333333");
+    QTest::newRow("100 g shortest")    << 100.0 << 'g' << shortest << QString("100");
+    QTest::newRow("2^53 g shortest")   << 9007199254740992.0 << 'g' << shortest << QString("9007199254740992");
+    QTest::newRow("1e16 g shortest")   << 1e16 << 'g' << shortest << QString("10000000000000000");
+    QTest::newRow("1e17 g shortest")   << 1e17 << 'g' << shortest << QString("1e+17");
+    QTest::newRow("1e20 g shortest")   << 1e20 << 'g' << shortest << QString("1e+20");
+    QTest::newRow("1e23 g shortest")   << 1e23 << 'g' << shortest << QString("1e+23");
+    QTest::newRow("big g shortest")    << 123456789012345678.0 << 'g' << shortest << QString("1.2345678901234568e+17");
+    QTest::newRow("0.0001 g shortest") << 0.0001 << 'g' << shortest << QString("0.0001");
+    QTest::newRow("1e-5 g shortest")   << 1e-5 << 'g' << shortest << QString("1e-05");
+    QTest::newRow("min g shortest")    << 5e-324 << 'g' << shortest << QString("5e-324");
+    QTest::newRow("max g shortest")    << 1.7976931348623157e308 << 'g' << shortest << QString("1.7976931348623157e+308");
+    QTest::newRow("-1.5 g shortest")   << -1.5 << 'g' << shortest << QString("-1.5");
+    QTest::newRow("0 g shortest")      << 0.0 << 'g' << shortest << QString("0");
+    QTest::newRow("0.1 e shortest")    << 0.1 << 'e' << shortest << QString("1e-01");
+    QTest::newRow("123.25 e shortest") << 123.25 << 'e' << shortest << QString("1.2325e+02");
+    QTest::newRow("1.5 f shortest")    << 1.5 << 'f' << shortest << QString("1.5");
+    QTest::newRow("1e21 f shortest")   << 1e21 << 'f' << shortest << QString("1000000000000000000000");
+    QTest::newRow("1e-7 f shortest")   << 1e-7 << 'f' << shortest << QString("0.0000001");
+
+    QTest::newRow("pi g 6")            << M_PI << 'g' << 6 << QString("3.14159");
+    QTest::newRow("pi f 2")            << M_PI << 'f' << 2 << QString("3.14");
+    QTest::newRow("pi e 16")           << M_PI << 'e' << 16 << QString("3.1415926535897931e+00");
+    QTest::newRow("0.1 g 17")          << 0.1 << 'g' << 17 << QString("0.10000000000000001");
+    QTest::newRow("1e23 g 17")         << 1e23 << 'g' << 17 << QString("9.9999999999999992e+22");
+    QTest::newRow("999999.5 g 6")      << 999999.5 << 'g' << 6 << QString("1e+06");
+    QTest::newRow("9.995 f 2")         << 9.995 << 'f' << 2 << QString("9.99");
+    QTest::newRow("0.5 f 0")           << 0.5 << 'f' << 0 << QString("0");
+    QTest::newRow("2.5 f 0")           << 2.5 << 'f' << 0 << QString("2");
+    QTest::newRow("0.125 f 2")         << 0.125 << 'f' << 2 << QString("0.12");
+    QTest::newRow("min e 3")           << 5e-324 << 'e' << 3 << QString("4.941e-324");
+}
+
+void tst_QLocale::doubleToString()
+{
+    QFETCH(double, num);
+    QFETCH(char, format);
+    QFETCH(int, precision);
+    QFETCH(QString, expected);
+
+    QLocale locale = QLocale::c();
+    locale.setNumberOptions(QLocale::OmitGroupSeparator);
+
+    QCOMPARE(QString::number(num, format, precision), expected);
+    QCOMPARE(locale.toString(num, format, precision), expected);
+    QCOMPARE(QByteArray::number(num, format, precision), expected.toLatin1());
+
+    bool ok;
+    const double back = locale.toDouble(expected, &ok);
+    QVERIFY(ok);
+    if (precision == QLocale::FloatingPointShortest)
+        QCOMPARE(back, num);
+}
+
+void tst_QLocale::shortestRoundTrip()
+{
+    // A simple linear congruential generator, so that the test is reproducible.
+    quint64 state = Q_UINT64_C(0x9e3779b97f4a7c15);
+    for (int i = 0; i < 100000; ++i) {
+        state = state * Q_UINT64_C(6364136223846793005) + Q_UINT64_C(1442695040888963407);
+        double d;
+        memcpy(&d, &state, sizeof(d));
+        if (!qIsFinite(d))
+            continue;
+
+        const QString shortest = QString::number(d, 'e', QLocale::FloatingPointShortest);
+        bool ok;
+        const double back = shortest.toDouble(&ok);
+        QVERIFY2(ok && back == d, qPrintable(shortest));
+
+        // No representation with fewer digits reads back the same number.
+        const int digits = shortest.indexOf(QLatin1Char('e')) - (d < 0 ? 1 : 0)
+                - (shortest.contains(QLatin1Char('.')) ? 1 : 0);
+        if (digits > 1)
+            QVERIFY2(QString::number(d, 'e', digits - 2).toDouble() != d, qPrintable(shortest));
+    }
+}
+
 void tst_QLocale::long_long_conversion_data()
 {
     QTest::addColumn<QString>("locale_name");
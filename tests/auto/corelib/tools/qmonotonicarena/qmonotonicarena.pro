@@ -0,0 +1,4 @@
+CONFIG += testcase parallel_test
+TARGET = tst_qmonotonicarena
+QT = core testlib
+SOURCES = $$PWD/tst_qmonotonicarena.cpp
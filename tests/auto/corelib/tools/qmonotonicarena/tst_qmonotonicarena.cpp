@@ -0,0 +1,255 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+
+#include <qhash.h>
+#include <qmonotonicarena.h>
+#include <qthread.h>
+#include <qvector.h>
+
+class tst_QMonotonicArena : public QObject
+{
+    Q_OBJECT
+private slots:
+    void allocate();
+    void alignment();
+    void largeAllocations();
+    void release();
+    void heapByDefault();
+    void hash();
+    void copies();
+    void destroyInOtherThread();
+    void threads();
+};
+
+void tst_QMonotonicArena::allocate()
+{
+    QMonotonicArena arena(256);
+    QCOMPARE(arena.bytesAllocated(), size_t(0));
+    QVERIFY(!arena.owns(&arena));
+
+    QVector<char *> pointers;
+    for (int i = 0; i < 1000; ++i) {
+        char *p = static_cast<char *>(arena.allocate(10, 1));
+        QVERIFY(p);
+        memset(p, i, 10);
+        pointers << p;
+    }
+    QCOMPARE(arena.bytesAllocated(), size_t(10000));
+    for (int i = 0; i < pointers.size(); ++i) {
+        QVERIFY(arena.owns(pointers.at(i)));
+        QVERIFY(arena.owns(pointers.at(i) + 9));
+        QCOMPARE(pointers.at(i)[0], char(i));
+        QCOMPARE(pointers.at(i)[9], char(i));
+    }
+
+    // allocations are consecutive within a block
+    QCOMPARE(pointers.at(1), pointers.at(0) + 10);
+
+    QMonotonicArena other;
+    QVERIFY(!other.owns(pointers.first()));
+}
+
+void tst_QMonotonicArena::alignment()
+{
+    QMonotonicArena arena;
+    for (size_t alignment = 1; alignment <= 4096; alignment *= 2) {
+        void *odd = arena.allocate(1, 1);
+        QVERIFY(odd);
+        void *p = arena.allocate(24, alignment);
+        QVERIFY(p);
+        QCOMPARE(quintptr(p) % alignment, quintptr(0));
+    }
+}
+
+void tst_QMonotonicArena::largeAllocations()
+{
+    QMonotonicArena arena;
+    char *small = static_cast<char *>(arena.allocate(16, 8));
+    char *large = static_cast<char *>(arena.allocate(4 * 1024 * 1024, 64));
+    QVERIFY(large);
+    QCOMPARE(quintptr(large) % 64, quintptr(0));
+    memset(large, 'x', 4 * 1024 * 1024);
+    QVERIFY(arena.owns(large + 4 * 1024 * 1024 - 1));
+
+    // the block of the small allocations is still in use
+    char *next = static_cast<char *>(arena.allocate(16, 8));
+    QCOMPARE(next, small + 16);
+    QCOMPARE(arena.bytesAllocated(), size_t(4 * 1024 * 1024 + 32));
+}
+
+void tst_QMonotonicArena::release()
+{
+    QMonotonicArena arena(1024);
+    void *first = arena.allocate(100, 8);
+    for (int i = 0; i < 100; ++i)
+        QVERIFY(arena.allocate(100, 8));
+    void *large = arena.allocate(2 * 1024 * 1024, 8);
+    QVERIFY(arena.owns(first));
+    QVERIFY(arena.owns(large));
+
+    arena.release();
+    QCOMPARE(arena.bytesAllocated(), size_t(0));
+    QVERIFY(!arena.owns(first));
+    QVERIFY(!arena.owns(large));
+
+    // the current block is reused
+    void *p = arena.allocate(100, 8);
+    QVERIFY(p);
+    QVERIFY(arena.owns(p));
+    QCOMPARE(arena.bytesAllocated(), size_t(100));
+
+    // releasing an arena that only has large blocks
+    QMonotonicArena largeOnly;
+    QVERIFY(largeOnly.allocate(2 * 1024 * 1024, 8));
+    largeOnly.release();
+    QVERIFY(largeOnly.allocate(10, 8));
+}
+
+void tst_QMonotonicArena::heapByDefault()
+{
+    QMonotonicArena arena;
+    QString s(100, QLatin1Char('a'));
+    QVector<int> v(100);
+    QHash<int, int> h;
+    h.insert(1, 1);
+    QVERIFY(!arena.owns(s.constData()));
+    QVERIFY(!arena.owns(v.constData()));
+    QVERIFY(!arena.owns(&*h.constBegin()));
+    QCOMPARE(arena.bytesAllocated(), size_t(0));
+}
+
+void tst_QMonotonicArena::hash()
+{
+    QMonotonicArena arena;
+    QHash<int, QString> hash = arena.createHash<int, QString>(100);
+    QVERIFY(hash.capacity() >= 100);
+    const size_t before = arena.bytesAllocated();
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(i, QString::number(i));
+    QVERIFY(arena.bytesAllocated() >= before + 1000 * sizeof(int));
+    QVERIFY(arena.owns(&hash.find(500).value()));
+    QVERIFY(!arena.owns(hash.value(500).constData())); // the strings are on the heap
+    for (int i = 0; i < 1000; i += 2)
+        hash.remove(i);
+    QCOMPARE(hash.size(), 500);
+    QCOMPARE(hash.value(999), QStringLiteral("999"));
+    QVERIFY(!hash.contains(998));
+    hash.squeeze();
+    QCOMPARE(hash.value(501), QStringLiteral("501"));
+}
+
+void tst_QMonotonicArena::copies()
+{
+    QMonotonicArena arena;
+    QHash<int, int> hash = arena.createHash<int, int>();
+    hash.insert(1, 1);
+    QHash<int, int> hashCopy = hash;
+    const size_t before = arena.bytesAllocated();
+    hashCopy.insert(2, 2);
+    QCOMPARE(arena.bytesAllocated(), before);
+    QCOMPARE(hash.size(), 1);
+    QCOMPARE(hashCopy.size(), 2);
+    QVERIFY(!arena.owns(&*hashCopy.constBegin()));
+
+    // the copy outlives the arena
+    hash.clear();
+    arena.release();
+    QCOMPARE(hashCopy.value(1), 1);
+    QCOMPARE(hashCopy.value(2), 2);
+}
+
+class DestroyThread : public QThread
+{
+public:
+    QHash<QString, int> hash;
+    void run() Q_DECL_OVERRIDE
+    {
+        hash = QHash<QString, int>();
+    }
+};
+
+void tst_QMonotonicArena::destroyInOtherThread()
+{
+    QMonotonicArena arena;
+    DestroyThread thread;
+    thread.hash = arena.createHash<QString, int>();
+    thread.hash.insert(QStringLiteral("abc"), 1);
+    thread.hash.insert(QStringLiteral("def"), 2);
+    thread.start();
+    QVERIFY(thread.wait(60000));
+    QVERIFY(thread.hash.isEmpty());
+}
+
+class ArenaThread : public QThread
+{
+public:
+    bool ok;
+    void run() Q_DECL_OVERRIDE
+    {
+        ok = true;
+        QMonotonicArena arena;
+        for (int round = 0; round < 50; ++round) {
+            {
+                QHash<QString, int> hash = arena.createHash<QString, int>(200);
+                for (int i = 0; i < 200; ++i)
+                    hash.insert(QString::number(i), i);
+                ok = ok && hash.size() == 200 && hash.value(QStringLiteral("42")) == 42;
+                ok = ok && arena.owns(&hash.find(QStringLiteral("7")).value());
+            }
+            arena.release();
+        }
+    }
+};
+
+void tst_QMonotonicArena::threads()
+{
+    ArenaThread threads[4];
+    for (int i = 0; i < 4; ++i)
+        threads[i].start();
+
+    // this thread allocates from the heap meanwhile
+    QStringList list;
+    for (int i = 0; i < 10000; ++i)
+        list << QString::number(i);
+
+    for (int i = 0; i < 4; ++i) {
+        QVERIFY(threads[i].wait(60000));
+        QVERIFY(threads[i].ok);
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_QMonotonicArena)
+#include "tst_qmonotonicarena.moc"
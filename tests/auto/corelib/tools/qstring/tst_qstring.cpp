@@ -565,6 +565,7 @@ private slots:
     void repeated() const;
     void repeated_data() const;
     void compareRef();
+    void kernelsAtAllLengths();
     void arg_locale();
 #ifdef QT_USE_ICU
     void toUpperLower_icu();
@@ -6219,6 +6220,58 @@ void tst_QString::compareRef()
     QVERIFY(QStringRef(&a2, 1, 2).compare(QStringRef(&a, 1, 3), Qt::CaseInsensitive) < 0);
 }
 
+// Checks the vectorized kernels at every length and position, so that each
+// of the full-vector, overlapping and masked tail paths is taken
+void tst_QString::kernelsAtAllLengths()
+{
+    for (int len = 0; len < 100; ++len) {
+        QString lower;
+        for (int i = 0; i < len; ++i)
+            lower += QLatin1Char('a' + i % 26);
+        const QString upper = lower.toUpper();
+        const QByteArray latin1 = lower.toLatin1();
+
+        QCOMPARE(QString::fromLatin1(latin1), lower);
+        QCOMPARE(lower.compare(upper, Qt::CaseInsensitive), 0);
+        QCOMPARE(lower.compare(QLatin1String(latin1)), 0);
+
+        for (int pos = 0; pos < len; ++pos) {
+            QString changed = lower;
+            changed[pos] = QLatin1Char('#');
+            QVERIFY2(lower.compare(changed) > 0, qPrintable(changed));
+            QVERIFY2(changed.compare(lower) < 0, qPrintable(changed));
+            QVERIFY2(changed.compare(QLatin1String(latin1)) < 0, qPrintable(changed));
+            QVERIFY2(upper.compare(changed, Qt::CaseInsensitive) > 0, qPrintable(changed));
+            QCOMPARE(changed.indexOf(QLatin1Char('#')), pos);
+            QCOMPARE(changed.indexOf(QLatin1Char('#'), pos), pos);
+            QCOMPARE(changed.indexOf(QLatin1Char('#'), pos + 1), -1);
+
+            // non-Latin 1 characters become question marks
+            changed[pos] = QChar(0x20ac);
+            QByteArray expected = latin1;
+            expected[pos] = '?';
+            QCOMPARE(changed.toLatin1(), expected);
+            // a temporary is converted in place
+            QCOMPARE(QString(changed.constData(), changed.size()).toLatin1(), expected);
+
+            // non-ASCII characters are case folded too
+            changed[pos] = QChar(0xc4);
+            QString changedUpper = upper;
+            changedUpper[pos] = QChar(0xe4);
+            QCOMPARE(changed.compare(changedUpper, Qt::CaseInsensitive), 0);
+
+            for (int needleLen = 2; needleLen <= 17 && pos + needleLen <= len; needleLen += 15) {
+                QString haystack = lower;
+                const QString needle = QString(needleLen, QLatin1Char('#'));
+                haystack.replace(pos, needleLen, needle);
+                QCOMPARE(haystack.indexOf(needle), pos);
+                QCOMPARE(haystack.indexOf(needle, pos), pos);
+                QCOMPARE(haystack.indexOf(needle, pos + 1), -1);
+            }
+        }
+    }
+}
+
 void tst_QString::arg_locale()
 {
     QLocale l(QLocale::English, QLocale::UnitedKingdom);
@@ -0,0 +1,4 @@
+CONFIG += testcase parallel_test
+TARGET = tst_qstringrope
+QT = core testlib
+SOURCES = $$PWD/tst_qstringrope.cpp
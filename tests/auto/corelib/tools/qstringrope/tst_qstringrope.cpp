@@ -0,0 +1,432 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+
+#include <qbuffer.h>
+#include <qstringrope.h>
+#include <qtextstream.h>
+
+class tst_QStringRope : public QObject
+{
+    Q_OBJECT
+private slots:
+    void empty();
+    void append();
+    void appendSharesLongStrings();
+    void appendRope();
+    void insert();
+    void remove();
+    void mid();
+    void at();
+    void randomEdits();
+    void implicitSharing();
+    void equality();
+    void toLatin1AndUtf8();
+    void splitSurrogatePair();
+    void textStream();
+    void ioDeviceWrite();
+};
+
+static QString longString(int n, char c)
+{
+    return QString(n, QLatin1Char(c));
+}
+
+void tst_QStringRope::empty()
+{
+    QStringRope rope;
+    QVERIFY(rope.isEmpty());
+    QCOMPARE(rope.size(), 0);
+    QCOMPARE(rope.chunkCount(), 0);
+    QVERIFY(rope.toString().isNull());
+    QVERIFY(rope.toUtf8().isEmpty());
+
+    rope.append(QString());
+    rope.append(QLatin1String(""));
+    rope.append(QStringRef());
+    QVERIFY(rope.isEmpty());
+    QCOMPARE(rope.chunkCount(), 0);
+    QCOMPARE(rope, QStringRope());
+}
+
+void tst_QStringRope::append()
+{
+    QStringRope rope;
+    QString expected;
+    for (int i = 0; i < 10000; ++i) {
+        const QString number = QString::number(i);
+        switch (i % 4) {
+        case 0:
+            rope.append(number);
+            break;
+        case 1:
+            rope += QLatin1String("abc");
+            expected += QLatin1String("abc");
+            continue;
+        case 2:
+            rope += QChar(0x20ac);
+            expected += QChar(0x20ac);
+            continue;
+        case 3:
+            rope.append(number.constData(), number.size());
+            break;
+        }
+        expected += number;
+    }
+
+    QCOMPARE(rope.size(), expected.size());
+    QCOMPARE(rope.toString(), expected);
+    // small appends go into growing chunks instead of one piece each
+    QVERIFY(rope.chunkCount() < 20);
+
+    int total = 0;
+    for (int i = 0; i < rope.chunkCount(); ++i) {
+        QVERIFY(!rope.chunk(i).isEmpty());
+        QCOMPARE(rope.chunk(i).toString(), expected.mid(total, rope.chunk(i).size()));
+        total += rope.chunk(i).size();
+    }
+    QCOMPARE(total, expected.size());
+}
+
+void tst_QStringRope::appendSharesLongStrings()
+{
+    const QString big = longString(5000, 'x');
+    QStringRope rope;
+    rope += QLatin1String("head");
+    rope += big;
+    rope += QLatin1String("tail");
+    bool shared = false;
+    for (int i = 0; i < rope.chunkCount(); ++i)
+        shared = shared || rope.chunk(i).constData() == big.constData();
+    QVERIFY(shared);
+
+    const QStringRef ref = big.midRef(1000, 2000);
+    rope += ref;
+    QCOMPARE(rope.chunkCount(), 4);
+    QCOMPARE(rope.chunk(3).constData(), ref.constData());
+
+    QCOMPARE(rope.toString(), QLatin1String("head") + big + QLatin1String("tail") + ref.toString());
+
+    // a rope made of one complete string gives back that string
+    const QStringRope single(big);
+    QCOMPARE(single.toString().constData(), big.constData());
+}
+
+void tst_QStringRope::appendRope()
+{
+    QStringRope a(QLatin1String("abc"));
+    QStringRope b(longString(2000, 'b'));
+    a += b;
+    a += a;
+    QCOMPARE(a.toString(), QString(QLatin1String("abc") + longString(2000, 'b')).repeated(2));
+
+    QStringRope c;
+    c += QStringRope(QLatin1String("x"));
+    c += QStringRope(QLatin1String("y"));
+    QCOMPARE(c.chunkCount(), 1);
+    QCOMPARE(c.toString(), QString("xy"));
+}
+
+void tst_QStringRope::insert()
+{
+    QStringRope rope(QLatin1String("Hello world"));
+    rope.insert(5, QString(","));
+    QCOMPARE(rope.toString(), QString("Hello, world"));
+    rope.prepend(QString(">> "));
+    rope.insert(rope.size(), QString("!"));
+    QCOMPARE(rope.toString(), QString(">> Hello, world!"));
+
+    // a long insertion splits the chunk and shares the string
+    const QString big = longString(3000, '-');
+    rope.insert(3, big);
+    QCOMPARE(rope.toString(), QString(">> " + big + "Hello, world!"));
+    bool shared = false;
+    for (int i = 0; i < rope.chunkCount(); ++i)
+        shared = shared || rope.chunk(i).constData() == big.constData();
+    QVERIFY(shared);
+
+    QStringRope other(QLatin1String("<>"));
+    rope.insert(1, other);
+    rope.insert(rope.size(), other);
+    rope.insert(0, rope);
+    const QString once = ">" + QString("<>") + "> " + big + "Hello, world!<>";
+    QCOMPARE(rope.toString(), once + once);
+}
+
+void tst_QStringRope::remove()
+{
+    QStringRope rope(QLatin1String("0123456789"));
+    rope += longString(2000, 'a');
+    rope += QLatin1String("xyz");
+
+    QString expected = rope.toString();
+    rope.remove(2, 3);
+    expected.remove(2, 3);
+    QCOMPARE(rope.toString(), expected);
+
+    rope.remove(5, 1500);
+    expected.remove(5, 1500);
+    QCOMPARE(rope.toString(), expected);
+
+    rope.remove(-1, 5);
+    rope.remove(rope.size(), 5);
+    rope.remove(0, 0);
+    QCOMPARE(rope.toString(), expected);
+
+    rope.remove(rope.size() - 2, 100);
+    expected.chop(2);
+    QCOMPARE(rope.toString(), expected);
+
+    rope.remove(0, rope.size());
+    QVERIFY(rope.isEmpty());
+    QCOMPARE(rope.chunkCount(), 0);
+}
+
+void tst_QStringRope::mid()
+{
+    QStringRope rope;
+    rope += QLatin1String("abc");
+    rope += longString(2000, 'd');
+    rope += QLatin1String("efg");
+    const QString flat = rope.toString();
+
+    QCOMPARE(rope.mid(0).toString(), flat);
+    QCOMPARE(rope.mid(1, 3).toString(), flat.mid(1, 3));
+    QCOMPARE(rope.mid(2, 2000).toString(), flat.mid(2, 2000));
+    QCOMPARE(rope.mid(1990).toString(), flat.mid(1990));
+    QCOMPARE(rope.mid(-5, 10).toString(), flat.mid(-5, 10));
+    QVERIFY(rope.mid(flat.size()).isEmpty());
+    QVERIFY(rope.mid(flat.size() + 10).isEmpty());
+    QCOMPARE(rope.left(5).toString(), flat.left(5));
+    QCOMPARE(rope.right(5).toString(), flat.right(5));
+    QCOMPARE(rope.right(100000).toString(), flat);
+    QVERIFY(rope.right(0).isEmpty());
+
+    // slices share the characters of the rope
+    const QStringRope slice = rope.mid(10, 100);
+    QCOMPARE(slice.chunkCount(), 1);
+    QCOMPARE(slice.chunk(0).constData(), rope.chunk(1).constData() + 7);
+}
+
+void tst_QStringRope::at()
+{
+    QStringRope rope;
+    QString expected;
+    for (int i = 0; i < 50; ++i) {
+        const QString part = i % 5 ? QString::number(i) : longString(1100 + i, 'a' + i % 26);
+        rope += part;
+        expected += part;
+    }
+    QCOMPARE(rope.size(), expected.size());
+    for (int i = 0; i < expected.size(); ++i) {
+        if (rope.at(i) != expected.at(i))
+            QFAIL(qPrintable(QString("mismatch at %1").arg(i)));
+    }
+    QCOMPARE(rope[0], expected.at(0));
+    QCOMPARE(rope[expected.size() - 1], expected.at(expected.size() - 1));
+}
+
+void tst_QStringRope::randomEdits()
+{
+    // A simple linear congruential generator, so that the test is reproducible.
+    quint32 state = 12345;
+    QStringRope rope;
+    QString expected;
+    for (int step = 0; step < 2000; ++step) {
+        state = state * 1103515245 + 12345;
+        const int r = int(state >> 8);
+        const int position = expected.isEmpty() ? 0 : r % (expected.size() + 1);
+        const QString text = (r & 0x40) ? longString(1000 + r % 500, 'A' + r % 26)
+                                        : QString::number(r % 1000);
+        switch (r % 5) {
+        case 0:
+        case 1:
+            rope.append(text);
+            expected.append(text);
+            break;
+        case 2:
+            rope.insert(position, text);
+            expected.insert(position, text);
+            break;
+        case 3:
+            rope.remove(position, r % 700);
+            expected.remove(position, r % 700);
+            break;
+        case 4:
+            rope = rope.mid(r % 10, expected.size() - r % 20);
+            expected = expected.mid(r % 10, expected.size() - r % 20);
+            break;
+        }
+        QCOMPARE(rope.size(), expected.size());
+    }
+    QCOMPARE(rope.toString(), expected);
+}
+
+void tst_QStringRope::implicitSharing()
+{
+    QStringRope a(QLatin1String("abc"));
+    QStringRope b = a;
+    b += QLatin1String("def");
+    a += QLatin1String("xyz");
+    QCOMPARE(a.toString(), QString("abcxyz"));
+    QCOMPARE(b.toString(), QString("abcdef"));
+
+    QStringRope c = a;
+    c.insert(1, QString("-"));
+    c.remove(4, 1);
+    QCOMPARE(a.toString(), QString("abcxyz"));
+    QCOMPARE(c.toString(), QString("a-bcyz"));
+
+    QString source(QLatin1String("short"));
+    QStringRope d(source);
+    source[0] = QLatin1Char('S');
+    QCOMPARE(d.toString(), QString("short"));
+}
+
+void tst_QStringRope::equality()
+{
+    QStringRope a;
+    a += longString(1500, 'a');
+    a += QLatin1String("bcd");
+
+    QStringRope b;
+    b += QLatin1String("aa");
+    b += longString(1498, 'a');
+    b += QLatin1String("b");
+    b += QLatin1String("cd");
+
+    QVERIFY(a == b);
+    QVERIFY(!(a != b));
+    QVERIFY(a.chunkCount() != b.chunkCount());
+
+    b += QLatin1Char('e');
+    QVERIFY(a != b);
+    a += QLatin1Char('f');
+    QVERIFY(a != b);
+}
+
+void tst_QStringRope::toLatin1AndUtf8()
+{
+    QStringRope rope;
+    rope += QLatin1String("gr\xfc\xdf");
+    rope += longString(1200, 'z');
+    rope += QChar(0x20ac);
+    const QString flat = rope.toString();
+    QCOMPARE(rope.toLatin1(), flat.toLatin1());
+    QCOMPARE(rope.toUtf8(), flat.toUtf8());
+}
+
+void tst_QStringRope::splitSurrogatePair()
+{
+    // U+1F600 split across two chunks
+    const QChar high(0xd83d);
+    const QChar low(0xde00);
+    QStringRope rope;
+    rope += longString(1500, 'a') + high;
+    rope += QString(low) + longString(1500, 'b');
+    QCOMPARE(rope.chunkCount(), 2);
+    QCOMPARE(rope.toUtf8(), rope.toString().toUtf8());
+    QVERIFY(rope.toUtf8().contains("a\xf0\x9f\x98\x80" "b"));
+
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    QCOMPARE(buffer.write(rope), qint64(rope.toUtf8().size()));
+    QCOMPARE(buffer.data(), rope.toUtf8());
+
+    // a lone high surrogate at the end
+    rope += high;
+    QCOMPARE(rope.toUtf8(), rope.toString().toUtf8());
+}
+
+void tst_QStringRope::textStream()
+{
+    QStringRope rope;
+    for (int i = 0; i < 1000; ++i) {
+        rope += QLatin1String("line ");
+        rope += QString::number(i);
+        rope += QLatin1Char('\n');
+    }
+    rope += longString(70000, 'x');
+
+    QString out;
+    {
+        QTextStream stream(&out);
+        stream << rope;
+    }
+    QCOMPARE(out, rope.toString());
+
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    {
+        QTextStream stream(&buffer);
+        stream.setCodec("UTF-8");
+        stream << rope << QStringRope(QLatin1String("end"));
+    }
+    QCOMPARE(buffer.data(), rope.toUtf8() + "end");
+
+    // padding to the field width
+    out.clear();
+    {
+        QTextStream stream(&out);
+        stream.setFieldWidth(6);
+        stream << QStringRope(QLatin1String("abc"));
+    }
+    QCOMPARE(out, QString("   abc"));
+}
+
+void tst_QStringRope::ioDeviceWrite()
+{
+    QStringRope rope;
+    for (int i = 0; i < 50000; ++i) {
+        rope += QString::number(i);
+        rope += QChar(i % 2 ? 0xe9 : 0x4e2d);
+    }
+    const QByteArray expected = rope.toString().toUtf8();
+
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    QCOMPARE(buffer.write(rope), qint64(expected.size()));
+    QCOMPARE(buffer.data(), expected);
+
+    QCOMPARE(buffer.write(QStringRope()), qint64(0));
+
+    QBuffer readOnly;
+    QVERIFY(readOnly.open(QIODevice::ReadOnly));
+    QTest::ignoreMessage(QtWarningMsg, "QIODevice::write (QBuffer): ReadOnly device");
+    QCOMPARE(readOnly.write(rope), qint64(-1));
+}
+
+QTEST_APPLESS_MAIN(tst_QStringRope)
+#include "tst_qstringrope.moc"
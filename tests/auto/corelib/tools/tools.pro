@@ -20,6 +20,8 @@ SUBDIRS=\
     qeasingcurve \
     qelapsedtimer \
     qexplicitlyshareddatapointer \
+    qflathash \
+    qflatmap \
     qfreelist \
     qhash \
     qhash_strictiterators \
@@ -33,6 +35,7 @@ SUBDIRS=\
     qmap_strictiterators \
     qmargins \
     qmessageauthenticationcode \
+    qmonotonicarena \
     qpair \
     qpoint \
     qpointf \
@@ -55,6 +58,7 @@ SUBDIRS=\
     qstringlist \
     qstringmatcher \
     qstringref \
+    qstringrope \
     qtextboundaryfinder \
     qtime \
     qtimezone \
@@ -0,0 +1,4 @@
+TEMPLATE = app
+TARGET = tst_bench_qtconcurrentmap
+QT = core concurrent testlib
+SOURCES += tst_qtconcurrentmap.cpp
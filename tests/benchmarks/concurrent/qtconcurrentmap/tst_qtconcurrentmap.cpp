@@ -0,0 +1,106 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtConcurrent/QtConcurrent>
+#include <QtTest/QtTest>
+
+// Measures how mappedReduced() scales with the number of pool threads for
+// the sequential reduce options and for ParallelReduce. The map and reduce
+// functions are cheap, so the sequential variants are bound by the reduction.
+
+enum {
+    ItemCount = 1000000
+};
+
+static qint64 widen(const int &value)
+{
+    return value;
+}
+
+static void sum(qint64 &result, const qint64 &value)
+{
+    result += value;
+}
+
+class tst_QtConcurrentMap : public QObject
+{
+    Q_OBJECT
+private slots:
+    void reduceScaling_data();
+    void reduceScaling();
+};
+
+void tst_QtConcurrentMap::reduceScaling_data()
+{
+    QTest::addColumn<int>("options");
+    QTest::addColumn<int>("threadCount");
+
+    static const int counts[] = { 1, 2, 4, 8, 16, 32 };
+    for (size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); ++i) {
+        const QByteArray suffix = ", " + QByteArray::number(counts[i]) + " threads";
+        QTest::newRow(("unordered" + suffix).constData())
+                << int(QtConcurrent::UnorderedReduce | QtConcurrent::SequentialReduce) << counts[i];
+        QTest::newRow(("ordered" + suffix).constData())
+                << int(QtConcurrent::OrderedReduce | QtConcurrent::SequentialReduce) << counts[i];
+        QTest::newRow(("parallel" + suffix).constData())
+                << int(QtConcurrent::ParallelReduce) << counts[i];
+    }
+}
+
+void tst_QtConcurrentMap::reduceScaling()
+{
+    QFETCH(int, options);
+    QFETCH(int, threadCount);
+
+    QVector<int> items(ItemCount);
+    for (int i = 0; i < ItemCount; ++i)
+        items[i] = i;
+
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int oldThreadCount = pool->maxThreadCount();
+    pool->setMaxThreadCount(threadCount);
+
+    qint64 result = 0;
+    QBENCHMARK {
+        result = QtConcurrent::blockingMappedReduced(items, widen, sum,
+                                                     QtConcurrent::ReduceOptions(options));
+    }
+    QCOMPARE(result, qint64(ItemCount - 1) * ItemCount / 2);
+
+    pool->setMaxThreadCount(oldThreadCount);
+}
+
+QTEST_MAIN(tst_QtConcurrentMap)
+
+#include "tst_qtconcurrentmap.moc"
@@ -1,3 +1,5 @@
 TEMPLATE = subdirs
-SUBDIRS = qtextcodec
+SUBDIRS = \
+        qtextcodec \
+        qutf8
 	
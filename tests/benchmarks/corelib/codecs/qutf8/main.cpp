@@ -0,0 +1,162 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <QTextCodec>
+#include <QTextDecoder>
+#include <QTextEncoder>
+#include <QSharedPointer>
+#include <qtest.h>
+
+// each sample is repeated to make about 64 kB of UTF-8
+static const int DataSize = 64 * 1024;
+
+static const struct Sample {
+    const char name[16];
+    const char *text;
+} samples[] = {
+    { "ascii", "The quick brown fox jumps over the lazy dog. " },
+    { "latin", "Gr\xc3\xb6\xc3\x9f" "enordnung f\xc3\xbcr \xc3\x9c" "berg\xc3\xa4nge, caf\xc3\xa9 \xc3\xa0 la cr\xc3\xa8me br\xc3\xbbl\xc3\xa9" "e. " },
+    { "cyrillic", "\xd0\xa1\xd1\x8a\xd0\xb5\xd1\x88\xd1\x8c \xd0\xb6\xd0\xb5 \xd0\xb5\xd1\x89\xd1\x91 \xd1\x8d\xd1\x82\xd0\xb8\xd1\x85 \xd0\xbc\xd1\x8f\xd0\xb3\xd0\xba\xd0\xb8\xd1\x85 \xd1\x84\xd1\x80\xd0\xb0\xd0\xbd\xd1\x86\xd1\x83\xd0\xb7\xd1\x81\xd0\xba\xd0\xb8\xd1\x85 \xd0\xb1\xd1\x83\xd0\xbb\xd0\xbe\xd0\xba, \xd0\xb4\xd0\xb0 \xd0\xb2\xd1\x8b\xd0\xbf\xd0\xb5\xd0\xb9 \xd1\x87\xd0\xb0\xd1\x8e. " },
+    { "greek", "\xce\x9e\xce\xb5\xcf\x83\xce\xba\xce\xb5\xcf\x80\xce\xac\xce\xb6\xcf\x89 \xcf\x84\xce\xb7\xce\xbd \xcf\x88\xcf\x85\xcf\x87\xce\xbf\xcf\x86\xce\xb8\xcf\x8c\xcf\x81\xce\xb1 \xce\xb2\xce\xb4\xce\xb5\xce\xbb\xcf\x85\xce\xb3\xce\xbc\xce\xaf\xce\xb1. " },
+    { "cjk", "\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e\xe3\x81\xae\xe6\x96\x87\xe7\xab\xa0\xe3\x81\xa8\xe4\xb8\xad\xe6\x96\x87\xe7\x9a\x84\xe5\x8f\xa5\xe5\xad\x90\xe3\x80\x81\xed\x95\x9c\xea\xb5\xad\xec\x96\xb4 \xeb\xac\xb8\xec\x9e\xa5\xeb\x8f\x84 \xec\x9e\x88\xec\x8a\xb5\xeb\x8b\x88\xeb\x8b\xa4\xe3\x80\x82" },
+    { "emoji", "smile \xf0\x9f\x98\x80 and party \xf0\x9f\x8e\x89 or launch \xf0\x9f\x9a\x80 now " },
+    { "invalid", "caf\xc3\xa9 \xff with \xc3( broken \xed\xa0\x80 bytes \xe2\x82 " }
+};
+
+class tst_QUtf8 : public QObject
+{
+    Q_OBJECT
+private slots:
+    void fromUtf8_data();
+    void fromUtf8();
+    void toUtf8_data();
+    void toUtf8();
+    void decoder_data();
+    void decoder();
+    void encoder_data();
+    void encoder();
+};
+
+static QByteArray repeated(const char *text)
+{
+    QByteArray result;
+    result.reserve(DataSize + int(qstrlen(text)));
+    while (result.size() < DataSize)
+        result += text;
+    return result;
+}
+
+void tst_QUtf8::fromUtf8_data()
+{
+    QTest::addColumn<QByteArray>("utf8");
+    for (uint i = 0; i < sizeof(samples) / sizeof(samples[0]); ++i)
+        QTest::newRow(samples[i].name) << repeated(samples[i].text);
+}
+
+void tst_QUtf8::fromUtf8()
+{
+    QFETCH(QByteArray, utf8);
+
+    QBENCHMARK {
+        QString s = QString::fromUtf8(utf8);
+        Q_UNUSED(s);
+    }
+}
+
+void tst_QUtf8::toUtf8_data()
+{
+    fromUtf8_data();
+}
+
+void tst_QUtf8::toUtf8()
+{
+    QFETCH(QByteArray, utf8);
+    const QString utf16 = QString::fromUtf8(utf8);
+
+    QBENCHMARK {
+        QByteArray ba = utf16.toUtf8();
+        Q_UNUSED(ba);
+    }
+}
+
+void tst_QUtf8::decoder_data()
+{
+    QTest::addColumn<QByteArray>("utf8");
+    QTest::addColumn<int>("chunkSize");
+
+    // odd chunk sizes split multi-byte sequences between calls
+    for (uint i = 0; i < sizeof(samples) / sizeof(samples[0]); ++i) {
+        const QByteArray utf8 = repeated(samples[i].text);
+        QTest::newRow(QByteArray(samples[i].name) + "-4096") << utf8 << 4096;
+        QTest::newRow(QByteArray(samples[i].name) + "-257") << utf8 << 257;
+    }
+}
+
+void tst_QUtf8::decoder()
+{
+    QFETCH(QByteArray, utf8);
+    QFETCH(int, chunkSize);
+    QTextCodec *codec = QTextCodec::codecForMib(106);
+
+    QBENCHMARK {
+        QSharedPointer<QTextDecoder> decoder(codec->makeDecoder());
+        for (int i = 0; i < utf8.size(); i += chunkSize) {
+            QString s = decoder->toUnicode(utf8.constData() + i, qMin(chunkSize, utf8.size() - i));
+            Q_UNUSED(s);
+        }
+    }
+}
+
+void tst_QUtf8::encoder_data()
+{
+    decoder_data();
+}
+
+void tst_QUtf8::encoder()
+{
+    QFETCH(QByteArray, utf8);
+    QFETCH(int, chunkSize);
+    const QString utf16 = QString::fromUtf8(utf8);
+    QTextCodec *codec = QTextCodec::codecForMib(106);
+
+    QBENCHMARK {
+        QSharedPointer<QTextEncoder> encoder(codec->makeEncoder());
+        for (int i = 0; i < utf16.size(); i += chunkSize) {
+            QByteArray ba = encoder->fromUnicode(utf16.constData() + i, qMin(chunkSize, utf16.size() - i));
+            Q_UNUSED(ba);
+        }
+    }
+}
+
+QTEST_MAIN(tst_QUtf8)
+
+#include "main.moc"
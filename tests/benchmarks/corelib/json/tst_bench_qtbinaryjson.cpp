@@ -34,6 +34,7 @@
 #include <QtTest>
 #include <qjsondocument.h>
 #include <qjsonobject.h>
+#include <qjsonarray.h>
 
 class BenchmarkQtBinaryJson: public QObject
 {
@@ -50,6 +51,8 @@ private Q_SLOTS:
     void parseNumbers();
     void parseJson();
     void parseJsonToVariant();
+    void parseThroughput_data();
+    void parseThroughput();
 
     void toByteArray();
     void fromByteArray();
@@ -125,6 +128,47 @@ void BenchmarkQtBinaryJson::parseJsonToVariant()
     }
 }
 
+// builds an array of count objects, each with a few string members of the given form
+static QByteArray generateDocument(int count, const QByteArray &string, bool indented)
+{
+    QJsonArray array;
+    for (int i = 0; i < count; ++i) {
+        QJsonObject object;
+        object.insert(QStringLiteral("id"), i);
+        object.insert(QStringLiteral("name"), QString::fromUtf8(string));
+        object.insert(QStringLiteral("description"), QString::fromUtf8(string + string));
+        object.insert(QStringLiteral("tags"), QJsonArray() << QString::fromUtf8(string) << true << 1.5);
+        array.append(object);
+    }
+    return QJsonDocument(array).toJson(indented ? QJsonDocument::Indented : QJsonDocument::Compact);
+}
+
+void BenchmarkQtBinaryJson::parseThroughput_data()
+{
+    QTest::addColumn<QByteArray>("json");
+
+    const QByteArray shortString("short");
+    const QByteArray longString(200, 'x');
+    const QByteArray escapedString = QByteArray("line\tone\nline \"two\"\n").repeated(8);
+    const QByteArray unicodeString = QByteArray("gr\xc3\xbc\xc3\x9f \xd0\x9f\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82 ").repeated(8);
+
+    QTest::newRow("compact-short-strings") << generateDocument(1000, shortString, false);
+    QTest::newRow("indented-short-strings") << generateDocument(1000, shortString, true);
+    QTest::newRow("long-strings") << generateDocument(1000, longString, false);
+    QTest::newRow("escaped-strings") << generateDocument(1000, escapedString, false);
+    QTest::newRow("unicode-strings") << generateDocument(1000, unicodeString, false);
+}
+
+void BenchmarkQtBinaryJson::parseThroughput()
+{
+    QFETCH(QByteArray, json);
+
+    QBENCHMARK {
+        QJsonDocument doc = QJsonDocument::fromJson(json);
+        Q_UNUSED(doc);
+    }
+}
+
 void BenchmarkQtBinaryJson::toByteArray()
 {
     // Example: send information over a datastream to another process
@@ -1,9 +1,11 @@
 TEMPLATE = subdirs
 SUBDIRS = \
         events \
+        qeventdispatcher \
         qmetaobject \
         qmetatype \
         qobject \
+        qtimer \
         qvariant \
         qcoreapplication
 
@@ -40,6 +40,68 @@ Q_OBJECT
 private slots:
     void event_posting_benchmark_data();
     void event_posting_benchmark();
+    void queued_signal_throughput_data();
+    void queued_signal_throughput();
+    void queued_signal_arguments();
+};
+
+class ArgumentSender : public QObject
+{
+    Q_OBJECT
+public:
+    void send(int i, const QString &s, double d) { emit ping(i, s, d); }
+
+signals:
+    void ping(int, const QString &, double);
+};
+
+class ArgumentReceiver : public QObject
+{
+    Q_OBJECT
+public:
+    ArgumentReceiver() : received(0) {}
+    int received;
+
+public slots:
+    void pong(int, const QString &, double) { ++received; }
+};
+
+class QueuedSender : public QThread
+{
+    Q_OBJECT
+public:
+    explicit QueuedSender(int count) : count(count) {}
+
+signals:
+    void ping();
+
+protected:
+    void run() Q_DECL_OVERRIDE
+    {
+        for (int i = 0; i < count; ++i)
+            emit ping();
+    }
+
+private:
+    int count;
+};
+
+class QueuedReceiver : public QObject
+{
+    Q_OBJECT
+public:
+    explicit QueuedReceiver(int expected) : received(0), expected(expected) {}
+
+public slots:
+    void pong()
+    {
+        if (++received == expected)
+            QCoreApplication::exit();
+    }
+
+private:
+    int received;
+    int expected;
 };
 
 void QCoreApplicationBenchmark::event_posting_benchmark_data()
@@ -69,6 +131,62 @@ void QCoreApplicationBenchmark::event_posting_benchmark()
     }
 }
 
+void QCoreApplicationBenchmark::queued_signal_throughput_data()
+{
+    QTest::addColumn<int>("threadCount");
+    QTest::addColumn<int>("connectionType");
+    QTest::newRow("queued, 1 thread") << 1 << int(Qt::QueuedConnection);
+    QTest::newRow("queued, 2 threads") << 2 << int(Qt::QueuedConnection);
+    QTest::newRow("queued, 4 threads") << 4 << int(Qt::QueuedConnection);
+    QTest::newRow("queued, 8 threads") << 8 << int(Qt::QueuedConnection);
+    QTest::newRow("batched, 1 thread") << 1 << int(Qt::BatchedConnection);
+    QTest::newRow("batched, 2 threads") << 2 << int(Qt::BatchedConnection);
+    QTest::newRow("batched, 4 threads") << 4 << int(Qt::BatchedConnection);
+    QTest::newRow("batched, 8 threads") << 8 << int(Qt::BatchedConnection);
+}
+
+void QCoreApplicationBenchmark::queued_signal_throughput()
+{
+    QFETCH(int, threadCount);
+    QFETCH(int, connectionType);
+    const int total = 100000;
+    const int perThread = total / threadCount;
+
+    // benchmark delivering queued signals from other threads to this one
+    QBENCHMARK {
+        QueuedReceiver receiver(perThread * threadCount);
+        QList<QueuedSender *> senders;
+        for (int i = 0; i < threadCount; ++i) {
+            QueuedSender *sender = new QueuedSender(perThread);
+            connect(sender, SIGNAL(ping()), &receiver, SLOT(pong()),
+                    Qt::ConnectionType(connectionType));
+            senders.append(sender);
+        }
+        foreach (QueuedSender *sender, senders)
+            sender->start();
+        QCoreApplication::exec();
+        foreach (QueuedSender *sender, senders)
+            sender->wait();
+        qDeleteAll(senders);
+    }
+}
+
+void QCoreApplicationBenchmark::queued_signal_arguments()
+{
+    ArgumentSender sender;
+    ArgumentReceiver receiver;
+    connect(&sender, SIGNAL(ping(int,QString,double)),
+            &receiver, SLOT(pong(int,QString,double)), Qt::QueuedConnection);
+    const QString text = QStringLiteral("argument");
+
+    // benchmark copying queued arguments and delivering them
+    QBENCHMARK {
+        for (int i = 0; i < 10000; ++i)
+            sender.send(i, text, 0.5);
+        QCoreApplication::sendPostedEvents();
+    }
+}
+
 QTEST_MAIN(QCoreApplicationBenchmark)
 
 #include "main.moc"
@@ -1,4 +1,4 @@
-QT += testlib
+QT = core testlib
 
 TEMPLATE = app
 TARGET = tst_bench_qcoreapplication
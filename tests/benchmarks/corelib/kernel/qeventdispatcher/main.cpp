@@ -0,0 +1,173 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QSemaphore>
+#include <QtCore/QSocketNotifier>
+#include <QtCore/QThread>
+#include <QtCore/QVector>
+#include <private/qeventdispatcher_unix_p.h>
+#ifndef QT_NO_EPOLL
+#  include <private/qeventdispatcher_epoll_p.h>
+#endif
+#include <private/qcore_unix_p.h>
+
+#include <qtest.h>
+
+#include <sys/resource.h>
+
+enum DispatcherType {
+    SelectDispatcher,
+    EpollDispatcher
+};
+
+class Receiver : public QObject
+{
+    Q_OBJECT
+public:
+    QVector<int> readFds;
+    QSemaphore activated;
+
+public slots:
+    void createNotifiers()
+    {
+        foreach (int fd, readFds) {
+            QSocketNotifier *notifier = new QSocketNotifier(fd, QSocketNotifier::Read, this);
+            connect(notifier, &QSocketNotifier::activated, this, &Receiver::readyRead);
+        }
+    }
+
+    void destroyNotifiers()
+    {
+        qDeleteAll(findChildren<QSocketNotifier *>());
+    }
+
+    void readyRead(int fd)
+    {
+        char c;
+        qt_safe_read(fd, &c, 1);
+        activated.release();
+    }
+};
+
+class tst_QEventDispatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void wakeUpLatency_data();
+    void wakeUpLatency();
+};
+
+void tst_QEventDispatcher::initTestCase()
+{
+    // allow as many descriptors as the hard limit permits
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+void tst_QEventDispatcher::wakeUpLatency_data()
+{
+    QTest::addColumn<int>("dispatcherType");
+    QTest::addColumn<int>("notifierCount");
+
+    static const int counts[] = { 1, 10, 100, 400, 1000, 5000, 20000 };
+    for (uint i = 0; i < sizeof(counts) / sizeof(counts[0]); ++i) {
+        const int count = counts[i];
+        // each notifier needs a pipe, i.e. two descriptors
+        if (2 * count + 16 < FD_SETSIZE)
+            QTest::newRow(qPrintable(QString("select-%1").arg(count))) << int(SelectDispatcher) << count;
+#ifndef QT_NO_EPOLL
+        QTest::newRow(qPrintable(QString("epoll-%1").arg(count))) << int(EpollDispatcher) << count;
+#endif
+    }
+}
+
+// measures the time from a descriptor becoming readable until its notifier
+// has been activated in another thread, with many other idle notifiers
+void tst_QEventDispatcher::wakeUpLatency()
+{
+    QFETCH(int, dispatcherType);
+    QFETCH(int, notifierCount);
+
+    QVector<int> writeFds;
+    Receiver receiver;
+    for (int i = 0; i < notifierCount; ++i) {
+        int pipefd[2];
+        if (qt_safe_pipe(pipefd, O_NONBLOCK) == -1) {
+            foreach (int fd, receiver.readFds)
+                qt_safe_close(fd);
+            foreach (int fd, writeFds)
+                qt_safe_close(fd);
+            QSKIP("Not enough file descriptors available");
+        }
+        receiver.readFds.append(pipefd[0]);
+        writeFds.append(pipefd[1]);
+    }
+
+    QThread thread;
+#ifndef QT_NO_EPOLL
+    if (dispatcherType == EpollDispatcher)
+        thread.setEventDispatcher(new QEventDispatcherEpoll);
+    else
+#endif
+        thread.setEventDispatcher(new QEventDispatcherUNIX);
+    thread.start();
+    receiver.moveToThread(&thread);
+    QMetaObject::invokeMethod(&receiver, "createNotifiers", Qt::BlockingQueuedConnection);
+
+    // the most recently created descriptor is the worst case for select()
+    const int writeFd = writeFds.last();
+    QBENCHMARK {
+        const char c = 0;
+        qt_safe_write(writeFd, &c, 1);
+        receiver.activated.acquire();
+    }
+
+    QMetaObject::invokeMethod(&receiver, "destroyNotifiers", Qt::BlockingQueuedConnection);
+    thread.quit();
+    thread.wait();
+
+    foreach (int fd, receiver.readFds)
+        qt_safe_close(fd);
+    foreach (int fd, writeFds)
+        qt_safe_close(fd);
+}
+
+QTEST_MAIN(tst_QEventDispatcher)
+
+#include "main.moc"
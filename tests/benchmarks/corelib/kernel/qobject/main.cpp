@@ -54,6 +54,10 @@ private slots:
     void connect_disconnect_benchmark_data();
     void connect_disconnect_benchmark();
     void receiver_destroyed_benchmark();
+    void emit_receivers_benchmark_data();
+    void emit_receivers_benchmark();
+    void reconnect_receivers_benchmark_data();
+    void reconnect_receivers_benchmark();
 };
 
 struct Functor {
@@ -238,6 +242,63 @@ void QObjectBenchmark::receiver_destroyed_benchmark()
     }
 }
 
+static void receiverCount_data()
+{
+    QTest::addColumn<int>("receiverCount");
+    QTest::newRow("1 receiver") << 1;
+    QTest::newRow("100 receivers") << 100;
+    QTest::newRow("10000 receivers") << 10000;
+}
+
+void QObjectBenchmark::emit_receivers_benchmark_data()
+{
+    receiverCount_data();
+}
+
+void QObjectBenchmark::emit_receivers_benchmark()
+{
+    QFETCH(int, receiverCount);
+    Object sender;
+    QVector<Object *> receivers;
+    for (int i = 0; i < receiverCount; ++i) {
+        receivers.append(new Object);
+        QObject::connect(&sender, &Object::signal0, receivers.last(), &Object::slot0);
+    }
+
+    QBENCHMARK {
+        sender.emitSignal0();
+    }
+    qDeleteAll(receivers);
+}
+
+void QObjectBenchmark::reconnect_receivers_benchmark_data()
+{
+    receiverCount_data();
+}
+
+void QObjectBenchmark::reconnect_receivers_benchmark()
+{
+    QFETCH(int, receiverCount);
+    Object sender;
+    QVector<Object *> receivers;
+    QVector<QMetaObject::Connection> connections;
+    for (int i = 0; i < receiverCount; ++i) {
+        receivers.append(new Object);
+        connections.append(QObject::connect(&sender, &Object::signal0,
+                                            receivers.last(), &Object::slot0));
+    }
+
+    // disconnect every receiver by its handle and connect it again
+    QBENCHMARK {
+        for (int i = 0; i < receiverCount; ++i) {
+            QObject::disconnect(connections.at(i));
+            connections[i] = QObject::connect(&sender, &Object::signal0,
+                                              receivers.at(i), &Object::slot0);
+        }
+    }
+    qDeleteAll(receivers);
+}
+
 QTEST_MAIN(QObjectBenchmark)
 
 #include "main.moc"
@@ -0,0 +1,214 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore/QBasicTimer>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QThread>
+#include <QtCore/QVector>
+
+#include <qtest.h>
+
+class TimerObject : public QObject
+{
+public:
+    TimerObject() : fired(0), singleShot(false) { }
+
+    QBasicTimer timer;
+    int fired;
+    bool singleShot;
+
+protected:
+    void timerEvent(QTimerEvent *) Q_DECL_OVERRIDE
+    {
+        ++fired;
+        if (singleShot)
+            timer.stop();
+    }
+};
+
+class tst_QTimer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void startStop_data();
+    void startStop();
+    void insert_data();
+    void insert();
+    void remove_data();
+    void remove();
+    void fire_data();
+    void fire();
+};
+
+// start a number of long running timers with different intervals, as a
+// server would do for connection idle timeouts
+static void startIdleTimers(QVector<TimerObject *> &objects, int count, Qt::TimerType type)
+{
+    objects.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        TimerObject *object = new TimerObject;
+        object->timer.start(60000 + (i * 7919) % 60000, type, object);
+        objects.append(object);
+    }
+}
+
+void tst_QTimer::startStop_data()
+{
+    QTest::addColumn<int>("timerCount");
+    QTest::addColumn<int>("timerType");
+
+    static const int counts[] = { 0, 1000, 10000, 50000 };
+    for (uint i = 0; i < sizeof(counts) / sizeof(counts[0]); ++i) {
+        QTest::newRow(qPrintable(QString("precise-%1").arg(counts[i])))
+                << counts[i] << int(Qt::PreciseTimer);
+        QTest::newRow(qPrintable(QString("coarse-%1").arg(counts[i])))
+                << counts[i] << int(Qt::CoarseTimer);
+    }
+}
+
+// cost of starting and stopping a timer while many others are active
+void tst_QTimer::startStop()
+{
+    QFETCH(int, timerCount);
+    QFETCH(int, timerType);
+
+    QVector<TimerObject *> objects;
+    startIdleTimers(objects, timerCount, Qt::TimerType(timerType));
+
+    TimerObject object;
+    int interval = 0;
+    QBENCHMARK {
+        object.timer.start(30000 + interval, Qt::TimerType(timerType), &object);
+        object.timer.stop();
+        interval = (interval + 4973) % 60000;
+    }
+
+    qDeleteAll(objects);
+}
+
+static void timerCountData()
+{
+    QTest::addColumn<int>("timerCount");
+    QTest::addColumn<int>("timerType");
+
+    static const int counts[] = { 1000, 10000, 100000 };
+    for (uint i = 0; i < sizeof(counts) / sizeof(counts[0]); ++i) {
+        QTest::newRow(qPrintable(QString("precise-%1").arg(counts[i])))
+                << counts[i] << int(Qt::PreciseTimer);
+        QTest::newRow(qPrintable(QString("coarse-%1").arg(counts[i])))
+                << counts[i] << int(Qt::CoarseTimer);
+    }
+}
+
+void tst_QTimer::insert_data()
+{
+    timerCountData();
+}
+
+// cost of starting many timers
+void tst_QTimer::insert()
+{
+    QFETCH(int, timerCount);
+    QFETCH(int, timerType);
+
+    QVector<TimerObject *> objects;
+    objects.reserve(timerCount);
+    for (int i = 0; i < timerCount; ++i)
+        objects.append(new TimerObject);
+
+    QBENCHMARK_ONCE {
+        for (int i = 0; i < timerCount; ++i)
+            objects.at(i)->timer.start(60000 + (i * 7919) % 60000, Qt::TimerType(timerType), objects.at(i));
+    }
+
+    qDeleteAll(objects);
+}
+
+void tst_QTimer::remove_data()
+{
+    timerCountData();
+}
+
+// cost of stopping many timers, in a different order than they were started
+void tst_QTimer::remove()
+{
+    QFETCH(int, timerCount);
+    QFETCH(int, timerType);
+
+    QVector<TimerObject *> objects;
+    startIdleTimers(objects, timerCount, Qt::TimerType(timerType));
+
+    QBENCHMARK_ONCE {
+        for (int i = 0; i < timerCount; ++i)
+            objects.at((i * 7) % timerCount)->timer.stop();
+    }
+
+    qDeleteAll(objects);
+}
+
+void tst_QTimer::fire_data()
+{
+    timerCountData();
+}
+
+// cost of activating many timers that are due at the same time
+void tst_QTimer::fire()
+{
+    QFETCH(int, timerCount);
+    QFETCH(int, timerType);
+
+    QVector<TimerObject *> objects;
+    objects.reserve(timerCount);
+    for (int i = 0; i < timerCount; ++i) {
+        TimerObject *object = new TimerObject;
+        object->singleShot = true;
+        object->timer.start(100 + i % 100, Qt::TimerType(timerType), object);
+        objects.append(object);
+    }
+
+    // let all of them expire before measuring
+    QThread::msleep(250);
+
+    QBENCHMARK_ONCE {
+        QCoreApplication::processEvents();
+    }
+
+    for (int i = 0; i < timerCount; ++i)
+        QCOMPARE(objects.at(i)->fired, 1);
+    qDeleteAll(objects);
+}
+
+QTEST_MAIN(tst_QTimer)
+
+#include "main.moc"
@@ -0,0 +1,116 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtest.h>
+#include <QtCore>
+
+class tst_QFuture : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void reportResult_data();
+    void reportResult();
+};
+
+class ReportingThread : public QThread
+{
+public:
+    QFutureInterface<int> *promise;
+    int count;
+
+    void run() Q_DECL_OVERRIDE
+    {
+        for (int i = 0; i < count; ++i)
+            promise->reportResult(i);
+    }
+};
+
+void tst_QFuture::reportResult_data()
+{
+    QTest::addColumn<bool>("lockFree");
+    QTest::addColumn<bool>("watched");
+    QTest::addColumn<int>("threadCount");
+
+    for (int threadCount = 1; threadCount <= 4; threadCount *= 4) {
+        const QByteArray threads = ", " + QByteArray::number(threadCount) + " thread(s)";
+        QTest::newRow("mutex" + threads) << false << false << threadCount;
+        QTest::newRow("lock-free" + threads) << true << false << threadCount;
+        QTest::newRow("mutex, watched" + threads) << false << true << threadCount;
+        QTest::newRow("lock-free, watched" + threads) << true << true << threadCount;
+    }
+}
+
+void tst_QFuture::reportResult()
+{
+    QFETCH(bool, lockFree);
+    QFETCH(bool, watched);
+    QFETCH(int, threadCount);
+    const int resultCount = 40000;
+
+    QVector<ReportingThread *> threads;
+    for (int i = 0; i < threadCount; ++i)
+        threads.append(new ReportingThread);
+
+    QBENCHMARK {
+        QFutureInterface<int> promise;
+        // filter mode takes the mutex for every result, like all results
+        // did before they could be reported without it; appending with
+        // index -1 stores them the same way
+        promise.setFilterMode(!lockFree);
+        promise.reportStarted();
+
+        QFutureWatcher<int> watcher;
+        if (watched)
+            watcher.setFuture(promise.future());
+
+        for (int i = 0; i < threadCount; ++i) {
+            threads[i]->promise = &promise;
+            threads[i]->count = resultCount / threadCount;
+            threads[i]->start();
+        }
+        for (int i = 0; i < threadCount; ++i)
+            threads[i]->wait();
+        promise.reportFinished();
+        QCOMPARE(promise.future().resultCount(), resultCount);
+
+        // deliver the watcher's notifications, which both paths post alike
+        QCoreApplication::processEvents();
+    }
+
+    qDeleteAll(threads);
+}
+
+QTEST_MAIN(tst_QFuture)
+
+#include "tst_qfuture.moc"
@@ -33,6 +33,7 @@
 
 #include <QtCore/QtCore>
 #include <QtTest/QtTest>
+#include <private/qmutex_p.h>
 
 #include <math.h>
 
@@ -141,6 +142,9 @@ private slots:
     void contendedNative();
     void contendedQMutex();
     void contendedQMutexLocker();
+
+    void contendedSpinning_data();
+    void contendedSpinning();
 };
 
 QSemaphore tst_QMutex::semaphore1;
@@ -456,5 +460,83 @@ void tst_QMutex::contendedQMutexLocker()
     qDeleteAll(threads);
 }
 
+void tst_QMutex::contendedSpinning_data()
+{
+    QTest::addColumn<int>("threads");
+    QTest::addColumn<int>("spinLimit");
+
+    static const int threadCounts[] = { 2, 8, 32 };
+    for (int i = 0; i < int(sizeof(threadCounts) / sizeof(threadCounts[0])); ++i) {
+        const int n = threadCounts[i];
+        QTest::newRow(qPrintable(QString("%1 threads, no spinning").arg(n))) << n << 0;
+        QTest::newRow(qPrintable(QString("%1 threads, spinning").arg(n))) << n << -1;
+    }
+}
+
+class QMutexSpinningThread : public QThread
+{
+    QMutex *mutex;
+    int *counter;
+public:
+    bool done;
+    QMutexSpinningThread(QMutex *mutex, int *counter)
+        : mutex(mutex), counter(counter), done(false)
+    { }
+    void run() {
+        forever {
+            tst_QMutex::semaphore1.release();
+            tst_QMutex::semaphore2.acquire();
+            if (done)
+                break;
+            // a short critical section, the case spinning is meant for
+            for (int i = 0; i < 10000; ++i) {
+                mutex->lock();
+                ++*counter;
+                mutex->unlock();
+            }
+            tst_QMutex::semaphore3.release();
+            tst_QMutex::semaphore4.acquire();
+        }
+    }
+};
+
+void tst_QMutex::contendedSpinning()
+{
+#ifndef QT_LINUX_FUTEX
+    QSKIP("The spin policy is only used by the futex-based QMutex");
+#else
+    QFETCH(int, threads);
+    QFETCH(int, spinLimit);
+
+    QMutexSpinPolicy::setSpinLimit(spinLimit);
+
+    QMutex mutex;
+    int counter = 0;
+
+    QVector<QMutexSpinningThread *> pool(threads);
+    for (int i = 0; i < pool.count(); ++i) {
+        pool[i] = new QMutexSpinningThread(&mutex, &counter);
+        pool[i]->start();
+    }
+
+    QBENCHMARK {
+        semaphore1.acquire(threads);
+        semaphore2.release(threads);
+        semaphore3.acquire(threads);
+        semaphore4.release(threads);
+    }
+
+    for (int i = 0; i < pool.count(); ++i)
+        pool[i]->done = true;
+    semaphore1.acquire(threads);
+    semaphore2.release(threads);
+    for (int i = 0; i < pool.count(); ++i)
+        pool[i]->wait();
+    qDeleteAll(pool);
+
+    QMutexSpinPolicy::setSpinLimit(-1);
+#endif
+}
+
 QTEST_MAIN(tst_QMutex)
 #include "tst_qmutex.moc"
@@ -0,0 +1,6 @@
+TEMPLATE = app
+TARGET = tst_bench_qreadwritelock
+QT = core testlib
+SOURCES += tst_qreadwritelock.cpp
+
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0
@@ -0,0 +1,186 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtCore/QtCore>
+#include <QtTest/QtTest>
+
+// Measures how read locking scales with the number of threads compared to
+// a plain QMutex. Every thread performs the same number of lookups in a
+// shared table, so with perfect scaling the time per run grows only with
+// the total amount of work, not with lock contention.
+
+enum LockType {
+    MutexLock,
+    ReadLock,
+    ReadMostly          // read lock, with a write lock every WriteInterval lookups
+};
+
+enum {
+    Iterations = 100000,
+    WriteInterval = 100,
+    TableSize = 64
+};
+
+class tst_QReadWriteLock : public QObject
+{
+    Q_OBJECT
+private slots:
+    void uncontendedQMutex();
+    void uncontendedReadLock();
+    void uncontendedWriteLock();
+    void uncontendedReadLocker();
+
+    void readerScaling_data();
+    void readerScaling();
+};
+
+void tst_QReadWriteLock::uncontendedQMutex()
+{
+    QMutex lock;
+    QBENCHMARK {
+        lock.lock();
+        lock.unlock();
+    }
+}
+
+void tst_QReadWriteLock::uncontendedReadLock()
+{
+    QReadWriteLock lock;
+    QBENCHMARK {
+        lock.lockForRead();
+        lock.unlock();
+    }
+}
+
+void tst_QReadWriteLock::uncontendedWriteLock()
+{
+    QReadWriteLock lock;
+    QBENCHMARK {
+        lock.lockForWrite();
+        lock.unlock();
+    }
+}
+
+void tst_QReadWriteLock::uncontendedReadLocker()
+{
+    QReadWriteLock lock;
+    QBENCHMARK {
+        QReadLocker locker(&lock);
+    }
+}
+
+struct SharedTable
+{
+    QMutex mutex;
+    QReadWriteLock lock;
+    int values[TableSize];
+};
+
+class LookupThread : public QThread
+{
+public:
+    LookupThread(SharedTable *table, LockType type)
+        : table(table), type(type), sum(0)
+    { }
+
+    void run() Q_DECL_OVERRIDE
+    {
+        for (int i = 0; i < Iterations; ++i) {
+            const int index = i % TableSize;
+            switch (type) {
+            case MutexLock:
+                table->mutex.lock();
+                sum += table->values[index];
+                table->mutex.unlock();
+                break;
+            case ReadMostly:
+                if (i % WriteInterval == 0) {
+                    table->lock.lockForWrite();
+                    ++table->values[index];
+                    table->lock.unlock();
+                    break;
+                }
+                // fall through
+            case ReadLock:
+                table->lock.lockForRead();
+                sum += table->values[index];
+                table->lock.unlock();
+                break;
+            }
+        }
+    }
+
+    SharedTable *table;
+    LockType type;
+    qint64 sum;
+};
+
+void tst_QReadWriteLock::readerScaling_data()
+{
+    QTest::addColumn<int>("type");
+    QTest::addColumn<int>("threadCount");
+
+    static const int counts[] = { 1, 2, 4, 8, 16 };
+    for (size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); ++i) {
+        const QByteArray suffix = ", " + QByteArray::number(counts[i]) + " threads";
+        QTest::newRow(("QMutex" + suffix).constData()) << int(MutexLock) << counts[i];
+        QTest::newRow(("lockForRead" + suffix).constData()) << int(ReadLock) << counts[i];
+        QTest::newRow(("read-mostly" + suffix).constData()) << int(ReadMostly) << counts[i];
+    }
+}
+
+void tst_QReadWriteLock::readerScaling()
+{
+    QFETCH(int, type);
+    QFETCH(int, threadCount);
+
+    SharedTable table;
+    for (int i = 0; i < TableSize; ++i)
+        table.values[i] = i;
+
+    QBENCHMARK {
+        QVector<LookupThread *> threads;
+        for (int i = 0; i < threadCount; ++i) {
+            threads.append(new LookupThread(&table, LockType(type)));
+            threads.last()->start();
+        }
+        for (int i = 0; i < threadCount; ++i)
+            threads.at(i)->wait();
+        qDeleteAll(threads);
+    }
+}
+
+QTEST_MAIN(tst_QReadWriteLock)
+
+#include "tst_qreadwritelock.moc"
@@ -45,6 +45,8 @@ public:
 private slots:
     void startRunnables();
     void activeThreadCount();
+    void contention_data();
+    void contention();
 };
 
 tst_QThreadPool::tst_QThreadPool()
@@ -62,6 +64,17 @@ public:
     }
 };
 
+class CountingRunnable : public QRunnable
+{
+public:
+    explicit CountingRunnable(QAtomicInt *counter) : counter(counter) { }
+    void run() Q_DECL_OVERRIDE {
+        counter->ref();
+    }
+
+    QAtomicInt *counter;
+};
+
 void tst_QThreadPool::startRunnables()
 {
     QThreadPool threadPool;
@@ -80,5 +93,34 @@ void tst_QThreadPool::activeThreadCount()
     }
 }
 
+void tst_QThreadPool::contention_data()
+{
+    QTest::addColumn<int>("threadCount");
+
+    QTest::newRow("1 thread") << 1;
+    QTest::newRow("2 threads") << 2;
+    QTest::newRow("8 threads") << 8;
+    QTest::newRow("32 threads") << 32;
+}
+
+// many tiny tasks, so that the threads mostly compete for the queue
+void tst_QThreadPool::contention()
+{
+    QFETCH(int, threadCount);
+    const int taskCount = 100000;
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(threadCount);
+    QAtomicInt counter;
+
+    QBENCHMARK {
+        for (int i = 0; i < taskCount; ++i)
+            threadPool.start(new CountingRunnable(&counter));
+        threadPool.waitForDone();
+    }
+
+    QVERIFY(counter.load() % taskCount == 0);
+}
+
 QTEST_MAIN(tst_QThreadPool)
 #include "tst_qthreadpool.moc"
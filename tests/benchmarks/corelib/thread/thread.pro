@@ -1,6 +1,8 @@
 TEMPLATE = subdirs
 SUBDIRS = \
+        qfuture \
         qmutex \
+        qreadwritelock \
         qthreadstorage \
         qthreadpool \
         qwaitcondition \
@@ -0,0 +1,252 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QFlatHash>
+#include <QHash>
+#include <QVector>
+#include <qtest.h>
+
+class tst_QFlatHash : public QObject
+{
+    Q_OBJECT
+private slots:
+    void insert_int_data() { data(); }
+    void insert_int();
+    void lookup_int_data() { data(); }
+    void lookup_int();
+    void lookupMissing_int_data() { data(); }
+    void lookupMissing_int();
+    void remove_int_data() { data(); }
+    void remove_int();
+    void iterate_int_data() { data(); }
+    void iterate_int();
+    void lookup_string_data() { data(); }
+    void lookup_string();
+
+private:
+    void data();
+};
+
+void tst_QFlatHash::data()
+{
+    QTest::addColumn<bool>("flat");
+    QTest::addColumn<int>("size");
+
+    const int sizes[] = { 1000, 100000, 1000000 };
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        const QByteArray size = QByteArray::number(sizes[i]);
+        QTest::newRow(QByteArray("QHash--" + size).constData()) << false << sizes[i];
+        QTest::newRow(QByteArray("QFlatHash--" + size).constData()) << true << sizes[i];
+    }
+}
+
+// keeps the compiler from dropping the loops being measured
+static volatile int sink;
+
+// a fixed xorshift sequence, so that every run sees the same data
+static quint32 nextRandom(quint32 &state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+// distinct keys without any pattern either container could profit from;
+// offset selects a disjoint set of keys
+static QVector<int> intKeys(int size, int offset = 0)
+{
+    QVector<int> keys;
+    keys.reserve(size);
+    quint32 state = 2463534242U;
+    for (int i = 0; i < size; ++i)
+        keys.append(int(nextRandom(state) & ~1U) | (offset ? 1 : 0));
+    return keys;
+}
+
+// the same keys in another order: looking them up in insertion order would
+// favor QHash, whose nodes are allocated in that order
+template <typename Key>
+static QVector<Key> lookupKeys(QVector<Key> keys)
+{
+    quint32 state = 88675123U;
+    for (int i = keys.size() - 1; i > 0; --i)
+        qSwap(keys[i], keys[int(nextRandom(state) % uint(i + 1))]);
+    return keys;
+}
+
+template <typename Hash>
+static void fill(Hash &hash, const QVector<int> &keys)
+{
+    for (int i = 0; i < keys.size(); ++i)
+        hash.insert(keys.at(i), i);
+}
+
+template <typename Hash>
+static void insertInt(int size)
+{
+    const QVector<int> keys = intKeys(size);
+    QBENCHMARK {
+        Hash hash;
+        fill(hash, keys);
+    }
+}
+
+void tst_QFlatHash::insert_int()
+{
+    QFETCH(bool, flat);
+    QFETCH(int, size);
+    if (flat)
+        insertInt<QFlatHash<int, int> >(size);
+    else
+        insertInt<QHash<int, int> >(size);
+}
+
+template <typename Hash>
+static void lookupInt(int size, int offset)
+{
+    Hash hash;
+    fill(hash, intKeys(size));
+    const QVector<int> keys = lookupKeys(intKeys(size, offset));
+
+    int sum = 0;
+    QBENCHMARK {
+        for (int i = 0; i < keys.size(); ++i)
+            sum += hash.value(keys.at(i));
+    }
+    sink = sum;
+}
+
+void tst_QFlatHash::lookup_int()
+{
+    QFETCH(bool, flat);
+    QFETCH(int, size);
+    if (flat)
+        lookupInt<QFlatHash<int, int> >(size, 0);
+    else
+        lookupInt<QHash<int, int> >(size, 0);
+}
+
+void tst_QFlatHash::lookupMissing_int()
+{
+    QFETCH(bool, flat);
+    QFETCH(int, size);
+    if (flat)
+        lookupInt<QFlatHash<int, int> >(size, 1);
+    else
+        lookupInt<QHash<int, int> >(size, 1);
+}
+
+template <typename Hash>
+static void removeInt(int size)
+{
+    const QVector<int> keys = intKeys(size);
+    Hash filled;
+    fill(filled, keys);
+
+    QBENCHMARK {
+        Hash hash = filled;
+        hash.detach();
+        for (int i = 0; i < keys.size(); ++i)
+            hash.remove(keys.at(i));
+    }
+}
+
+void tst_QFlatHash::remove_int()
+{
+    QFETCH(bool, flat);
+    QFETCH(int, size);
+    if (flat)
+        removeInt<QFlatHash<int, int> >(size);
+    else
+        removeInt<QHash<int, int> >(size);
+}
+
+template <typename Hash>
+static void iterateInt(int size)
+{
+    Hash hash;
+    fill(hash, intKeys(size));
+
+    int sum = 0;
+    QBENCHMARK {
+        for (typename Hash::const_iterator it = hash.constBegin(); it != hash.constEnd(); ++it)
+            sum += it.value();
+    }
+    sink = sum;
+}
+
+void tst_QFlatHash::iterate_int()
+{
+    QFETCH(bool, flat);
+    QFETCH(int, size);
+    if (flat)
+        iterateInt<QFlatHash<int, int> >(size);
+    else
+        iterateInt<QHash<int, int> >(size);
+}
+
+template <typename Hash>
+static void lookupString(int size)
+{
+    QVector<QString> keys;
+    keys.reserve(size);
+    Hash hash;
+    for (int i = 0; i < size; ++i) {
+        keys.append(QStringLiteral("/usr/share/item/") + QString::number(i));
+        hash.insert(keys.last(), i);
+    }
+
+    keys = lookupKeys(keys);
+
+    int sum = 0;
+    QBENCHMARK {
+        for (int i = 0; i < keys.size(); ++i)
+            sum += hash.value(keys.at(i));
+    }
+    sink = sum;
+}
+
+void tst_QFlatHash::lookup_string()
+{
+    QFETCH(bool, flat);
+    QFETCH(int, size);
+    if (flat)
+        lookupString<QFlatHash<QString, int> >(size);
+    else
+        lookupString<QHash<QString, int> >(size);
+}
+
+QTEST_MAIN(tst_QFlatHash)
+
+#include "main.moc"
@@ -0,0 +1,259 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QFlatMap>
+#include <QMap>
+#include <QVector>
+#include <qtest.h>
+
+class tst_QFlatMap : public QObject
+{
+    Q_OBJECT
+private slots:
+    void build_int_data() { data(); }
+    void build_int();
+    void insert_int_data() { data(); }
+    void insert_int();
+    void lookup_int_data() { data(); }
+    void lookup_int();
+    void lookup_string_data() { data(); }
+    void lookup_string();
+    void iterate_int_data() { data(); }
+    void iterate_int();
+    void copyAndModify_int_data() { data(); }
+    void copyAndModify_int();
+
+private:
+    void data();
+};
+
+// small maps are what QFlatMap is meant for; the largest size shows where
+// inserting into the middle of the arrays starts to hurt
+void tst_QFlatMap::data()
+{
+    QTest::addColumn<bool>("flat");
+    QTest::addColumn<int>("size");
+
+    const int sizes[] = { 8, 64, 1000, 100000 };
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        const QByteArray size = QByteArray::number(sizes[i]);
+        QTest::newRow(QByteArray("QMap--" + size).constData()) << false << sizes[i];
+        QTest::newRow(QByteArray("QFlatMap--" + size).constData()) << true << sizes[i];
+    }
+}
+
+// keeps the compiler from dropping the loops being measured
+static volatile int sink;
+
+// a fixed xorshift sequence, so that every run sees the same data
+static quint32 nextRandom(quint32 &state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+static QVector<int> intKeys(int size)
+{
+    QVector<int> keys;
+    keys.reserve(size);
+    quint32 state = 2463534242U;
+    for (int i = 0; i < size; ++i)
+        keys.append(int(nextRandom(state)));
+    return keys;
+}
+
+template <typename Key>
+static QVector<Key> shuffled(QVector<Key> keys)
+{
+    quint32 state = 88675123U;
+    for (int i = keys.size() - 1; i > 0; --i)
+        qSwap(keys[i], keys[int(nextRandom(state) % uint(i + 1))]);
+    return keys;
+}
+
+template <typename Key>
+static QVector<QPair<Key, int> > pairsOf(const QVector<Key> &keys)
+{
+    QVector<QPair<Key, int> > pairs;
+    pairs.reserve(keys.size());
+    for (int i = 0; i < keys.size(); ++i)
+        pairs.append(qMakePair(keys.at(i), i));
+    return pairs;
+}
+
+template <typename Map>
+static void fill(Map &map, const QVector<int> &keys)
+{
+    for (int i = 0; i < keys.size(); ++i)
+        map.insert(keys.at(i), i);
+}
+
+// building a whole map from unsorted data: QFlatMap sorts it in one go
+void tst_QFlatMap::build_int()
+{
+    QFETCH(bool, flat);
+    QFETCH(int, size);
+    const QVector<QPair<int, int> > pairs = pairsOf(intKeys(size));
+
+    if (flat) {
+        QBENCHMARK {
+            QFlatMap<int, int> map = QFlatMap<int, int>::fromVector(pairs);
+            sink = map.size();
+        }
+    } else {
+        QBENCHMARK {
+            QMap<int, int> map;
+            for (int i = 0; i < pairs.size(); ++i)
+                map.insert(pairs.at(i).first, pairs.at(i).second);
+            sink = map.size();
+        }
+    }
+}
+
+template <typename Map>
+static void insertInt(int size)
+{
+    const QVector<int> keys = intKeys(size);
+    QBENCHMARK {
+        Map map;
+        fill(map, keys);
+        sink = map.size();
+    }
+}
+
+// building a map one insert() at a time
+void tst_QFlatMap::insert_int()
+{
+    QFETCH(bool, flat);
+    QFETCH(int, size);
+    if (flat)
+        insertInt<QFlatMap<int, int> >(size);
+    else
+        insertInt<QMap<int, int> >(size);
+}
+
+template <typename Map, typename Key>
+static void lookup(const QVector<Key> &keys)
+{
+    Map map;
+    for (int i = 0; i < keys.size(); ++i)
+        map.insert(keys.at(i), i);
+    const QVector<Key> lookups = shuffled(keys);
+
+    int sum = 0;
+    QBENCHMARK {
+        for (int i = 0; i < lookups.size(); ++i)
+            sum += map.value(lookups.at(i));
+    }
+    sink = sum;
+}
+
+void tst_QFlatMap::lookup_int()
+{
+    QFETCH(bool, flat);
+    QFETCH(int, size);
+    if (flat)
+        lookup<QFlatMap<int, int> >(intKeys(size));
+    else
+        lookup<QMap<int, int> >(intKeys(size));
+}
+
+// like looking up header fields or settings
+void tst_QFlatMap::lookup_string()
+{
+    QFETCH(bool, flat);
+    QFETCH(int, size);
+    QVector<QString> keys;
+    keys.reserve(size);
+    for (int i = 0; i < size; ++i)
+        keys.append(QStringLiteral("X-Header-Field-") + QString::number(i));
+
+    if (flat)
+        lookup<QFlatMap<QString, int> >(keys);
+    else
+        lookup<QMap<QString, int> >(keys);
+}
+
+template <typename Map>
+static void iterateInt(int size)
+{
+    Map map;
+    fill(map, intKeys(size));
+
+    int sum = 0;
+    QBENCHMARK {
+        for (typename Map::const_iterator it = map.constBegin(); it != map.constEnd(); ++it)
+            sum += it.value();
+    }
+    sink = sum;
+}
+
+void tst_QFlatMap::iterate_int()
+{
+    QFETCH(bool, flat);
+    QFETCH(int, size);
+    if (flat)
+        iterateInt<QFlatMap<int, int> >(size);
+    else
+        iterateInt<QMap<int, int> >(size);
+}
+
+template <typename Map>
+static void copyAndModifyInt(int size)
+{
+    Map map;
+    fill(map, intKeys(size));
+
+    QBENCHMARK {
+        Map copy = map;
+        copy.insert(0, 0);
+        sink = copy.size();
+    }
+}
+
+// the cost of detaching a shared map
+void tst_QFlatMap::copyAndModify_int()
+{
+    QFETCH(bool, flat);
+    QFETCH(int, size);
+    if (flat)
+        copyAndModifyInt<QFlatMap<int, int> >(size);
+    else
+        copyAndModifyInt<QMap<int, int> >(size);
+}
+
+QTEST_MAIN(tst_QFlatMap)
+
+#include "main.moc"
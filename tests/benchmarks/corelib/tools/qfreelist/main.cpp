@@ -0,0 +1,162 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QThread>
+#include <QVector>
+#include <QtTest>
+#include <private/qfreelist_p.h>
+
+struct MagazineConstants : QFreeListDefaultConstants
+{
+    enum { MagazineSize = 16 };
+};
+
+static QFreeList<void> sharedFreeList;
+static QFreeList<void, MagazineConstants> magazineFreeList;
+
+enum { Iterations = 100000 };
+
+// Takes and releases ids the way timers and mutexes do: a few are held at
+// any time, and most are released soon after they were taken.
+template <typename FreeList>
+static void useIds(FreeList &freeList)
+{
+    int held[4];
+    for (int i = 0; i < Iterations; ++i) {
+        const int n = 1 + i % 4;
+        for (int j = 0; j < n; ++j)
+            held[j] = freeList.next();
+        for (int j = 0; j < n; ++j)
+            freeList.release(held[j]);
+    }
+}
+
+class FreeListThread : public QThread
+{
+public:
+    explicit FreeListThread(bool useMagazines) : useMagazines(useMagazines) {}
+    void run() Q_DECL_OVERRIDE
+    {
+        if (useMagazines)
+            useIds(magazineFreeList);
+        else
+            useIds(sharedFreeList);
+    }
+
+private:
+    bool useMagazines;
+};
+
+class TimerThread : public QThread
+{
+public:
+    void run() Q_DECL_OVERRIDE
+    {
+        QObject object;
+        for (int i = 0; i < Iterations / 10; ++i) {
+            const int id = object.startTimer(1000);
+            object.killTimer(id);
+        }
+    }
+};
+
+class tst_QFreeList : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void nextRelease_data();
+    void nextRelease();
+    void timerIds_data();
+    void timerIds();
+};
+
+void tst_QFreeList::nextRelease_data()
+{
+    QTest::addColumn<bool>("useMagazines");
+    QTest::addColumn<int>("threadCount");
+    const int threadCounts[] = { 1, 4, 16 };
+    for (int i = 0; i < 3; ++i) {
+        const int count = threadCounts[i];
+        QTest::newRow(qPrintable(QString::fromLatin1("shared, %1 threads").arg(count))) << false << count;
+        QTest::newRow(qPrintable(QString::fromLatin1("magazines, %1 threads").arg(count))) << true << count;
+    }
+}
+
+void tst_QFreeList::nextRelease()
+{
+    QFETCH(bool, useMagazines);
+    QFETCH(int, threadCount);
+
+    QBENCHMARK {
+        QVector<FreeListThread *> threads;
+        for (int i = 0; i < threadCount; ++i) {
+            threads << new FreeListThread(useMagazines);
+            threads.last()->start();
+        }
+        foreach (FreeListThread *thread, threads) {
+            thread->wait();
+            delete thread;
+        }
+    }
+}
+
+void tst_QFreeList::timerIds_data()
+{
+    QTest::addColumn<int>("threadCount");
+    QTest::newRow("1 thread") << 1;
+    QTest::newRow("4 threads") << 4;
+    QTest::newRow("16 threads") << 16;
+}
+
+void tst_QFreeList::timerIds()
+{
+    QFETCH(int, threadCount);
+
+    QBENCHMARK {
+        QVector<TimerThread *> threads;
+        for (int i = 0; i < threadCount; ++i) {
+            threads << new TimerThread;
+            threads.last()->start();
+        }
+        foreach (TimerThread *thread, threads) {
+            thread->wait();
+            delete thread;
+        }
+    }
+}
+
+QTEST_MAIN(tst_QFreeList)
+
+#include "main.moc"
@@ -0,0 +1,8 @@
+TEMPLATE = app
+TARGET = tst_bench_qfreelist
+
+QT = core-private testlib
+
+SOURCES += main.cpp
+!contains(QT_CONFIG,private_tests): SOURCES += $$QT_SOURCE_TREE/src/corelib/tools/qfreelist.cpp
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0
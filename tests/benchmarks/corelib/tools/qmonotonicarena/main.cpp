@@ -0,0 +1,157 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QHash>
+#include <QMonotonicArena>
+#include <QString>
+#include <QThread>
+#include <QVector>
+#include <QtTest>
+
+class tst_QMonotonicArena : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void request_data();
+    void request();
+    void threads_data();
+    void threads();
+};
+
+static QByteArray makeMessage()
+{
+    QByteArray message;
+    for (int i = 0; i < 50; ++i)
+        message += "key" + QByteArray::number(i) + '=' + QByteArray::number(i * 7919) + '&';
+    return message;
+}
+
+// A typical request: parse a message into a temporary hash, compute a
+// result and throw everything away. With an arena, the nodes of the hash
+// get their memory from it.
+static int handleRequest(const QByteArray &message, QMonotonicArena *arena)
+{
+    QHash<QString, QString> query;
+    if (arena)
+        query = arena->createHash<QString, QString>(64);
+    int sum = 0;
+    int start = 0;
+    while (start < message.size()) {
+        int end = message.indexOf('&', start);
+        if (end < 0)
+            end = message.size();
+        const int eq = message.indexOf('=', start);
+        const QString key = QString::fromLatin1(message.constData() + start, eq - start);
+        const QString value = QString::fromLatin1(message.constData() + eq + 1, end - eq - 1);
+        query.insert(key, value);
+        sum += value.toInt();
+        start = end + 1;
+    }
+    return query.size() + sum;
+}
+
+static void handleRequests(const QByteArray &message, int count, bool useArena)
+{
+    QMonotonicArena arena(64 * 1024);
+    for (int i = 0; i < count; ++i) {
+        if (useArena) {
+            handleRequest(message, &arena);
+            arena.release();
+        } else {
+            handleRequest(message, Q_NULLPTR);
+        }
+    }
+}
+
+void tst_QMonotonicArena::request_data()
+{
+    QTest::addColumn<bool>("useArena");
+    QTest::newRow("heap") << false;
+    QTest::newRow("arena") << true;
+}
+
+void tst_QMonotonicArena::request()
+{
+    QFETCH(bool, useArena);
+    const QByteArray message = makeMessage();
+    QBENCHMARK {
+        handleRequests(message, 100, useArena);
+    }
+}
+
+class RequestThread : public QThread
+{
+public:
+    RequestThread(const QByteArray &message, bool useArena)
+        : message(message), useArena(useArena) {}
+    void run() Q_DECL_OVERRIDE { handleRequests(message, 200, useArena); }
+
+private:
+    QByteArray message;
+    bool useArena;
+};
+
+void tst_QMonotonicArena::threads_data()
+{
+    QTest::addColumn<bool>("useArena");
+    QTest::addColumn<int>("threadCount");
+    QTest::newRow("heap, 4 threads") << false << 4;
+    QTest::newRow("arena, 4 threads") << true << 4;
+    QTest::newRow("heap, 16 threads") << false << 16;
+    QTest::newRow("arena, 16 threads") << true << 16;
+}
+
+void tst_QMonotonicArena::threads()
+{
+    QFETCH(bool, useArena);
+    QFETCH(int, threadCount);
+    const QByteArray message = makeMessage();
+
+    QBENCHMARK {
+        QVector<RequestThread *> threads;
+        for (int i = 0; i < threadCount; ++i) {
+            threads << new RequestThread(message, useArena);
+            threads.last()->start();
+        }
+        foreach (RequestThread *thread, threads) {
+            thread->wait();
+            delete thread;
+        }
+    }
+}
+
+QTEST_MAIN(tst_QMonotonicArena)
+
+#include "main.moc"
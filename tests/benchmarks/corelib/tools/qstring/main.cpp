@@ -34,6 +34,46 @@
 #include <QFile>
 #include <QtTest/QtTest>
 
+#ifdef __GLIBC__
+#include <stdlib.h>
+
+extern "C" void *__libc_malloc(size_t);
+extern "C" void *__libc_realloc(void *, size_t);
+extern "C" void *__libc_calloc(size_t, size_t);
+
+// Counts the heap allocations made while countAllocations is set, so that
+// the short string benchmarks can report allocations and bytes per call.
+static bool countAllocations = false;
+static qint64 allocationCount = 0;
+static qint64 allocatedBytes = 0;
+
+static inline void recordAllocation(size_t size)
+{
+    if (countAllocations) {
+        ++allocationCount;
+        allocatedBytes += size;
+    }
+}
+
+extern "C" void *malloc(size_t size)
+{
+    recordAllocation(size);
+    return __libc_malloc(size);
+}
+
+extern "C" void *realloc(void *ptr, size_t size)
+{
+    recordAllocation(size);
+    return __libc_realloc(ptr, size);
+}
+
+extern "C" void *calloc(size_t n, size_t size)
+{
+    recordAllocation(n * size);
+    return __libc_calloc(n, size);
+}
+#endif
+
 class tst_QString: public QObject
 {
     Q_OBJECT
@@ -54,7 +94,30 @@ private slots:
     void toCaseFolded_data();
     void toCaseFolded();
 
+    void shortString_data();
+    void shortString();
+    void shortStringAllocations_data() { shortString_data(); }
+    void shortStringAllocations();
+    void shortStringBytes_data() { shortString_data(); }
+    void shortStringBytes();
+
+    void fromLatin1_data() { kernel_data(); }
+    void fromLatin1();
+    void toLatin1_data() { kernel_data(); }
+    void toLatin1();
+    void compare_data() { kernel_data(); }
+    void compare();
+    void compareLatin1_data() { kernel_data(); }
+    void compareLatin1();
+    void compareCaseInsensitive_data() { kernel_data(); }
+    void compareCaseInsensitive();
+    void indexOfChar_data() { kernel_data(); }
+    void indexOfChar();
+    void indexOfString_data() { kernel_data(); }
+    void indexOfString();
+
 private:
+    void kernel_data();
     void section_data_impl(bool includeRegExOnly = true);
     template <typename RX> void section_impl();
 };
@@ -193,6 +256,217 @@ void tst_QString::toCaseFolded()
     }
 }
 
+enum ShortStringOperation {
+    NumberPositive,
+    NumberNegative,
+    NumberZero,
+    ToUtf8Ascii,
+    ToUtf8NonAscii,
+    FromUtf8,
+    FromLatin1,
+    ToLatin1
+};
+
+static volatile int sink;
+
+static void runShortStringOperation(int operation, int i)
+{
+    static const QString ascii = QStringLiteral("hello, world");
+    static const QString nonAscii = QString::fromUtf8("gr\xc3\xbc\xc3\x9f dich, Welt");
+    static const char utf8[] = "na\xc3\xafve caf\xc3\xa9";
+
+    switch (operation) {
+    case NumberPositive:
+        sink = QString::number(i + 1000).size();
+        break;
+    case NumberNegative:
+        sink = QString::number(-i - 1000).size();
+        break;
+    case NumberZero:
+        sink = QString::number(i & 0).size();
+        break;
+    case ToUtf8Ascii:
+        sink = ascii.toUtf8().size();
+        break;
+    case ToUtf8NonAscii:
+        sink = nonAscii.toUtf8().size();
+        break;
+    case FromUtf8:
+        sink = QString::fromUtf8(utf8).size();
+        break;
+    case FromLatin1:
+        sink = QString::fromLatin1("hello, world").size();
+        break;
+    case ToLatin1:
+        sink = ascii.toLatin1().size();
+        break;
+    }
+}
+
+void tst_QString::shortString_data()
+{
+    QTest::addColumn<int>("operation");
+
+    QTest::newRow("number(positive)") << int(NumberPositive);
+    QTest::newRow("number(negative)") << int(NumberNegative);
+    QTest::newRow("number(0)") << int(NumberZero);
+    QTest::newRow("toUtf8(ascii)") << int(ToUtf8Ascii);
+    QTest::newRow("toUtf8(non-ascii)") << int(ToUtf8NonAscii);
+    QTest::newRow("fromUtf8") << int(FromUtf8);
+    QTest::newRow("fromLatin1") << int(FromLatin1);
+    QTest::newRow("toLatin1") << int(ToLatin1);
+}
+
+void tst_QString::shortString()
+{
+    QFETCH(int, operation);
+
+    QBENCHMARK {
+        for (int i = 0; i < 1000; ++i)
+            runShortStringOperation(operation, i);
+    }
+}
+
+void tst_QString::shortStringAllocations()
+{
+#ifdef __GLIBC__
+    QFETCH(int, operation);
+
+    runShortStringOperation(operation, 0); // warm up the static data
+    allocationCount = 0;
+    countAllocations = true;
+    runShortStringOperation(operation, 0);
+    countAllocations = false;
+
+    QTest::setBenchmarkResult(allocationCount, QTest::Events);
+#else
+    QSKIP("Counting allocations requires glibc");
+#endif
+}
+
+void tst_QString::shortStringBytes()
+{
+#ifdef __GLIBC__
+    QFETCH(int, operation);
+
+    runShortStringOperation(operation, 0);
+    allocatedBytes = 0;
+    countAllocations = true;
+    runShortStringOperation(operation, 0);
+    countAllocations = false;
+
+    QTest::setBenchmarkResult(allocatedBytes, QTest::BytesAllocated);
+#else
+    QSKIP("Counting allocations requires glibc");
+#endif
+}
+
+// The string kernels pick their SSE2, AVX2 or AVX-512 implementation at
+// runtime; run with QT_NO_CPU_FEATURE="avx512bw" or "avx2 avx512bw" to
+// compare them on the same machine.
+void tst_QString::kernel_data()
+{
+    QTest::addColumn<int>("size");
+
+    QTest::newRow("8") << 8;
+    QTest::newRow("31") << 31;
+    QTest::newRow("100") << 100;
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("10000") << 10000;
+}
+
+static QString kernelString(int size)
+{
+    QString s;
+    s.reserve(size);
+    for (int i = 0; i < size; ++i)
+        s += QLatin1Char('a' + i % 26);
+    return s;
+}
+
+void tst_QString::fromLatin1()
+{
+    QFETCH(int, size);
+    const QByteArray latin1 = kernelString(size).toLatin1();
+
+    QBENCHMARK {
+        sink = QString::fromLatin1(latin1).size();
+    }
+}
+
+void tst_QString::toLatin1()
+{
+    QFETCH(int, size);
+    const QString s = kernelString(size);
+
+    QBENCHMARK {
+        sink = s.toLatin1().size();
+    }
+}
+
+void tst_QString::compare()
+{
+    QFETCH(int, size);
+    const QString a = kernelString(size);
+    QString b = a;
+    b.detach();
+    b[size - 1] = QLatin1Char('#');
+
+    QBENCHMARK {
+        sink = a.compare(b);
+    }
+}
+
+void tst_QString::compareLatin1()
+{
+    QFETCH(int, size);
+    const QString a = kernelString(size);
+    QByteArray b = a.toLatin1();
+    b[size - 1] = '#';
+    const QLatin1String latin1(b);
+
+    QBENCHMARK {
+        sink = a.compare(latin1);
+    }
+}
+
+void tst_QString::compareCaseInsensitive()
+{
+    QFETCH(int, size);
+    const QString a = kernelString(size);
+    QString b = a.toUpper();
+    b[size - 1] = QLatin1Char('#');
+
+    QBENCHMARK {
+        sink = a.compare(b, Qt::CaseInsensitive);
+    }
+}
+
+void tst_QString::indexOfChar()
+{
+    QFETCH(int, size);
+    QString s = kernelString(size);
+    s[size - 1] = QLatin1Char('#');
+
+    QBENCHMARK {
+        sink = s.indexOf(QLatin1Char('#'));
+    }
+}
+
+void tst_QString::indexOfString()
+{
+    QFETCH(int, size);
+    QString s = kernelString(size);
+    // the needle starts and ends with characters that occur in the
+    // haystack, but only matches at the end
+    const QString needle = QStringLiteral("abc#");
+    s.replace(size - needle.size(), needle.size(), needle);
+
+    QBENCHMARK {
+        sink = s.indexOf(needle);
+    }
+}
+
 QTEST_APPLESS_MAIN(tst_QString)
 
 #include "main.moc"
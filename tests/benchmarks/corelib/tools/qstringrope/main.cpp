@@ -0,0 +1,184 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QBuffer>
+#include <QString>
+#include <QStringRope>
+#include <QTextStream>
+#include <QtTest>
+
+class tst_QStringRope : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void build_data();
+    void build();
+    void insert_data();
+    void insert();
+    void write_data();
+    void write();
+    void textStream_data();
+    void textStream();
+
+private:
+    static QStringList pieces();
+    static QStringRope makeRope();
+};
+
+// About 8 MB of UTF-16 text made from short and a few long pieces.
+QStringList tst_QStringRope::pieces()
+{
+    QStringList result;
+    const QString paragraph = QString(QLatin1String("Lorem ipsum dolor sit amet. ")).repeated(100);
+    for (int i = 0; i < 100000; ++i) {
+        result << QLatin1String("<td>") << QString::number(i) << QLatin1String("</td>\n");
+        if (i % 100 == 0)
+            result << paragraph;
+    }
+    return result;
+}
+
+QStringRope tst_QStringRope::makeRope()
+{
+    QStringRope rope;
+    foreach (const QString &piece, pieces())
+        rope += piece;
+    return rope;
+}
+
+void tst_QStringRope::build_data()
+{
+    QTest::addColumn<bool>("useRope");
+    QTest::newRow("QString") << false;
+    QTest::newRow("QStringRope") << true;
+}
+
+void tst_QStringRope::build()
+{
+    QFETCH(bool, useRope);
+    const QStringList input = pieces();
+
+    if (useRope) {
+        QBENCHMARK {
+            QStringRope rope;
+            foreach (const QString &piece, input)
+                rope += piece;
+            QVERIFY(!rope.isEmpty());
+        }
+    } else {
+        QBENCHMARK {
+            QString string;
+            foreach (const QString &piece, input)
+                string += piece;
+            QVERIFY(!string.isEmpty());
+        }
+    }
+}
+
+void tst_QStringRope::insert_data()
+{
+    build_data();
+}
+
+void tst_QStringRope::insert()
+{
+    QFETCH(bool, useRope);
+    const QStringRope initial = makeRope();
+    const QString line = QLatin1String("<tr><td>inserted</td></tr>\n");
+
+    if (useRope) {
+        QBENCHMARK {
+            QStringRope rope = initial;
+            for (int i = 0; i < 1000; ++i)
+                rope.insert((rope.size() / 1000) * i, line);
+        }
+    } else {
+        const QString initialString = initial.toString();
+        QBENCHMARK {
+            QString string = initialString;
+            for (int i = 0; i < 1000; ++i)
+                string.insert((string.size() / 1000) * i, line);
+        }
+    }
+}
+
+void tst_QStringRope::write_data()
+{
+    build_data();
+}
+
+void tst_QStringRope::write()
+{
+    QFETCH(bool, useRope);
+    const QStringRope rope = makeRope();
+    const QString string = rope.toString();
+
+    QBENCHMARK {
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        if (useRope)
+            buffer.write(rope);
+        else
+            buffer.write(string.toUtf8());
+    }
+}
+
+void tst_QStringRope::textStream_data()
+{
+    build_data();
+}
+
+void tst_QStringRope::textStream()
+{
+    QFETCH(bool, useRope);
+    const QStringRope rope = makeRope();
+    const QString string = rope.toString();
+
+    QBENCHMARK {
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        QTextStream stream(&buffer);
+        stream.setCodec("UTF-8");
+        if (useRope)
+            stream << rope;
+        else
+            stream << string;
+        stream.flush();
+    }
+}
+
+QTEST_MAIN(tst_QStringRope)
+
+#include "main.moc"
@@ -0,0 +1,7 @@
+TEMPLATE = app
+TARGET = tst_bench_qstringrope
+
+QT = core testlib
+
+SOURCES += main.cpp
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0
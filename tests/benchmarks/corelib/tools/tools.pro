@@ -6,8 +6,12 @@ SUBDIRS = \
         qcontiguouscache \
         qcryptographichash \
         qdatetime \
+        qflathash \
+        qflatmap \
+        qfreelist \
         qlist \
         qlocale \
+        qmonotonicarena \
         qmap \
         qrect \
         qregexp \
@@ -16,6 +20,7 @@ SUBDIRS = \
         qstring \
         qstringbuilder \
         qstringlist \
+        qstringrope \
         qvector \
         qalgorithms
 
@@ -160,6 +160,7 @@ Configure::Configure(int& argc, char** argv)
     dictionary[ "SSE4_2" ]          = "auto";
     dictionary[ "AVX" ]             = "auto";
     dictionary[ "AVX2" ]            = "auto";
+    dictionary[ "AVX512BW" ]        = "auto";
     dictionary[ "SYNCQT" ]          = "auto";
     dictionary[ "CE_CRT" ]          = "no";
     dictionary[ "CETEST" ]          = "auto";
@@ -183,6 +184,7 @@ Configure::Configure(int& argc, char** argv)
     dictionary[ "QT_TSLIB" ]        = "auto";
     dictionary[ "QT_INOTIFY" ]      = "auto";
     dictionary[ "QT_EVENTFD" ]      = "auto";
+    dictionary[ "QT_EPOLL" ]        = "auto";
     dictionary[ "QT_CUPS" ]         = "auto";
     dictionary[ "CFG_GCC_SYSROOT" ] = "yes";
     dictionary[ "SLOG2" ]           = "no";
@@ -865,6 +867,10 @@ void Configure::parseCmdLine()
             dictionary[ "AVX2" ] = "no";
         else if (configCmdLine.at(i) == "-avx2")
             dictionary[ "AVX2" ] = "yes";
+        else if (configCmdLine.at(i) == "-no-avx512bw")
+            dictionary[ "AVX512BW" ] = "no";
+        else if (configCmdLine.at(i) == "-avx512bw")
+            dictionary[ "AVX512BW" ] = "yes";
 
         else if (configCmdLine.at(i) == "-no-ssl") {
             dictionary[ "SSL"] = "no";
@@ -939,6 +945,10 @@ void Configure::parseCmdLine()
             dictionary[ "QT_EVENTFD" ] = "no";
         } else if (configCmdLine.at(i) == "-eventfd") {
             dictionary[ "QT_EVENTFD" ] = "yes";
+        } else if (configCmdLine.at(i) == "-no-epoll") {
+            dictionary[ "QT_EPOLL" ] = "no";
+        } else if (configCmdLine.at(i) == "-epoll") {
+            dictionary[ "QT_EPOLL" ] = "yes";
         }
 
         // Work around compiler nesting limitation
@@ -1679,6 +1689,7 @@ void Configure::applySpecSpecifics()
         dictionary[ "SSE4_2" ]              = "no";
         dictionary[ "AVX" ]                 = "no";
         dictionary[ "AVX2" ]                = "no";
+        dictionary[ "AVX512BW" ]            = "no";
         dictionary[ "CE_CRT" ]              = "yes";
         dictionary[ "LARGE_FILE" ]          = "no";
         dictionary[ "ANGLE" ]               = "no";
@@ -1887,6 +1898,9 @@ bool Configure::displayHelp()
         desc("QT_EVENTFD",  "yes",     "-eventfd",      "Enable eventfd(7) support in the UNIX event loop.");
         desc("QT_EVENTFD",  "no",      "-no-eventfd",   "Disable eventfd(7) support in the UNIX event loop.\n");
 
+        desc("QT_EPOLL",    "yes",     "-epoll",        "Enable the epoll(7) based event dispatcher.");
+        desc("QT_EPOLL",    "no",      "-no-epoll",     "Disable the epoll(7) based event dispatcher.\n");
+
         desc("LARGE_FILE",  "yes",     "-largefile",    "Enables Qt to access files larger than 4 GB.\n");
 
         desc("FONT_CONFIG", "yes",     "-fontconfig",   "Build with FontConfig support.");
@@ -1993,7 +2007,9 @@ bool Configure::displayHelp()
         desc("AVX", "no",       "-no-avx",              "Do not compile with use of AVX instructions.");
         desc("AVX", "yes",      "-avx",                 "Compile with use of AVX instructions.");
         desc("AVX2", "no",      "-no-avx2",             "Do not compile with use of AVX2 instructions.");
-        desc("AVX2", "yes",     "-avx2",                "Compile with use of AVX2 instructions.\n");
+        desc("AVX2", "yes",     "-avx2",                "Compile with use of AVX2 instructions.");
+        desc("AVX512BW", "no",  "-no-avx512bw",         "Do not compile with use of AVX-512 BW instructions.");
+        desc("AVX512BW", "yes", "-avx512bw",            "Compile with use of AVX-512 BW instructions.\n");
         desc("SSL", "no",        "-no-ssl",             "Do not compile support for SSL.");
         desc("SSL", "yes",       "-ssl",                "Enable run-time SSL support.");
         desc("OPENSSL", "no",    "-no-openssl",         "Do not compile support for OpenSSL.");
@@ -2262,6 +2278,8 @@ bool Configure::checkAvailability(const QString &part)
         available = tryCompileProject("common/avx");
     else if (part == "AVX2")
         available = tryCompileProject("common/avx2");
+    else if (part == "AVX512BW")
+        available = tryCompileProject("common/avx512bw");
     else if (part == "OPENSSL")
         available = findFile("openssl\\ssl.h");
     else if (part == "LIBPROXY")
@@ -2308,6 +2326,8 @@ bool Configure::checkAvailability(const QString &part)
         available = tryCompileProject("unix/inotify");
     } else if (part == "QT_EVENTFD") {
         available = tryCompileProject("unix/eventfd");
+    } else if (part == "QT_EPOLL") {
+        available = tryCompileProject("unix/epoll");
     } else if (part == "CUPS") {
         available = (platform() != WINDOWS) && (platform() != WINDOWS_CE) && (platform() != WINDOWS_RT) && tryCompileProject("unix/cups");
     } else if (part == "STACK_PROTECTOR_STRONG") {
@@ -2425,6 +2445,8 @@ void Configure::autoDetection()
         dictionary["AVX"] = checkAvailability("AVX") ? "yes" : "no";
     if (dictionary["AVX2"] == "auto")
         dictionary["AVX2"] = checkAvailability("AVX2") ? "yes" : "no";
+    if (dictionary["AVX512BW"] == "auto")
+        dictionary["AVX512BW"] = checkAvailability("AVX512BW") ? "yes" : "no";
     if (dictionary["NEON"] == "auto")
         dictionary["NEON"] = checkAvailability("NEON") ? "yes" : "no";
     if (dictionary["SSL"] == "auto") {
@@ -2509,6 +2531,9 @@ void Configure::autoDetection()
     if (dictionary["QT_EVENTFD"] == "auto")
         dictionary["QT_EVENTFD"] = checkAvailability("QT_EVENTFD") ? "yes" : "no";
 
+    if (dictionary["QT_EPOLL"] == "auto")
+        dictionary["QT_EPOLL"] = checkAvailability("QT_EPOLL") ? "yes" : "no";
+
     if (dictionary["FONT_CONFIG"] == "auto")
         dictionary["FONT_CONFIG"] = checkAvailability("FONT_CONFIG") ? "yes" : "no";
 
@@ -2951,6 +2976,9 @@ void Configure::generateOutputVars()
     if (dictionary["QT_EVENTFD"] == "yes")
         qtConfig += "eventfd";
 
+    if (dictionary["QT_EPOLL"] == "yes")
+        qtConfig += "epoll";
+
     if (dictionary["FONT_CONFIG"] == "yes") {
         qtConfig += "fontconfig";
         qmakeVars += "QMAKE_CFLAGS_FONTCONFIG =";
@@ -3125,6 +3153,8 @@ void Configure::generateCachefile()
             moduleStream << " avx";
         if (dictionary[ "AVX2" ] == "yes")
             moduleStream << " avx2";
+        if (dictionary[ "AVX512BW" ] == "yes")
+            moduleStream << " avx512bw";
         if (dictionary[ "NEON" ] == "yes")
             moduleStream << " neon";
         if (dictionary[ "LARGE_FILE" ] == "yes")
@@ -3588,6 +3618,8 @@ void Configure::generateConfigfiles()
             tmpStream << "#define QT_COMPILER_SUPPORTS_AVX 1" << endl;
         if (dictionary[ "AVX2" ] == "yes")
             tmpStream << "#define QT_COMPILER_SUPPORTS_AVX2 1" << endl;
+        if (dictionary[ "AVX512BW" ] == "yes")
+            tmpStream << "#define QT_COMPILER_SUPPORTS_AVX512BW 1" << endl;
 
         if (dictionary["QREAL"] != "double") {
             tmpStream << "#define QT_COORD_TYPE " << dictionary["QREAL"] << endl;
@@ -3663,6 +3695,7 @@ void Configure::generateConfigfiles()
         if (dictionary["QT_GLIB"] == "no")           qconfigList += "QT_NO_GLIB";
         if (dictionary["QT_INOTIFY"] == "no")        qconfigList += "QT_NO_INOTIFY";
         if (dictionary["QT_EVENTFD"] ==  "no")       qconfigList += "QT_NO_EVENTFD";
+        if (dictionary["QT_EPOLL"] == "no")          qconfigList += "QT_NO_EPOLL";
 
         if (dictionary["REDUCE_EXPORTS"] == "yes")     qconfigList += "QT_VISIBILITY_AVAILABLE";
         if (dictionary["REDUCE_RELOCATIONS"] == "yes") qconfigList += "QT_REDUCE_RELOCATIONS";
@@ -3761,6 +3794,7 @@ void Configure::displayConfig()
     sout << "SSE4.2 support.............." << dictionary[ "SSE4_2" ] << endl;
     sout << "AVX support................." << dictionary[ "AVX" ] << endl;
     sout << "AVX2 support................" << dictionary[ "AVX2" ] << endl;
+    sout << "AVX-512 BW support.........." << dictionary[ "AVX512BW" ] << endl;
     sout << "NEON support................" << dictionary[ "NEON" ] << endl;
     sout << "OpenGL support.............." << dictionary[ "OPENGL" ] << endl;
     sout << "Large File support.........." << dictionary[ "LARGE_FILE" ] << endl;
@@ -3770,6 +3804,7 @@ void Configure::displayConfig()
     sout << "Mtdev support..............." << dictionary[ "QT_MTDEV" ] << endl;
     sout << "Inotify support............." << dictionary[ "QT_INOTIFY" ] << endl;
     sout << "eventfd(7) support.........." << dictionary[ "QT_EVENTFD" ] << endl;
+    sout << "epoll(7) support............" << dictionary[ "QT_EPOLL" ] << endl;
     sout << "Glib support................" << dictionary[ "QT_GLIB" ] << endl;
     sout << "CUPS support................" << dictionary[ "QT_CUPS" ] << endl;
     sout << "OpenVG support.............." << dictionary[ "OPENVG" ] << endl;